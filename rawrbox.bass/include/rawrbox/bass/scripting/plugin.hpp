@@ -56,5 +56,9 @@ namespace rawrbox {
 			if (L == nullptr) throw std::runtime_error("Tried to register plugin on invalid mod!");
 			rawrbox::LuaUtils::compileAndLoadFile(L, "RawrBox::Enums::BASS", "./lua/enums/bass.lua");
 		}
+
+		void removeState(lua_State* L) override {
+			rawrbox::SoundInstanceWrapper::callbacks.removeState(L);
+		}
 	};
 } // namespace rawrbox
@@ -1,10 +1,13 @@
 #pragma once
+#include <rawrbox/scripting/utils/callbacks.hpp>
 #include <rawrbox/scripting/utils/lua.hpp>
 
 namespace rawrbox {
 	class SoundInstanceWrapper {
 
 	public:
+		static rawrbox::LuaCallbacks callbacks; // onBEAT / onBPM / onEnd, BASScripting drops them per mod
+
 		static void registerLua(lua_State* L);
 	};
 } // namespace rawrbox
@@ -3,6 +3,8 @@
 #include <rawrbox/bass/sound/instance.hpp>
 
 namespace rawrbox {
+	rawrbox::LuaCallbacks SoundInstanceWrapper::callbacks = {};
+
 	void SoundInstanceWrapper::registerLua(lua_State* L) {
 		luabridge::getGlobalNamespace(L)
 		    .beginClass<rawrbox::SoundInstance>("SoundInstance")
@@ -43,21 +45,21 @@ namespace rawrbox {
 		    // CALLBACKS ---
 		    .addFunction("onBEAT", [](rawrbox::SoundInstance* self, const luabridge::LuaRef& callback) {
 			    if (self == nullptr) throw std::runtime_error("Failed to get instance");
-			    if (!callback.isCallable()) throw std::runtime_error("Invalid callback");
 
-			    self->onBEAT += [callback](double beat) { luabridge::call(callback, beat); };
+			    auto handle = callbacks.add(callback);
+			    self->onBEAT += [handle](double beat) { rawrbox::LuaCallbacks::call(handle, beat); };
 		    })
 		    .addFunction("onBPM", [](rawrbox::SoundInstance* self, const luabridge::LuaRef& callback) {
 			    if (self == nullptr) throw std::runtime_error("Failed to get instance");
-			    if (!callback.isCallable()) throw std::runtime_error("Invalid callback");
 
-			    self->onBPM += [callback](float beat) { luabridge::call(callback, beat); };
+			    auto handle = callbacks.add(callback);
+			    self->onBPM += [handle](float beat) { rawrbox::LuaCallbacks::call(handle, beat); };
 		    })
 		    .addFunction("onEnd", [](rawrbox::SoundInstance* self, const luabridge::LuaRef& callback) {
 			    if (self == nullptr) throw std::runtime_error("Failed to get instance");
-			    if (!callback.isCallable()) throw std::runtime_error("Invalid callback");
 
-			    self->onEnd += [callback]() { luabridge::call(callback); };
+			    auto handle = callbacks.add(callback);
+			    self->onEnd += [handle]() { rawrbox::LuaCallbacks::call(handle); };
 		    })
 		    // ------
 		    .endClass();
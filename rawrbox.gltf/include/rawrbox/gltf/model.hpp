@@ -64,9 +64,14 @@ namespace rawrbox {
 
 				for (const auto& primitive : mesh->primitives) {
 					for (const auto& blend : primitive.blendShapes) {
+						// GLTF morph targets are already deltas
+						std::vector<rawrbox::Vector3f> normals(blend.norms.size());
+						for (size_t n = 0; n < blend.norms.size(); n++) {
+							normals[n] = blend.norms[n].xyz();
+						}
+
 						auto s = std::make_unique<rawrbox::BlendShapes<M>>();
-						s->normals = blend.norms;
-						s->pos = blend.pos;
+						s->stream = rawrbox::BlendShapeStream::fromDeltas(blend.pos, normals);
 						s->weight = blend.weight;
 
 						s->mesh = this->_meshes[i].get();
@@ -40,7 +40,7 @@ namespace rawrbox {
 		if ((this->loadFlags & rawrbox::GLTFLoadFlags::IMPORT_TEXTURES) > 0) {
 			extensions |= fastgltf::Extensions::KHR_materials_unlit |
 				      fastgltf::Extensions::KHR_materials_specular | fastgltf::Extensions::KHR_texture_basisu |
-				      fastgltf::Extensions::EXT_texture_webp | fastgltf::Extensions::KHR_materials_emissive_strength;
+				      fastgltf::Extensions::EXT_texture_webp | fastgltf::Extensions::MSFT_texture_dds | fastgltf::Extensions::KHR_materials_emissive_strength;
 
 			gltfOptions |= fastgltf::Options::LoadExternalImages; // Handle loading for us
 		}
@@ -182,15 +182,15 @@ namespace rawrbox {
 
 			std::optional<std::pair<size_t, rawrbox::GLTFImageType>> imgIndex = std::nullopt;
 
-			if (gltfTexture.basisuImageIndex.has_value()) {
-				imgIndex = {gltfTexture.basisuImageIndex.value(), rawrbox::GLTFImageType::OTHER};
+			// Prefer block compressed sources, basis payloads can't be transcoded so they go last
+			if (gltfTexture.ddsImageIndex.has_value()) {
+				imgIndex = {gltfTexture.ddsImageIndex.value(), rawrbox::GLTFImageType::DDS};
 			} else if (gltfTexture.imageIndex.has_value()) {
 				imgIndex = {gltfTexture.imageIndex.value(), rawrbox::GLTFImageType::OTHER};
 			} else if (gltfTexture.webpImageIndex.has_value()) {
 				imgIndex = {gltfTexture.webpImageIndex.value(), rawrbox::GLTFImageType::WEBP};
-			} else if (gltfTexture.ddsImageIndex.has_value()) {
-				// imgIndex = {gltfTexture.ddsImageIndex.value(), rawrbox::GLTFImageType::DDS};  // TODO: SUPPORT DDS
-				continue;
+			} else if (gltfTexture.basisuImageIndex.has_value()) {
+				imgIndex = {gltfTexture.basisuImageIndex.value(), rawrbox::GLTFImageType::OTHER};
 			}
 
 			std::string name(gltfTexture.name);
@@ -222,8 +222,6 @@ namespace rawrbox {
 					texture = std::make_unique<rawrbox::TextureWEBP>(name, bah, static_cast<int>(imageData.bytes.size()));
 					break;
 				case GLTFImageType::DDS:
-					this->_logger->warn("Unsupported texture '{} -> {}'", i, name);
-					continue;
 				case GLTFImageType::OTHER:
 					texture = std::make_unique<rawrbox::TextureImage>(bah, static_cast<int>(imageData.bytes.size()));
 					break;
@@ -436,6 +434,7 @@ namespace rawrbox {
 
 			this->skeletons[i] = std::move(buildSkeleton);
 			this->skeletons[i]->inverseBindMatrices = inverseBindMatrices;
+			this->skeletons[i]->rootInverse = rawrbox::Matrix4x4(inverseBindMatrices[0]).inverse().mtx; // Used by every skinned pose, no need to invert it each frame
 			// ----------------------
 
 			// Apply skins on bones --
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <rawrbox/math/bbox.hpp>
+#include <rawrbox/math/matrix4x4.hpp>
+#include <rawrbox/math/vector3.hpp>
+#include <rawrbox/math/vector4.hpp>
+
+#include <array>
+#include <cstdint>
+
+namespace rawrbox {
+	// Planes are stored as (normal.xyz, distance), pointing inwards
+	class Frustum {
+	protected:
+		std::array<rawrbox::Vector4f, 6> _planes = {}; // LEFT, RIGHT, BOTTOM, TOP, NEAR, FAR
+
+	public:
+		Frustum() = default;
+		explicit Frustum(const rawrbox::Matrix4x4& viewProj);
+
+		void update(const rawrbox::Matrix4x4& viewProj);
+		[[nodiscard]] const std::array<rawrbox::Vector4f, 6>& getPlanes() const;
+
+		[[nodiscard]] bool contains(const rawrbox::Vector3f& point) const;
+
+		[[nodiscard]] bool intersects(const rawrbox::BBOX& bbox) const;
+		[[nodiscard]] bool intersects(const rawrbox::Vector3f& center, const rawrbox::Vector3f& extents) const;
+
+		// Batch test (SoA), writes 1 into `out` if the box is visible, 0 otherwise. Uses SSE when available
+		void intersects(const float* centerX, const float* centerY, const float* centerZ, const float* extentX, const float* extentY, const float* extentZ, size_t count, uint8_t* out) const;
+	};
+} // namespace rawrbox
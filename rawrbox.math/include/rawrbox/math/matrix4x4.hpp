@@ -1,5 +1,6 @@
 #pragma once
 
+#include <rawrbox/math/bbox.hpp>
 #include <rawrbox/math/vector3.hpp>
 #include <rawrbox/math/vector4.hpp>
 
@@ -72,6 +73,7 @@ namespace rawrbox {
 
 		[[nodiscard]] rawrbox::Vector3f mulVec(const rawrbox::Vector3f& other) const;
 		[[nodiscard]] rawrbox::Vector4f mulVec(const rawrbox::Vector4f& other) const;
+		[[nodiscard]] rawrbox::BBOX mulBBOX(const rawrbox::BBOX& other) const; // Transformed AABB that encloses the rotated box
 
 		rawrbox::Matrix4x4& inverse();
 		rawrbox::Matrix4x4& lookAt(const rawrbox::Vector3f& _eye, const rawrbox::Vector3f& _at, const rawrbox::Vector3f& _up);
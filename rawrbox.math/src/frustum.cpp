@@ -0,0 +1,110 @@
+#include <rawrbox/math/frustum.hpp>
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+	#include <xmmintrin.h>
+	#define RAWRBOX_FRUSTUM_SSE
+#endif
+
+namespace rawrbox {
+	Frustum::Frustum(const rawrbox::Matrix4x4& viewProj) { this->update(viewProj); }
+
+	void Frustum::update(const rawrbox::Matrix4x4& viewProj) {
+		// Gribb / Hartmann plane extraction, matrix is column-major (clip = viewProj * pos)
+		const auto& m = viewProj.mtx;
+
+		const rawrbox::Vector4f row0 = {m[0], m[4], m[8], m[12]};
+		const rawrbox::Vector4f row1 = {m[1], m[5], m[9], m[13]};
+		const rawrbox::Vector4f row2 = {m[2], m[6], m[10], m[14]};
+		const rawrbox::Vector4f row3 = {m[3], m[7], m[11], m[15]};
+
+		this->_planes[0] = row3 + row0; // LEFT
+		this->_planes[1] = row3 - row0; // RIGHT
+		this->_planes[2] = row3 + row1; // BOTTOM
+		this->_planes[3] = row3 - row1; // TOP
+		this->_planes[4] = row3 + row2; // NEAR
+		this->_planes[5] = row3 - row2; // FAR
+
+		for (auto& plane : this->_planes) {
+			float len = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+			if (len <= 0.F) continue;
+
+			plane = plane / len;
+		}
+	}
+
+	const std::array<rawrbox::Vector4f, 6>& Frustum::getPlanes() const { return this->_planes; }
+
+	bool Frustum::contains(const rawrbox::Vector3f& point) const {
+		for (const auto& plane : this->_planes) {
+			if (plane.x * point.x + plane.y * point.y + plane.z * point.z + plane.w < 0.F) return false;
+		}
+
+		return true;
+	}
+
+	bool Frustum::intersects(const rawrbox::BBOX& bbox) const {
+		return this->intersects((bbox.min + bbox.max) * 0.5F, (bbox.max - bbox.min) * 0.5F);
+	}
+
+	bool Frustum::intersects(const rawrbox::Vector3f& center, const rawrbox::Vector3f& extents) const {
+		for (const auto& plane : this->_planes) {
+			float dist = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+			float radius = std::abs(plane.x) * extents.x + std::abs(plane.y) * extents.y + std::abs(plane.z) * extents.z;
+
+			if (dist + radius < 0.F) return false;
+		}
+
+		return true;
+	}
+
+	void Frustum::intersects(const float* centerX, const float* centerY, const float* centerZ, const float* extentX, const float* extentY, const float* extentZ, size_t count, uint8_t* out) const {
+		size_t i = 0;
+
+#ifdef RAWRBOX_FRUSTUM_SSE
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 signMask = _mm_set1_ps(-0.F);
+
+		// Plain arrays, std::array drops __m128's alignment attribute (-Wignored-attributes)
+		__m128 nx[6]; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+		__m128 ny[6]; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+		__m128 nz[6]; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+		__m128 nd[6]; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+
+		for (size_t p = 0; p < this->_planes.size(); p++) {
+			nx[p] = _mm_set1_ps(this->_planes[p].x);
+			ny[p] = _mm_set1_ps(this->_planes[p].y);
+			nz[p] = _mm_set1_ps(this->_planes[p].z);
+			nd[p] = _mm_set1_ps(this->_planes[p].w);
+		}
+
+		for (; i + 4 <= count; i += 4) {
+			const __m128 cx = _mm_loadu_ps(centerX + i);
+			const __m128 cy = _mm_loadu_ps(centerY + i);
+			const __m128 cz = _mm_loadu_ps(centerZ + i);
+			const __m128 ex = _mm_loadu_ps(extentX + i);
+			const __m128 ey = _mm_loadu_ps(extentY + i);
+			const __m128 ez = _mm_loadu_ps(extentZ + i);
+
+			__m128 outside = _mm_setzero_ps();
+			for (size_t p = 0; p < this->_planes.size(); p++) {
+				__m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, nx[p]), _mm_mul_ps(cy, ny[p])), _mm_add_ps(_mm_mul_ps(cz, nz[p]), nd[p]));
+				__m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ex, _mm_andnot_ps(signMask, nx[p])), _mm_mul_ps(ey, _mm_andnot_ps(signMask, ny[p]))), _mm_mul_ps(ez, _mm_andnot_ps(signMask, nz[p])));
+
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(dist, radius), zero));
+			}
+
+			const int mask = _mm_movemask_ps(outside);
+			out[i + 0] = static_cast<uint8_t>((mask & 0x1) == 0);
+			out[i + 1] = static_cast<uint8_t>((mask & 0x2) == 0);
+			out[i + 2] = static_cast<uint8_t>((mask & 0x4) == 0);
+			out[i + 3] = static_cast<uint8_t>((mask & 0x8) == 0);
+		}
+#endif
+
+		for (; i < count; i++) {
+			out[i] = static_cast<uint8_t>(this->intersects({centerX[i], centerY[i], centerZ[i]}, {extentX[i], extentY[i], extentZ[i]}));
+		}
+	}
+} // namespace rawrbox
@@ -340,6 +340,19 @@ namespace rawrbox {
 		return result;
 	}
 
+	[[nodiscard]] rawrbox::BBOX Matrix4x4::mulBBOX(const rawrbox::BBOX& other) const {
+		const rawrbox::Vector3f center = (other.min + other.max) * 0.5F;
+		const rawrbox::Vector3f extents = (other.max - other.min) * 0.5F;
+
+		const rawrbox::Vector3f newCenter = this->mulVec(center);
+		const rawrbox::Vector3f newExtents = {
+		    std::abs(this->mtx[0]) * extents.x + std::abs(this->mtx[4]) * extents.y + std::abs(this->mtx[8]) * extents.z,
+		    std::abs(this->mtx[1]) * extents.x + std::abs(this->mtx[5]) * extents.y + std::abs(this->mtx[9]) * extents.z,
+		    std::abs(this->mtx[2]) * extents.x + std::abs(this->mtx[6]) * extents.y + std::abs(this->mtx[10]) * extents.z};
+
+		return {newCenter - newExtents, newCenter + newExtents, newExtents * 2.F};
+	}
+
 	rawrbox::Matrix4x4& Matrix4x4::inverse() {
 		const float xx = mtx[0];
 		const float xy = mtx[1];
@@ -0,0 +1,58 @@
+#include <rawrbox/math/frustum.hpp>
+#include <rawrbox/math/matrix4x4.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <vector>
+
+TEST_CASE("Frustum should behave as expected", "[rawrbox::Frustum]") {
+	rawrbox::Matrix4x4::MTX_RIGHT_HANDED = false;
+
+	rawrbox::Matrix4x4 view = {};
+	view.lookAt({0, 0, 0}, {0, 0, 1}, {0, 1, 0});
+
+	auto proj = rawrbox::Matrix4x4::mtxProj(60.F, 1.F, 0.1F, 100.F);
+	rawrbox::Frustum frustum(proj * view);
+
+	SECTION("rawrbox::Frustum::contains") {
+		REQUIRE(frustum.contains({0, 0, 10}) == true);
+		REQUIRE(frustum.contains({0, 0, -10}) == false); // Behind
+		REQUIRE(frustum.contains({0, 0, 200}) == false); // Past far
+		REQUIRE(frustum.contains({0, 0, 0.01F}) == false); // Before near
+		REQUIRE(frustum.contains({50, 0, 10}) == false);
+		REQUIRE(frustum.contains({0, -50, 10}) == false);
+	}
+
+	SECTION("rawrbox::Frustum::intersects") {
+		REQUIRE(frustum.intersects(rawrbox::BBOX({-1, -1, 9}, {1, 1, 11}, {2, 2, 2})) == true);
+		REQUIRE(frustum.intersects(rawrbox::BBOX({-1, -1, -11}, {1, 1, -9}, {2, 2, 2})) == false);
+
+		// Partially inside
+		REQUIRE(frustum.intersects(rawrbox::Vector3f{8, 0, 10}, rawrbox::Vector3f{3, 1, 1}) == true);
+		REQUIRE(frustum.intersects(rawrbox::Vector3f{20, 0, 10}, rawrbox::Vector3f{3, 1, 1}) == false);
+
+		// Large box enclosing the camera
+		REQUIRE(frustum.intersects(rawrbox::Vector3f{0, 0, 0}, rawrbox::Vector3f{500, 500, 500}) == true);
+	}
+
+	SECTION("rawrbox::Frustum::intersects (batch)") {
+		std::vector<float> cx = {}, cy = {}, cz = {}, ex = {}, ey = {}, ez = {};
+		for (int i = 0; i < 23; i++) {
+			cx.push_back(static_cast<float>(i * 4 - 40));
+			cy.push_back(static_cast<float>(i % 3));
+			cz.push_back(static_cast<float>(i % 2 == 0 ? 20 : -20));
+			ex.push_back(1.F);
+			ey.push_back(1.F);
+			ez.push_back(1.F);
+		}
+
+		std::vector<uint8_t> out(cx.size(), 2);
+		frustum.intersects(cx.data(), cy.data(), cz.data(), ex.data(), ey.data(), ez.data(), cx.size(), out.data());
+
+		for (size_t i = 0; i < cx.size(); i++) {
+			bool expected = frustum.intersects(rawrbox::Vector3f{cx[i], cy[i], cz[i]}, rawrbox::Vector3f{ex[i], ey[i], ez[i]});
+			REQUIRE(out[i] == static_cast<uint8_t>(expected));
+		}
+	}
+}
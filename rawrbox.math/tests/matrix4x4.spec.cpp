@@ -402,4 +402,25 @@ TEST_CASE("Matrix4x4 should behave as expected", "[rawrbox::Matrix4x4]") {
 		REQUIRE_THAT(orthoRH[14], Catch::Matchers::WithinAbs(-1.00020003F, 0.0001F));
 		REQUIRE_THAT(orthoRH[15], Catch::Matchers::WithinAbs(1.0F, 0.0001F));
 	}
+
+	SECTION("rawrbox::Matrix4x4::mulBBOX") {
+		rawrbox::BBOX bbox({-1, -2, -3}, {1, 2, 3}, {2, 4, 6});
+
+		rawrbox::Matrix4x4 mtx = {};
+		mtx.translate({10, 0, 0});
+
+		auto moved = mtx.mulBBOX(bbox);
+		REQUIRE(moved.min == rawrbox::Vector3f(9, -2, -3));
+		REQUIRE(moved.max == rawrbox::Vector3f(11, 2, 3));
+		REQUIRE(moved.size == rawrbox::Vector3f(2, 4, 6));
+
+		mtx = {};
+		mtx.rotateY(rawrbox::piHalf<float>);
+
+		auto rotated = mtx.mulBBOX(bbox);
+		REQUIRE_THAT(rotated.min.x, Catch::Matchers::WithinAbs(-3.0F, 0.0001F));
+		REQUIRE_THAT(rotated.max.x, Catch::Matchers::WithinAbs(3.0F, 0.0001F));
+		REQUIRE_THAT(rotated.min.z, Catch::Matchers::WithinAbs(-1.0F, 0.0001F));
+		REQUIRE_THAT(rotated.max.z, Catch::Matchers::WithinAbs(1.0F, 0.0001F));
+	}
 }
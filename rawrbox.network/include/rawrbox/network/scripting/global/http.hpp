@@ -1,11 +1,14 @@
 #pragma once
 
 #include <rawrbox/network/http.hpp>
+#include <rawrbox/scripting/utils/callbacks.hpp>
 #include <rawrbox/scripting/utils/lua.hpp>
 
 namespace rawrbox {
 	class HTTPGlobal {
 	public:
+		static rawrbox::LuaCallbacks callbacks; // Pending request callbacks, NetworkScripting drops them per mod
+
 		// UTILS -----
 		static void request(const std::string& url, int method, const luabridge::LuaRef& headers, const luabridge::LuaRef& callback, std::optional<int> timeout);
 		// ----------------
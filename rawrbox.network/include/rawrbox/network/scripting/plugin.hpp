@@ -21,5 +21,9 @@ namespace rawrbox {
 			if (L == nullptr) throw std::runtime_error("Tried to register plugin on invalid mod!");
 			rawrbox::LuaUtils::compileAndLoadFile(L, "RawrBox::Enums::HTTP", "./lua/enums/http.lua");
 		}
+
+		void removeState(lua_State* L) override {
+			rawrbox::HTTPGlobal::callbacks.removeState(L);
+		}
 	};
 } // namespace rawrbox
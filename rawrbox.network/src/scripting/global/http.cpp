@@ -3,10 +3,11 @@
 #include <rawrbox/utils/string.hpp>
 
 namespace rawrbox {
+	rawrbox::LuaCallbacks HTTPGlobal::callbacks = {};
+
 	void HTTPGlobal::request(const std::string& url, int method, const luabridge::LuaRef& headers, const luabridge::LuaRef& callback, std::optional<int> timeout) {
 		if (url.empty()) throw std::runtime_error("URL cannot be empty");
 		if (!headers.isTable()) throw std::runtime_error("Invalid header table");
-		if (!callback.isCallable()) throw std::runtime_error("Invalid callback");
 
 		auto* L = headers.state();
 
@@ -24,13 +25,16 @@ namespace rawrbox {
 		}
 		// ----------
 
+		// The reply can come after the mod unloaded, the handle is empty by then and L is never touched
+		auto handle = callbacks.add(callback);
+
 		rawrbox::HTTP::request(
-		    url, static_cast<rawrbox::HTTPMethod>(method), headerMap, [callback, L](int code, const std::map<std::string, std::string>& headerResp, const std::string& resp) {
-			    rawrbox::runOnRenderThread([resp, code, callback, headerResp, L]() {
-				    if (code == 0 || (code == 200 && resp.starts_with("Operation timed out after"))) {
-					    auto result = luabridge::call(callback, false, resp); // curl error
-					    if (result.hasFailed()) fmt::print("Lua error\n  └── {}\n", result.errorMessage());
+		    url, static_cast<rawrbox::HTTPMethod>(method), headerMap, [handle, L](int code, const std::map<std::string, std::string>& headerResp, const std::string& resp) {
+			    rawrbox::runOnRenderThread([resp, code, handle, headerResp, L]() {
+				    if (!handle->has_value()) return;
 
+				    if (code == 0 || (code == 200 && resp.starts_with("Operation timed out after"))) {
+					    rawrbox::LuaCallbacks::call(handle, false, resp); // curl error
 					    return;
 				    }
 
@@ -45,8 +49,7 @@ namespace rawrbox {
 				    tbl["data"] = resp;
 				    tbl["headers"] = headerTbl;
 
-				    auto result = luabridge::call(callback, true, tbl);
-				    if (result.hasFailed()) fmt::print("Lua error\n  └── {}\n", result.errorMessage());
+				    rawrbox::LuaCallbacks::call(handle, true, tbl);
 			    });
 		    },
 		    timeout.value_or(10000));
@@ -5,11 +5,13 @@
 #include <rawrbox/math/vector4.hpp>
 #include <rawrbox/render/render_config.hpp>
 #include <rawrbox/render/textures/render.hpp>
+#include <rawrbox/render/utils/frame_allocator.hpp>
 #include <rawrbox/utils/logger.hpp>
 
 #include <RefCntAutoPtr.hpp>
 
 #include <Buffer.h>
+#include <ShaderResourceVariable.h>
 
 #include <memory>
 
@@ -81,12 +83,26 @@ namespace rawrbox {
 		std::unique_ptr<rawrbox::Logger> _logger = std::make_unique<rawrbox::Logger>("RawrBox-Camera");
 		// -------------
 
+		// TRANSFORMS ---
+		static std::unique_ptr<rawrbox::FrameAllocator> _transformAllocator;
+		static Diligent::IShaderResourceVariable* _transformVariable;
+
+		static uint64_t _transformEpoch; // Increases every time the ring gets renamed, invalidating the bound offset
+		static uint64_t _boundEpoch;
+		static const rawrbox::CameraBase* _boundCamera;
+		static rawrbox::Matrix4x4 _boundTransform;
+		// -------------
+
 		virtual void updateMtx();
 		virtual rawrbox::CameraStaticUniforms getStaticData();
+		[[nodiscard]] virtual rawrbox::CameraUniforms getUniforms(const rawrbox::Matrix4x4& world) const;
 
 	public:
 		static Diligent::RefCntAutoPtr<Diligent::IBuffer> staticUniforms;
 		static Diligent::RefCntAutoPtr<Diligent::IBuffer> uniforms;
+		static Diligent::RefCntAutoPtr<Diligent::IBuffer> transformUniforms; // Graphics only, ring of CameraUniforms bound with dynamic offsets
+
+		static constexpr uint32_t TRANSFORM_STRIDE = (sizeof(rawrbox::CameraUniforms) + 255U) & ~255U; // Constant buffer offsets must be 256 aligned
 
 		CameraBase(const rawrbox::Vector2u& renderSize, bool depth = true);
 		CameraBase(CameraBase&&) = default;
@@ -116,6 +132,10 @@ namespace rawrbox {
 		[[nodiscard]] virtual const rawrbox::Matrix4x4& getModelTransform() const;
 		virtual void setModelTransform(const rawrbox::Matrix4x4& transform);
 
+		// Writes all the transforms with a single map, returns the offset of the first one (each is TRANSFORM_STRIDE apart)
+		[[nodiscard]] virtual uint64_t writeModelTransforms(const rawrbox::Matrix4x4* transforms, size_t count);
+		virtual void bindModelTransform(const rawrbox::Matrix4x4& transform, uint64_t offset);
+
 		[[nodiscard]] virtual rawrbox::Vector3f worldToScreen(const rawrbox::Vector3f& pos) const;
 		[[nodiscard]] virtual rawrbox::Vector3f screenToWorld(const rawrbox::Vector2f& screen_pos, const rawrbox::Vector3f& origin = {0, 0, 0}) const;
 
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <rawrbox/math/bbox.hpp>
+#include <rawrbox/math/frustum.hpp>
+#include <rawrbox/render/models/instance.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace rawrbox {
+	// Same layout as DrawIndexedIndirect arguments (D3D12 / Vulkan / Diligent)
+	struct DrawIndexedIndirectArgs {
+		uint32_t numIndices = 0;
+		uint32_t numInstances = 0;
+		uint32_t firstIndex = 0;
+		int32_t baseVertex = 0;
+		uint32_t firstInstance = 0;
+	};
+
+	static_assert(sizeof(rawrbox::DrawIndexedIndirectArgs) == 20, "DrawIndexedIndirectArgs must match the GPU layout");
+
+	// CPU reference of `instance_cull.csh`, also used as fallback when indirect drawing is not available
+	// Unlike the GPU version, the compacted output keeps the instance order
+	class InstanceCuller {
+	protected:
+		std::vector<uint8_t> _visibility = {};
+
+		// World bounds (SoA) ---
+		std::vector<float> _centerX = {};
+		std::vector<float> _centerY = {};
+		std::vector<float> _centerZ = {};
+
+		std::vector<float> _extentX = {};
+		std::vector<float> _extentY = {};
+		std::vector<float> _extentZ = {};
+		// ---
+
+		void resize(size_t count);
+
+	public:
+		static constexpr size_t CULL_BATCH_SIZE = 1024; // Instances per job when culling in parallel
+
+		// Writes the visible instances into `out` and sets `args.numInstances`, returns the visible count
+		virtual uint32_t cull(const rawrbox::Frustum& frustum, const rawrbox::BBOX& bounds, const rawrbox::Instance* instances, size_t count, std::vector<rawrbox::Instance>& out, rawrbox::DrawIndexedIndirectArgs& args);
+		virtual uint32_t cull(const rawrbox::Frustum& frustum, const rawrbox::BBOX& bounds, const std::vector<rawrbox::Instance>& instances, std::vector<rawrbox::Instance>& out, rawrbox::DrawIndexedIndirectArgs& args);
+
+		InstanceCuller() = default;
+		InstanceCuller(const InstanceCuller&) = delete;
+		InstanceCuller(InstanceCuller&&) = delete;
+		InstanceCuller& operator=(const InstanceCuller&) = delete;
+		InstanceCuller& operator=(InstanceCuller&&) = delete;
+		virtual ~InstanceCuller() = default;
+	};
+} // namespace rawrbox
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <rawrbox/math/bbox.hpp>
+#include <rawrbox/math/frustum.hpp>
+#include <rawrbox/math/matrix4x4.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace rawrbox {
+	struct CullingStats {
+		uint32_t total = 0;
+		uint32_t visible = 0;
+		uint32_t culled = 0;
+	};
+
+	// World-space bounds of everything that can be frustum culled, stored as SoA so the cull can run in batches
+	// WARNING: NOT THREAD SAFE, add / update / remove must not be called while culling
+	class CullingList {
+	protected:
+		// BOUNDS (dense) ---
+		std::vector<float> _centerX = {};
+		std::vector<float> _centerY = {};
+		std::vector<float> _centerZ = {};
+
+		std::vector<float> _extentX = {};
+		std::vector<float> _extentY = {};
+		std::vector<float> _extentZ = {};
+
+		std::vector<void*> _owners = {};
+		std::vector<uint8_t> _visibility = {};
+		std::vector<uint32_t> _denseToHandle = {};
+		// ----
+
+		// HANDLES ---
+		std::vector<uint32_t> _handleToDense = {};
+		std::vector<uint32_t> _freeHandles = {};
+		// ----
+
+		rawrbox::Frustum _frustum = {};
+		rawrbox::CullingStats _stats = {};
+
+		void setBounds(uint32_t index, const rawrbox::BBOX& bbox);
+
+	public:
+		static constexpr uint32_t INVALID_HANDLE = UINT32_MAX;
+		static constexpr size_t CULL_BATCH_SIZE = 1024; // Elements per job when culling in parallel
+
+		CullingList() = default;
+		CullingList(const CullingList&) = delete;
+		CullingList(CullingList&&) = delete;
+		CullingList& operator=(const CullingList&) = delete;
+		CullingList& operator=(CullingList&&) = delete;
+		virtual ~CullingList() = default;
+
+		// Returns a stable handle, the element is visible until the next cull
+		[[nodiscard]] virtual uint32_t add(const rawrbox::BBOX& bbox, void* owner = nullptr);
+		virtual void update(uint32_t handle, const rawrbox::BBOX& bbox);
+		virtual void remove(uint32_t handle);
+		virtual void clear();
+
+		virtual void cull(const rawrbox::Matrix4x4& viewProj);
+
+		// UTILS ---
+		[[nodiscard]] virtual bool isVisible(uint32_t handle) const;
+		[[nodiscard]] virtual bool isValid(uint32_t handle) const;
+		[[nodiscard]] virtual void* getOwner(uint32_t handle) const;
+
+		[[nodiscard]] virtual const rawrbox::Frustum& getFrustum() const;
+		[[nodiscard]] virtual const rawrbox::CullingStats& getStats() const;
+
+		[[nodiscard]] virtual size_t size() const;
+		[[nodiscard]] virtual bool empty() const;
+		// ------
+	};
+} // namespace rawrbox
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <rawrbox/render/utils/range_allocator.hpp>
+#include <rawrbox/utils/logger.hpp>
+
+#include <Buffer.h>
+#include <DeviceContext.h>
+#include <RefCntAutoPtr.hpp>
+
+#include <memory>
+#include <unordered_map>
+
+namespace rawrbox {
+	struct GeometryAllocation {
+		uint32_t vertexStride = 0;
+
+		uint64_t vertexOffset = rawrbox::RangeAllocator::INVALID_OFFSET; // In vertices, used as BaseVertex
+		uint64_t indexOffset = rawrbox::RangeAllocator::INVALID_OFFSET;  // In indices, used as FirstIndexLocation
+
+		[[nodiscard]] bool isValid() const { return this->vertexStride != 0 && this->vertexOffset != rawrbox::RangeAllocator::INVALID_OFFSET && this->indexOffset != rawrbox::RangeAllocator::INVALID_OFFSET; }
+	};
+
+	struct GeometryArenaStats {
+		rawrbox::RangeAllocatorStats vertices = {};
+		rawrbox::RangeAllocatorStats indices = {};
+	};
+
+	// Shared vertex / index buffers for static geometry of the same vertex stride
+	class GeometryArena {
+	protected:
+		Diligent::RefCntAutoPtr<Diligent::IBuffer> _vbh; // Vertices
+		Diligent::RefCntAutoPtr<Diligent::IBuffer> _ibh; // Indices
+
+		rawrbox::RangeAllocator _vertices;
+		rawrbox::RangeAllocator _indices;
+
+		uint32_t _stride = 0;
+
+		// LOGGER ------
+		std::unique_ptr<rawrbox::Logger> _logger = std::make_unique<rawrbox::Logger>("RawrBox-GeometryArena");
+		// -------------
+
+		virtual void resizeVertices(uint64_t vertices);
+		virtual void resizeIndices(uint64_t indices);
+
+		virtual Diligent::RefCntAutoPtr<Diligent::IBuffer> resize(Diligent::IBuffer* old, uint64_t oldSize, uint64_t size, Diligent::BIND_FLAGS flags, Diligent::RESOURCE_STATE state);
+
+	public:
+		explicit GeometryArena(uint32_t stride);
+		GeometryArena(const GeometryArena&) = delete;
+		GeometryArena(GeometryArena&&) = delete;
+		GeometryArena& operator=(const GeometryArena&) = delete;
+		GeometryArena& operator=(GeometryArena&&) = delete;
+		virtual ~GeometryArena();
+
+		[[nodiscard]] virtual rawrbox::GeometryAllocation allocate(uint64_t vertices, uint64_t indices);
+		virtual void free(const rawrbox::GeometryAllocation& allocation);
+
+		virtual void upload(const rawrbox::GeometryAllocation& allocation, const void* vertices, uint64_t vertexCount, const uint32_t* indices, uint64_t indexCount);
+
+		// UTILS ----
+		[[nodiscard]] virtual Diligent::IBuffer* getVertexBuffer() const;
+		[[nodiscard]] virtual Diligent::IBuffer* getIndexBuffer() const;
+
+		[[nodiscard]] virtual uint32_t getStride() const;
+		[[nodiscard]] virtual rawrbox::GeometryArenaStats getStats() const;
+		// ----------
+	};
+
+	class GEOMETRY {
+	protected:
+		static std::unordered_map<uint32_t, std::unique_ptr<rawrbox::GeometryArena>> _arenas;
+		static rawrbox::GeometryArena* _bound;
+
+	public:
+		static void shutdown();
+
+		// BINDING ----
+		// Binds the arena vertex / index buffers, skipped if they are still bound. Arena models then only differ by BaseVertex / FirstIndexLocation
+		static void bind(Diligent::IDeviceContext* context, uint32_t stride);
+		// Forget the bound arena, call it at the start of a pass and whenever something else binds vertex / index buffers
+		static void unbind();
+		[[nodiscard]] static bool isBound(uint32_t stride);
+		// ----------
+
+		// Arenas are shared by vertex stride, offsets are in elements so any layout of the same size can live in the same buffer
+		static rawrbox::GeometryArena* get(uint32_t stride);
+		static rawrbox::GeometryAllocation allocate(uint32_t stride, uint64_t vertices, uint64_t indices);
+		static void free(const rawrbox::GeometryAllocation& allocation);
+
+		// UTILS ----
+		static rawrbox::GeometryArenaStats getStats(uint32_t stride);
+		// ----------
+	};
+} // namespace rawrbox
@@ -114,30 +114,39 @@ namespace rawrbox {
 
 		template <typename T = rawrbox::VertexData>
 			requires(std::derived_from<T, rawrbox::VertexData>)
-		void bindPipeline(const rawrbox::Mesh<T>& mesh) {
+		[[nodiscard]] Diligent::IPipelineState* getPipeline(const rawrbox::Mesh<T>& mesh) const {
 			if (this->base == nullptr) RAWRBOX_CRITICAL("Material not initialized!");
-			auto* context = rawrbox::RENDERER->context();
 
 			if (mesh.getWireframe()) {
 				if (this->wireframe == nullptr) RAWRBOX_CRITICAL("Wireframe not supported on material");
-				context->SetPipelineState(this->wireframe);
-			} else if (mesh.getLineMode()) {
+				return this->wireframe;
+			}
+
+			if (mesh.getLineMode()) {
 				if (this->line == nullptr) RAWRBOX_CRITICAL("Line not supported on material");
-				context->SetPipelineState(this->line);
-			} else {
-				if (mesh.culling == Diligent::CULL_MODE_NONE) {
-					if (this->cullnone == nullptr) RAWRBOX_CRITICAL("Disabled cull not supported on material");
-					if (mesh.isTransparent() && this->cullnone_alpha == nullptr) RAWRBOX_CRITICAL("Disabled alpha cull not supported on material");
-					context->SetPipelineState(mesh.isTransparent() ? this->cullnone_alpha : this->cullnone);
-				} else if (mesh.culling == Diligent::CULL_MODE_BACK) {
-					if (this->cullback == nullptr) RAWRBOX_CRITICAL("Cull back not supported on material");
-					if (mesh.isTransparent() && this->cullback_alpha == nullptr) RAWRBOX_CRITICAL("Cull back alpha not supported on material");
-					context->SetPipelineState(mesh.isTransparent() ? this->cullback_alpha : this->cullback);
-				} else {
-					if (mesh.isTransparent() && this->base_alpha == nullptr) RAWRBOX_CRITICAL("Alpha not supported on material");
-					context->SetPipelineState(mesh.isTransparent() ? this->base_alpha : this->base);
-				}
+				return this->line;
+			}
+
+			if (mesh.culling == Diligent::CULL_MODE_NONE) {
+				if (this->cullnone == nullptr) RAWRBOX_CRITICAL("Disabled cull not supported on material");
+				if (mesh.isTransparent() && this->cullnone_alpha == nullptr) RAWRBOX_CRITICAL("Disabled alpha cull not supported on material");
+				return mesh.isTransparent() ? this->cullnone_alpha : this->cullnone;
+			}
+
+			if (mesh.culling == Diligent::CULL_MODE_BACK) {
+				if (this->cullback == nullptr) RAWRBOX_CRITICAL("Cull back not supported on material");
+				if (mesh.isTransparent() && this->cullback_alpha == nullptr) RAWRBOX_CRITICAL("Cull back alpha not supported on material");
+				return mesh.isTransparent() ? this->cullback_alpha : this->cullback;
 			}
+
+			if (mesh.isTransparent() && this->base_alpha == nullptr) RAWRBOX_CRITICAL("Alpha not supported on material");
+			return mesh.isTransparent() ? this->base_alpha : this->base;
+		}
+
+		template <typename T = rawrbox::VertexData>
+			requires(std::derived_from<T, rawrbox::VertexData>)
+		void bindPipeline(const rawrbox::Mesh<T>& mesh) {
+			rawrbox::RENDERER->context()->SetPipelineState(this->getPipeline(mesh));
 		}
 	};
 } // namespace rawrbox
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <rawrbox/render/models/animations/skeleton.hpp>
+
+#include <ozz/animation/runtime/blending_job.h>
+
+#include <stdexcept>
+#include <vector>
+
+namespace rawrbox {
+	struct AnimationBlendInput {
+		ozz::span<const ozz::math::SoaTransform> locals = {};
+		float weight = 1.F;
+		bool additive = false;
+		const std::vector<float>* jointMask = nullptr; // Per joint, nullptr / empty = every joint
+	};
+
+	// Blends sampled clips with ozz's BlendingJob and builds the skinning pose, buffers are kept between ticks
+	class AnimationBlender {
+	protected:
+		ozz::vector<ozz::math::SoaTransform> _locals = {};
+		std::vector<ozz::vector<ozz::math::SimdFloat4>> _masks = {};
+
+		std::vector<ozz::animation::BlendingJob::Layer> _layers = {};
+		std::vector<ozz::animation::BlendingJob::Layer> _additive = {};
+
+		rawrbox::SkeletonPose _pose = {};
+
+		virtual ozz::span<const ozz::math::SimdFloat4> buildMask(size_t index, const std::vector<float>& mask, size_t soaJoints) {
+			if (this->_masks.size() <= index) this->_masks.resize(index + 1);
+
+			auto& soa = this->_masks[index];
+			soa.resize(soaJoints);
+
+			auto get = [&mask](size_t joint) { return joint < mask.size() ? mask[joint] : 0.F; };
+			for (size_t i = 0; i < soaJoints; i++) {
+				soa[i] = ozz::math::simd_float4::Load(get(i * 4 + 0), get(i * 4 + 1), get(i * 4 + 2), get(i * 4 + 3));
+			}
+
+			return ozz::make_span(soa);
+		}
+
+	public:
+		float threshold = 0.1F; // Same as ozz, under this total weight the rest pose is blended in
+
+		virtual const std::vector<rawrbox::Matrix4x4>& blend(const ozz::animation::Skeleton* skeleton, const std::vector<rawrbox::AnimationBlendInput>& inputs) {
+			if (skeleton == nullptr) throw std::runtime_error("Invalid skeleton");
+
+			auto soaJoints = static_cast<size_t>(skeleton->num_soa_joints());
+			this->_locals.resize(soaJoints);
+
+			this->_layers.clear();
+			this->_additive.clear();
+
+			size_t masks = 0;
+			for (const auto& input : inputs) {
+				if (input.locals.size() != soaJoints) throw std::runtime_error("Animation does not match the skeleton");
+
+				ozz::animation::BlendingJob::Layer layer = {};
+				layer.weight = input.weight;
+				layer.transform = input.locals;
+				if (input.jointMask != nullptr && !input.jointMask->empty()) layer.joint_weights = this->buildMask(masks++, *input.jointMask, soaJoints);
+
+				if (input.additive) {
+					this->_additive.push_back(layer);
+				} else {
+					this->_layers.push_back(layer);
+				}
+			}
+
+			ozz::animation::BlendingJob job;
+			job.threshold = this->threshold;
+			job.layers = ozz::make_span(this->_layers);
+			job.additive_layers = ozz::make_span(this->_additive);
+			job.rest_pose = skeleton->joint_rest_poses();
+			job.output = ozz::make_span(this->_locals);
+
+			if (!job.Run()) throw std::runtime_error("Failed to run blending job");
+
+			this->_pose.update(skeleton, ozz::make_span(this->_locals));
+			return this->_pose.skinning;
+		}
+
+		[[nodiscard]] virtual const std::vector<rawrbox::Matrix4x4>& getSkinning() const {
+			return this->_pose.skinning;
+		}
+	};
+} // namespace rawrbox
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace rawrbox {
+	// Weight moving towards a target at a fixed rate, used for cross-fades
+	struct AnimationFade {
+		float weight = 0.F;
+		float target = 0.F;
+		float speed = 0.F;    // Weight per second, 0 = instant
+		bool release = false; // Remove the clip once it reaches 0
+
+		void fadeTo(float target, float duration);
+		void update(float deltaTime);
+
+		[[nodiscard]] bool isFading() const;
+	};
+
+	struct AnimationLayer {
+		std::string name;
+
+		float weight = 1.F;
+		bool additive = false;
+
+		std::vector<float> jointMask = {};                        // Per joint weight (0 - 1), empty = every joint
+		std::map<std::string, rawrbox::AnimationFade> clips = {}; // Sorted, so the blend order is stable
+	};
+
+	struct AnimationBlendEntry {
+		const std::string* clip = nullptr; // Owned by the graph, valid until it changes
+		size_t layer = 0;
+
+		float weight = 0.F; // Clip weight * layer weight
+		bool additive = false;
+	};
+
+	// Layered weights for the animations of a model, each clip lives on a single layer
+	// Clips that are not active (weight under the threshold) should not be sampled
+	class AnimationGraph {
+	protected:
+		std::vector<rawrbox::AnimationLayer> _layers = {};
+		float _threshold = 0.001F;
+
+		rawrbox::AnimationFade* find(const std::string& clip, size_t* layer = nullptr);
+		[[nodiscard]] const rawrbox::AnimationFade* find(const std::string& clip, size_t* layer = nullptr) const;
+
+		rawrbox::AnimationFade& insert(const std::string& clip, size_t layer);
+
+	public:
+		explicit AnimationGraph(float threshold = 0.001F);
+
+		// LAYERS ---
+		size_t addLayer(const std::string& name, bool additive = false, const std::vector<float>& jointMask = {});
+
+		void setLayerWeight(size_t layer, float weight);
+		void setJointMask(size_t layer, const std::vector<float>& jointMask);
+
+		[[nodiscard]] const rawrbox::AnimationLayer& getLayer(size_t layer) const;
+		[[nodiscard]] const std::vector<rawrbox::AnimationLayer>& getLayers() const;
+		// ----------
+
+		// CLIPS ---
+		// Sets the clip weight instantly, other clips on the layer are untouched
+		void set(const std::string& clip, float weight = 1.F, size_t layer = 0);
+
+		// Cross-fades the layer into the clip, every other clip on that layer fades out and gets released
+		void play(const std::string& clip, float fadeTime = 0.F, size_t layer = 0);
+		void fade(const std::string& clip, float weight, float fadeTime); // Fading to 0 releases the clip
+
+		void remove(const std::string& clip);
+		void clear();
+
+		// Advances the fades, returns the released clips that reached 0 (they are removed from the graph)
+		std::vector<std::string> update(float deltaTime);
+		// ----------
+
+		// UTILS ---
+		[[nodiscard]] bool has(const std::string& clip) const;
+		[[nodiscard]] bool isActive(const std::string& clip) const;
+
+		[[nodiscard]] float getWeight(const std::string& clip) const; // Clip weight * layer weight
+
+		// Active clips sorted by layer, `out` is reused so ticking does not allocate
+		void getActive(std::vector<rawrbox::AnimationBlendEntry>& out) const;
+		[[nodiscard]] float getThreshold() const;
+		// ----------
+	};
+} // namespace rawrbox
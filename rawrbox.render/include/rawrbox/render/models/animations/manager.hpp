@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace rawrbox {
+	// Anything with animations that can be advanced outside of draw()
+	class AnimationTarget {
+	public:
+		AnimationTarget() = default;
+		AnimationTarget(const AnimationTarget&) = default;
+		AnimationTarget(AnimationTarget&&) = default;
+		AnimationTarget& operator=(const AnimationTarget&) = default;
+		AnimationTarget& operator=(AnimationTarget&&) = default;
+		virtual ~AnimationTarget() = default;
+
+		// Advances & samples the animations, called from worker threads so it can only touch its own data
+		virtual void tickAnimations() = 0;
+
+		// Main thread, handles finished animations (callbacks, cleanup)
+		virtual void finishAnimations() = 0;
+	};
+
+	class ANIMATIONS {
+	protected:
+		static std::vector<rawrbox::AnimationTarget*> _targets;
+		static bool _finishing;
+
+	public:
+		static void add(rawrbox::AnimationTarget* target);
+		static void remove(rawrbox::AnimationTarget* target);
+
+		// Ticks every target on the worker pool, then finishes them in order on the calling thread
+		static void tick();
+
+		// UTILS ----
+		[[nodiscard]] static size_t count();
+		// ----------
+	};
+} // namespace rawrbox
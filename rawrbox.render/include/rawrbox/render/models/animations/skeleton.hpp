@@ -1,21 +1,69 @@
 #pragma once
 
+#include <rawrbox/math/matrix4x4.hpp>
 #include <rawrbox/render/models/animations/base.hpp>
 
 #include <ozz/animation/runtime/skeleton.h>
 
 #include <stdexcept>
+#include <unordered_map>
+#include <vector>
 
 namespace rawrbox {
-	class AnimationSkeletonSampler : public rawrbox::AnimationSampler {
-	private:
-	public:
-		AnimationSkeletonSampler(size_t index, ozz::animation::Animation* anim, std::function<void(const std::string&)> onComplete = nullptr) : rawrbox::AnimationSampler(index, anim, onComplete) {}
+	struct SkeletonPose {
+		ozz::vector<ozz::math::Float4x4> model = {};      // LocalToModel output
+		std::vector<rawrbox::Matrix4x4> inverseBind = {}; // Converted once from the skeleton
+		std::vector<rawrbox::Matrix4x4> skinning = {};    // root * model * inverseBind
+		bool dirty = true;
 
-		// UTILS ----
-		virtual ozz::vector<ozz::math::Float4x4> getOutput(const ozz::animation::Skeleton* skeleton) {
+		// Runs LocalToModel on the local (SoA) transforms and builds the skinning matrices
+		void update(const ozz::animation::Skeleton* skeleton, ozz::span<const ozz::math::SoaTransform> locals) {
 			if (skeleton == nullptr) throw std::runtime_error("Invalid skeleton");
 
+			auto joints = static_cast<size_t>(skeleton->num_joints());
+			if (this->model.size() != joints) {
+				this->model.resize(joints);
+				this->skinning.resize(joints);
+
+				this->inverseBind.resize(joints);
+				for (size_t i = 0; i < joints && i < skeleton->inverseBindMatrices.size(); i++) {
+					this->inverseBind[i] = rawrbox::Matrix4x4(skeleton->inverseBindMatrices[i]);
+				}
+			}
+
+			ozz::animation::LocalToModelJob localJob;
+			localJob.input = locals;
+			localJob.output = ozz::make_span(this->model);
+			localJob.skeleton = skeleton;
+
+			if (!localJob.Run()) throw std::runtime_error("Failed to run local to model job");
+
+			rawrbox::Matrix4x4 root = rawrbox::Matrix4x4(skeleton->rootInverse);
+			rawrbox::Matrix4x4 mtx = {};
+
+			for (size_t i = 0; i < joints; i++) {
+				const ozz::math::Float4x4& output = this->model[i];
+				for (size_t c = 0; c < 4; c++) {
+					ozz::math::StorePtrU(output.cols[c], mtx.mtx.data() + c * 4);
+				}
+
+				this->skinning[i] = root * mtx * this->inverseBind[i];
+			}
+
+			this->dirty = false;
+		}
+	};
+
+	class AnimationSkeletonSampler : public rawrbox::AnimationSampler {
+	protected:
+		std::unordered_map<const ozz::animation::Skeleton*, rawrbox::SkeletonPose> _poses = {};
+
+		float _sampledTime = -1.F;
+		bool _sampled = false;
+
+		virtual void sample() {
+			if (this->_sampled && this->_sampledTime == this->_currentTime) return;
+
 			ozz::animation::SamplingJob job;
 			job.context = &this->_context;
 			job.animation = this->_animation;
@@ -24,16 +72,41 @@ namespace rawrbox {
 
 			if (!job.Run()) throw std::runtime_error("Failed to run animation job");
 
-			ozz::vector<ozz::math::Float4x4> localOutput(skeleton->num_joints());
+			this->_sampledTime = this->_currentTime;
+			this->_sampled = true;
 
-			ozz::animation::LocalToModelJob localJob;
-			localJob.input = ozz::make_span(this->_output);
-			localJob.output = ozz::make_span(localOutput);
-			localJob.skeleton = skeleton;
+			for (auto& pose : this->_poses) {
+				pose.second.dirty = true;
+			}
+		}
 
-			if (!localJob.Run()) throw std::runtime_error("Failed to run local to model job");
+		virtual rawrbox::SkeletonPose& getPose(const ozz::animation::Skeleton* skeleton) {
+			if (skeleton == nullptr) throw std::runtime_error("Invalid skeleton");
+			this->sample();
+
+			auto& pose = this->_poses[skeleton];
+			if (pose.dirty) pose.update(skeleton, ozz::make_span(this->_output));
+
+			return pose;
+		}
+
+	public:
+		AnimationSkeletonSampler(size_t index, ozz::animation::Animation* anim, std::function<void(const std::string&)> onComplete = nullptr) : rawrbox::AnimationSampler(index, anim, onComplete) {}
+
+		// UTILS ----
+		// Local (SoA) transforms, for blending
+		virtual const ozz::vector<ozz::math::SoaTransform>& getLocals() {
+			this->sample();
+			return this->_output;
+		}
+
+		// Sampled once per time / skeleton, meshes sharing a skeleton reuse the same pose
+		virtual const ozz::vector<ozz::math::Float4x4>& getOutput(const ozz::animation::Skeleton* skeleton) {
+			return this->getPose(skeleton).model;
+		}
 
-			return localOutput;
+		virtual const std::vector<rawrbox::Matrix4x4>& getSkinning(const ozz::animation::Skeleton* skeleton) {
+			return this->getPose(skeleton).skinning;
 		}
 		// -------------
 	};
@@ -1,9 +1,14 @@
 #pragma once
 
+#include <rawrbox/render/culling/list.hpp>
+#include <rawrbox/render/geometry/arena.hpp>
 #include <rawrbox/render/materials/unlit.hpp>
+#include <rawrbox/render/models/utils/blend_shapes.hpp>
 #include <rawrbox/utils/string.hpp>
+#include <rawrbox/utils/threading.hpp>
 
 #include <Buffer.h>
+#include <MapHelper.hpp>
 
 namespace rawrbox {
 
@@ -14,9 +19,7 @@ namespace rawrbox {
 		float weight = 0.F;
 
 		rawrbox::Mesh<typename M::vertexBufferType>* mesh = nullptr; // For quick access
-
-		std::vector<rawrbox::Vector3f> pos = {};
-		std::vector<rawrbox::Vector4f> normals = {};
+		rawrbox::BlendShapeStream stream = {};                       // Sparse position / normal deltas
 
 		[[nodiscard]] bool isActive() const { return weight > 0.F; }
 		BlendShapes() = default;
@@ -25,12 +28,8 @@ namespace rawrbox {
 	enum class UploadType {
 		STATIC = 0,
 		FIXED_DYNAMIC = 1,
-		RESIZABLE_DYNAMIC = 2
-	};
-
-	struct ModelOriginalData {
-		rawrbox::Vector3f pos = {};
-		uint32_t normal = {};
+		RESIZABLE_DYNAMIC = 2,
+		STREAMING_DYNAMIC = 3 // Rewritten every draw through a mapped ring (Map DISCARD), for data that changes every frame
 	};
 
 	template <typename M = rawrbox::MaterialUnlit>
@@ -41,15 +40,26 @@ namespace rawrbox {
 		Diligent::RefCntAutoPtr<Diligent::IBuffer> _vbh; // Vertices
 		Diligent::RefCntAutoPtr<Diligent::IBuffer> _ibh; // Indices
 
+		rawrbox::GeometryAllocation _geometry = {}; // Static uploads live in the shared geometry arena
+
 		std::unique_ptr<rawrbox::Mesh<typename M::vertexBufferType>> _mesh = nullptr;
 		std::unique_ptr<M> _material = nullptr;
 
 		std::unordered_map<std::string, std::unique_ptr<rawrbox::BlendShapes<M>>> _blend_shapes = {};
-		std::vector<rawrbox::ModelOriginalData> _original_data = {};
+		std::unordered_map<rawrbox::Mesh<typename M::vertexBufferType>*, rawrbox::BlendShapeAccumulator> _blend_accumulators = {}; // Base pose per mesh
+		std::vector<rawrbox::BlendShapeWeight> _blend_weights = {};
+		bool _blendShapesDirty = false;
 
 		// DYNAMIC SUPPORT ---
 		rawrbox::UploadType _uploadType = rawrbox::UploadType::STATIC;
 		bool _requiresUpdate = false;
+		bool _fullUpdate = false;
+		// ----
+
+		// CULLING ---
+		std::weak_ptr<rawrbox::CullingList> _cullingList = {}; // Expires with the renderer
+		uint32_t _cullingHandle = rawrbox::CullingList::INVALID_HANDLE;
+		bool _frustumCulling = true;
 		// ----
 
 		// LOGGER ------
@@ -58,75 +68,150 @@ namespace rawrbox {
 
 		// BLEND SHAPES ---
 		virtual void calculateOriginalShape() {
-			auto vertSize = static_cast<uint32_t>(this->_mesh->vertices.size());
-			auto indcSize = static_cast<uint32_t>(this->_mesh->indices.size());
-
-			auto empty = vertSize == 0 || indcSize == 0;
-			if (empty) RAWRBOX_CRITICAL("Invalid mesh! Missing vertices / indices!");
+			auto old = std::move(this->_blend_accumulators); // Meshes might already be deformed, keep their base
+			this->_blend_accumulators.clear();
 
-			// Store original positions for blendstates
-			this->_original_data.clear();
-			this->_original_data.reserve(vertSize);
+			for (auto& shape : this->_blend_shapes) {
+				auto* mesh = shape.second->mesh;
+				if (mesh == nullptr || this->_blend_accumulators.contains(mesh)) continue;
+				if (mesh->vertices.empty()) RAWRBOX_CRITICAL("Invalid mesh! Missing vertices!");
 
-			for (auto& v : this->_mesh->vertices) {
+				// Only keep normals if a shape moves them
+				bool normals = false;
 				if constexpr (supportsNormals<typename M::vertexBufferType>) {
-					this->_original_data.push_back({v.position, v.normal});
-				} else {
-					this->_original_data.push_back({v.position, {}});
+					for (auto& other : this->_blend_shapes) {
+						if (other.second->mesh == mesh && other.second->stream.hasNormals()) normals = true;
+					}
 				}
+
+				auto prev = old.find(mesh);
+				bool hasPrev = prev != old.end() && prev->second.size() == mesh->vertices.size();
+
+				std::vector<rawrbox::Vector3f> basePos(mesh->vertices.size());
+				std::vector<rawrbox::Vector3f> baseNormals(normals ? mesh->vertices.size() : 0);
+
+				for (size_t i = 0; i < mesh->vertices.size(); i++) {
+					basePos[i] = hasPrev ? prev->second.getBasePosition(i) : mesh->vertices[i].position;
+
+					if constexpr (supportsNormals<typename M::vertexBufferType>) {
+						if (!normals) continue;
+						baseNormals[i] = hasPrev && prev->second.hasNormals() ? prev->second.getBaseNormal(i) : rawrbox::Vector4f(rawrbox::PackUtils::fromNormal(mesh->vertices[i].normal)).xyz();
+					}
+				}
+
+				this->_blend_accumulators[mesh].setBase(basePos, baseNormals);
 			}
-			// -----------
 		}
 
 		virtual void applyBlendShapes() {
 			if (!this->isUploaded()) RAWRBOX_CRITICAL("Blendshapes require the model to be uploaded!");
 			if (!this->isDynamic()) RAWRBOX_CRITICAL("Blendshapes require the model to be dynamic!");
 
-			if (this->_original_data.empty()) this->calculateOriginalShape(); // Initial setup
+			if (this->_blend_accumulators.empty()) this->calculateOriginalShape(); // Initial setup
 
-			for (auto& shape : this->_blend_shapes) {
-				if (!shape.second->isActive() || shape.second->mesh == nullptr) continue;
-
-				auto& verts = shape.second->mesh->vertices;
-				auto& blendPos = shape.second->pos;
-				auto& blendNormals = shape.second->normals;
+			auto* flat = this->_mesh.get();
+			for (auto& acc : this->_blend_accumulators) {
+				auto* mesh = acc.first;
+				auto& accumulator = acc.second;
 
-				if (!blendPos.empty() && blendPos.size() != verts.size()) {
-					RAWRBOX_CRITICAL("Blendshape verts do not match with the mesh '{}' verts! Total verts: {}, blend shape verts: {}", shape.first, verts.size(), blendPos.size());
+				this->_blend_weights.clear();
+				for (auto& shape : this->_blend_shapes) {
+					if (shape.second->mesh != mesh) continue;
+					this->_blend_weights.push_back({&shape.second->stream, shape.second->isActive() ? std::clamp(shape.second->weight, 0.F, 1.F) : 0.F});
 				}
 
-				if (!blendNormals.empty() && blendNormals.size() != verts.size()) {
-					RAWRBOX_CRITICAL("Blendshape normals do not match with the mesh '{}' verts! Total verts: {}, blend shape verts: {}", shape.first, verts.size(), blendNormals.size());
-				}
+				accumulator.apply(this->_blend_weights); // Zero weights are skipped
 
-				float step = std::clamp(shape.second->weight, 0.F, 1.F);
+				auto [start, end] = accumulator.getDirty();
+				if (start >= end) continue;
 
-				// Apply vertices ----
-				for (size_t i = 0; i < blendPos.size(); i++) {
-					verts[i].position = this->_original_data[i].pos.lerp(blendPos[i], step);
-				}
-				// -------------------
+				// Write back, sub-meshes are also copied in the flattened mesh
+				uint32_t offset = mesh == flat ? 0 : mesh->baseVertex;
+				rawrbox::ASYNC::parallel(
+				    end - start, [&](size_t blockStart, size_t blockEnd) {
+					    for (size_t i = start + blockStart; i < start + blockEnd; i++) {
+						    auto& vert = mesh->vertices[i];
+						    vert.position = accumulator.getPosition(i);
 
-				// Apply normal ----
-				if constexpr (supportsNormals<typename M::vertexBufferType>) {
-					for (size_t i = 0; i < blendNormals.size(); i++) {
-						rawrbox::Vector4f unpacked = rawrbox::Vector4f(rawrbox::PackUtils::fromNormal(this->_original_data[i].normal)).lerp(blendNormals[i], step); // meh
-						verts[i].normal = rawrbox::PackUtils::packNormal(unpacked.x, unpacked.y, unpacked.z);
-					}
-				}
-				// -------------------
+						    if constexpr (supportsNormals<typename M::vertexBufferType>) {
+							    if (accumulator.hasNormals()) {
+								    auto normal = accumulator.getNormal(i).normalized();
+								    vert.normal = rawrbox::PackUtils::packNormal(normal.x, normal.y, normal.z);
+							    }
+						    }
+
+						    if (mesh != flat) flat->vertices[offset + i] = vert;
+					    }
+				    },
+				    rawrbox::BlendShapeAccumulator::BLOCK_SIZE);
+
+				this->updateVertices(offset + start, end - start); // Only the touched range is uploaded
 			}
 		}
 		// --------------
 
-		virtual void internalUpdate() {
-			if (!this->isUploaded() || !this->isDynamic() || !this->_requiresUpdate) return;
-			auto* context = rawrbox::RENDERER->context();
+		// GEOMETRY ---
+		[[nodiscard]] virtual bool usesGeometryArena() const { return this->_geometry.isValid(); }
 
+		virtual void uploadGeometryArena() {
 			auto vertSize = static_cast<uint64_t>(this->_mesh->vertices.size());
 			auto indcSize = static_cast<uint64_t>(this->_mesh->indices.size());
+			if (vertSize == 0 || indcSize == 0) RAWRBOX_CRITICAL("Vertices / indices data cannot be empty!");
+
+			auto stride = static_cast<uint32_t>(sizeof(typename M::vertexBufferType));
+			this->_geometry = rawrbox::GEOMETRY::allocate(stride, vertSize, indcSize);
+
+			rawrbox::GEOMETRY::get(stride)->upload(this->_geometry, this->_mesh->vertices.data(), vertSize, this->_mesh->indices.data(), indcSize);
+		}
+		// --------------
 
-			const bool empty = vertSize == 0 || indcSize == 0;
+		// CULLING ---
+		// Local space bounds used for frustum culling, empty bounds disable it
+		[[nodiscard]] virtual rawrbox::BBOX getCullingBBOX() const { return {}; }
+
+		virtual void updateCulling() {
+			if (!this->isUploaded() || rawrbox::RENDERER == nullptr) return;
+
+			auto bbox = this->_frustumCulling ? this->getCullingBBOX() : rawrbox::BBOX{};
+			if (bbox.isEmpty()) {
+				this->removeCulling();
+				return;
+			}
+
+			auto worldBBOX = this->getMatrix().mulBBOX(bbox);
+			auto list = this->_cullingList.lock();
+			if (list == nullptr) {
+				list = rawrbox::RENDERER->culling();
+
+				this->_cullingList = list;
+				this->_cullingHandle = list->add(worldBBOX, this);
+			} else {
+				list->update(this->_cullingHandle, worldBBOX);
+			}
+		}
+
+		virtual void removeCulling() {
+			auto list = this->_cullingList.lock();
+			if (list != nullptr) list->remove(this->_cullingHandle);
+
+			this->_cullingList.reset();
+			this->_cullingHandle = rawrbox::CullingList::INVALID_HANDLE;
+		}
+		// --------------
+
+		virtual void internalUpdate() {
+			if (!this->isUploaded() || !this->isDynamic()) return;
+
+			// Contents of dynamic buffers only last a frame, rewrite them every draw
+			if (this->isStreaming()) {
+				this->writeStreaming();
+				return;
+			}
+
+			if (!this->_requiresUpdate) return;
+
+			auto vertSize = static_cast<uint64_t>(this->_mesh->vertices.size());
+			auto indcSize = static_cast<uint64_t>(this->_mesh->indices.size());
 
 			uint64_t sizeVB = sizeof(typename M::vertexBufferType) * vertSize;
 			uint64_t sizeIB = sizeof(uint32_t) * indcSize;
@@ -154,29 +239,92 @@ namespace rawrbox {
 				this->_logger->debug("Resizing index buffer ({} -> {})", fmt::styled(indcSize, fmt::fg(fmt::color::cyan)), fmt::styled(this->_mesh->indices.capacity(), fmt::fg(fmt::color::cyan)));
 			}
 
-			if (resizeVertex && resizeIndex) {
-				this->_requiresUpdate = false;
-				return;
+			// Full updates upload everything, otherwise only the dirty ranges ----
+			auto& dirtyVertices = this->_mesh->dirtyVertices;
+			auto& dirtyIndices = this->_mesh->dirtyIndices;
+
+			if (this->_fullUpdate) {
+				dirtyVertices.clear();
+				dirtyIndices.clear();
+
+				dirtyVertices.mark(0, vertSize);
+				dirtyIndices.mark(0, indcSize);
 			}
 
-			// BARRIER -----
-			std::vector<Diligent::StateTransitionDesc> barriers = {};
-			if (!resizeVertex) barriers.emplace_back(this->_vbh, Diligent::RESOURCE_STATE_VERTEX_BUFFER, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE);
-			if (!resizeIndex) barriers.emplace_back(this->_ibh, Diligent::RESOURCE_STATE_INDEX_BUFFER, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE);
+			dirtyVertices.clamp(vertSize);
+			dirtyIndices.clamp(indcSize);
+
+			dirtyVertices.coalesce(RB_RENDER_DIRTY_RANGE_GAP);
+			dirtyIndices.coalesce(RB_RENDER_DIRTY_RANGE_GAP);
+
+			if (!resizeVertex) this->uploadRanges(this->_vbh, dirtyVertices, sizeof(typename M::vertexBufferType), this->_mesh->vertices.data(), Diligent::RESOURCE_STATE_VERTEX_BUFFER);
+			if (!resizeIndex) this->uploadRanges(this->_ibh, dirtyIndices, sizeof(uint32_t), this->_mesh->indices.data(), Diligent::RESOURCE_STATE_INDEX_BUFFER);
 
-			rawrbox::BarrierUtils::barrier(barriers);
+			dirtyVertices.clear();
+			dirtyIndices.clear();
+			// -----------
+
+			this->_requiresUpdate = false;
+			this->_fullUpdate = false;
+		}
 
-			if (!resizeVertex) context->UpdateBuffer(this->_vbh, 0, vertSize * sizeof(typename M::vertexBufferType), empty ? nullptr : this->_mesh->vertices.data(), Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
-			if (!resizeIndex) context->UpdateBuffer(this->_ibh, 0, indcSize * sizeof(uint32_t), empty ? nullptr : this->_mesh->indices.data(), Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+		virtual void uploadRanges(Diligent::IBuffer* buffer, const rawrbox::DirtyRanges& ranges, uint64_t stride, const void* data, Diligent::RESOURCE_STATE state) {
+			if (ranges.empty() || data == nullptr) return;
+
+			auto* context = rawrbox::RENDERER->context();
+			const auto* bytes = static_cast<const uint8_t*>(data);
+
+			// BARRIER -----
+			rawrbox::BarrierUtils::barrier({{buffer, state, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
 
-			barriers.clear();
-			if (!resizeVertex) barriers.emplace_back(this->_vbh, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::RESOURCE_STATE_VERTEX_BUFFER, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE);
-			if (!resizeIndex) barriers.emplace_back(this->_ibh, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::RESOURCE_STATE_INDEX_BUFFER, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE);
+			for (const auto& range : ranges.getRanges()) {
+				uint64_t offset = range.first * stride;
+				context->UpdateBuffer(buffer, offset, (range.second - range.first) * stride, bytes + offset, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+			}
 
-			rawrbox::BarrierUtils::barrier(barriers);
+			rawrbox::BarrierUtils::barrier({{buffer, Diligent::RESOURCE_STATE_COPY_DEST, state, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
 			// -----------
+		}
+
+		virtual void writeStreaming() {
+			auto vertSize = static_cast<uint64_t>(this->_mesh->vertices.size());
+			auto indcSize = static_cast<uint64_t>(this->_mesh->indices.size());
+
+			uint64_t sizeVB = sizeof(typename M::vertexBufferType) * vertSize;
+			uint64_t sizeIB = sizeof(uint32_t) * indcSize;
+
+			if (sizeVB > this->_vbh->GetDesc().Size) {
+				RAWRBOX_DESTROY(this->_vbh);
+
+				this->_mesh->vertices.reserve(vertSize + RB_RENDER_BUFFER_INCREASE_OFFSET);
+				this->createVertexBuffer();
+			}
+
+			if (sizeIB > this->_ibh->GetDesc().Size) {
+				RAWRBOX_DESTROY(this->_ibh);
+
+				this->_mesh->indices.reserve(indcSize + RB_RENDER_BUFFER_INCREASE_OFFSET);
+				this->createIndexBuffer();
+			}
+
+			auto* context = rawrbox::RENDERER->context();
+			if (sizeVB != 0) {
+				Diligent::MapHelper<uint8_t> verts(context, this->_vbh, Diligent::MAP_WRITE, Diligent::MAP_FLAG_DISCARD);
+				if (verts == nullptr) RAWRBOX_CRITICAL("Failed to map vertex buffer!");
+				std::memcpy(verts, this->_mesh->vertices.data(), sizeVB);
+			}
+
+			if (sizeIB != 0) {
+				Diligent::MapHelper<uint8_t> indcs(context, this->_ibh, Diligent::MAP_WRITE, Diligent::MAP_FLAG_DISCARD);
+				if (indcs == nullptr) RAWRBOX_CRITICAL("Failed to map index buffer!");
+				std::memcpy(indcs, this->_mesh->indices.data(), sizeIB);
+			}
+
+			this->_mesh->dirtyVertices.clear();
+			this->_mesh->dirtyIndices.clear();
 
 			this->_requiresUpdate = false;
+			this->_fullUpdate = false;
 		}
 
 		virtual void createIndexBuffer() {
@@ -192,11 +340,16 @@ namespace rawrbox {
 			IndcBuffDesc.Size = static_cast<uint32_t>(sizeof(uint32_t)) * indcSize;
 			IndcBuffDesc.ElementByteStride = sizeof(uint32_t);
 
+			if (this->isStreaming()) {
+				IndcBuffDesc.Usage = Diligent::USAGE_DYNAMIC;
+				IndcBuffDesc.CPUAccessFlags = Diligent::CPU_ACCESS_WRITE;
+			}
+
 			Diligent::BufferData IBData;
 			IBData.pData = this->_mesh->indices.data();
 			IBData.DataSize = IndcBuffDesc.Size;
 
-			device->CreateBuffer(IndcBuffDesc, &IBData, &this->_ibh);
+			device->CreateBuffer(IndcBuffDesc, this->isStreaming() ? nullptr : &IBData, &this->_ibh); // Dynamic buffers cannot have initial data
 			if (this->_ibh == nullptr) RAWRBOX_CRITICAL("Failed to create index buffer");
 
 			rawrbox::BarrierUtils::barrier({{this->_ibh, Diligent::RESOURCE_STATE_UNKNOWN, Diligent::RESOURCE_STATE_INDEX_BUFFER, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
@@ -214,11 +367,16 @@ namespace rawrbox {
 			VertBuffDesc.Usage = this->isDynamic() ? Diligent::USAGE_DEFAULT : Diligent::USAGE_IMMUTABLE; // TODO:  Diligent::USAGE_SPARSE;
 			VertBuffDesc.Size = static_cast<uint32_t>(sizeof(typename M::vertexBufferType)) * vertSize;
 
+			if (this->isStreaming()) {
+				VertBuffDesc.Usage = Diligent::USAGE_DYNAMIC;
+				VertBuffDesc.CPUAccessFlags = Diligent::CPU_ACCESS_WRITE;
+			}
+
 			Diligent::BufferData VBData;
 			VBData.pData = this->_mesh->vertices.data();
 			VBData.DataSize = VertBuffDesc.Size;
 
-			device->CreateBuffer(VertBuffDesc, &VBData, &this->_vbh);
+			device->CreateBuffer(VertBuffDesc, this->isStreaming() ? nullptr : &VBData, &this->_vbh); // Dynamic buffers cannot have initial data
 			if (this->_vbh == nullptr) RAWRBOX_CRITICAL("Failed to create vertex buffer");
 
 			rawrbox::BarrierUtils::barrier({{this->_vbh, Diligent::RESOURCE_STATE_UNKNOWN, Diligent::RESOURCE_STATE_VERTEX_BUFFER, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
@@ -235,6 +393,12 @@ namespace rawrbox {
 		ModelBase(const ModelBase&) = delete;
 		ModelBase& operator=(const ModelBase&) = delete;
 		virtual ~ModelBase() {
+			auto cullingList = this->_cullingList.lock(); // Renderer might be gone already
+			if (cullingList != nullptr) cullingList->remove(this->_cullingHandle);
+
+			rawrbox::GEOMETRY::free(this->_geometry);
+			this->_geometry = {};
+
 			RAWRBOX_DESTROY(this->_vbh);
 			RAWRBOX_DESTROY(this->_ibh);
 
@@ -242,16 +406,45 @@ namespace rawrbox {
 		}
 
 		// BLEND SHAPES ---
+		// Positions / normals are the full target shape, they get stored as deltas from the original mesh
 		bool createBlendShape(const std::string& id, const std::vector<rawrbox::Vector3f>& newVertexPos, const std::vector<rawrbox::Vector4f>& newNormPos, float weight = 0.F) {
 			if (this->_mesh == nullptr) RAWRBOX_CRITICAL("Mesh not initialized!");
 
+			auto* mesh = this->_mesh.get();
+			auto fnd = this->_blend_accumulators.find(mesh); // Mesh could already be deformed
+
+			if (!newVertexPos.empty() && newVertexPos.size() != mesh->vertices.size()) {
+				RAWRBOX_CRITICAL("Blendshape verts do not match with the mesh '{}' verts! Total verts: {}, blend shape verts: {}", id, mesh->vertices.size(), newVertexPos.size());
+			}
+
+			if (!newNormPos.empty() && newNormPos.size() != mesh->vertices.size()) {
+				RAWRBOX_CRITICAL("Blendshape normals do not match with the mesh '{}' verts! Total verts: {}, blend shape verts: {}", id, mesh->vertices.size(), newNormPos.size());
+			}
+
+			std::vector<rawrbox::Vector3f> posDeltas(newVertexPos.size());
+			for (size_t i = 0; i < newVertexPos.size(); i++) {
+				auto base = fnd != this->_blend_accumulators.end() ? fnd->second.getBasePosition(i) : mesh->vertices[i].position;
+				posDeltas[i] = newVertexPos[i] - base;
+			}
+
+			std::vector<rawrbox::Vector3f> normDeltas = {};
+			if constexpr (supportsNormals<typename M::vertexBufferType>) {
+				normDeltas.resize(newNormPos.size());
+
+				for (size_t i = 0; i < newNormPos.size(); i++) {
+					auto base = fnd != this->_blend_accumulators.end() && fnd->second.hasNormals() ? fnd->second.getBaseNormal(i) : rawrbox::Vector4f(rawrbox::PackUtils::fromNormal(mesh->vertices[i].normal)).xyz();
+					normDeltas[i] = newNormPos[i].xyz() - base;
+				}
+			}
+
 			auto blend = std::make_unique<rawrbox::BlendShapes<M>>();
-			blend->pos = newVertexPos;
-			blend->normals = newNormPos;
+			blend->stream = rawrbox::BlendShapeStream::fromDeltas(posDeltas, normDeltas);
 			blend->weight = weight;
-			blend->mesh = this->_mesh.get();
+			blend->mesh = mesh;
 
 			this->_blend_shapes[id] = std::move(blend);
+			if (!this->_blend_accumulators.empty()) this->calculateOriginalShape(); // The new shape might add normals
+			this->_blendShapesDirty = true;
 			return true;
 		}
 
@@ -260,7 +453,7 @@ namespace rawrbox {
 			if (fnd == this->_blend_shapes.end()) return false;
 
 			this->_blend_shapes.erase(id);
-			this->applyBlendShapes();
+			this->_blendShapesDirty = true;
 			return true;
 		}
 
@@ -269,7 +462,7 @@ namespace rawrbox {
 			if (fnd == this->_blend_shapes.end()) return false;
 
 			fnd->second->weight = weight;
-			this->applyBlendShapes();
+			this->_blendShapesDirty = true; // Applied once on draw
 			return true;
 		}
 
@@ -285,7 +478,7 @@ namespace rawrbox {
 				}
 			}
 
-			if (found) this->applyBlendShapes();
+			if (found) this->_blendShapesDirty = true;
 			return found;
 		}
 		// --------------
@@ -293,6 +486,22 @@ namespace rawrbox {
 		// UTIL ---
 		virtual void updateBuffers() {
 			this->_requiresUpdate = this->isDynamic() && this->isUploaded();
+			this->_fullUpdate = this->_requiresUpdate;
+		}
+
+		// Only re-upload the given vertices / indices on the next draw, ranges are merged until then
+		virtual void updateVertices(size_t start, size_t count = 1) {
+			if (!this->isDynamic() || !this->isUploaded()) return;
+
+			this->_mesh->markVerticesDirty(start, count);
+			this->_requiresUpdate = true;
+		}
+
+		virtual void updateIndices(size_t start, size_t count = 1) {
+			if (!this->isDynamic() || !this->isUploaded()) return;
+
+			this->_mesh->markIndicesDirty(start, count);
+			this->_requiresUpdate = true;
 		}
 
 		[[nodiscard]] virtual uint32_t getID(int /*index*/ = -1) const { return this->_mesh->getID(); }
@@ -308,19 +517,23 @@ namespace rawrbox {
 		[[nodiscard]] virtual const rawrbox::Vector3f& getPos() const { return this->_mesh->getPos(); }
 		virtual void setPos(const rawrbox::Vector3f& pos) {
 			this->_mesh->setPos(pos);
+			this->updateCulling();
 		}
 
 		[[nodiscard]] virtual const rawrbox::Vector3f& getScale() const { return this->_mesh->getScale(); }
 		virtual void setScale(const rawrbox::Vector3f& scale) {
 			this->_mesh->setScale(scale);
+			this->updateCulling();
 		}
 
 		[[nodiscard]] virtual const rawrbox::Vector4f& getAngle() const { return this->_mesh->getAngle(); }
 		virtual void setAngle(const rawrbox::Vector4f& ang) {
 			this->_mesh->setAngle(ang);
+			this->updateCulling();
 		}
 		virtual void setEulerAngle(const rawrbox::Vector3f& ang) {
 			this->_mesh->setEulerAngle(ang);
+			this->updateCulling();
 		}
 
 		[[nodiscard]] virtual const rawrbox::Matrix4x4& getMatrix() const {
@@ -330,27 +543,64 @@ namespace rawrbox {
 		[[nodiscard]] virtual bool isDynamic() const {
 			return this->_uploadType != rawrbox::UploadType::STATIC;
 		}
+		[[nodiscard]] virtual bool isStreaming() const {
+			return this->_uploadType == rawrbox::UploadType::STREAMING_DYNAMIC;
+		}
 		[[nodiscard]] virtual bool isUploaded() const {
-			return (this->_vbh != nullptr && this->_ibh != nullptr);
+			return this->_geometry.isValid() || (this->_vbh != nullptr && this->_ibh != nullptr);
+		}
+
+		// Offsets into the bound vertex / index buffers, non-zero when the model lives in the geometry arena
+		[[nodiscard]] virtual uint32_t getBaseVertex() const { return this->usesGeometryArena() ? static_cast<uint32_t>(this->_geometry.vertexOffset) : 0U; }
+		[[nodiscard]] virtual uint32_t getBaseIndex() const { return this->usesGeometryArena() ? static_cast<uint32_t>(this->_geometry.indexOffset) : 0U; }
+
+		[[nodiscard]] virtual Diligent::IBuffer* getVertexBuffer() const {
+			if (this->usesGeometryArena()) return rawrbox::GEOMETRY::get(this->_geometry.vertexStride)->getVertexBuffer();
+			return this->_vbh;
+		}
+
+		[[nodiscard]] virtual Diligent::IBuffer* getIndexBuffer() const {
+			if (this->usesGeometryArena()) return rawrbox::GEOMETRY::get(this->_geometry.vertexStride)->getIndexBuffer();
+			return this->_ibh;
 		}
 
 		virtual rawrbox::Mesh<typename M::vertexBufferType>* mesh() {
 			return this->_mesh.get();
 		}
 
+		// CULLING ---
+		virtual void setFrustumCulling(bool enabled) {
+			this->_frustumCulling = enabled;
+			this->updateCulling();
+		}
+		[[nodiscard]] virtual bool isFrustumCulling() const { return this->_frustumCulling; }
+
+		// Result of the last cull, always true if not tracked by the culling list
+		[[nodiscard]] virtual bool isVisible() const {
+			auto list = this->_cullingList.lock();
+			return list == nullptr || list->isVisible(this->_cullingHandle);
+		}
+		// ----
+
 		// ----
 		virtual void upload(rawrbox::UploadType type = rawrbox::UploadType::STATIC) {
 			if (this->isUploaded()) RAWRBOX_CRITICAL("Already uploaded!");
 			this->_uploadType = type;
 
 			// BUFFERS ----
-			this->createVertexBuffer();
-			this->createIndexBuffer();
+			if (this->isDynamic()) {
+				this->createVertexBuffer();
+				this->createIndexBuffer();
+			} else {
+				this->uploadGeometryArena();
+			}
 			// ---------------------
 
 			// Initialize material ----
 			this->_material->init();
 			// ------------
+
+			this->updateCulling();
 		}
 
 		virtual void draw() {
@@ -359,15 +609,25 @@ namespace rawrbox {
 
 			auto* context = rawrbox::RENDERER->context();
 
-			// Execute pending buffer updates --
+			// Execute pending blend shapes & buffer updates --
+			if (this->_blendShapesDirty) {
+				this->applyBlendShapes();
+				this->_blendShapesDirty = false;
+			}
+
 			this->internalUpdate();
 			// --------------------------
 
-			// Bind vertex and index buffers
-			std::array<Diligent::IBuffer*, 1> pBuffs = {this->_vbh};
+			// Bind vertex and index buffers, arena models share them for the whole pass
+			if (this->usesGeometryArena()) {
+				rawrbox::GEOMETRY::bind(context, this->_geometry.vertexStride);
+			} else {
+				std::array<Diligent::IBuffer*, 1> pBuffs = {this->getVertexBuffer()};
 
-			context->SetVertexBuffers(0, 1, pBuffs.data(), nullptr, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY, Diligent::SET_VERTEX_BUFFERS_FLAG_RESET);
-			context->SetIndexBuffer(this->_ibh, 0, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+				context->SetVertexBuffers(0, 1, pBuffs.data(), nullptr, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY, Diligent::SET_VERTEX_BUFFERS_FLAG_RESET);
+				context->SetIndexBuffer(this->getIndexBuffer(), 0, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+				rawrbox::GEOMETRY::unbind();
+			}
 			// ----
 
 			// Reset material uniforms ----
@@ -3,8 +3,10 @@
 #include <rawrbox/render/materials/instanced.hpp>
 #include <rawrbox/render/models/instance.hpp>
 #include <rawrbox/render/models/model.hpp>
+#include <rawrbox/render/plugins/gpu_culling.hpp>
 
 #include <DynamicBuffer.hpp>
+#include <MapHelper.hpp>
 
 namespace rawrbox {
 
@@ -14,12 +16,140 @@ namespace rawrbox {
 	protected:
 		std::unique_ptr<Diligent::DynamicBuffer> _dataBuffer = nullptr;
 		std::vector<rawrbox::Instance> _instances = {};
+		rawrbox::DirtyRanges _dirtyInstances = {};
+
+		// INDIRECT ---
+		bool _indirect = false;
+
+		rawrbox::GPUCullingTarget _cullingTarget = {};
+		Diligent::RefCntAutoPtr<Diligent::IBuffer> _culledBuffer; // Compacted visible instances
+		Diligent::RefCntAutoPtr<Diligent::IBuffer> _argsBuffer;   // DrawIndexedIndirectArgs, written by the GPUCulling plugin
+
+		rawrbox::InstanceCuller _culler = {}; // CPU fallback
+		std::vector<rawrbox::Instance> _culledInstances = {};
+		// ----
 
 		void updateBuffers() override {
 			rawrbox::ModelBase<M>::updateBuffers();
 			this->updateInstances();
 		}
 
+		void updateCulling() override {
+			rawrbox::ModelBase<M>::updateCulling();
+			this->_cullingTarget.world = this->getMatrix();
+		}
+
+		// INDIRECT ---
+		[[nodiscard]] virtual rawrbox::GPUCullingPlugin* getCullingPlugin() const {
+			if (rawrbox::RENDERER == nullptr || !rawrbox::GPUCullingPlugin::isSupported()) return nullptr;
+			return rawrbox::RENDERER->getPlugin<rawrbox::GPUCullingPlugin>("GPUCulling");
+		}
+
+		// Vertex shader moves the vertices, bounds cannot be trusted
+		[[nodiscard]] virtual bool canCullInstances() const {
+			return this->_mesh->data.billboard == 0 && this->_mesh->data.displacement == nullptr && !this->_cullingTarget.bounds.isEmpty();
+		}
+
+		virtual void calculateInstanceBBOX() {
+			this->_cullingTarget.bounds = {};
+
+			bool first = true;
+			for (auto& vert : this->_mesh->vertices) {
+				if (first) {
+					this->_cullingTarget.bounds = {vert.position, vert.position, {}};
+					first = false;
+				} else {
+					this->_cullingTarget.bounds.expand(vert.position);
+				}
+			}
+		}
+
+		virtual void createIndirectBuffers(bool gpu) {
+			auto* device = rawrbox::RENDERER->device();
+			auto capacity = static_cast<uint64_t>(std::max<size_t>(this->_instances.capacity(), 1));
+
+			RAWRBOX_DESTROY(this->_culledBuffer);
+
+			Diligent::BufferDesc CulledBuffDesc;
+			CulledBuffDesc.Name = "RawrBox::Buffer::Instance::Culled";
+			CulledBuffDesc.Size = sizeof(rawrbox::Instance) * capacity;
+
+			if (gpu) {
+				CulledBuffDesc.Usage = Diligent::USAGE_DEFAULT;
+				CulledBuffDesc.Mode = Diligent::BUFFER_MODE_RAW;
+				CulledBuffDesc.BindFlags = Diligent::BIND_VERTEX_BUFFER | Diligent::BIND_UNORDERED_ACCESS;
+			} else {
+				CulledBuffDesc.Usage = Diligent::USAGE_DYNAMIC;
+				CulledBuffDesc.CPUAccessFlags = Diligent::CPU_ACCESS_WRITE;
+				CulledBuffDesc.BindFlags = Diligent::BIND_VERTEX_BUFFER;
+			}
+
+			device->CreateBuffer(CulledBuffDesc, nullptr, &this->_culledBuffer);
+			if (this->_culledBuffer == nullptr) RAWRBOX_CRITICAL("Failed to create culled instance buffer");
+
+			rawrbox::BarrierUtils::barrier({{this->_culledBuffer, Diligent::RESOURCE_STATE_UNKNOWN, Diligent::RESOURCE_STATE_VERTEX_BUFFER, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
+
+			// ARGS ----
+			if (gpu && this->_argsBuffer == nullptr) {
+				Diligent::BufferDesc ArgsBuffDesc;
+				ArgsBuffDesc.Name = "RawrBox::Buffer::Instance::Args";
+				ArgsBuffDesc.Usage = Diligent::USAGE_DEFAULT;
+				ArgsBuffDesc.Mode = Diligent::BUFFER_MODE_RAW;
+				ArgsBuffDesc.BindFlags = Diligent::BIND_INDIRECT_DRAW_ARGS | Diligent::BIND_UNORDERED_ACCESS;
+				ArgsBuffDesc.Size = sizeof(rawrbox::DrawIndexedIndirectArgs);
+
+				device->CreateBuffer(ArgsBuffDesc, nullptr, &this->_argsBuffer);
+				if (this->_argsBuffer == nullptr) RAWRBOX_CRITICAL("Failed to create indirect args buffer");
+
+				rawrbox::BarrierUtils::barrier({{this->_argsBuffer, Diligent::RESOURCE_STATE_UNKNOWN, Diligent::RESOURCE_STATE_INDIRECT_ARGUMENT, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
+			}
+			// ---------
+		}
+
+		virtual void updateIndirect() {
+			if (!this->_indirect || this->_dataBuffer == nullptr) return;
+
+			// Draw template ---
+			this->calculateInstanceBBOX();
+
+			auto& draw = this->_cullingTarget.draw;
+			draw.numIndices = this->_mesh->totalIndex;
+			draw.numInstances = static_cast<uint32_t>(this->_instances.size());
+			draw.firstIndex = this->getBaseIndex() + this->_mesh->baseIndex;
+			draw.baseVertex = static_cast<int32_t>(this->getBaseVertex() + this->_mesh->baseVertex);
+			draw.firstInstance = 0;
+			// ----
+
+			bool gpu = this->_argsBuffer != nullptr;
+			if (this->_culledBuffer == nullptr || this->_culledBuffer->GetDesc().Size < sizeof(rawrbox::Instance) * this->_instances.size()) {
+				this->createIndirectBuffers(gpu);
+			}
+
+			if (gpu) {
+				this->_cullingTarget.instances = this->_dataBuffer->GetBuffer(); // Can change on resize
+				this->_cullingTarget.culled = this->_culledBuffer;
+				this->_cullingTarget.args = this->_argsBuffer;
+			}
+		}
+
+		// Returns the visible instance count
+		virtual uint32_t cullInstances() {
+			rawrbox::Frustum frustum(rawrbox::MAIN_CAMERA->getViewProjMtx() * this->getMatrix()); // Model space frustum
+			rawrbox::DrawIndexedIndirectArgs args = this->_cullingTarget.draw;
+
+			auto visible = this->_culler.cull(frustum, this->_cullingTarget.bounds, this->_instances, this->_culledInstances, args);
+			if (visible == 0) return 0;
+
+			if (this->_culledBuffer->GetDesc().Size < sizeof(rawrbox::Instance) * visible) this->createIndirectBuffers(false);
+
+			Diligent::MapHelper<rawrbox::Instance> data(rawrbox::RENDERER->context(), this->_culledBuffer, Diligent::MAP_WRITE, Diligent::MAP_FLAG_DISCARD);
+			if (data == nullptr) RAWRBOX_CRITICAL("Failed to map culled instance buffer!");
+
+			std::memcpy(data, this->_culledInstances.data(), sizeof(rawrbox::Instance) * visible);
+			return visible;
+		}
+		// ----
+
 	public:
 		explicit InstancedModel(size_t instanceSize = 0) {
 			if (instanceSize != 0) this->_instances.reserve(instanceSize);
@@ -30,6 +160,14 @@ namespace rawrbox {
 		InstancedModel& operator=(const InstancedModel&) = delete;
 		InstancedModel& operator=(InstancedModel&&) = delete;
 		~InstancedModel() override {
+			if (this->_cullingTarget.isValid()) {
+				auto* plugin = this->getCullingPlugin();
+				if (plugin != nullptr) plugin->unregisterTarget(&this->_cullingTarget);
+			}
+
+			RAWRBOX_DESTROY(this->_culledBuffer);
+			RAWRBOX_DESTROY(this->_argsBuffer);
+
 			this->_dataBuffer.reset();
 			this->_instances.clear();
 		}
@@ -65,6 +203,17 @@ namespace rawrbox {
 		virtual std::vector<rawrbox::Instance>& instances() { return this->_instances; }
 		[[nodiscard]] virtual size_t count() const { return this->_instances.size(); }
 
+		// INDIRECT ---
+		// Culls instances against the camera before drawing, on the GPU if the `GPUCulling` plugin is available, CPU otherwise
+		virtual void setIndirect(bool indirect) {
+			if (this->isUploaded()) RAWRBOX_CRITICAL("Indirect drawing has to be set before uploading");
+			this->_indirect = indirect;
+		}
+
+		[[nodiscard]] virtual bool isIndirect() const { return this->_indirect; }
+		[[nodiscard]] virtual bool isGPUCulling() const { return this->_argsBuffer != nullptr; }
+		// ----
+
 		void upload(rawrbox::UploadType type = rawrbox::UploadType::STATIC) override {
 			rawrbox::ModelBase<M>::upload(type);
 
@@ -78,6 +227,12 @@ namespace rawrbox {
 			InstBuffDesc.Usage = Diligent::USAGE_SPARSE;
 			InstBuffDesc.BindFlags = Diligent::BIND_VERTEX_BUFFER;
 
+			auto* plugin = this->_indirect ? this->getCullingPlugin() : nullptr;
+			if (plugin != nullptr) {
+				InstBuffDesc.BindFlags |= Diligent::BIND_SHADER_RESOURCE; // Read by the cull shader
+				InstBuffDesc.Mode = Diligent::BUFFER_MODE_RAW;
+			}
+
 			Diligent::DynamicBufferCreateInfo dynamicBuff;
 			dynamicBuff.Desc = InstBuffDesc;
 
@@ -88,29 +243,61 @@ namespace rawrbox {
 			rawrbox::BarrierUtils::barrier({{this->_dataBuffer->GetBuffer(), Diligent::RESOURCE_STATE_UNKNOWN, Diligent::RESOURCE_STATE_VERTEX_BUFFER, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
 			// ------------
 
+			// INDIRECT ----
+			if (this->_indirect) {
+				this->calculateInstanceBBOX();
+
+				if (this->canCullInstances()) {
+					this->createIndirectBuffers(plugin != nullptr);
+					this->updateIndirect();
+
+					if (plugin != nullptr) plugin->registerTarget(&this->_cullingTarget);
+				} else {
+					this->_logger->warn("Instance culling disabled, mesh bounds are not reliable (billboard / displacement)");
+					this->_indirect = false;
+				}
+			}
+			// ------------
+
 			if (size != 0) this->updateInstances(); // Data was already added, then update the buffer
 		}
 
+		// Uploads all the instances
 		virtual void updateInstances() {
+			this->_dirtyInstances.clear();
+			this->_dirtyInstances.mark(0, this->_instances.size());
+
+			this->flushInstances();
+		}
+
+		// Only re-upload the given instances, ranges are merged and uploaded on the next draw
+		virtual void updateInstances(size_t start, size_t count = 1) {
+			this->_dirtyInstances.mark(start, count);
+		}
+
+		virtual void flushInstances() {
 			if (this->_dataBuffer == nullptr) RAWRBOX_CRITICAL("Data buffer not valid! Did you call upload()?");
 
 			auto* context = rawrbox::RENDERER->context();
 			auto* device = rawrbox::RENDERER->device();
 
-			// Update buffer ----
-			uint64_t size = sizeof(rawrbox::Instance) * static_cast<uint64_t>(this->_instances.capacity());
+			// Resize buffer, content is discarded so upload everything ----
+			uint64_t size = sizeof(rawrbox::Instance) * static_cast<uint64_t>(this->_instances.size());
 			if (size > this->_dataBuffer->GetDesc().Size) {
-				this->_instances.reserve(this->_instances.capacity() + 16);
-				this->_dataBuffer->Resize(device, context, sizeof(rawrbox::Decal) * static_cast<uint64_t>(_instances.capacity()), true);
+				this->_dataBuffer->Resize(device, context, sizeof(rawrbox::Instance) * static_cast<uint64_t>(this->_instances.capacity()), true);
+
+				this->_dirtyInstances.clear();
+				this->_dirtyInstances.mark(0, this->_instances.size());
 			}
+			// ---------
+
+			this->_dirtyInstances.clamp(this->_instances.size());
+			this->_dirtyInstances.coalesce(RB_RENDER_DIRTY_RANGE_GAP);
 
-			auto* buffer = this->_dataBuffer->GetBuffer();
+			this->uploadRanges(this->_dataBuffer->GetBuffer(), this->_dirtyInstances, sizeof(rawrbox::Instance), this->_instances.data(), Diligent::RESOURCE_STATE_VERTEX_BUFFER);
+			this->_dirtyInstances.clear();
 
-			// BARRIER ----
-			rawrbox::BarrierUtils::barrier({{buffer, Diligent::RESOURCE_STATE_VERTEX_BUFFER, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
-			context->UpdateBuffer(buffer, 0, size, this->_instances.empty() ? nullptr : this->_instances.data(), Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
-			rawrbox::BarrierUtils::barrier({{buffer, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::RESOURCE_STATE_VERTEX_BUFFER, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
-			//  ---------
+			this->updateIndirect();
 		}
 
 		void draw() override {
@@ -119,14 +306,33 @@ namespace rawrbox {
 
 			auto* context = rawrbox::RENDERER->context();
 
+			// Pending partial updates ---
+			if (!this->_dirtyInstances.empty()) this->flushInstances();
+			// ---------
+
+			// Cull instances ---
+			Diligent::IBuffer* instanceBuffer = this->_dataBuffer->GetBuffer();
+			auto instanceCount = static_cast<uint32_t>(this->_instances.size());
+
+			if (this->_indirect) {
+				if (!this->isGPUCulling()) {
+					instanceCount = this->cullInstances();
+					if (instanceCount == 0) return;
+				}
+
+				instanceBuffer = this->_culledBuffer;
+			}
+			// -------------
+
 			// Bind vertex and index buffers
 			// NOLINTBEGIN(*)
 			const uint64_t offset[] = {0, 0};
-			Diligent::IBuffer* pBuffs[] = {this->_vbh, this->_dataBuffer->GetBuffer()};
+			Diligent::IBuffer* pBuffs[] = {this->getVertexBuffer(), instanceBuffer};
 			// NOLINTEND(*)
 
 			context->SetVertexBuffers(0, 2, pBuffs, offset, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY, Diligent::SET_VERTEX_BUFFERS_FLAG_RESET);
-			context->SetIndexBuffer(this->_ibh, 0, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+			context->SetIndexBuffer(this->getIndexBuffer(), 0, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+			rawrbox::GEOMETRY::unbind(); // Instance buffer is on slot 1
 			// ----
 
 			// Bind materials uniforms & textures ----
@@ -145,12 +351,23 @@ namespace rawrbox {
 			this->_material->bindPixelUniforms(*this->_mesh);
 			// -----------
 
+			if (this->isGPUCulling()) {
+				Diligent::DrawIndexedIndirectAttribs IndirectAttrs;
+				IndirectAttrs.pAttribsBuffer = this->_argsBuffer;
+				IndirectAttrs.IndexType = Diligent::VT_UINT32;
+				IndirectAttrs.Flags = Diligent::DRAW_FLAG_VERIFY_ALL;
+				IndirectAttrs.AttribsBufferStateTransitionMode = Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY;
+
+				context->DrawIndexedIndirect(IndirectAttrs);
+				return;
+			}
+
 			Diligent::DrawIndexedAttribs DrawAttrs;
 			DrawAttrs.IndexType = Diligent::VT_UINT32;
-			DrawAttrs.FirstIndexLocation = this->_mesh->baseIndex;
-			DrawAttrs.BaseVertex = this->_mesh->baseVertex;
+			DrawAttrs.FirstIndexLocation = this->getBaseIndex() + this->_mesh->baseIndex;
+			DrawAttrs.BaseVertex = this->getBaseVertex() + this->_mesh->baseVertex;
 			DrawAttrs.NumIndices = this->_mesh->totalIndex;
-			DrawAttrs.NumInstances = static_cast<uint32_t>(this->_instances.size());
+			DrawAttrs.NumInstances = instanceCount;
 			DrawAttrs.Flags = Diligent::DRAW_FLAG_VERIFY_ALL; // Instanced buffers are only updated once
 			// if (!updated) DrawAttrs.Flags |= Diligent::DRAW_FLAG_DYNAMIC_RESOURCE_BUFFERS_INTACT;
 
@@ -5,9 +5,11 @@
 #include <rawrbox/math/matrix4x4.hpp>
 #include <rawrbox/math/utils/math.hpp>
 #include <rawrbox/math/vector3.hpp>
+#include <rawrbox/render/models/utils/merge.hpp>
 #include <rawrbox/render/models/vertex.hpp>
 #include <rawrbox/render/static.hpp>
 #include <rawrbox/render/textures/base.hpp>
+#include <rawrbox/render/utils/dirty_ranges.hpp>
 
 #include <RasterizerState.h>
 #include <fmt/printf.h>
@@ -43,13 +45,14 @@ namespace rawrbox {
 		float emissionFactor = 1.0F;
 
 		float alphaCutoff = 0.5F;
+		float distanceField = 0.F; // 1 if the base texture is a signed distance field (sdf text)
 
 		[[nodiscard]] rawrbox::Vector4f getTextureData() const {
 			return {roughnessFactor, metalnessFactor, specularFactor, emissionFactor};
 		}
 
 		[[nodiscard]] rawrbox::Vector4f getData() const {
-			return {alphaCutoff, 0.F, 0.F, 0.F};
+			return {alphaCutoff, distanceField, 0.F, 0.F};
 		}
 
 		[[nodiscard]] rawrbox::Vector4_t<uint32_t> getTextureIDs() const {
@@ -62,7 +65,7 @@ namespace rawrbox {
 		}
 
 		[[nodiscard]] bool canMerge(const rawrbox::MeshTextures& other) const {
-			return this->roughnessFactor == other.roughnessFactor && this->metalnessFactor == other.metalnessFactor && this->specularFactor == other.specularFactor && this->emissionFactor == other.emissionFactor && this->alphaCutoff == other.alphaCutoff;
+			return this->roughnessFactor == other.roughnessFactor && this->metalnessFactor == other.metalnessFactor && this->specularFactor == other.specularFactor && this->emissionFactor == other.emissionFactor && this->alphaCutoff == other.alphaCutoff && this->distanceField == other.distanceField;
 		}
 
 		bool operator==(const rawrbox::MeshTextures& other) const { return this->texture == other.texture && this->normal == other.normal && this->specularFactor == other.specularFactor && this->roughtMetal == other.roughtMetal && this->emission == other.emission; }
@@ -109,6 +112,9 @@ namespace rawrbox {
 
 		std::vector<T> vertices = {};
 		std::vector<uint32_t> indices = {};
+
+		rawrbox::DirtyRanges dirtyVertices = {}; // Pending partial uploads (dynamic models)
+		rawrbox::DirtyRanges dirtyIndices = {};
 		// -------
 
 		// TEXTURES ---
@@ -167,6 +173,9 @@ namespace rawrbox {
 		[[nodiscard]] virtual const std::vector<T>& getVertices() const { return this->vertices; }
 		[[nodiscard]] virtual const std::vector<uint32_t>& getIndices() const { return this->indices; }
 
+		virtual void markVerticesDirty(size_t start, size_t count = 1) { this->dirtyVertices.mark(start, count); }
+		virtual void markIndicesDirty(size_t start, size_t count = 1) { this->dirtyIndices.mark(start, count); }
+
 		[[nodiscard]] virtual rawrbox::BBOX getBBOX() const { return this->bbox * this->_scale; }
 
 		[[nodiscard]] virtual bool empty() const {
@@ -303,6 +312,11 @@ namespace rawrbox {
 			if (this->vertices.size() + other.vertices.size() >= RB_RENDER_MAX_VERTICES) return false; // Max vertice limit
 			if (this->indices.size() + other.indices.size() >= RB_RENDER_MAX_INDICES) return false;    // Max indice limit
 
+			return this->isMergeCompatible(other);
+		}
+
+		// Same render state, ignores buffer limits
+		[[nodiscard]] virtual bool isMergeCompatible(const rawrbox::Mesh<T>& other) const {
 			return this->textures == other.textures && // TODO: Replace with canMerge and pass textureID down to vertex?
 			       this->color == other.color &&
 			       this->meshID == other.meshID &&
@@ -312,5 +326,38 @@ namespace rawrbox {
 			       this->_transparent == other._transparent &&
 			       this->matrix == other.matrix;
 		}
+
+		// Hash of the state checked by isMergeCompatible, equal states always hash the same
+		[[nodiscard]] virtual size_t getMergeHash() const {
+			size_t hash = 0;
+
+			rawrbox::MeshMerger::hashCombine(hash, this->textures.texture);
+			rawrbox::MeshMerger::hashCombine(hash, this->textures.normal);
+			rawrbox::MeshMerger::hashCombine(hash, this->textures.roughtMetal);
+			rawrbox::MeshMerger::hashCombine(hash, this->textures.emission);
+			rawrbox::MeshMerger::hashCombine(hash, this->textures.specularFactor);
+
+			rawrbox::MeshMerger::hashCombine(hash, this->color.r);
+			rawrbox::MeshMerger::hashCombine(hash, this->color.g);
+			rawrbox::MeshMerger::hashCombine(hash, this->color.b);
+			rawrbox::MeshMerger::hashCombine(hash, this->color.a);
+			rawrbox::MeshMerger::hashCombine(hash, this->meshID);
+
+			rawrbox::MeshMerger::hashCombine(hash, this->data.vertexSnapPower);
+			rawrbox::MeshMerger::hashCombine(hash, this->data.billboard);
+			rawrbox::MeshMerger::hashCombine(hash, this->data.slice);
+			rawrbox::MeshMerger::hashCombine(hash, this->data.displacement);
+			rawrbox::MeshMerger::hashCombine(hash, this->data.displacementPower);
+
+			rawrbox::MeshMerger::hashCombine(hash, this->_wireframe);
+			rawrbox::MeshMerger::hashCombine(hash, this->_lineMode);
+			rawrbox::MeshMerger::hashCombine(hash, this->_transparent);
+
+			for (const auto& val : this->matrix.mtx) {
+				rawrbox::MeshMerger::hashCombine(hash, val);
+			}
+
+			return hash;
+		}
 	};
 } // namespace rawrbox
@@ -2,17 +2,26 @@
 
 #include <rawrbox/engine/static.hpp>
 #include <rawrbox/render/lights/manager.hpp>
+#include <rawrbox/render/models/animations/blender.hpp>
+#include <rawrbox/render/models/animations/blending.hpp>
+#include <rawrbox/render/models/animations/manager.hpp>
 #include <rawrbox/render/models/animations/skeleton.hpp>
 #include <rawrbox/render/models/animations/vertex.hpp>
 #include <rawrbox/render/models/base.hpp>
+#include <rawrbox/render/models/utils/merge.hpp>
 #include <rawrbox/render/models/utils/optimization.hpp>
+#include <rawrbox/render/queue/queue.hpp>
 #include <rawrbox/render/static.hpp>
+#include <rawrbox/render/textures/streamer.hpp>
+
+#include <algorithm>
+#include <limits>
 
 namespace rawrbox {
 
 	template <typename M = rawrbox::MaterialUnlit>
 		requires(std::derived_from<M, rawrbox::MaterialBase>)
-	class Model : public rawrbox::ModelBase<M> {
+	class Model : public rawrbox::ModelBase<M>, public rawrbox::AnimationTarget {
 
 	protected:
 		// ANIMATION ---
@@ -20,15 +29,32 @@ namespace rawrbox {
 
 		std::unordered_map<size_t, std::vector<rawrbox::Mesh<typename M::vertexBufferType>*>> _vertexAnimations = {}; // For quick lookup
 		std::unordered_map<std::string, std::unique_ptr<rawrbox::AnimationSampler>> _playingAnimations = {};
+		std::vector<std::string> _finishedAnimations = {};
+
+		// Skeleton animation weights / layers, clips that are not active are not sampled
+		rawrbox::AnimationGraph _animationGraph = {};
+		std::unordered_map<const ozz::animation::Skeleton*, rawrbox::AnimationBlender> _blenders = {};
+
+		std::vector<rawrbox::AnimationBlendEntry> _activeAnimations = {}; // Reused every tick
+		std::vector<rawrbox::AnimationBlendInput> _blendInputs = {};
+		std::vector<const ozz::animation::Skeleton*> _skeletons = {};
+
+		uint64_t _animationFrame = std::numeric_limits<uint64_t>::max(); // Last ticked frame, multiple cameras / ANIMATIONS::tick only tick once
 		// ------------
 
 		std::vector<std::unique_ptr<rawrbox::Mesh<typename M::vertexBufferType>>> _meshes = {};
 		rawrbox::BBOX _bbox = {};
+		rawrbox::BBOX _cullingBBOX = {}; // Built from the vertices on upload
 
 		// LIGHTS ---
 		std::vector<rawrbox::LightBase> _lights = {};
 		// -----
 
+		// DRAW ---
+		rawrbox::RenderQueue _queue = {};
+		std::vector<rawrbox::Matrix4x4> _drawTransforms = {};
+		// -----
+
 		bool _canMerge = true;
 
 		// ANIMATIONS ----
@@ -39,10 +65,16 @@ namespace rawrbox {
 			switch (animation->type) {
 				case ozz::animation::VERTEX:
 					this->_playingAnimations[name] = std::make_unique<rawrbox::AnimationVertexSampler>(index, animation, onComplete);
+					rawrbox::ANIMATIONS::add(this);
+
 					return this->_playingAnimations[name].get();
 				case ozz::animation::SKELETON:
 					if constexpr (supportsBones<typename M::vertexBufferType>) {
 						this->_playingAnimations[name] = std::make_unique<rawrbox::AnimationSkeletonSampler>(index, animation, onComplete);
+						if (!this->_animationGraph.has(name)) this->_animationGraph.set(name); // Full weight on the base layer, unless it was setup before
+
+						rawrbox::ANIMATIONS::add(this);
+
 						return this->_playingAnimations[name].get();
 					} else {
 						this->_logger->warn("Failed to play animation {}, model does not support bones", name);
@@ -57,6 +89,39 @@ namespace rawrbox {
 			return nullptr;
 		}
 
+		// CULLING ---
+		virtual void calculateCullingBBOX() {
+			this->_cullingBBOX = {};
+
+			// Mesh bboxes do not include the generation offset, so use the real vertices
+			bool first = true;
+			for (auto& mesh : this->_meshes) {
+				if (mesh == nullptr || mesh->empty()) continue;
+
+				for (auto& vert : mesh->vertices) {
+					auto pos = mesh->matrix.mulVec(vert.position);
+					if (first) {
+						this->_cullingBBOX = {pos, pos, {}};
+						first = false;
+					} else {
+						this->_cullingBBOX.expand(pos);
+					}
+				}
+			}
+		}
+
+		[[nodiscard]] rawrbox::BBOX getCullingBBOX() const override {
+			if (this->isDynamic() || !this->_animations.empty() || !this->_blend_shapes.empty()) return {}; // Bounds can change, never cull
+
+			// Vertex shader moves the vertices
+			for (const auto& mesh : this->_meshes) {
+				if (mesh->data.billboard != 0 || mesh->data.displacement != nullptr) return {};
+			}
+
+			return this->_cullingBBOX;
+		}
+		// --------------
+
 		void sampleAnimations(rawrbox::AnimationSampler* sample) const {
 			switch (sample->getType()) {
 				case ozz::animation::VERTEX:
@@ -104,35 +169,104 @@ namespace rawrbox {
 				const ozz::animation::Skeleton* skeleton = mesh->skeleton;
 				if (skeleton == nullptr) continue;
 
-				rawrbox::Matrix4x4 globalMtx = rawrbox::Matrix4x4(skeleton->inverseBindMatrices[0]);
-				globalMtx.inverse();
+				// Cached per sampler & skeleton, meshes sharing a skeleton only copy it
+				const auto& skinning = sample->getSkinning(skeleton);
+				std::copy_n(skinning.begin(), std::min(skinning.size(), mesh->boneTransforms.size()), mesh->boneTransforms.begin());
+			}
+		}
+
+		void blendSkeletonAnimations() {
+			if constexpr (supportsBones<typename M::vertexBufferType>) {
+				this->_animationGraph.getActive(this->_activeAnimations);
+				if (this->_activeAnimations.empty()) return; // Keep the last pose
+
+				// Single clip at full weight, use the cached pose ---
+				const auto& first = this->_activeAnimations.front();
+				if (this->_activeAnimations.size() == 1 && first.weight >= 1.F && !first.additive && this->_animationGraph.getLayer(first.layer).jointMask.empty()) {
+					auto fnd = this->_playingAnimations.find(*first.clip);
+					if (fnd != this->_playingAnimations.end() && fnd->second != nullptr && fnd->second->getType() == ozz::animation::SKELETON) {
+						this->processSkeletonAnimations(dynamic_cast<rawrbox::AnimationSkeletonSampler*>(fnd->second.get()));
+					}
+
+					return;
+				}
+				// ---------------
 
-				const ozz::vector<ozz::math::Float4x4>& modelOutput = sample->getOutput(skeleton);
-				for (size_t i = 0; i < modelOutput.size(); i++) {
-					const ozz::math::Float4x4& output = modelOutput[i];
+				// Only sample what has weight ---
+				this->_blendInputs.clear();
+				for (const auto& entry : this->_activeAnimations) {
+					auto fnd = this->_playingAnimations.find(*entry.clip);
+					if (fnd == this->_playingAnimations.end() || fnd->second == nullptr || fnd->second->getType() != ozz::animation::SKELETON) continue;
+
+					auto* sampler = dynamic_cast<rawrbox::AnimationSkeletonSampler*>(fnd->second.get());
+					this->_blendInputs.push_back({ozz::make_span(sampler->getLocals()), entry.weight, entry.additive, &this->_animationGraph.getLayer(entry.layer).jointMask});
+				}
+
+				if (this->_blendInputs.empty()) return;
+				// ---------------
+
+				// Blend once per skeleton, then copy into the meshes ---
+				this->_skeletons.clear();
+				for (auto& mesh : this->_meshes) {
+					if (mesh->skeleton == nullptr || std::find(this->_skeletons.begin(), this->_skeletons.end(), mesh->skeleton) != this->_skeletons.end()) continue;
+
+					this->_skeletons.push_back(mesh->skeleton);
+					this->_blenders[mesh->skeleton].blend(mesh->skeleton, this->_blendInputs);
+				}
 
-					rawrbox::Matrix4x4 invMtx = rawrbox::Matrix4x4(skeleton->inverseBindMatrices[i]);
-					rawrbox::Matrix4x4 mtx = rawrbox::Matrix4x4({ozz::math::GetX(output.cols[0]), ozz::math::GetY(output.cols[0]), ozz::math::GetZ(output.cols[0]), ozz::math::GetW(output.cols[0]), ozz::math::GetX(output.cols[1]), ozz::math::GetY(output.cols[1]), ozz::math::GetZ(output.cols[1]), ozz::math::GetW(output.cols[1]), ozz::math::GetX(output.cols[2]), ozz::math::GetY(output.cols[2]), ozz::math::GetZ(output.cols[2]), ozz::math::GetW(output.cols[2]), ozz::math::GetX(output.cols[3]), ozz::math::GetY(output.cols[3]), ozz::math::GetZ(output.cols[3]), ozz::math::GetW(output.cols[3])});
+				for (auto& mesh : this->_meshes) {
+					if (mesh->skeleton == nullptr) continue;
 
-					mesh->boneTransforms[i] = globalMtx * mtx * invMtx;
+					const auto& skinning = this->_blenders[mesh->skeleton].getSkinning();
+					std::copy_n(skinning.begin(), std::min(skinning.size(), mesh->boneTransforms.size()), mesh->boneTransforms.begin());
 				}
+				// ---------------
 			}
 		}
 
-		void tickAnimations() {
-			for (auto it = this->_playingAnimations.begin(); it != this->_playingAnimations.end();) {
-				const auto& anim = it->second;
-				if (anim == nullptr) continue;
+		void tickAnimations() override {
+			if (this->_animationFrame == rawrbox::FRAME) return;
+			this->_animationFrame = rawrbox::FRAME;
+
+			// Cross-fades, faded out clips are stopped ---
+			for (auto& name : this->_animationGraph.update(rawrbox::DELTA_TIME)) {
+				this->_finishedAnimations.push_back(name);
+			}
+			// ---------------
 
-				if (anim->tick(rawrbox::DELTA_TIME)) {
-					it = this->_playingAnimations.erase(it);
+			bool skeletal = false;
+			for (auto& anim : this->_playingAnimations) {
+				if (anim.second == nullptr) continue;
+
+				if (anim.second->tick(rawrbox::DELTA_TIME)) {
+					this->_finishedAnimations.push_back(anim.first);
 					continue;
-				} else {
-					this->sampleAnimations(anim.get());
 				}
 
-				++it;
+				// Skeleton clips are sampled by weight
+				if (anim.second->getType() == ozz::animation::SKELETON) {
+					skeletal = true;
+					continue;
+				}
+
+				this->sampleAnimations(anim.second.get());
 			}
+
+			if (skeletal) this->blendSkeletonAnimations();
+		}
+
+		void finishAnimations() override {
+			for (const auto& name : this->_finishedAnimations) {
+				auto fnd = this->_playingAnimations.find(name);
+				if (fnd == this->_playingAnimations.end()) continue;
+
+				auto anim = std::move(fnd->second); // onComplete can play a new animation with the same name
+				this->_playingAnimations.erase(fnd);
+				this->_animationGraph.remove(name);
+			}
+
+			this->_finishedAnimations.clear();
+			if (this->_playingAnimations.empty()) rawrbox::ANIMATIONS::remove(this);
 		}
 		// --------------
 
@@ -150,15 +284,6 @@ namespace rawrbox {
 			}
 		}
 
-		// BLEND SHAPES ---
-		void applyBlendShapes() override {
-			rawrbox::ModelBase<M>::applyBlendShapes();
-
-			this->flattenMeshes(false, false); // No need to optimize & sort, it's just vertex changes
-			rawrbox::ModelBase<M>::updateBuffers();
-		}
-		// --------------
-
 	public:
 		Model(size_t vertices = 0, size_t indices = 0) : rawrbox::ModelBase<M>(vertices, indices) {};
 		Model(const Model&) = delete;
@@ -166,6 +291,8 @@ namespace rawrbox {
 		Model& operator=(const Model&) = delete;
 		Model& operator=(Model&&) = delete;
 		~Model() override {
+			rawrbox::ANIMATIONS::remove(this);
+
 			this->_meshes.clear();
 			this->_vertexAnimations.clear();
 			this->_animations.clear();
@@ -228,36 +355,7 @@ namespace rawrbox {
 
 		virtual void merge() {
 			size_t old = this->_meshes.size();
-
-			for (size_t i1 = 0; i1 < this->_meshes.size(); i1++) {
-				auto& mesh1 = this->_meshes[i1];
-
-				// figure out how big our buffers will get
-				size_t reserveVertices = mesh1->vertices.size();
-				size_t reserveIndices = mesh1->indices.size();
-
-				for (size_t i2 = this->_meshes.size() - 1; i2 > i1; i2--) {
-					auto& mesh2 = this->_meshes[i2];
-					if (!mesh1->canMerge(*mesh2)) continue;
-
-					reserveVertices += mesh2->vertices.size();
-					reserveIndices += mesh2->indices.size();
-				}
-
-				if (reserveVertices == mesh1->vertices.size()) continue;
-
-				mesh1->vertices.reserve(reserveVertices);
-				mesh1->indices.reserve(reserveIndices);
-
-				// merge what it can
-				for (size_t i2 = this->_meshes.size() - 1; i2 > i1; i2--) {
-					auto& mesh2 = this->_meshes[i2];
-					if (!mesh1->canMerge(*mesh2)) continue;
-
-					mesh1->merge(*mesh2);
-					this->_meshes.erase(this->_meshes.begin() + i2);
-				}
-			}
+			rawrbox::MeshMerger::merge(this->_meshes);
 
 			if (old != this->_meshes.size() && !this->isUploaded()) this->_logger->debug("Merged mesh for rendering ({} -> {})", fmt::styled(old, fmt::fg(fmt::color::cyan)), fmt::styled(this->_meshes.size(), fmt::fg(fmt::color::cyan))); // Only do it once
 		}
@@ -271,8 +369,34 @@ namespace rawrbox {
 		}
 
 		// ANIMATIONS ----
-		virtual bool blendAnimation(const std::string& /*otherAnim*/, float /*blend*/) {
-			RAWRBOX_CRITICAL("TODO");
+		// Cross-fades the layer into `otherAnim` over `blend` seconds (starting it if needed), the other clips on that layer are stopped once faded out
+		virtual bool blendAnimation(const std::string& otherAnim, float blend, bool loop = false, size_t layer = 0) {
+			if (layer >= this->_animationGraph.getLayers().size()) return false;
+
+			bool started = false;
+			if (!this->isAnimationPlaying(otherAnim)) {
+				this->_animationGraph.set(otherAnim, 0.F, layer); // Start from nothing and fade in
+				if (this->playAnimation(otherAnim, loop) == nullptr) {
+					this->_animationGraph.remove(otherAnim);
+					return false;
+				}
+
+				started = true;
+			}
+
+			// Only skeletal clips blend, the sampler type is only known once it exists so undo the start
+			auto fnd = this->_playingAnimations.find(otherAnim);
+			if (fnd == this->_playingAnimations.end() || fnd->second == nullptr || fnd->second->getType() != ozz::animation::SKELETON) {
+				if (started) this->stopAnimation(otherAnim);
+				return false;
+			}
+
+			this->_animationGraph.play(otherAnim, blend, layer);
+			return true;
+		}
+
+		virtual rawrbox::AnimationGraph& getAnimationGraph() {
+			return this->_animationGraph;
 		}
 
 		virtual std::vector<rawrbox::AnimationSampler*> playAnimation(bool loop = false, std::function<void(const std::string&)> onComplete = nullptr) {
@@ -299,7 +423,7 @@ namespace rawrbox {
 				if (fnd != this->_playingAnimations.end()) return nullptr; // Already playing
 
 				auto* playingAnim = this->playAnimation(i, anim, onComplete);
-				if (anim == nullptr) return nullptr;
+				if (playingAnim == nullptr) return nullptr;
 
 				playingAnim->setLoop(loop);
 				return playingAnim;
@@ -316,6 +440,7 @@ namespace rawrbox {
 
 		virtual void stopAllAnimations() {
 			this->_playingAnimations.clear();
+			this->_animationGraph.clear();
 		}
 
 		virtual bool hasAnimation(const std::string& name) {
@@ -327,6 +452,7 @@ namespace rawrbox {
 			if (fnd == this->_playingAnimations.end()) return false;
 
 			this->_playingAnimations.erase(fnd);
+			this->_animationGraph.remove(name);
 			return true;
 		}
 
@@ -486,45 +612,91 @@ namespace rawrbox {
 
 		void upload(rawrbox::UploadType type = rawrbox::UploadType::STATIC) override {
 			this->flattenMeshes(); // Merge and optimize meshes for drawing
+			this->calculateCullingBBOX();
+
 			ModelBase<M>::upload(type);
 		}
 
 		void draw() override {
-			ModelBase<M>::draw();
+			// Normally already ticked by ANIMATIONS::tick this frame
 			this->tickAnimations();
+			if (!this->_finishedAnimations.empty()) this->finishAnimations();
 
-			for (auto& mesh : this->_meshes) {
+			if (!this->isVisible()) return; // Animations are kept in sync while off-screen
+			ModelBase<M>::draw();
+
+			auto* context = rawrbox::RENDERER->context();
+			const auto& cameraPos = rawrbox::MAIN_CAMERA->getPos();
+			const bool streaming = rawrbox::TextureStreamer::isActive();
+
+			// Sort meshes by state, opaque front-to-back and transparent back-to-front ----
+			this->_queue.begin();
+			for (size_t i = 0; i < this->_meshes.size(); i++) {
+				auto& mesh = this->_meshes[i];
 				if (mesh == nullptr || mesh->empty()) continue; // Bone, skip it.
 
-				// Bind pipelines ----
-				this->_material->bindPipeline(*mesh);
+				auto textures = mesh->textures.getTextureIDs();
+				auto textureKey = static_cast<uint16_t>(textures.x ^ (textures.y << 4U) ^ (textures.z << 8U) ^ (textures.w << 12U));
+				auto pipelineKey = this->_queue.getStateID(this->_material->getPipeline(*mesh));
+
+				auto worldPos = this->getMatrix().mulVec(mesh->matrix.mulVec(rawrbox::Vector3f{}));
+				auto distance = worldPos.distance(cameraPos);
+				this->_queue.add(rawrbox::RenderQueue::makeKey(0, mesh->isTransparent(), pipelineKey, textureKey, distance), static_cast<uint32_t>(i));
+
+				// Mip feedback for streamed textures, from the rough size of the mesh on screen ---
+				if (streaming) {
+					const auto& size = mesh->getBBOX().size;
+					const auto& scale = this->getScale();
+
+					auto worldSize = std::max({size.x * scale.x, size.y * scale.y, size.z * scale.z});
+					rawrbox::TextureStreamer::request(mesh->textures, rawrbox::TextureStreamer::getScreenSize(worldSize, distance));
+				}
+			}
+
+			this->_queue.sort();
+			if (this->_queue.size() == 0) return;
+			// -------------------
+
+			// Upload every transform at once ----
+			this->_drawTransforms.clear();
+			for (const auto& item : this->_queue.getItems()) {
+				this->_drawTransforms.push_back(this->getMatrix() * this->_meshes[item.index]->getMatrix());
+			}
+
+			auto transformOffset = rawrbox::MAIN_CAMERA->writeModelTransforms(this->_drawTransforms.data(), this->_drawTransforms.size());
+			// -------------------
+
+			const auto& items = this->_queue.getItems();
+			for (size_t i = 0; i < items.size(); i++) {
+				auto& mesh = this->_meshes[items[i].index];
+
+				// Bind pipelines, only when it changes ----
+				auto* pipeline = this->_material->getPipeline(*mesh);
+				if (this->_queue.setPipeline(pipeline)) context->SetPipelineState(pipeline);
 				// -------------------
 
 				// Update uniforms -----
-				// bool buffersUpdated = false;
-				// buffersUpdated = this->_material->bindVertexUniforms(*mesh);
-				// buffersUpdated = this->_material->bindVertexSkinnedUniforms(*mesh);
-				// buffersUpdated = this->_material->bindPixelUniforms(*mesh);
-
-				this->_material->bindVertexUniforms(*mesh);
-				this->_material->bindVertexSkinnedUniforms(*mesh);
-				this->_material->bindPixelUniforms(*mesh);
+				this->_queue.countUniforms(this->_material->bindVertexUniforms(*mesh));
+				this->_queue.countUniforms(this->_material->bindVertexSkinnedUniforms(*mesh));
+				this->_queue.countUniforms(this->_material->bindPixelUniforms(*mesh));
 
-				rawrbox::MAIN_CAMERA->setModelTransform(this->getMatrix() * mesh->getMatrix());
+				rawrbox::MAIN_CAMERA->bindModelTransform(this->_drawTransforms[i], transformOffset + i * rawrbox::CameraBase::TRANSFORM_STRIDE);
 				// -----------
 
 				// DRAW -------
 				Diligent::DrawIndexedAttribs DrawAttrs;
 				DrawAttrs.IndexType = Diligent::VT_UINT32;
-				DrawAttrs.FirstIndexLocation = mesh->baseIndex;
-				DrawAttrs.BaseVertex = mesh->baseVertex;
+				DrawAttrs.FirstIndexLocation = this->getBaseIndex() + mesh->baseIndex;
+				DrawAttrs.BaseVertex = this->getBaseVertex() + mesh->baseVertex;
 				DrawAttrs.NumIndices = mesh->totalIndex;
 				DrawAttrs.Flags = Diligent::DRAW_FLAG_VERIFY_ALL;
-				// if (!buffersUpdated) DrawAttrs.Flags |= Diligent::DRAW_FLAG_DYNAMIC_RESOURCE_BUFFERS_INTACT;
 
-				rawrbox::RENDERER->context()->DrawIndexed(DrawAttrs);
+				context->DrawIndexed(DrawAttrs);
+				this->_queue.countDraw();
 				// -----------
 			}
+
+			this->_queue.end();
 		}
 	};
 } // namespace rawrbox
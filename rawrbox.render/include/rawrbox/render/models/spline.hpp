@@ -160,6 +160,8 @@ namespace rawrbox {
 
 			Diligent::DrawIndexedAttribs DrawAttrs;
 			DrawAttrs.IndexType = Diligent::VT_UINT32;
+			DrawAttrs.FirstIndexLocation = this->getBaseIndex();
+			DrawAttrs.BaseVertex = this->getBaseVertex();
 			DrawAttrs.NumIndices = this->_mesh->totalIndex;
 			DrawAttrs.Flags = Diligent::DRAW_FLAG_VERIFY_ALL /*| Diligent::DRAW_FLAG_DYNAMIC_RESOURCE_BUFFERS_INTACT*/;
 
@@ -61,6 +61,7 @@ namespace rawrbox {
 				rawrbox::Mesh<typename M::vertexBufferType> mesh;
 
 				mesh.setTexture(font.getPackTexture(glyph)); // Set the atlas
+				mesh.textures.distanceField = font.getType() == rawrbox::FontType::SDF ? 1.F : 0.F;
 				mesh.setName(fmt::format("3dtext-{}", id));
 				mesh.setColor(cl);
 
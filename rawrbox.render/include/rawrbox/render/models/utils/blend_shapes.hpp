@@ -0,0 +1,94 @@
+#pragma once
+
+#include <rawrbox/math/vector3.hpp>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace rawrbox {
+	struct BlendShapeRun {
+		uint32_t vertex = 0; // First vertex
+		uint32_t count = 0;
+		uint32_t offset = 0; // Into the stream deltas
+	};
+
+	// Sparse blend shape, only the vertices that move are stored (grouped into runs of consecutive vertices)
+	struct BlendShapeStream {
+		std::vector<rawrbox::BlendShapeRun> runs = {};
+
+		std::vector<float> x = {}; // Position deltas
+		std::vector<float> y = {};
+		std::vector<float> z = {};
+
+		std::vector<float> nx = {}; // Normal deltas, empty if the shape does not touch the normals
+		std::vector<float> ny = {};
+		std::vector<float> nz = {};
+
+		uint32_t start = 0; // Touched vertices [start, end)
+		uint32_t end = 0;
+
+		// Deltas smaller than epsilon are skipped, small gaps between runs are filled with zeros to keep them long
+		static rawrbox::BlendShapeStream fromDeltas(const std::vector<rawrbox::Vector3f>& positions, const std::vector<rawrbox::Vector3f>& normals = {}, float epsilon = 0.00001F);
+
+		[[nodiscard]] bool empty() const;
+		[[nodiscard]] bool hasNormals() const;
+		[[nodiscard]] size_t size() const; // Stored vertices
+	};
+
+	struct BlendShapeWeight {
+		const rawrbox::BlendShapeStream* stream = nullptr;
+		float weight = 0.F;
+	};
+
+	// Applies weighted sparse shapes on top of a base pose, in parallel chunks
+	// Only the vertices touched by the active shapes (and the ones touched last time, to restore them) are rebuilt
+	class BlendShapeAccumulator {
+	protected:
+		std::vector<float> _baseX = {};
+		std::vector<float> _baseY = {};
+		std::vector<float> _baseZ = {};
+		std::vector<float> _baseNX = {};
+		std::vector<float> _baseNY = {};
+		std::vector<float> _baseNZ = {};
+
+		std::vector<float> _x = {};
+		std::vector<float> _y = {};
+		std::vector<float> _z = {};
+		std::vector<float> _nx = {};
+		std::vector<float> _ny = {};
+		std::vector<float> _nz = {};
+
+		std::pair<uint32_t, uint32_t> _last = {0, 0};  // Range touched by the previous apply
+		std::pair<uint32_t, uint32_t> _dirty = {0, 0}; // Range rebuilt by the last apply
+
+		static void accumulate(const rawrbox::BlendShapeStream& stream, float weight, uint32_t start, uint32_t end, float* x, float* y, float* z, float* nx, float* ny, float* nz);
+
+	public:
+		static constexpr size_t BLOCK_SIZE = 2048; // Vertices per job
+
+		BlendShapeAccumulator() = default;
+		BlendShapeAccumulator(const BlendShapeAccumulator&) = default;
+		BlendShapeAccumulator(BlendShapeAccumulator&&) = default;
+		BlendShapeAccumulator& operator=(const BlendShapeAccumulator&) = default;
+		BlendShapeAccumulator& operator=(BlendShapeAccumulator&&) = default;
+		virtual ~BlendShapeAccumulator() = default;
+
+		// Normals are optional, the next apply rebuilds every vertex
+		virtual void setBase(const std::vector<rawrbox::Vector3f>& positions, const std::vector<rawrbox::Vector3f>& normals = {});
+		virtual void apply(const std::vector<rawrbox::BlendShapeWeight>& shapes);
+
+		// UTILS ---
+		[[nodiscard]] virtual std::pair<uint32_t, uint32_t> getDirty() const; // [start, end) to write back / upload
+
+		[[nodiscard]] virtual rawrbox::Vector3f getPosition(size_t vertex) const;
+		[[nodiscard]] virtual rawrbox::Vector3f getNormal(size_t vertex) const;
+
+		[[nodiscard]] virtual rawrbox::Vector3f getBasePosition(size_t vertex) const;
+		[[nodiscard]] virtual rawrbox::Vector3f getBaseNormal(size_t vertex) const;
+
+		[[nodiscard]] virtual bool hasNormals() const;
+		[[nodiscard]] virtual size_t size() const;
+		// ----------
+	};
+} // namespace rawrbox
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace rawrbox {
+	template <typename T>
+	concept MergeableMesh = requires(T& a, const T& b) {
+		{ b.isMergeable() } -> std::convertible_to<bool>;
+		{ b.getMergeHash() } -> std::convertible_to<size_t>;
+		{ b.isMergeCompatible(b) } -> std::convertible_to<bool>;
+		{ b.canMerge(b) } -> std::convertible_to<bool>;
+		a.merge(b);
+		a.vertices.reserve(size_t{});
+		a.indices.reserve(size_t{});
+	};
+
+	class MeshMerger {
+	public:
+		template <typename V>
+		static void hashCombine(size_t& seed, const V& val) {
+			seed ^= std::hash<V>{}(val) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+		}
+
+		// Merges every compatible mesh into the first mesh of its group, keeping the survivors in their original order
+		// Produces the same output as the pairwise (i1 < i2, i2 walking backwards) merge, but only compares meshes that share the same state hash
+		template <typename T>
+			requires(MergeableMesh<T>)
+		static void merge(std::vector<std::unique_ptr<T>>& meshes) {
+			if (meshes.size() <= 1) return;
+
+			// Bucket by state, collisions are split using isMergeCompatible ---
+			std::vector<std::vector<size_t>> groups = {};
+			std::unordered_map<size_t, std::vector<size_t>> buckets = {}; // hash -> group ids
+			buckets.reserve(meshes.size());
+
+			for (size_t i = 0; i < meshes.size(); i++) {
+				const auto& mesh = meshes[i];
+				if (mesh == nullptr || !mesh->isMergeable()) continue;
+
+				auto& bucket = buckets[mesh->getMergeHash()];
+				auto fnd = std::find_if(bucket.begin(), bucket.end(), [&](size_t group) { return meshes[groups[group].front()]->isMergeCompatible(*mesh); });
+
+				if (fnd == bucket.end()) {
+					bucket.push_back(groups.size());
+					groups.push_back({i});
+				} else {
+					groups[*fnd].push_back(i);
+				}
+			}
+			// --------------
+
+			// Merge each group ---
+			std::vector<bool> merged(meshes.size(), false);
+			std::vector<size_t> pending = {};
+
+			for (auto& group : groups) {
+				while (group.size() > 1) {
+					auto& leader = meshes[group.front()];
+
+					// figure out how big our buffers will get
+					size_t reserveVertices = leader->vertices.size();
+					size_t reserveIndices = leader->indices.size();
+
+					for (size_t i = 1; i < group.size(); i++) {
+						auto& other = meshes[group[i]];
+						if (!leader->canMerge(*other)) continue;
+
+						reserveVertices += other->vertices.size();
+						reserveIndices += other->indices.size();
+					}
+
+					leader->vertices.reserve(reserveVertices);
+					leader->indices.reserve(reserveIndices);
+
+					// Walk backwards, whatever doesn't fit anymore starts the next leader
+					pending.clear();
+					for (size_t i = group.size() - 1; i > 0; i--) {
+						auto& other = meshes[group[i]];
+
+						if (!leader->canMerge(*other)) {
+							pending.push_back(group[i]);
+							continue;
+						}
+
+						leader->merge(*other);
+						merged[group[i]] = true;
+					}
+
+					std::reverse(pending.begin(), pending.end());
+					group.swap(pending);
+				}
+			}
+			// --------------
+
+			// Compact, survivors keep their order ---
+			size_t write = 0;
+			for (size_t i = 0; i < meshes.size(); i++) {
+				if (merged[i]) continue;
+				if (write != i) meshes[write] = std::move(meshes[i]);
+
+				write++;
+			}
+
+			meshes.resize(write);
+			// --------------
+		}
+	};
+} // namespace rawrbox
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <rawrbox/render/culling/instances.hpp>
+#include <rawrbox/render/plugins/base.hpp>
+
+namespace rawrbox {
+	struct GPUCullingUniforms {
+		std::array<rawrbox::Vector4f, 6> planes = {};
+
+		rawrbox::Vector4f center = {};
+		rawrbox::Vector4f extents = {};
+
+		rawrbox::Vector4u info = {}; // Instance count, ??, ??, ??
+	};
+
+	// Buffers of a single indirect draw, owned by the model
+	struct GPUCullingTarget {
+		Diligent::IBuffer* instances = nullptr; // Source instances (raw, SRV)
+		Diligent::IBuffer* culled = nullptr;    // Compacted instances (raw, UAV + vertex buffer)
+		Diligent::IBuffer* args = nullptr;      // DrawIndexedIndirectArgs (raw, UAV + indirect args)
+
+		rawrbox::Matrix4x4 world = {};              // Model transform, applied on top of the instance transform
+		rawrbox::BBOX bounds = {};                  // Local space bounds of the instanced mesh
+		rawrbox::DrawIndexedIndirectArgs draw = {}; // Draw template, numInstances is the source instance count
+
+		[[nodiscard]] bool isValid() const { return this->instances != nullptr && this->culled != nullptr && this->args != nullptr; }
+	};
+
+	// Culls registered instance buffers against the camera frustum on the GPU, writes the compacted instances + indirect draw args
+	class GPUCullingPlugin : public rawrbox::RenderPlugin {
+	protected:
+		std::vector<rawrbox::GPUCullingTarget*> _registeredTargets = {};
+
+		Diligent::IPipelineState* _cullProgram = nullptr;
+
+		// SIGNATURE ---
+		Diligent::RefCntAutoPtr<Diligent::IPipelineResourceSignature> _signature;
+		Diligent::RefCntAutoPtr<Diligent::IShaderResourceBinding> _signatureBind;
+		// --------------
+
+		// BUFFERS -----
+		Diligent::RefCntAutoPtr<Diligent::IBuffer> _uniforms;
+		// -------------
+
+		void createSignatures();
+		void createBuffers();
+
+		void createPipelines();
+
+		// RENDERING ---
+		void cullTarget(const rawrbox::Frustum& frustum, rawrbox::GPUCullingTarget* target);
+		// ---------
+
+	public:
+		static constexpr uint32_t THREAD_GROUP_SIZE = 64;
+
+		GPUCullingPlugin() = default;
+		GPUCullingPlugin(const GPUCullingPlugin&) = delete;
+		GPUCullingPlugin(GPUCullingPlugin&&) = delete;
+		GPUCullingPlugin& operator=(const GPUCullingPlugin&) = delete;
+		GPUCullingPlugin& operator=(GPUCullingPlugin&&) = delete;
+		~GPUCullingPlugin() override;
+
+		void initialize(const rawrbox::Vector2u& size) override;
+		void upload() override;
+
+		void preRender(const rawrbox::CameraBase& camera) override;
+
+		// Indirect draws need device support, models fallback to the CPU culler otherwise
+		[[nodiscard]] static bool isSupported();
+
+		// REGISTER ----
+		void registerTarget(rawrbox::GPUCullingTarget* target);
+		void unregisterTarget(rawrbox::GPUCullingTarget* target);
+		// -------------
+
+		std::string getID() override;
+	};
+} // namespace rawrbox
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace rawrbox {
+	struct RenderQueueStats {
+		uint32_t draws = 0;
+
+		uint32_t pipelineBinds = 0;
+		uint32_t pipelineSkips = 0;
+
+		uint32_t uniformUploads = 0;
+		uint32_t uniformSkips = 0;
+
+		RenderQueueStats& operator+=(const RenderQueueStats& other) {
+			this->draws += other.draws;
+			this->pipelineBinds += other.pipelineBinds;
+			this->pipelineSkips += other.pipelineSkips;
+			this->uniformUploads += other.uniformUploads;
+			this->uniformSkips += other.uniformSkips;
+			return *this;
+		}
+	};
+
+	struct RenderQueueItem {
+		uint64_t key = 0;
+		uint32_t index = 0; // Index into the caller's draw list
+	};
+
+	// Sort key layout (MSB -> LSB):
+	// OPAQUE      -> PASS (4) | TRANSPARENT (1) = 0 | PIPELINE (16) | TEXTURES (16) | DEPTH (27), front-to-back
+	// TRANSPARENT -> PASS (4) | TRANSPARENT (1) = 1 | ~DEPTH (27) | PIPELINE (16) | TEXTURES (16), back-to-front
+	class RenderQueue {
+	protected:
+		std::vector<rawrbox::RenderQueueItem> _items = {};
+		std::vector<rawrbox::RenderQueueItem> _scratch = {};
+
+		std::unordered_map<const void*, uint16_t> _stateIDs = {};
+
+		const void* _lastPipeline = nullptr;
+		rawrbox::RenderQueueStats _stats = {};
+
+		// FRAME STATS ---
+		static rawrbox::RenderQueueStats _frameStats;
+		static rawrbox::RenderQueueStats _lastFrameStats;
+		// ----
+
+	public:
+		static uint64_t makeKey(uint8_t pass, bool transparent, uint16_t pipeline, uint16_t textures, float depth);
+		static uint32_t quantizeDepth(float depth);
+
+		// Returns a small stable id for a state object (pipeline, etc), used to group draws in the key
+		[[nodiscard]] uint16_t getStateID(const void* state);
+
+		void begin();
+		void add(uint64_t key, uint32_t index);
+		void sort();
+		void end();
+
+		// STATE ---
+		// Returns true if the pipeline needs to be bound
+		[[nodiscard]] bool setPipeline(const void* pipeline);
+		void countUniforms(bool uploaded);
+		void countDraw();
+		// ----
+
+		[[nodiscard]] const std::vector<rawrbox::RenderQueueItem>& getItems() const;
+		[[nodiscard]] const rawrbox::RenderQueueStats& getStats() const;
+		[[nodiscard]] size_t size() const;
+
+		// FRAME STATS ---
+		static void frame();
+		[[nodiscard]] static const rawrbox::RenderQueueStats& getFrameStats(); // Totals of the last finished frame
+		// ----
+	};
+} // namespace rawrbox
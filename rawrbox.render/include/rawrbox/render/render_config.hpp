@@ -18,7 +18,10 @@
 
 #define RB_MAX_BONES_PER_VERTEX          4
 #define RB_RENDER_MAX_BONES_PER_MODEL    150
-#define RB_RENDER_BUFFER_INCREASE_OFFSET 256 // To prevent the vertex / index buffer from resizing too often, increase this value to offset the scaling based on your model needs
+#define RB_RENDER_BUFFER_INCREASE_OFFSET 256    // To prevent the vertex / index buffer from resizing too often, increase this value to offset the scaling based on your model needs
+#define RB_RENDER_TRANSFORM_BUFFER_SIZE  262144 // Per-frame ring for model transforms, it gets renamed when full
+#define RB_RENDER_DIRTY_RANGE_GAP        64    // Dirty ranges closer than this (in elements) are uploaded together, less UpdateBuffer calls
+#define RB_RENDER_GEOMETRY_ARENA_SIZE    65536  // Initial vertices per shared static geometry arena (indices get 3x), arenas grow when full
 // -------------
 
 // SHADERS ------
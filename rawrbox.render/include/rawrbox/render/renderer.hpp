@@ -3,6 +3,7 @@
 #include <rawrbox/math/color.hpp>
 #include <rawrbox/math/vector2.hpp>
 #include <rawrbox/render/cameras/base.hpp>
+#include <rawrbox/render/culling/list.hpp>
 #include <rawrbox/render/enums/draw.hpp>
 #include <rawrbox/render/plugins/base.hpp>
 #include <rawrbox/render/stencil.hpp>
@@ -86,6 +87,7 @@ namespace rawrbox {
 		std::unique_ptr<rawrbox::Logger> _logger = std::make_unique<rawrbox::Logger>("RawrBox-Renderer");
 		std::unique_ptr<rawrbox::Stencil> _stencil = nullptr;
 		std::unique_ptr<rawrbox::TextureBLIT> _GPUBlit = nullptr;
+		std::shared_ptr<rawrbox::CullingList> _culling = std::make_shared<rawrbox::CullingList>(); // Shared, models hold weak refs and can outlive the renderer
 		// -------------
 
 		// CAMERAS ---
@@ -177,6 +179,7 @@ namespace rawrbox {
 
 		// Utils ----
 		[[nodiscard]] virtual rawrbox::Stencil* stencil() const;
+		[[nodiscard]] virtual const std::shared_ptr<rawrbox::CullingList>& culling() const;
 
 		// WARNING: NOT THREAD SAFE!!
 		[[nodiscard]] virtual Diligent::IDeviceContext* context() const;
@@ -2,10 +2,13 @@
 
 #include <rawrbox/math/aabb.hpp>
 #include <rawrbox/math/color.hpp>
+#include <rawrbox/math/matrix4x4.hpp>
 #include <rawrbox/math/pi.hpp>
 #include <rawrbox/math/vector4.hpp>
 #include <rawrbox/render/text/font.hpp>
+#include <rawrbox/render/text/layout.hpp>
 #include <rawrbox/render/textures/flat.hpp>
+#include <rawrbox/render/utils/draw_arena.hpp>
 #include <rawrbox/render/utils/streaming.hpp>
 
 #include <RefCntAutoPtr.hpp>
@@ -14,16 +17,30 @@
 #include <ShaderResourceBinding.h>
 #include <Texture.h>
 
+#include <array>
 #include <memory>
 #include <vector>
 
 namespace rawrbox {
+	// Screen pixels (left, top, right, bottom) a vertex may draw into, checked per pixel so clipping never splits a draw
+	using StencilClipRect = std::array<uint16_t, 4>;
+	constexpr rawrbox::StencilClipRect STENCIL_NO_CLIP = {0, 0, 0xFFFF, 0xFFFF};
+
+	// uv.w / StencilQuad::flag, how stencil.psh reads the texture. One shader so boxes and text share draws
+	enum class StencilMode : uint32_t {
+		TEXTURE = 0,
+		STIPPLE = 1,
+		GLYPH = 2, // Single channel atlas
+		GLYPH_SDF = 3
+	};
+
 	struct PosUVColorVertexData {
 		// ----------
 		uint32_t textureID = 0x00000000;
 		rawrbox::Vector2f pos = {};
 		uint32_t color = 0x00000000;
 		rawrbox::Vector4f uv = {};
+		rawrbox::StencilClipRect clip = rawrbox::STENCIL_NO_CLIP;
 		//  ----------
 
 		PosUVColorVertexData() = default;
@@ -39,7 +56,9 @@ namespace rawrbox {
 			    // Attribute 2 - Color
 			    Diligent::LayoutElement{2, 0, 4, Diligent::VT_UINT8, true, Diligent::LAYOUT_ELEMENT_AUTO_OFFSET, Diligent::LAYOUT_ELEMENT_AUTO_STRIDE, Diligent::INPUT_ELEMENT_FREQUENCY_PER_VERTEX},
 			    // Attribute 3 - UV
-			    Diligent::LayoutElement{3, 0, 4, Diligent::VT_FLOAT32, false, Diligent::LAYOUT_ELEMENT_AUTO_OFFSET, Diligent::LAYOUT_ELEMENT_AUTO_STRIDE, Diligent::INPUT_ELEMENT_FREQUENCY_PER_VERTEX}};
+			    Diligent::LayoutElement{3, 0, 4, Diligent::VT_FLOAT32, false, Diligent::LAYOUT_ELEMENT_AUTO_OFFSET, Diligent::LAYOUT_ELEMENT_AUTO_STRIDE, Diligent::INPUT_ELEMENT_FREQUENCY_PER_VERTEX},
+			    // Attribute 4 - Clip
+			    Diligent::LayoutElement{4, 0, 4, Diligent::VT_UINT16, false, Diligent::LAYOUT_ELEMENT_AUTO_OFFSET, Diligent::LAYOUT_ELEMENT_AUTO_STRIDE, Diligent::INPUT_ELEMENT_FREQUENCY_PER_VERTEX}};
 		}
 	};
 
@@ -62,30 +81,67 @@ namespace rawrbox {
 		bool operator!=(const Clip& other) const { return !operator==(other); }
 	};
 
+	// Axis aligned quad, expanded to 4 corners by stencil_quad.vsh
+	struct StencilQuad {
+		// ----------
+		rawrbox::Vector4f rect = {}; // x, y, width, height
+		rawrbox::Vector4f uv = {};   // u0, v0, u1, v1
+		uint32_t color = 0x00000000;
+		uint32_t textureID = 0x00000000;
+		float slice = 0.F;
+		float flag = 0.F; // StencilMode, uv.w on PosUVColorVertexData
+		rawrbox::StencilClipRect clip = rawrbox::STENCIL_NO_CLIP;
+		//  ----------
+
+		static std::vector<Diligent::LayoutElement> vLayout() {
+			return {
+			    // Attribute 0 - Rect
+			    Diligent::LayoutElement{0, 0, 4, Diligent::VT_FLOAT32, false, Diligent::LAYOUT_ELEMENT_AUTO_OFFSET, Diligent::LAYOUT_ELEMENT_AUTO_STRIDE, Diligent::INPUT_ELEMENT_FREQUENCY_PER_INSTANCE},
+			    // Attribute 1 - UV
+			    Diligent::LayoutElement{1, 0, 4, Diligent::VT_FLOAT32, false, Diligent::LAYOUT_ELEMENT_AUTO_OFFSET, Diligent::LAYOUT_ELEMENT_AUTO_STRIDE, Diligent::INPUT_ELEMENT_FREQUENCY_PER_INSTANCE},
+			    // Attribute 2 - Color
+			    Diligent::LayoutElement{2, 0, 4, Diligent::VT_UINT8, true, Diligent::LAYOUT_ELEMENT_AUTO_OFFSET, Diligent::LAYOUT_ELEMENT_AUTO_STRIDE, Diligent::INPUT_ELEMENT_FREQUENCY_PER_INSTANCE},
+			    // Attribute 3 - TextureID
+			    Diligent::LayoutElement{3, 0, 1, Diligent::VT_UINT32, false, Diligent::LAYOUT_ELEMENT_AUTO_OFFSET, Diligent::LAYOUT_ELEMENT_AUTO_STRIDE, Diligent::INPUT_ELEMENT_FREQUENCY_PER_INSTANCE},
+			    // Attribute 4 - Slice + flag
+			    Diligent::LayoutElement{4, 0, 2, Diligent::VT_FLOAT32, false, Diligent::LAYOUT_ELEMENT_AUTO_OFFSET, Diligent::LAYOUT_ELEMENT_AUTO_STRIDE, Diligent::INPUT_ELEMENT_FREQUENCY_PER_INSTANCE},
+			    // Attribute 5 - Clip
+			    Diligent::LayoutElement{5, 0, 4, Diligent::VT_UINT16, false, Diligent::LAYOUT_ELEMENT_AUTO_OFFSET, Diligent::LAYOUT_ELEMENT_AUTO_STRIDE, Diligent::INPUT_ELEMENT_FREQUENCY_PER_INSTANCE}};
+		}
+	};
+
 	struct StencilDraw {
 		Diligent::IPipelineState* stencilProgram = nullptr;
 
-		std::vector<rawrbox::PosUVColorVertexData> vertices = {};
-		std::vector<uint32_t> indices = {};
+		rawrbox::DrawRange range = {}; // Into the stencil's arena
+		bool instanced = false;        // Draws range.instanceCount StencilQuads instead of indexed vertices
 
-		rawrbox::Clip clip = {};
 		bool cull = true;
 		bool optimize = true;
 
 		void clear() {
 			this->cull = true;
-			this->clip = {};
 
 			this->optimize = true;
+			this->instanced = false;
 			this->stencilProgram = nullptr;
 
-			this->indices.clear();
-			this->vertices.clear();
+			this->range = {};
 		}
 
 		StencilDraw() = default;
 	};
 
+	struct StencilStats {
+		uint32_t calls = 0;       // Draw requests that made geometry
+		uint32_t clipChanges = 0; // Requests with a different clip than the one before, each one used to split the draw
+		uint32_t draws = 0;       // Draw calls sent to the GPU
+
+		uint32_t vertices = 0;
+		uint32_t indices = 0;
+		uint32_t quads = 0;
+	};
+
 	struct StencilRotation {
 		float rotation = 0.F;
 		rawrbox::Vector2f origin = {};
@@ -157,11 +213,13 @@ namespace rawrbox {
 		// HANDLES ----
 		Diligent::IPipelineState* _2dPipeline = nullptr;
 		Diligent::IPipelineState* _linePipeline = nullptr;
-		Diligent::IPipelineState* _textPipeline = nullptr;
+		Diligent::IPipelineState* _quadPipeline = nullptr;
 
 		static constexpr const int MaxVertsInStreamingBuffer = 65536;
+		static constexpr const int MaxQuadsInStreamingBuffer = 16384;
 		std::unique_ptr<rawrbox::StreamingBuffer> _streamingVB = nullptr;
 		std::unique_ptr<rawrbox::StreamingBuffer> _streamingIB = nullptr;
+		std::unique_ptr<rawrbox::StreamingBuffer> _streamingQuads = nullptr;
 		// ------------
 
 		// WINDOW ----
@@ -176,6 +234,7 @@ namespace rawrbox {
 
 		// Clip handling ----
 		std::vector<rawrbox::Clip> _clips = {};
+		rawrbox::StencilClipRect _clipRect = rawrbox::STENCIL_NO_CLIP; // Top clip in screen pixels
 		// ----------
 
 		// Outline handling ----
@@ -186,11 +245,13 @@ namespace rawrbox {
 		// Rotation handling ----
 		std::vector<rawrbox::StencilRotation> _rotations = {};
 		StencilRotation _rotation = {};
+		rawrbox::Matrix4x4 _rotationMtx = {}; // Rebuilt on push / pop, not per vertex
 		// ----------
 
 		// Scale handling ----
 		std::vector<rawrbox::Vector2f> _scales = {};
 		rawrbox::Vector2f _scale = {};
+		rawrbox::Matrix4x4 _scaleMtx = {};
 		// ----------
 
 		// Optimization handling ----
@@ -198,26 +259,38 @@ namespace rawrbox {
 		// ---------------------------
 
 		// Drawing -----
+		rawrbox::DrawArena<rawrbox::PosUVColorVertexData, rawrbox::StencilQuad> _arena = {}; // Reset every frame, keeps its memory
 		rawrbox::StencilDraw _currentDraw = {};
 		std::vector<rawrbox::StencilDraw> _drawCalls = {};
 		// ----------
 
+		// Stats -----
+		rawrbox::StencilStats _frameStats = {};
+		rawrbox::StencilStats _stats = {};
+		rawrbox::StencilClipRect _lastClipRect = rawrbox::STENCIL_NO_CLIP;
+		// ----------
+
 		// LOGGER ------
 		std::unique_ptr<rawrbox::Logger> _logger = std::make_unique<rawrbox::Logger>("RawrBox-Stencil");
 		// -------------
 
 		// ------ UTILS
 		void pushVertice(const uint32_t& textureID, rawrbox::Vector2f pos, const rawrbox::Vector4f& uv, const rawrbox::Color& col);
-		void pushIndices(std::vector<uint32_t> ind);
+		void pushVertice(const uint32_t& textureID, rawrbox::Vector2f pos, const rawrbox::Vector4f& uv, uint32_t col);
+		void pushQuad(const uint32_t& textureID, rawrbox::Vector2f min, rawrbox::Vector2f max, const rawrbox::Vector2f& uvStart, const rawrbox::Vector2f& uvEnd, float slice, float flag, uint32_t col);
 
 		void applyRotation(rawrbox::Vector2f& vert) const;
-		void applyScale(rawrbox::Vector2f& vert);
+		void applyScale(rawrbox::Vector2f& vert) const;
+
+		void updateRotation();
+		void updateScale();
+		void updateClip();
 
 		[[nodiscard]] rawrbox::Vector2f alignPosition(const rawrbox::Vector2f& pos, const rawrbox::Vector2f& size, rawrbox::Alignment alignX, rawrbox::Alignment alignY) const;
 		// --------------------
 
 		// ------ RENDERING
-		void setupDrawCall(Diligent::IPipelineState* program);
+		void setupDrawCall(Diligent::IPipelineState* program, bool instanced = false);
 		void pushDrawCall();
 
 		void internalDraw();
@@ -246,6 +319,7 @@ namespace rawrbox {
 		virtual void drawLine(const rawrbox::Vector2& from, const rawrbox::Vector2& to, const rawrbox::Color& col = rawrbox::Colors::White());
 		virtual void drawText(const std::string& text, const rawrbox::Vector2f& pos, const rawrbox::Color& col = rawrbox::Colors::White(), const rawrbox::Color& bgCol = rawrbox::Colors::Transparent(), rawrbox::Alignment alignX = rawrbox::Alignment::Left, rawrbox::Alignment alignY = rawrbox::Alignment::Left);
 		virtual void drawText(const rawrbox::Font& font, const std::string& text, const rawrbox::Vector2f& pos, const rawrbox::Color& col = rawrbox::Colors::White(), rawrbox::Alignment alignX = rawrbox::Alignment::Left, rawrbox::Alignment alignY = rawrbox::Alignment::Left);
+		virtual void drawText(const rawrbox::TextLayout& layout, const rawrbox::Vector2f& pos, const rawrbox::Color& col = rawrbox::Colors::White());
 		virtual void drawLoading(const rawrbox::Vector2f& pos, const rawrbox::Vector2f& size, const rawrbox::Color& color = rawrbox::Colors::White());
 
 		virtual void drawVertices(const std::vector<rawrbox::PosUVColorVertexData>& vertices, const std::vector<uint32_t>& indices);
@@ -289,7 +363,9 @@ namespace rawrbox {
 
 		// ------ OTHER
 		[[nodiscard]] virtual const rawrbox::Vector2u& getSize() const;
-		[[nodiscard]] virtual std::vector<rawrbox::StencilDraw> getDrawCalls() const;
+		[[nodiscard]] virtual const std::vector<rawrbox::StencilDraw>& getDrawCalls() const;
+		[[nodiscard]] virtual const rawrbox::DrawArena<rawrbox::PosUVColorVertexData, rawrbox::StencilQuad>& getArena() const;
+		[[nodiscard]] virtual const rawrbox::StencilStats& getStats() const; // Last rendered frame
 		virtual void clear();
 		// --------------------
 	};
@@ -5,6 +5,7 @@
 
 #include <filesystem>
 #include <map>
+#include <unordered_map>
 #include <utility>
 
 namespace rawrbox {
@@ -13,6 +14,8 @@ namespace rawrbox {
 	protected:
 		static std::map<std::string, std::unique_ptr<rawrbox::Font>> _fonts;
 		static std::map<uint16_t, std::unique_ptr<rawrbox::TexturePack>> _packs;
+		static std::map<std::string, std::unordered_map<uint32_t, rawrbox::Glyph>> _distanceFields; // Per font file, shared by every size
+		static size_t _maxPacks; // Per format, past this glyphs get evicted instead of growing
 
 		// LOGGER ------
 		static std::unique_ptr<rawrbox::Logger> _logger;
@@ -20,14 +23,35 @@ namespace rawrbox {
 
 		static std::string getFontInSystem(const std::filesystem::path& path);
 
+		// ATLAS ---
+		// Makes room in an existing pack, compacting it first when it's mostly holes, then dropping least recently used glyphs
+		static bool reclaim(uint16_t id, rawrbox::TexturePack& pack, uint16_t width, uint16_t height);
+		static void evictGlyphs(uint16_t id, const std::vector<rawrbox::AtlasRect>& evicted);
+		static void relocateGlyphs(uint16_t id, const std::vector<rawrbox::AtlasRelocation>& relocations);
+		// -------
+
 	public:
+		static constexpr uint32_t PACK_SIZE = 512U;
+		static constexpr float DEFRAGMENT_OCCUPANCY = 0.75F; // Full packs below this are compacted before evicting
+
 		static uint16_t packID;
 
 		static void shutdown();
 
-		static std::pair<uint16_t, rawrbox::TexturePack*> requestPack(uint16_t width, uint16_t height, Diligent::TEXTURE_FORMAT format = Diligent::TEXTURE_FORMAT::TEX_FORMAT_RGBA8_UNORM);
+		static std::pair<uint16_t, rawrbox::TexturePack*> requestPack(uint16_t width, uint16_t height, Diligent::TEXTURE_FORMAT format = Diligent::TEXTURE_FORMAT::TEX_FORMAT_R8_UNORM);
 		static rawrbox::TexturePack* getPack(uint16_t id);
 
-		static rawrbox::Font* load(const std::filesystem::path& filename, uint16_t size, uint32_t index = 0);
+		static void setMaxPacks(size_t max);
+		[[nodiscard]] static size_t getMaxPacks();
+
+		// SDF ---
+		[[nodiscard]] static const rawrbox::Glyph* getDistanceField(const std::string& font, uint32_t codePoint);
+		static void addDistanceField(const std::string& font, const rawrbox::Glyph& glyph);
+		// -------
+
+		// Bakes again the glyphs of the text the font lost to eviction
+		static void restoreGlyphs(const rawrbox::Font& font, const std::string& text);
+
+		static rawrbox::Font* load(const std::filesystem::path& filename, uint16_t size, uint32_t index = 0, rawrbox::FontType type = rawrbox::FontType::ALPHA);
 	};
 } // namespace rawrbox
@@ -8,6 +8,8 @@
 #include <functional>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 struct stbtt_fontinfo;
 
@@ -18,6 +20,11 @@ namespace rawrbox {
 		Right
 	};
 
+	enum class FontType {
+		ALPHA, // Coverage, baked for each size
+		SDF    // Signed distance field, baked once and scaled to every size
+	};
+
 	struct FontInfo {
 		/// The font height in pixel.
 		uint16_t pixelSize;
@@ -74,6 +81,7 @@ namespace rawrbox {
 
 	struct Glyph {
 		uint16_t packID = 0;
+		uint64_t spriteID = 0;
 		uint32_t codePoint = 0;
 
 		float scale = 0.F;
@@ -86,14 +94,32 @@ namespace rawrbox {
 		rawrbox::Vector2f textureBottomRight = {};
 	};
 
+	// Rasterized glyph, before it lands on an atlas
+	struct GlyphBitmap {
+		uint32_t codePoint = 0;
+
+		int32_t x = 0; // Offset from the cursor
+		int32_t y = 0;
+		uint32_t width = 0;
+		uint32_t height = 0;
+
+		float advance = 0.F;
+		std::vector<uint8_t> pixels = {}; // R8
+	};
+
 	class TextEngine;
 
 	class Font {
 	private:
 		std::shared_ptr<stbtt_fontinfo> _font = nullptr; // unique_ptr does not like incomplete types
+		std::vector<uint8_t> _buffer = {};                // stbtt reads straight from it, glyphs get baked long after load
 		std::unordered_map<uint32_t, std::unique_ptr<rawrbox::Glyph>> _glyphs = {};
+		std::unordered_set<uint32_t> _evicted = {}; // Dropped from the atlas, baked again when a layout needs them
+		uint64_t _generation = 0;                   // Bumped whenever glyphs are added, evicted or moved
 
 		std::filesystem::path _fileName = {};
+		uint32_t _fontIndex = 0;
+		rawrbox::FontType _type = rawrbox::FontType::ALPHA;
 
 		float _scale = 0.F;
 		float _pixelSize = 0;
@@ -112,13 +138,23 @@ namespace rawrbox {
 		// INTERNAL ---
 		virtual void loadFontInfo();
 
-		std::unique_ptr<rawrbox::Glyph> bakeGlyphAlpha(uint32_t codePoint);
-		virtual void generateGlyph(uint32_t codePoint);
+		// Thread safe, only reads the font
+		[[nodiscard]] rawrbox::GlyphBitmap bakeGlyphAlpha(uint32_t codePoint) const;
+		[[nodiscard]] rawrbox::GlyphBitmap bakeGlyphSDF(uint32_t codePoint) const;
+
+		// Packs a batch of bitmaps into the glyph atlases tallest first, storing each glyph as soon as it lands
+		// Packing can evict earlier glyphs of the same batch, those end up in _evicted like any other
+		void packGlyphs(std::vector<rawrbox::GlyphBitmap>& bitmaps, const std::string& key);
+		virtual void generateGlyphs(const std::vector<uint32_t>& codePoints);
 		// ----
 
 	public:
 		virtual ~Font();
 
+		static constexpr float SDF_SIZE = 48.F;   // Pixel size the distance fields are baked at
+		static constexpr int SDF_PADDING = 6;     // Texels of distance around each glyph
+		static constexpr uint8_t SDF_EDGE = 128;  // Distance value on the outline
+
 		Font(const std::filesystem::path& fileName, int16_t widthPadding = 6, int16_t heightPadding = 6);
 		Font(Font&&) = delete;
 		Font& operator=(Font&&) = delete;
@@ -126,15 +162,27 @@ namespace rawrbox {
 		Font& operator=(const Font&) = delete;
 
 		// LOADING ---
-		virtual void load(const std::vector<uint8_t>& buffer, uint16_t pixelHeight, uint32_t fontIndex = 0);
+		virtual void load(const std::vector<uint8_t>& buffer, uint16_t pixelHeight, uint32_t fontIndex = 0, rawrbox::FontType type = rawrbox::FontType::ALPHA);
 		virtual void addChars(const std::string& chars);
 		virtual rawrbox::Font* scale(uint16_t size);
+
+		// Bakes again any glyph of the text that was evicted from the atlas
+		virtual void restoreGlyphs(const std::string& text);
+		// ----
+
+		// ATLAS ---
+		virtual void evictGlyphs(uint16_t packID, const std::unordered_set<uint64_t>& sprites);
+		virtual void relocateGlyphs(uint16_t packID, const std::unordered_map<uint64_t, rawrbox::AtlasRect>& moved);
 		// ----
 
 		// UTILS ---
 		[[nodiscard]] virtual const rawrbox::FontInfo& getFontInfo() const;
+		[[nodiscard]] virtual rawrbox::FontType getType() const;
 
 		[[nodiscard]] virtual bool hasGlyph(uint32_t codepoint) const;
+		[[nodiscard]] virtual size_t getGlyphCount() const;
+		[[nodiscard]] virtual bool hasEvicted() const;
+		[[nodiscard]] virtual uint64_t getGeneration() const;
 		[[nodiscard]] virtual rawrbox::Glyph* getGlyph(uint32_t codepoint) const;
 
 		[[nodiscard]] virtual float getSize() const;
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <rawrbox/math/vector2.hpp>
+#include <rawrbox/math/vector4.hpp>
+#include <rawrbox/render/text/font.hpp>
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rawrbox {
+	struct TextLayoutGlyph {
+		uint32_t textureID = 0;
+		uint16_t packID = 0;
+		uint64_t spriteID = 0; // Touched on draw, keeps the glyph out of eviction
+
+		rawrbox::Vector2f min = {}; // Relative to the layout origin
+		rawrbox::Vector2f max = {};
+
+		rawrbox::Vector2f uvMin = {};
+		rawrbox::Vector2f uvMax = {};
+	};
+
+	// A shaped string: glyph quads, line breaks and measured size. Built once, drawn without touching the font again
+	class TextLayout {
+	protected:
+		std::vector<rawrbox::TextLayoutGlyph> _glyphs = {};
+		rawrbox::Vector2f _size = {};
+
+		size_t _lines = 0;
+		uint64_t _generation = 0; // Font generation when built, new glyphs replace fallbacks and evicted / moved ones change uvs
+		bool _sdf = false;
+
+	public:
+		// wrapWidth <= 0 only breaks on \n, otherwise words wrap (long words break anywhere)
+		TextLayout(const rawrbox::Font& font, const std::string& text, float wrapWidth = 0.F);
+
+		[[nodiscard]] const std::vector<rawrbox::TextLayoutGlyph>& getGlyphs() const;
+		[[nodiscard]] const rawrbox::Vector2f& getSize() const;
+		[[nodiscard]] size_t getLines() const;
+
+		[[nodiscard]] bool isSDF() const;
+		[[nodiscard]] bool isStale(const rawrbox::Font& font) const;
+		[[nodiscard]] bool empty() const;
+	};
+
+	// LRU of layouts keyed by (font, text, wrap width). Render thread only
+	class TextLayoutCache {
+	protected:
+		struct Entry {
+			size_t hash = 0;
+
+			const rawrbox::Font* font = nullptr;
+			std::string text = {};
+			float wrapWidth = 0.F;
+
+			std::unique_ptr<rawrbox::TextLayout> layout = nullptr;
+		};
+
+		static std::list<Entry> _entries; // Most recently used first
+		static std::unordered_map<size_t, std::list<Entry>::iterator> _lookup;
+		static size_t _capacity;
+
+		[[nodiscard]] static size_t hash(const rawrbox::Font& font, const std::string& text, float wrapWidth);
+
+	public:
+		static const rawrbox::TextLayout& get(const rawrbox::Font& font, const std::string& text, float wrapWidth = 0.F);
+		static void invalidate(const rawrbox::Font& font); // Drops every layout of the font, its atlas glyphs changed
+		static void clear();
+
+		static void setCapacity(size_t capacity);
+		[[nodiscard]] static size_t size();
+	};
+} // namespace rawrbox
@@ -2,6 +2,7 @@
 
 #include <rawrbox/math/color.hpp>
 #include <rawrbox/math/vector2.hpp>
+#include <rawrbox/render/textures/data.hpp>
 #include <rawrbox/render/utils/pipeline.hpp>
 
 #include <RefCntAutoPtr.hpp>
@@ -10,6 +11,7 @@
 #include <Texture.h>
 #include <TextureView.h>
 
+#include <filesystem>
 #include <vector>
 
 namespace rawrbox {
@@ -18,49 +20,6 @@ namespace rawrbox {
 		VERTEX
 	};
 
-	struct ImageFrame {
-		float delay = 0.F; // User for animation
-		std::vector<uint8_t> pixels = {};
-	};
-
-	struct ImageData {
-		rawrbox::Vector2u size = {};
-		uint8_t channels = 0U;
-
-		std::vector<rawrbox::ImageFrame> frames = {};
-
-		void createFrame() {
-			rawrbox::ImageFrame frame = {};
-			frame.pixels.resize(this->size.x * this->size.y * this->channels);
-			std::memset(frame.pixels.data(), 0, frame.pixels.size()); // Fill it with empty pixels
-
-			this->frames.emplace_back(frame);
-		};
-
-		void createFrame(const std::vector<uint8_t>& frame) { this->frames.push_back({0.F, frame}); };
-		[[nodiscard]] std::vector<uint8_t>& pixels() { return this->frames.begin()->pixels; }
-		[[nodiscard]] const std::vector<uint8_t>& pixels() const { return this->frames.begin()->pixels; }
-
-		void clearFrames() { this->frames.clear(); }
-
-		[[nodiscard]] bool valid() const { return channels != 0U && size > 0; }
-		[[nodiscard]] bool empty() const { return this->frames.empty(); }
-
-		[[nodiscard]] size_t total() const { return this->frames.size(); }
-		[[nodiscard]] bool transparent() const {
-			if (channels != 4U || this->frames.empty()) return false;
-
-			for (const auto& frame : this->frames) {
-				for (size_t o = 0; o < frame.pixels.size(); o += channels) {
-					if (frame.pixels[o + 3] == 1.F) continue;
-					return true;
-				}
-			}
-
-			return false;
-		}
-	};
-
 	class TextureBase {
 	protected:
 		Diligent::RefCntAutoPtr<Diligent::ITextureView> _handle;
@@ -80,6 +39,20 @@ namespace rawrbox {
 		bool _transparent = false;
 		bool _sRGB = false;
 		bool _registered = false;
+		bool _mipmaps = true;     // Only static pixel textures get mips
+		bool _gpuMipmaps = false; // Let the GPU build the chain instead, if the format supports it
+
+		// COMPRESSION ------
+		rawrbox::TEXTURE_COMPRESSION _compression = rawrbox::TEXTURE_COMPRESSION::NONE; // Encode on upload
+		std::filesystem::path _compressionCache = "";                                      // KTX2 file with the encoded data, optional
+		// -------------
+
+		// STREAMING ------
+		Diligent::TextureDesc _desc = {}; // Full chain, streamed textures only hold part of it
+		bool _streaming = false;
+		uint64_t _streamID = 0;
+		uint32_t _residentMip = 0;
+		// -------------
 
 		// LOGGER ------
 		std::unique_ptr<rawrbox::Logger> _logger = std::make_unique<rawrbox::Logger>("RawrBox-Texture");
@@ -90,6 +63,8 @@ namespace rawrbox {
 		virtual void updateSampler();
 
 		virtual void tryGetFormatChannels(Diligent::TEXTURE_FORMAT& format, uint8_t& channels);
+		[[nodiscard]] virtual uint32_t getMipLevels(Diligent::TEXTURE_FORMAT format, bool dynamic) const;
+		virtual void compress();
 
 	public:
 		TextureBase() = default;
@@ -133,6 +108,25 @@ namespace rawrbox {
 
 		virtual void setSRGB(bool set);
 
+		virtual void setMipmaps(bool enabled, bool gpu = false);
+		[[nodiscard]] virtual bool hasMipmaps() const;
+
+		// Block compresses the texture on upload (4-8x less VRAM), the result is stored on the cache path if set
+		// Sizes must be a multiple of 4, the cache is rebuilt if it does not match the format / size
+		virtual void setCompression(rawrbox::TEXTURE_COMPRESSION format, const std::filesystem::path& cachePath = "");
+		[[nodiscard]] virtual rawrbox::TEXTURE_COMPRESSION getCompression() const;
+
+		// Only the small mips are uploaded at first, the rest are streamed in when requested (see TextureStreamer)
+		virtual void setStreaming(bool enabled);
+		[[nodiscard]] virtual bool isStreaming() const;
+
+		[[nodiscard]] virtual uint64_t getStreamID() const;
+		virtual void setStreamID(uint64_t id);
+
+		[[nodiscard]] virtual uint32_t getResidentMip() const;
+		[[nodiscard]] virtual Diligent::RefCntAutoPtr<Diligent::ITexture> createTexture(uint32_t firstMip) const; // Thread safe, from the CPU copy
+		virtual void setResident(uint32_t firstMip, Diligent::RefCntAutoPtr<Diligent::ITexture> texture);
+
 		virtual void setSlice(uint32_t id);
 		[[nodiscard]] virtual uint32_t getSlice() const;
 		// -----
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <rawrbox/math/vector2.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace rawrbox {
+	// Block compression of the stored pixels
+	enum class TEXTURE_COMPRESSION {
+		NONE = 0,
+		BC1, // RGB + 1 bit alpha, 4 bits per texel
+		BC3, // RGBA, 8 bits per texel
+		BC4, // R, 4 bits per texel
+		BC5, // RG, 8 bits per texel
+		BC7  // RGBA, 8 bits per texel, best quality
+	};
+
+	struct ImageFrame {
+		float delay = 0.F; // User for animation
+		std::vector<uint8_t> pixels = {};
+
+		std::vector<std::vector<uint8_t>> mips = {}; // Level 1 and up, level 0 is pixels
+	};
+
+	struct ImageData {
+		rawrbox::Vector2u size = {};
+		uint8_t channels = 0U; // Decoded channels, also on compressed data
+
+		rawrbox::TEXTURE_COMPRESSION compression = rawrbox::TEXTURE_COMPRESSION::NONE; // Pixels & mips hold blocks if set
+		bool sRGB = false;                                                             // Set by containers that store it (ktx2 / dds)
+
+		std::vector<rawrbox::ImageFrame> frames = {};
+
+		void createFrame() {
+			rawrbox::ImageFrame frame = {};
+			frame.pixels.resize(this->size.x * this->size.y * this->channels);
+			std::memset(frame.pixels.data(), 0, frame.pixels.size()); // Fill it with empty pixels
+
+			this->frames.emplace_back(frame);
+		};
+
+		void createFrame(const std::vector<uint8_t>& frame) { this->frames.push_back({0.F, frame}); };
+		[[nodiscard]] std::vector<uint8_t>& pixels() { return this->frames.begin()->pixels; }
+		[[nodiscard]] const std::vector<uint8_t>& pixels() const { return this->frames.begin()->pixels; }
+
+		void clearFrames() { this->frames.clear(); }
+
+		// MIPS ---
+		// Levels stored on every frame, including the base level
+		[[nodiscard]] uint32_t mipLevels() const {
+			if (this->frames.empty()) return 1U;
+
+			size_t levels = this->frames.front().mips.size();
+			for (const auto& frame : this->frames) {
+				levels = std::min(levels, frame.mips.size());
+			}
+
+			return static_cast<uint32_t>(levels) + 1U;
+		}
+
+		void clearMips() {
+			for (auto& frame : this->frames) {
+				frame.mips.clear();
+			}
+		}
+		// ---------
+
+		[[nodiscard]] bool isCompressed() const { return this->compression != rawrbox::TEXTURE_COMPRESSION::NONE; }
+
+		[[nodiscard]] bool valid() const { return channels != 0U && size > 0; }
+		[[nodiscard]] bool empty() const { return this->frames.empty(); }
+
+		[[nodiscard]] size_t total() const { return this->frames.size(); }
+		[[nodiscard]] bool transparent() const {
+			if (channels != 4U || this->frames.empty()) return false;
+			if (this->isCompressed()) return this->transparentBlocks();
+
+			for (const auto& frame : this->frames) {
+				for (size_t o = 0; o < frame.pixels.size(); o += channels) {
+					if (frame.pixels[o + 3] == 1.F) continue;
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+	protected:
+		// BC3 alpha block, same layout as BC4
+		[[nodiscard]] static bool transparentBC3(const uint8_t* block) {
+			uint8_t a0 = block[0];
+			uint8_t a1 = block[1];
+
+			uint64_t indices = 0;
+			for (size_t i = 0; i < 6; i++) {
+				indices |= static_cast<uint64_t>(block[2 + i]) << (i * 8);
+			}
+
+			for (size_t i = 0; i < 16; i++) {
+				auto code = static_cast<uint8_t>((indices >> (i * 3)) & 7U);
+
+				bool opaque = false;
+				if (code == 0) {
+					opaque = a0 == 255;
+				} else if (code == 1) {
+					opaque = a1 == 255;
+				} else if (a0 <= a1) {
+					opaque = code == 7 || (code != 6 && a0 == 255); // 6 = 0, 7 = 255, rest interpolates the endpoints
+				}
+
+				if (!opaque) return true;
+			}
+
+			return false;
+		}
+
+		// Mode 6 stores both alpha endpoints at bits 49-62 with the p-bits at 63-64, other alpha modes aren't written by us
+		[[nodiscard]] static bool transparentBC7(const uint8_t* block) {
+			auto bits = [block](uint32_t offset, uint32_t count) {
+				uint32_t value = 0;
+				for (uint32_t i = 0; i < count; i++) {
+					uint32_t bit = offset + i;
+					value |= static_cast<uint32_t>((block[bit / 8] >> (bit % 8)) & 1U) << i;
+				}
+
+				return value;
+			};
+
+			uint32_t mode = 0;
+			while (mode < 8 && (block[0] & (1U << mode)) == 0) mode++;
+
+			if (mode < 4) return false; // No alpha
+			if (mode != 6) return true; // Can't tell without decoding
+
+			uint32_t e0 = (bits(49, 7) << 1) | bits(63, 1);
+			uint32_t e1 = (bits(56, 7) << 1) | bits(64, 1);
+			return e0 != 255 || e1 != 255;
+		}
+
+		[[nodiscard]] bool transparentBlocks() const {
+			size_t blockBytes = 0;
+			bool (*check)(const uint8_t*) = nullptr;
+
+			switch (this->compression) {
+				case rawrbox::TEXTURE_COMPRESSION::BC3:
+					blockBytes = 16;
+					check = &ImageData::transparentBC3;
+					break;
+				case rawrbox::TEXTURE_COMPRESSION::BC7:
+					blockBytes = 16;
+					check = &ImageData::transparentBC7;
+					break;
+				default:
+					return false; // BC1 punch-through is treated as opaque, BC4 / BC5 have no alpha
+			}
+
+			for (const auto& frame : this->frames) {
+				for (size_t o = 0; o + blockBytes <= frame.pixels.size(); o += blockBytes) {
+					if (check(frame.pixels.data() + o)) return true;
+				}
+			}
+
+			return false;
+		}
+	};
+} // namespace rawrbox
@@ -1,47 +1,42 @@
 #pragma once
 
 #include <rawrbox/render/textures/base.hpp>
+#include <rawrbox/render/textures/utils/packer.hpp>
+#include <rawrbox/render/utils/dirty_rects.hpp>
 
 #include <optional>
 
 namespace rawrbox {
-	struct PackNode {
-		uint32_t x = 0;
-		uint32_t y = 0;
-		uint32_t width = 0;
-		uint32_t height = 0;
-
-		std::vector<uint8_t> data = {};
-
-		std::unique_ptr<PackNode> left = nullptr;
-		std::unique_ptr<PackNode> right = nullptr;
-
-		bool canInsertNode(uint32_t insertedWidth, uint32_t insertedHeight);
-		std::optional<std::reference_wrapper<rawrbox::PackNode>> InsertNode(uint32_t width, uint32_t height);
-
-		PackNode() = default;
-		PackNode(uint32_t _x, uint32_t _y, uint32_t _w, uint32_t _h) : x(_x), y(_y), width(_w), height(_h){};
-	};
-
 	class TexturePack : public rawrbox::TextureBase {
 	private:
-		size_t _spriteCount = 0;
-		std::unique_ptr<rawrbox::PackNode> _root = nullptr;
-		bool _pendingUpdate = false;
+		rawrbox::AtlasPacker _packer;
+		rawrbox::DirtyRects _dirty = {}; // Only these get uploaded
+
+		void clearSprite(const rawrbox::AtlasRect& rect);
 
 	public:
-		explicit TexturePack(uint32_t size = 1024U);
+		explicit TexturePack(uint32_t size = 1024U, uint32_t padding = 0U, uint8_t channels = 4U);
 
 		TexturePack(const TexturePack&) = delete;
 		TexturePack(TexturePack&&) = delete;
 		TexturePack& operator=(const TexturePack&) = delete;
 		TexturePack& operator=(TexturePack&&) = delete;
-		~TexturePack() override;
+		~TexturePack() override = default;
 
 		[[nodiscard]] size_t getSpriteCount() const;
+		[[nodiscard]] float getOccupancy() const;
 
 		bool canInsertNode(uint32_t width, uint32_t height);
-		rawrbox::PackNode& addSprite(uint32_t width, uint32_t height, const std::vector<uint8_t>& data);
+		// Data has the pack's channels, 1 channel packs are R8
+		rawrbox::AtlasRect addSprite(uint32_t width, uint32_t height, const std::vector<uint8_t>& data);
+		void removeSprite(uint64_t id);
+
+		// Marks the sprite as used this frame, evictions take the least recently used first
+		void touchSprite(uint64_t id);
+		std::vector<rawrbox::AtlasRect> evictSprites(uint32_t width, uint32_t height);
+
+		// Compacts the atlas, pixels are moved too. Anything holding a rect / uvs must apply the relocations
+		std::vector<rawrbox::AtlasRelocation> defragment();
 
 		void upload(Diligent::TEXTURE_FORMAT format = Diligent::TEXTURE_FORMAT::TEX_FORMAT_UNKNOWN, bool dynamic = false) override;
 
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <rawrbox/render/textures/base.hpp>
+#include <rawrbox/render/textures/utils/residency.hpp>
+#include <rawrbox/utils/logger.hpp>
+
+#include <RefCntAutoPtr.hpp>
+
+#include <Texture.h>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace rawrbox {
+	struct MeshTextures;
+
+	struct StreamedTexture {
+		rawrbox::ResidencyChange change = {};
+		Diligent::RefCntAutoPtr<Diligent::ITexture> texture; // Null if it failed to build
+	};
+
+	// Keeps streamed textures under a VRAM budget, high mips are created on the worker pool and swapped in on the render thread
+	class TextureStreamer {
+	protected:
+		struct StreamEntry {
+			rawrbox::TextureBase* texture = nullptr;
+			uint32_t building = 0; // Workers reading it, remove waits for them
+		};
+
+		static rawrbox::TextureResidency _residency;
+		static std::unordered_map<uint64_t, StreamEntry> _textures;
+		static std::vector<rawrbox::StreamedTexture> _completed;
+
+		static std::mutex _lock; // Residency & textures, never held while building
+		static std::condition_variable _built;
+		static uint64_t _nextID;
+
+		// LOGGER ------
+		static std::unique_ptr<rawrbox::Logger> _logger;
+		// -------------
+
+	public:
+		// Returns the first level to upload
+		static uint32_t add(rawrbox::TextureBase& texture, uint32_t levels);
+		static void remove(rawrbox::TextureBase& texture);
+
+		// Applies finished levels and starts new ones, render thread only
+		static void update();
+		static void shutdown();
+
+		// FEEDBACK ---
+		static void request(const rawrbox::TextureBase* texture, float screenPixels);
+		static void request(const rawrbox::MeshTextures& textures, float screenPixels);
+
+		// Rough size in pixels of something worldSize wide at distance, on the main camera
+		[[nodiscard]] static float getScreenSize(float worldSize, float distance);
+		// ----------
+
+		// UTILS ---
+		static void setBudget(size_t bytes);
+		[[nodiscard]] static size_t getBudget();
+		[[nodiscard]] static size_t getUsed();
+
+		static void setUploadLimit(size_t bytes);
+		[[nodiscard]] static bool isActive();
+		// ----------
+	};
+} // namespace rawrbox
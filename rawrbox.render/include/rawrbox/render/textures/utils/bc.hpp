@@ -0,0 +1,44 @@
+#pragma once
+
+#include <rawrbox/math/vector2.hpp>
+#include <rawrbox/render/textures/data.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace rawrbox {
+	using BCBlock = std::array<uint8_t, 64>; // 4x4 RGBA texels
+
+	// CPU block compression, used to shrink textures at load time (or offline, through the ktx2 cache)
+	class BC {
+	public:
+		// BLOCKS ---
+		static void encodeBC1(const rawrbox::BCBlock& block, uint8_t* out, bool alpha = false); // alpha = use the 1 bit transparent mode if needed
+		static void encodeBC4(const rawrbox::BCBlock& block, uint8_t* out, uint8_t channel = 0);
+		static void encodeBC7(const rawrbox::BCBlock& block, uint8_t* out); // Mode 6 only
+
+		static void decodeBC1(const uint8_t* in, rawrbox::BCBlock& block, bool alpha = true);
+		static void decodeBC4(const uint8_t* in, rawrbox::BCBlock& block, uint8_t channel = 0);
+		static bool decodeBC7(const uint8_t* in, rawrbox::BCBlock& block); // Mode 6 only, false on other modes
+		// ----------
+
+		// UTILS ---
+		[[nodiscard]] static uint32_t getBlockBytes(rawrbox::TEXTURE_COMPRESSION format);
+		[[nodiscard]] static uint8_t getChannels(rawrbox::TEXTURE_COMPRESSION format);
+
+		[[nodiscard]] static uint32_t getRowBytes(rawrbox::TEXTURE_COMPRESSION format, uint32_t width);
+		[[nodiscard]] static size_t getLevelBytes(rawrbox::TEXTURE_COMPRESSION format, const rawrbox::Vector2u& size);
+		// ----------
+
+		// Single level ---
+		static std::vector<uint8_t> encode(rawrbox::TEXTURE_COMPRESSION format, const rawrbox::Vector2u& size, const std::vector<uint8_t>& pixels, uint8_t channels);
+		static std::vector<uint8_t> decode(rawrbox::TEXTURE_COMPRESSION format, const rawrbox::Vector2u& size, const std::vector<uint8_t>& blocks); // getChannels(format) per texel
+		// ----------
+
+		// Every frame & mip ---
+		static rawrbox::ImageData encode(const rawrbox::ImageData& data, rawrbox::TEXTURE_COMPRESSION format);
+		static rawrbox::ImageData decode(const rawrbox::ImageData& data);
+		// ----------
+	};
+} // namespace rawrbox
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace rawrbox {
+	struct ImageData;
+	class DDS {
+	public:
+		// DXT1 / DXT5 / ATI1 / ATI2, DX10 BC1 / BC3 / BC4 / BC5 / BC7 and 32 / 8 bit uncompressed, every array slice / face becomes a frame
+		static rawrbox::ImageData decode(const uint8_t* buffer, size_t bufferSize);
+		static rawrbox::ImageData decode(const std::vector<uint8_t>& data);
+	};
+} // namespace rawrbox
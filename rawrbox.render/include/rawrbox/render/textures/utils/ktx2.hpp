@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace rawrbox {
+	struct ImageData;
+	class KTX2 {
+	public:
+		// Raw (R8 / RG8 / RGBA8) and BC payloads, every layer / face becomes a frame
+		// Basis Universal and zstd supercompressed files are rejected, they need a transcoder
+		static rawrbox::ImageData decode(const uint8_t* buffer, size_t bufferSize);
+		static rawrbox::ImageData decode(const std::vector<uint8_t>& data);
+
+		static std::vector<uint8_t> encode(const rawrbox::ImageData& data, const std::map<std::string, std::string>& keyValues = {});
+
+		// Key / value data, empty if the file has none
+		static std::map<std::string, std::string> getKeyValues(const uint8_t* buffer, size_t bufferSize);
+		static std::map<std::string, std::string> getKeyValues(const std::vector<uint8_t>& data);
+	};
+} // namespace rawrbox
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <rawrbox/math/vector2.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace rawrbox {
+	struct ImageData;
+	class MipUtils {
+	public:
+		// Levels of a full chain, down to 1x1
+		static uint32_t getLevels(const rawrbox::Vector2u& size);
+		static rawrbox::Vector2u getSize(const rawrbox::Vector2u& size, uint32_t level);
+
+		// Halves the image with a 2x2 box filter, on sRGB the color channels are averaged in linear space (alpha is always linear)
+		static std::vector<uint8_t> downsample(const rawrbox::Vector2u& size, const std::vector<uint8_t>& pixels, uint8_t channels, bool sRGB = false);
+
+		// Fills the mips of every frame, 0 levels = full chain. Levels already stored (ex: cached) are kept
+		static void generate(rawrbox::ImageData& data, bool sRGB = false, uint32_t levels = 0);
+	};
+} // namespace rawrbox
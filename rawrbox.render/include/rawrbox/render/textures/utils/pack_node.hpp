@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+
+namespace rawrbox {
+	// Recursive guillotine tree, insert only. Fine for static packing, dynamic atlases use AtlasPacker
+	struct PackNode {
+		uint32_t x = 0;
+		uint32_t y = 0;
+		uint32_t width = 0;
+		uint32_t height = 0;
+
+		bool used = false; // Pixels live on the pack frame only
+
+		std::unique_ptr<PackNode> left = nullptr;
+		std::unique_ptr<PackNode> right = nullptr;
+
+		bool canInsertNode(uint32_t insertedWidth, uint32_t insertedHeight);
+		std::optional<std::reference_wrapper<rawrbox::PackNode>> InsertNode(uint32_t width, uint32_t height);
+
+		PackNode() = default;
+		PackNode(uint32_t _x, uint32_t _y, uint32_t _w, uint32_t _h) : x(_x), y(_y), width(_w), height(_h){};
+	};
+
+} // namespace rawrbox
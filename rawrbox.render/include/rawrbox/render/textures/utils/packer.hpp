@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <optional>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace rawrbox {
+	struct AtlasRect {
+		uint64_t id = 0;
+		uint32_t page = 0;
+
+		uint32_t x = 0;
+		uint32_t y = 0;
+		uint32_t width = 0;
+		uint32_t height = 0;
+	};
+
+	struct AtlasRelocation {
+		uint64_t id = 0;
+		rawrbox::AtlasRect from = {};
+		rawrbox::AtlasRect to = {};
+	};
+
+	// Online rect packer, free space is kept as disjoint rects (guillotine splits)
+	// Best fit is O(log size + log n): a max segment tree over one side finds the smallest bucket where the other side fits, then a lower_bound inside it
+	// Removed sprites give their space back and merge with free neighbours, found through corner lookups instead of a scan
+	class AtlasPacker {
+	protected:
+		using FreeRect = std::tuple<uint32_t, uint32_t, uint32_t, uint32_t>; // height, width, x, y
+
+		// Free rects bucketed by one side, queried by both
+		struct FreeAxis {
+			std::vector<uint32_t> tree = {}; // Largest other side per range of sides
+			std::map<uint32_t, std::set<std::tuple<uint32_t, uint32_t, uint32_t>>> buckets = {}; // side -> other, x, y
+			uint32_t leaves = 0;
+
+			explicit FreeAxis(uint32_t extent = 0);
+
+			void insert(uint32_t side, uint32_t other, uint32_t x, uint32_t y);
+			void erase(uint32_t side, uint32_t other, uint32_t x, uint32_t y);
+
+			// Smallest side >= side, then the smallest other >= other in it
+			[[nodiscard]] std::optional<std::tuple<uint32_t, uint32_t, uint32_t, uint32_t>> find(uint32_t side, uint32_t other) const;
+
+		private:
+			void refresh(uint32_t side);
+			[[nodiscard]] std::optional<uint32_t> first(size_t node, uint32_t lo, uint32_t hi, uint32_t side, uint32_t other) const;
+		};
+
+		struct FreeList {
+			FreeAxis byHeight;
+			FreeAxis byWidth;
+
+			// Corner -> rect, free rects are disjoint so each corner is unique
+			std::unordered_map<uint64_t, FreeRect> topLeft = {};
+			std::unordered_map<uint64_t, FreeRect> topRight = {};
+			std::unordered_map<uint64_t, FreeRect> bottomLeft = {};
+		};
+
+		struct Sprite {
+			rawrbox::AtlasRect rect = {};
+			std::list<uint64_t>::iterator lru = {};
+		};
+
+		uint32_t _size = 0;
+		uint32_t _maxPages = 1;
+		uint32_t _padding = 0; // Empty texels between sprites, avoids bleeding when filtering
+
+		std::vector<FreeList> _free = {}; // Per page
+		std::unordered_map<uint64_t, Sprite> _sprites = {};
+		std::list<uint64_t> _lru = {}; // Least recently used first
+
+		uint64_t _nextID = 1;
+		uint64_t _usedArea = 0;
+
+		[[nodiscard]] std::optional<FreeRect> find(uint32_t page, uint32_t width, uint32_t height) const;
+		void place(uint32_t page, const FreeRect& free, uint32_t width, uint32_t height);
+		void release(uint32_t page, FreeRect rect);
+		[[nodiscard]] std::optional<FreeRect> neighbour(uint32_t page, const FreeRect& rect) const;
+
+		void addFree(uint32_t page, const FreeRect& rect);
+		void eraseFree(uint32_t page, FreeRect rect);
+
+		void addPage();
+
+	public:
+		explicit AtlasPacker(uint32_t size = 1024U, uint32_t maxPages = 1U, uint32_t padding = 0U);
+
+		// Returns nothing if it doesn't fit on any page, even after adding pages
+		std::optional<rawrbox::AtlasRect> insert(uint32_t width, uint32_t height);
+		bool remove(uint64_t id);
+
+		// Marks the sprite as used, so it's evicted last
+		void touch(uint64_t id);
+		// Removes the least recently used sprites until width x height fits, returns what was removed
+		std::vector<rawrbox::AtlasRect> evict(uint32_t width, uint32_t height);
+
+		// Repacks every sprite (tallest first), returns the ones that moved. Nothing moves if the repack can't fit
+		std::vector<rawrbox::AtlasRelocation> defragment();
+
+		// UTILS ---
+		[[nodiscard]] bool canInsert(uint32_t width, uint32_t height) const;
+		[[nodiscard]] std::optional<rawrbox::AtlasRect> get(uint64_t id) const;
+
+		[[nodiscard]] uint32_t getSize() const;
+		[[nodiscard]] uint32_t getPages() const;
+		[[nodiscard]] size_t getSpriteCount() const;
+		[[nodiscard]] size_t getFreeRects() const;
+
+		[[nodiscard]] float getOccupancy() const; // Sprite area / pages area
+		// ---------
+	};
+} // namespace rawrbox
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <rawrbox/math/vector2.hpp>
+#include <rawrbox/render/textures/data.hpp>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace rawrbox {
+	struct ResidencyChange {
+		uint64_t id = 0;
+		uint32_t from = 0; // Finest resident level before the change
+		uint32_t to = 0;   // Finest resident level after it, lower = more detail
+
+		[[nodiscard]] bool isLoad() const { return this->to < this->from; }
+	};
+
+	struct ResidencyEntry {
+		std::vector<size_t> levelBytes = {}; // Every slice included
+
+		uint32_t tail = 0;      // Coarsest levels, always resident
+		uint32_t resident = 0;  // Finest resident level
+		uint32_t requested = 0; // Finest level requested on the last used frame
+
+		uint64_t lastUsed = 0;
+		bool pending = false; // Change handed out, but not applied yet
+	};
+
+	// Decides which mips of each texture live on the GPU, under a memory budget. Pure CPU, the streamer applies the changes
+	class TextureResidency {
+	protected:
+		std::unordered_map<uint64_t, rawrbox::ResidencyEntry> _entries = {};
+
+		size_t _budget = 0;
+		size_t _used = 0;
+		size_t _uploadLimit = 0; // Bytes loaded per update, 0 = no limit
+
+		uint32_t _tailSize = 64; // Levels this size or smaller are never evicted
+		uint64_t _frame = 1;
+
+		[[nodiscard]] static size_t getBytes(const rawrbox::ResidencyEntry& entry, uint32_t from, uint32_t to); // Levels [from, to)
+
+		// Frees memory from the least recently used textures, nothing is touched if it can't free enough
+		bool evict(size_t bytes, uint64_t skip, std::vector<rawrbox::ResidencyChange>& changes);
+
+	public:
+		explicit TextureResidency(size_t budget = 512ULL * 1024ULL * 1024ULL);
+
+		// Returns the first resident level (the tail), loaded right away
+		uint32_t add(uint64_t id, const rawrbox::Vector2u& size, const std::vector<size_t>& levelBytes);
+		void remove(uint64_t id);
+
+		// Finest level needed this frame, several requests keep the finest
+		void request(uint64_t id, uint32_t level);
+		// Marks the last change of the texture as applied
+		void complete(uint64_t id);
+		// The change could not be applied, goes back to the old level so it can be asked again
+		void fail(const rawrbox::ResidencyChange& change);
+
+		// Hands out the level changes for this frame, then starts a new one
+		std::vector<rawrbox::ResidencyChange> update();
+
+		// UTILS ---
+		void setBudget(size_t budget);
+		[[nodiscard]] size_t getBudget() const;
+		[[nodiscard]] size_t getUsed() const;
+
+		void setUploadLimit(size_t bytes);
+		void setTailSize(uint32_t size);
+
+		[[nodiscard]] bool has(uint64_t id) const;
+		[[nodiscard]] uint32_t getResident(uint64_t id) const;
+		[[nodiscard]] size_t size() const;
+
+		// Level that gives about one texel per pixel when the texture covers screenPixels
+		[[nodiscard]] static uint32_t estimateLevel(const rawrbox::Vector2u& textureSize, float screenPixels);
+		[[nodiscard]] static std::vector<size_t> getLevelBytes(const rawrbox::ImageData& data, uint32_t levels);
+		// ---------
+	};
+} // namespace rawrbox
@@ -15,6 +15,8 @@ namespace rawrbox {
 		IMAGE_BMP,     // Microsoft bitmap format
 		IMAGE_WEBP,    // Google WebP format, a type of .riff file
 		IMAGE_TGA,     // Truevision Targa image
+		IMAGE_KTX2,    // Khronos texture container, can hold block compressed data
+		IMAGE_DDS,     // DirectDraw surface, can hold block compressed data
 		IMAGE_INVALID, // unidentified image types.
 	};
 
@@ -29,6 +31,7 @@ namespace rawrbox {
 
 		static std::vector<uint8_t> resize(const rawrbox::Vector2u& originalSize, const std::vector<uint8_t>& data, const rawrbox::Vector2u& newSize, uint8_t channels = 4);
 
+		static rawrbox::ImageType getImageType(const uint8_t* data, size_t size);
 		static rawrbox::ImageType getImageType(const std::vector<uint8_t>& data);
 		static rawrbox::ImageData decodeImage(const std::vector<uint8_t>& data);
 	};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace rawrbox {
+	// Sorted set of [start, end) element ranges that need uploading, overlapping / touching ranges are merged on insert
+	class DirtyRanges {
+	protected:
+		std::vector<std::pair<uint64_t, uint64_t>> _ranges = {};
+
+	public:
+		// Marks [start, start + count) as dirty
+		virtual void mark(uint64_t start, uint64_t count = 1);
+		virtual void clear();
+
+		// Merges ranges separated by `gap` elements or less, fewer but bigger uploads
+		virtual void coalesce(uint64_t gap);
+
+		// Drops anything past `size` (ex: the buffer shrunk)
+		virtual void clamp(uint64_t size);
+
+		// UTILS ---
+		[[nodiscard]] virtual const std::vector<std::pair<uint64_t, uint64_t>>& getRanges() const;
+		[[nodiscard]] virtual std::pair<uint64_t, uint64_t> getBounds() const; // Single range covering all the dirty ranges
+		[[nodiscard]] virtual uint64_t getCoverage() const;                   // Total dirty elements
+
+		[[nodiscard]] virtual bool empty() const;
+		[[nodiscard]] virtual size_t size() const;
+		// ------
+
+		DirtyRanges() = default;
+		DirtyRanges(const DirtyRanges&) = default;
+		DirtyRanges(DirtyRanges&&) = default;
+		DirtyRanges& operator=(const DirtyRanges&) = default;
+		DirtyRanges& operator=(DirtyRanges&&) = default;
+		virtual ~DirtyRanges() = default;
+	};
+} // namespace rawrbox
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace rawrbox {
+	struct DirtyRect {
+		uint32_t minX = 0;
+		uint32_t minY = 0;
+		uint32_t maxX = 0; // Exclusive
+		uint32_t maxY = 0; // Exclusive
+
+		[[nodiscard]] uint64_t area() const { return static_cast<uint64_t>(this->maxX - this->minX) * (this->maxY - this->minY); }
+		[[nodiscard]] DirtyRect merge(const DirtyRect& other) const;
+
+		bool operator==(const DirtyRect& other) const { return this->minX == other.minX && this->minY == other.minY && this->maxX == other.maxX && this->maxY == other.maxY; }
+		bool operator!=(const DirtyRect& other) const { return !operator==(other); }
+	};
+
+	// 2D version of DirtyRanges, regions of a texture that need uploading
+	// Rects are merged when the merged rect wastes little space (neighbours, overlaps, contained rects)
+	class DirtyRects {
+	protected:
+		std::vector<rawrbox::DirtyRect> _rects = {};
+
+		float _waste = 1.25F;  // Merge if the union is at most this times the sum of both areas
+		size_t _maxRects = 16; // Past this, everything collapses into the bounds
+
+	public:
+		// Marks [x, x + width) x [y, y + height) as dirty
+		virtual void mark(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+		virtual void clear();
+
+		virtual void setWaste(float waste);
+		virtual void setMaxRects(size_t max);
+
+		// UTILS ---
+		[[nodiscard]] virtual const std::vector<rawrbox::DirtyRect>& getRects() const;
+		[[nodiscard]] virtual rawrbox::DirtyRect getBounds() const; // Single rect covering every dirty rect
+		[[nodiscard]] virtual uint64_t getCoverage() const;         // Total dirty texels, uploads included
+
+		[[nodiscard]] virtual bool empty() const;
+		[[nodiscard]] virtual size_t size() const;
+		// ------
+
+		DirtyRects() = default;
+		DirtyRects(const DirtyRects&) = default;
+		DirtyRects(DirtyRects&&) = default;
+		DirtyRects& operator=(const DirtyRects&) = default;
+		DirtyRects& operator=(DirtyRects&&) = default;
+		virtual ~DirtyRects() = default;
+	};
+} // namespace rawrbox
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace rawrbox {
+	// Slice of a DrawArena, indices are local to vertexStart
+	struct DrawRange {
+		uint32_t vertexStart = 0;
+		uint32_t vertexCount = 0;
+
+		uint32_t indexStart = 0;
+		uint32_t indexCount = 0;
+
+		uint32_t instanceStart = 0;
+		uint32_t instanceCount = 0;
+
+		[[nodiscard]] bool empty() const { return this->indexCount == 0 && this->instanceCount == 0; }
+	};
+
+	// Per-frame vertex / index / instance storage. Draws are ranges into it, clear() keeps the memory for the next frame
+	template <typename V, typename I>
+	class DrawArena {
+	protected:
+		std::vector<V> _vertices = {};
+		std::vector<uint32_t> _indices = {};
+		std::vector<I> _instances = {};
+
+		template <typename T>
+		static void grow(std::vector<T>& vec, size_t extra) {
+			auto needed = vec.size() + extra;
+			if (needed > vec.capacity()) vec.reserve(std::max(needed, vec.capacity() * 2));
+		}
+
+	public:
+		// Opens an empty range at the end of the arena
+		[[nodiscard]] rawrbox::DrawRange begin() const {
+			rawrbox::DrawRange range = {};
+			range.vertexStart = static_cast<uint32_t>(this->_vertices.size());
+			range.indexStart = static_cast<uint32_t>(this->_indices.size());
+			range.instanceStart = static_cast<uint32_t>(this->_instances.size());
+
+			return range;
+		}
+
+		// Grows the range over everything pushed since begin()
+		void end(rawrbox::DrawRange& range) const {
+			range.vertexCount = static_cast<uint32_t>(this->_vertices.size()) - range.vertexStart;
+			range.indexCount = static_cast<uint32_t>(this->_indices.size()) - range.indexStart;
+			range.instanceCount = static_cast<uint32_t>(this->_instances.size()) - range.instanceStart;
+		}
+
+		// Appends `next` to `into`, next must start where into ends. Indices are rebased in place, nothing is copied
+		void merge(rawrbox::DrawRange& into, const rawrbox::DrawRange& next) {
+			auto base = next.vertexStart - into.vertexStart;
+			if (base != 0) {
+				for (uint32_t i = next.indexStart; i < next.indexStart + next.indexCount; i++) {
+					this->_indices[i] += base;
+				}
+			}
+
+			into.vertexCount += next.vertexCount;
+			into.indexCount += next.indexCount;
+			into.instanceCount += next.instanceCount;
+		}
+
+		// ADD ----
+		template <typename... Args>
+		V& pushVertex(Args&&... args) {
+			return this->_vertices.emplace_back(std::forward<Args>(args)...);
+		}
+
+		template <typename... Args>
+		I& pushInstance(Args&&... args) {
+			return this->_instances.emplace_back(std::forward<Args>(args)...);
+		}
+
+		void pushIndices(std::initializer_list<uint32_t> ind) {
+			this->_indices.insert(this->_indices.end(), ind);
+		}
+
+		template <typename It>
+		void pushIndices(It first, It last) {
+			this->_indices.insert(this->_indices.end(), first, last);
+		}
+
+		// Two triangles over the last 4 vertices (top-left, bottom-left, top-right, bottom-right)
+		void pushQuad(const rawrbox::DrawRange& range) {
+			auto base = static_cast<uint32_t>(this->_vertices.size()) - range.vertexStart - 4;
+			this->_indices.insert(this->_indices.end(), {base, base + 1, base + 2,
+									base + 1, base + 3, base + 2});
+		}
+		// --------
+
+		// Room for that many more, still grows geometrically so per-draw reserves stay cheap
+		void reserve(size_t vertices, size_t indices, size_t instances) {
+			grow(this->_vertices, vertices);
+			grow(this->_indices, indices);
+			grow(this->_instances, instances);
+		}
+
+		void clear() {
+			this->_vertices.clear();
+			this->_indices.clear();
+			this->_instances.clear();
+		}
+
+		[[nodiscard]] const std::vector<V>& getVertices() const { return this->_vertices; }
+		[[nodiscard]] const std::vector<uint32_t>& getIndices() const { return this->_indices; }
+		[[nodiscard]] const std::vector<I>& getInstances() const { return this->_instances; }
+	};
+} // namespace rawrbox
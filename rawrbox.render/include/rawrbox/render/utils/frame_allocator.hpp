@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+namespace rawrbox {
+	struct FrameAllocation {
+		uint64_t offset = 0;
+		bool discard = false; // The backing buffer must be discarded (renamed) before writing
+	};
+
+	struct FrameAllocatorStats {
+		uint64_t allocations = 0;
+		uint64_t bytes = 0;
+		uint64_t discards = 0;
+	};
+
+	// Linear allocator that resets every frame, the backing memory is expected to be renamed on discard (Diligent USAGE_DYNAMIC buffers)
+	class FrameAllocator {
+	protected:
+		uint64_t _capacity = 0;
+		uint64_t _alignment = 1;
+		uint64_t _head = 0;
+
+		uint64_t _frame = UINT64_MAX;
+		rawrbox::FrameAllocatorStats _stats = {};
+
+	public:
+		FrameAllocator(uint64_t capacity, uint64_t alignment);
+
+		[[nodiscard]] rawrbox::FrameAllocation allocate(uint64_t size, uint64_t frame);
+		void reset();
+
+		[[nodiscard]] uint64_t align(uint64_t size) const;
+		[[nodiscard]] uint64_t getCapacity() const;
+		[[nodiscard]] uint64_t getUsed() const;
+		[[nodiscard]] const rawrbox::FrameAllocatorStats& getStats() const; // Current frame
+	};
+} // namespace rawrbox
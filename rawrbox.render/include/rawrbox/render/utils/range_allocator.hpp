@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+
+namespace rawrbox {
+	struct RangeAllocatorStats {
+		uint64_t capacity = 0;
+		uint64_t used = 0;
+		uint64_t free = 0;
+		uint64_t largestFree = 0;
+
+		uint32_t allocations = 0;
+		uint32_t freeBlocks = 0;
+
+		float fragmentation = 0.F; // 0 = all free space is contiguous, close to 1 = free space is scattered in small holes
+	};
+
+	// Best-fit free-list allocator over an abstract range (units are up to the caller), freed blocks are coalesced
+	class RangeAllocator {
+	protected:
+		uint64_t _capacity = 0;
+		uint64_t _used = 0;
+
+		std::map<uint64_t, uint64_t> _freeByOffset = {};    // offset -> size
+		std::multimap<uint64_t, uint64_t> _freeBySize = {}; // size -> offset
+		std::unordered_map<uint64_t, uint64_t> _allocated = {};
+
+		void addFree(uint64_t offset, uint64_t size);
+		void removeFree(std::map<uint64_t, uint64_t>::iterator it);
+
+	public:
+		static constexpr uint64_t INVALID_OFFSET = UINT64_MAX;
+
+		explicit RangeAllocator(uint64_t capacity = 0);
+
+		// Returns INVALID_OFFSET if there is no free block big enough
+		[[nodiscard]] uint64_t allocate(uint64_t size);
+		void free(uint64_t offset);
+
+		void grow(uint64_t capacity);
+		void reset();
+
+		// UTILS ---
+		[[nodiscard]] bool isAllocated(uint64_t offset) const;
+		[[nodiscard]] uint64_t getSize(uint64_t offset) const;
+
+		[[nodiscard]] uint64_t getCapacity() const;
+		[[nodiscard]] uint64_t getUsed() const;
+		[[nodiscard]] uint64_t getFree() const;
+		[[nodiscard]] uint64_t getLargestFree() const;
+
+		[[nodiscard]] rawrbox::RangeAllocatorStats getStats() const;
+		// ------
+	};
+} // namespace rawrbox
@@ -122,7 +122,7 @@ namespace rawrbox {
 		    {Diligent::SHADER_TYPE_PIXEL, "Constants", 1, Diligent::SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, Diligent::SHADER_RESOURCE_VARIABLE_TYPE_STATIC},
 		    {Diligent::SHADER_TYPE_PIXEL, "g_Textures", RB_RENDER_MAX_TEXTURES, Diligent::SHADER_RESOURCE_TYPE_TEXTURE_SRV, Diligent::SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, Diligent::PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY},
 
-		    {Diligent::SHADER_TYPE_VERTEX | Diligent::SHADER_TYPE_PIXEL | Diligent::SHADER_TYPE_GEOMETRY, "Camera", 1, Diligent::SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, Diligent::SHADER_RESOURCE_VARIABLE_TYPE_STATIC, Diligent::PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS},
+		    {Diligent::SHADER_TYPE_VERTEX | Diligent::SHADER_TYPE_PIXEL | Diligent::SHADER_TYPE_GEOMETRY, "Camera", 1, Diligent::SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, Diligent::SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE}, // Transform ring, bound with dynamic offsets
 		    {Diligent::SHADER_TYPE_VERTEX | Diligent::SHADER_TYPE_PIXEL | Diligent::SHADER_TYPE_GEOMETRY, "SCamera", 1, Diligent::SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, Diligent::SHADER_RESOURCE_VARIABLE_TYPE_STATIC, Diligent::PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS}};
 
 		// Add extra signatures ----
@@ -157,10 +157,6 @@ namespace rawrbox {
 		signature->GetStaticVariableByName(Diligent::SHADER_TYPE_VERTEX, "Constants")->Set(signatureBufferVertex);
 		signature->GetStaticVariableByName(Diligent::SHADER_TYPE_VERTEX, "SkinnedConstants")->Set(signatureBufferVertexSkinned);
 
-		signature->GetStaticVariableByName(Diligent::SHADER_TYPE_VERTEX, "Camera")->Set(rawrbox::CameraBase::uniforms);
-		signature->GetStaticVariableByName(Diligent::SHADER_TYPE_PIXEL, "Camera")->Set(rawrbox::CameraBase::uniforms);
-		signature->GetStaticVariableByName(Diligent::SHADER_TYPE_GEOMETRY, "Camera")->Set(rawrbox::CameraBase::uniforms);
-
 		signature->GetStaticVariableByName(Diligent::SHADER_TYPE_VERTEX, "SCamera")->Set(rawrbox::CameraBase::staticUniforms);
 		signature->GetStaticVariableByName(Diligent::SHADER_TYPE_PIXEL, "SCamera")->Set(rawrbox::CameraBase::staticUniforms);
 		signature->GetStaticVariableByName(Diligent::SHADER_TYPE_GEOMETRY, "SCamera")->Set(rawrbox::CameraBase::staticUniforms);
@@ -183,6 +179,10 @@ namespace rawrbox {
 		}
 		// -------------------------
 
+		// Setup camera transforms, shared by every stage ---
+		signatureBind->GetVariableByName(Diligent::SHADER_TYPE_VERTEX, "Camera")->SetBufferRange(rawrbox::CameraBase::transformUniforms, 0, rawrbox::CameraBase::TRANSFORM_STRIDE);
+		// ----------------------
+
 		// Setup textures ---
 		signatureBind->GetVariableByName(Diligent::SHADER_TYPE_VERTEX, "g_Textures")->SetArray(_vertexTextureHandles.data(), 0, static_cast<uint32_t>(_vertexTextureHandles.size()), Diligent::SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE);
 		signatureBind->GetVariableByName(Diligent::SHADER_TYPE_PIXEL, "g_Textures")->SetArray(_textureHandles.data(), 0, static_cast<uint32_t>(_textureHandles.size()), Diligent::SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE);
@@ -281,6 +281,24 @@ namespace rawrbox {
 		_logger->debug("Un-registering bindless {} texture slot '{}'", isVertex ? "vertex" : "pixel", fmt::styled(std::to_string(id), fmt::fg(fmt::color::violet)));
 	}
 
+	void BindlessManager::updateTexture(rawrbox::TextureBase& texture) {
+		if (signature == nullptr || !texture.isRegistered()) return; // Registered with the new handle later on
+
+		const bool isVertex = texture.getType() == rawrbox::TEXTURE_TYPE::VERTEX;
+		auto& handler = isVertex ? _vertexTextureHandles : _textureHandles;
+
+		const auto id = texture.getTextureID();
+		if (id >= handler.size()) RAWRBOX_CRITICAL("Index '{}' not found!", id);
+
+		handler[id] = texture.getHandle();
+
+		if (isVertex) {
+			_updateVertexSignature = true;
+		} else {
+			_updatePixelSignature = true;
+		}
+	}
+
 	void BindlessManager::registerUpdateTexture(rawrbox::TextureBase& texture) {
 		if (!texture.requiresUpdate()) return;
 		_updateTextures.push_back(&texture);
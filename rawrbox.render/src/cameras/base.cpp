@@ -4,9 +4,22 @@
 #include <rawrbox/render/plugins/clustered.hpp>
 #include <rawrbox/render/static.hpp>
 
+#include <cstring>
+
 namespace rawrbox {
 	Diligent::RefCntAutoPtr<Diligent::IBuffer> CameraBase::staticUniforms;
 	Diligent::RefCntAutoPtr<Diligent::IBuffer> CameraBase::uniforms;
+	Diligent::RefCntAutoPtr<Diligent::IBuffer> CameraBase::transformUniforms;
+
+	// PRIVATE ---
+	std::unique_ptr<rawrbox::FrameAllocator> CameraBase::_transformAllocator = nullptr;
+	Diligent::IShaderResourceVariable* CameraBase::_transformVariable = nullptr;
+
+	uint64_t CameraBase::_transformEpoch = 0;
+	uint64_t CameraBase::_boundEpoch = UINT64_MAX;
+	const rawrbox::CameraBase* CameraBase::_boundCamera = nullptr;
+	rawrbox::Matrix4x4 CameraBase::_boundTransform = {};
+	// -----------
 
 	CameraBase::CameraBase(const rawrbox::Vector2u& renderSize, bool depth) {
 		this->_renderTarget = std::make_unique<rawrbox::TextureRender>(renderSize, depth);
@@ -58,6 +71,18 @@ namespace rawrbox {
 		device->CreateBuffer(CBDesc, nullptr, &uniforms);
 		// ------------
 
+		// TRANSFORM RING ---
+		Diligent::BufferDesc TransformDesc;
+		TransformDesc.Name = "rawrbox::Camera::Transforms";
+		TransformDesc.Usage = Diligent::USAGE_DYNAMIC;
+		TransformDesc.BindFlags = Diligent::BIND_UNIFORM_BUFFER;
+		TransformDesc.CPUAccessFlags = Diligent::CPU_ACCESS_WRITE;
+		TransformDesc.Size = RB_RENDER_TRANSFORM_BUFFER_SIZE;
+
+		device->CreateBuffer(TransformDesc, nullptr, &transformUniforms);
+		_transformAllocator = std::make_unique<rawrbox::FrameAllocator>(RB_RENDER_TRANSFORM_BUFFER_SIZE, TRANSFORM_STRIDE);
+		// ------------
+
 		// BARRIER -----
 		rawrbox::BarrierUtils::barrier({{staticUniforms, Diligent::RESOURCE_STATE_UNKNOWN, Diligent::RESOURCE_STATE_CONSTANT_BUFFER, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE},
 		    {uniforms, Diligent::RESOURCE_STATE_UNKNOWN, Diligent::RESOURCE_STATE_CONSTANT_BUFFER, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
@@ -148,10 +173,52 @@ namespace rawrbox {
 	}
 
 	void CameraBase::setModelTransform(const rawrbox::Matrix4x4& transform) {
-		if (this->_world == transform) return;
+		if (_boundCamera == this && _boundEpoch == _transformEpoch && _boundTransform == transform) return;
+		this->bindModelTransform(transform, this->writeModelTransforms(&transform, 1));
+	}
+
+	uint64_t CameraBase::writeModelTransforms(const rawrbox::Matrix4x4* transforms, size_t count) {
+		if (transformUniforms == nullptr || _transformAllocator == nullptr) RAWRBOX_CRITICAL("Buffer not initialized! Did you call initialize?");
+		if (transforms == nullptr || count == 0) RAWRBOX_CRITICAL("No transforms to write");
+
+		auto allocation = _transformAllocator->allocate(static_cast<uint64_t>(TRANSFORM_STRIDE) * count, rawrbox::FRAME);
+		if (allocation.discard) _transformEpoch++;
+
+		auto* context = rawrbox::RENDERER->context();
+
+		void* mapped = nullptr;
+		context->MapBuffer(transformUniforms, Diligent::MAP_WRITE, allocation.discard ? Diligent::MAP_FLAG_DISCARD : Diligent::MAP_FLAG_NO_OVERWRITE, mapped);
+		if (mapped == nullptr) RAWRBOX_CRITICAL("Failed to map the transform buffer!");
+
+		// View data is the same for every transform, only world changes
+		auto data = this->getUniforms({});
+		auto viewProj = data.gView * rawrbox::Matrix4x4::mtxTranspose(this->getProjMtx());
+
+		auto* dst = static_cast<uint8_t*>(mapped) + allocation.offset;
+		for (size_t i = 0; i < count; i++) {
+			data.gWorld = rawrbox::Matrix4x4::mtxTranspose(transforms[i]);
+			data.gWorldViewProj = data.gWorld * viewProj;
+
+			std::memcpy(dst + i * TRANSFORM_STRIDE, &data, sizeof(rawrbox::CameraUniforms));
+		}
+
+		context->UnmapBuffer(transformUniforms, Diligent::MAP_WRITE);
+		return allocation.offset;
+	}
+
+	void CameraBase::bindModelTransform(const rawrbox::Matrix4x4& transform, uint64_t offset) {
+		if (_transformVariable == nullptr) {
+			if (rawrbox::BindlessManager::signatureBind == nullptr) RAWRBOX_CRITICAL("Signature not bound! Did you call init?");
+			_transformVariable = rawrbox::BindlessManager::signatureBind->GetVariableByName(Diligent::SHADER_TYPE_VERTEX, "Camera");
+			if (_transformVariable == nullptr) RAWRBOX_CRITICAL("Camera variable not found on signature");
+		}
 
 		this->_world = transform;
-		this->updateBuffer();
+		_transformVariable->SetBufferOffset(static_cast<uint32_t>(offset));
+
+		_boundCamera = this;
+		_boundEpoch = _transformEpoch;
+		_boundTransform = transform;
 	}
 
 	rawrbox::Vector3f CameraBase::worldToScreen(const rawrbox::Vector3f& /*pos*/) const {
@@ -187,25 +254,33 @@ namespace rawrbox {
 	rawrbox::TextureRender* CameraBase::getRenderTarget() const { return this->_renderTarget.get(); }
 	// ----------------
 
-	void CameraBase::updateBuffer() {
-		if (uniforms == nullptr) RAWRBOX_CRITICAL("Buffer not initialized! Did you call initialize?");
-
+	rawrbox::CameraUniforms CameraBase::getUniforms(const rawrbox::Matrix4x4& world) const {
 		auto view = rawrbox::Matrix4x4::mtxTranspose(this->getViewMtx());
 		auto viewInv = rawrbox::Matrix4x4::mtxInverse(this->getViewMtx());
 		auto projection = rawrbox::Matrix4x4::mtxTranspose(this->getProjMtx());
-		auto world = rawrbox::Matrix4x4::mtxTranspose(this->_world);
 
 		rawrbox::CameraUniforms data = {};
 		data.gView = view;
 		data.gViewInv = viewInv;
-		data.gWorld = world;
+		data.gWorld = rawrbox::Matrix4x4::mtxTranspose(world);
 		data.gWorldViewProj = data.gWorld * data.gView * projection;
 		data.gPos = this->getPos();
 		data.gDeltaTime = rawrbox::DELTA_TIME;
 
+		return data;
+	}
+
+	void CameraBase::updateBuffer() {
+		if (uniforms == nullptr) RAWRBOX_CRITICAL("Buffer not initialized! Did you call initialize?");
+
+		// Used by compute plugins, graphics read from the transform ring
+		auto data = this->getUniforms(this->_world);
+
 		rawrbox::BarrierUtils::barrier({{uniforms, Diligent::RESOURCE_STATE_CONSTANT_BUFFER, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
 		rawrbox::RENDERER->context()->UpdateBuffer(uniforms, 0, sizeof(rawrbox::CameraUniforms), &data, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 		rawrbox::BarrierUtils::barrier({{uniforms, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::RESOURCE_STATE_CONSTANT_BUFFER, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
+
+		this->bindModelTransform(this->_world, this->writeModelTransforms(&this->_world, 1));
 	}
 
 	void CameraBase::update() {}
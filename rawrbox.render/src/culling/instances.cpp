@@ -0,0 +1,65 @@
+#include <rawrbox/render/culling/instances.hpp>
+#include <rawrbox/utils/threading.hpp>
+
+#include <cmath>
+
+namespace rawrbox {
+	// PRIVATE ----
+	void InstanceCuller::resize(size_t count) {
+		if (this->_visibility.size() >= count) return;
+
+		this->_visibility.resize(count);
+		this->_centerX.resize(count);
+		this->_centerY.resize(count);
+		this->_centerZ.resize(count);
+		this->_extentX.resize(count);
+		this->_extentY.resize(count);
+		this->_extentZ.resize(count);
+	}
+	// ------------
+
+	uint32_t InstanceCuller::cull(const rawrbox::Frustum& frustum, const rawrbox::BBOX& bounds, const rawrbox::Instance* instances, size_t count, std::vector<rawrbox::Instance>& out, rawrbox::DrawIndexedIndirectArgs& args) {
+		out.clear();
+		args.numInstances = 0;
+
+		if (instances == nullptr || count == 0) return 0;
+		this->resize(count);
+
+		const rawrbox::Vector3f center = (bounds.min + bounds.max) * 0.5F;
+		const rawrbox::Vector3f extents = (bounds.max - bounds.min) * 0.5F;
+
+		rawrbox::ASYNC::parallel(
+		    count, [&](size_t start, size_t end) {
+			    for (size_t i = start; i < end; i++) {
+				    // Same as Matrix4x4::mulBBOX, without building the bbox
+				    const auto& m = instances[i].matrix.mtx;
+
+				    this->_centerX[i] = m[0] * center.x + m[4] * center.y + m[8] * center.z + m[12];
+				    this->_centerY[i] = m[1] * center.x + m[5] * center.y + m[9] * center.z + m[13];
+				    this->_centerZ[i] = m[2] * center.x + m[6] * center.y + m[10] * center.z + m[14];
+
+				    this->_extentX[i] = std::abs(m[0]) * extents.x + std::abs(m[4]) * extents.y + std::abs(m[8]) * extents.z;
+				    this->_extentY[i] = std::abs(m[1]) * extents.x + std::abs(m[5]) * extents.y + std::abs(m[9]) * extents.z;
+				    this->_extentZ[i] = std::abs(m[2]) * extents.x + std::abs(m[6]) * extents.y + std::abs(m[10]) * extents.z;
+			    }
+
+			    frustum.intersects(this->_centerX.data() + start, this->_centerY.data() + start, this->_centerZ.data() + start, this->_extentX.data() + start, this->_extentY.data() + start, this->_extentZ.data() + start, end - start, this->_visibility.data() + start);
+		    },
+		    CULL_BATCH_SIZE);
+
+		// Compact ---
+		out.reserve(count);
+		for (size_t i = 0; i < count; i++) {
+			if (this->_visibility[i] == 0U) continue;
+			out.push_back(instances[i]);
+		}
+		// ----
+
+		args.numInstances = static_cast<uint32_t>(out.size());
+		return args.numInstances;
+	}
+
+	uint32_t InstanceCuller::cull(const rawrbox::Frustum& frustum, const rawrbox::BBOX& bounds, const std::vector<rawrbox::Instance>& instances, std::vector<rawrbox::Instance>& out, rawrbox::DrawIndexedIndirectArgs& args) {
+		return this->cull(frustum, bounds, instances.data(), instances.size(), out, args);
+	}
+} // namespace rawrbox
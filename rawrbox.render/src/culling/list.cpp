@@ -0,0 +1,150 @@
+#include <rawrbox/render/culling/list.hpp>
+#include <rawrbox/utils/logger.hpp>
+#include <rawrbox/utils/threading.hpp>
+
+namespace rawrbox {
+	// PRIVATE ----
+	void CullingList::setBounds(uint32_t index, const rawrbox::BBOX& bbox) {
+		this->_centerX[index] = (bbox.min.x + bbox.max.x) * 0.5F;
+		this->_centerY[index] = (bbox.min.y + bbox.max.y) * 0.5F;
+		this->_centerZ[index] = (bbox.min.z + bbox.max.z) * 0.5F;
+
+		this->_extentX[index] = (bbox.max.x - bbox.min.x) * 0.5F;
+		this->_extentY[index] = (bbox.max.y - bbox.min.y) * 0.5F;
+		this->_extentZ[index] = (bbox.max.z - bbox.min.z) * 0.5F;
+	}
+	// ------------
+
+	uint32_t CullingList::add(const rawrbox::BBOX& bbox, void* owner) {
+		uint32_t handle = 0;
+		if (!this->_freeHandles.empty()) {
+			handle = this->_freeHandles.back();
+			this->_freeHandles.pop_back();
+		} else {
+			handle = static_cast<uint32_t>(this->_handleToDense.size());
+			this->_handleToDense.push_back(INVALID_HANDLE);
+		}
+
+		auto index = static_cast<uint32_t>(this->_owners.size());
+		this->_handleToDense[handle] = index;
+
+		this->_centerX.push_back(0.F);
+		this->_centerY.push_back(0.F);
+		this->_centerZ.push_back(0.F);
+		this->_extentX.push_back(0.F);
+		this->_extentY.push_back(0.F);
+		this->_extentZ.push_back(0.F);
+
+		this->_owners.push_back(owner);
+		this->_visibility.push_back(1U);
+		this->_denseToHandle.push_back(handle);
+
+		this->setBounds(index, bbox);
+		return handle;
+	}
+
+	void CullingList::update(uint32_t handle, const rawrbox::BBOX& bbox) {
+		if (!this->isValid(handle)) RAWRBOX_CRITICAL("Invalid culling handle '{}'", handle);
+		this->setBounds(this->_handleToDense[handle], bbox);
+	}
+
+	void CullingList::remove(uint32_t handle) {
+		if (!this->isValid(handle)) return;
+
+		// Swap with the last element, keeps the arrays packed
+		uint32_t index = this->_handleToDense[handle];
+		auto last = static_cast<uint32_t>(this->_owners.size() - 1);
+
+		if (index != last) {
+			this->_centerX[index] = this->_centerX[last];
+			this->_centerY[index] = this->_centerY[last];
+			this->_centerZ[index] = this->_centerZ[last];
+			this->_extentX[index] = this->_extentX[last];
+			this->_extentY[index] = this->_extentY[last];
+			this->_extentZ[index] = this->_extentZ[last];
+
+			this->_owners[index] = this->_owners[last];
+			this->_visibility[index] = this->_visibility[last];
+			this->_denseToHandle[index] = this->_denseToHandle[last];
+
+			this->_handleToDense[this->_denseToHandle[index]] = index;
+		}
+
+		this->_centerX.pop_back();
+		this->_centerY.pop_back();
+		this->_centerZ.pop_back();
+		this->_extentX.pop_back();
+		this->_extentY.pop_back();
+		this->_extentZ.pop_back();
+
+		this->_owners.pop_back();
+		this->_visibility.pop_back();
+		this->_denseToHandle.pop_back();
+
+		this->_handleToDense[handle] = INVALID_HANDLE;
+		this->_freeHandles.push_back(handle);
+	}
+
+	void CullingList::clear() {
+		this->_centerX.clear();
+		this->_centerY.clear();
+		this->_centerZ.clear();
+		this->_extentX.clear();
+		this->_extentY.clear();
+		this->_extentZ.clear();
+
+		this->_owners.clear();
+		this->_visibility.clear();
+		this->_denseToHandle.clear();
+
+		this->_handleToDense.clear();
+		this->_freeHandles.clear();
+
+		this->_stats = {};
+	}
+
+	void CullingList::cull(const rawrbox::Matrix4x4& viewProj) {
+		this->_frustum.update(viewProj);
+
+		const size_t total = this->_owners.size();
+		rawrbox::ASYNC::parallel(
+		    total, [this](size_t start, size_t end) {
+			    this->_frustum.intersects(this->_centerX.data() + start, this->_centerY.data() + start, this->_centerZ.data() + start,
+				this->_extentX.data() + start, this->_extentY.data() + start, this->_extentZ.data() + start,
+				end - start, this->_visibility.data() + start);
+		    },
+		    CULL_BATCH_SIZE);
+
+		// Models draw themselves and check isVisible, only the count is needed here
+		uint32_t visible = 0;
+		for (size_t i = 0; i < total; i++) {
+			visible += this->_visibility[i];
+		}
+
+		this->_stats.total = static_cast<uint32_t>(total);
+		this->_stats.visible = visible;
+		this->_stats.culled = this->_stats.total - this->_stats.visible;
+	}
+
+	// UTILS ---
+	bool CullingList::isVisible(uint32_t handle) const {
+		if (!this->isValid(handle)) return true; // Not tracked, never culled
+		return this->_visibility[this->_handleToDense[handle]] != 0U;
+	}
+
+	bool CullingList::isValid(uint32_t handle) const {
+		return handle < this->_handleToDense.size() && this->_handleToDense[handle] != INVALID_HANDLE;
+	}
+
+	void* CullingList::getOwner(uint32_t handle) const {
+		if (!this->isValid(handle)) return nullptr;
+		return this->_owners[this->_handleToDense[handle]];
+	}
+
+	const rawrbox::Frustum& CullingList::getFrustum() const { return this->_frustum; }
+	const rawrbox::CullingStats& CullingList::getStats() const { return this->_stats; }
+
+	size_t CullingList::size() const { return this->_owners.size(); }
+	bool CullingList::empty() const { return this->_owners.empty(); }
+	// ------
+} // namespace rawrbox
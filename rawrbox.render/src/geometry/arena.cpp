@@ -0,0 +1,192 @@
+#include <rawrbox/render/geometry/arena.hpp>
+#include <rawrbox/render/static.hpp>
+#include <rawrbox/render/utils/barrier.hpp>
+
+#include <algorithm>
+#include <array>
+
+namespace rawrbox {
+	// PRIVATE ----
+	void GeometryArena::resizeVertices(uint64_t vertices) {
+		auto old = this->_vertices.getCapacity();
+
+		this->_vbh = this->resize(this->_vbh, old * this->_stride, vertices * this->_stride, Diligent::BIND_VERTEX_BUFFER, Diligent::RESOURCE_STATE_VERTEX_BUFFER);
+		this->_vertices.grow(vertices);
+
+		if (rawrbox::GEOMETRY::isBound(this->_stride)) rawrbox::GEOMETRY::unbind(); // Old buffer is gone
+
+		if (old != 0) this->_logger->debug("Resizing vertex arena [{}] ({} -> {})", this->_stride, fmt::styled(old, fmt::fg(fmt::color::cyan)), fmt::styled(vertices, fmt::fg(fmt::color::cyan)));
+	}
+
+	void GeometryArena::resizeIndices(uint64_t indices) {
+		auto old = this->_indices.getCapacity();
+
+		this->_ibh = this->resize(this->_ibh, old * sizeof(uint32_t), indices * sizeof(uint32_t), Diligent::BIND_INDEX_BUFFER, Diligent::RESOURCE_STATE_INDEX_BUFFER);
+		this->_indices.grow(indices);
+
+		if (rawrbox::GEOMETRY::isBound(this->_stride)) rawrbox::GEOMETRY::unbind(); // Old buffer is gone
+
+		if (old != 0) this->_logger->debug("Resizing index arena [{}] ({} -> {})", this->_stride, fmt::styled(old, fmt::fg(fmt::color::cyan)), fmt::styled(indices, fmt::fg(fmt::color::cyan)));
+	}
+
+	Diligent::RefCntAutoPtr<Diligent::IBuffer> GeometryArena::resize(Diligent::IBuffer* old, uint64_t oldSize, uint64_t size, Diligent::BIND_FLAGS flags, Diligent::RESOURCE_STATE state) {
+		auto* device = rawrbox::RENDERER->device();
+		auto* context = rawrbox::RENDERER->context();
+
+		Diligent::BufferDesc BuffDesc;
+		BuffDesc.Name = flags == Diligent::BIND_INDEX_BUFFER ? "RawrBox::Buffer::Arena::Indices" : "RawrBox::Buffer::Arena::Vertex";
+		BuffDesc.BindFlags = flags;
+		BuffDesc.Usage = Diligent::USAGE_DEFAULT;
+		BuffDesc.Size = size;
+
+		Diligent::RefCntAutoPtr<Diligent::IBuffer> buffer;
+		device->CreateBuffer(BuffDesc, nullptr, &buffer);
+		if (buffer == nullptr) RAWRBOX_CRITICAL("Failed to create arena buffer");
+
+		// Keep existing allocations, so offsets stay valid ----
+		if (old != nullptr && oldSize != 0) {
+			rawrbox::BarrierUtils::barrier({{old, state, Diligent::RESOURCE_STATE_COPY_SOURCE, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}, {buffer, Diligent::RESOURCE_STATE_UNKNOWN, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
+			context->CopyBuffer(old, 0, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY, buffer, 0, oldSize, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+			rawrbox::BarrierUtils::barrier({{buffer, Diligent::RESOURCE_STATE_COPY_DEST, state, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
+		} else {
+			rawrbox::BarrierUtils::barrier({{buffer, Diligent::RESOURCE_STATE_UNKNOWN, state, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
+		}
+		// ------------
+
+		return buffer;
+	}
+	// -----------
+
+	GeometryArena::GeometryArena(uint32_t stride) : _stride(stride) {
+		if (stride == 0) RAWRBOX_CRITICAL("Invalid vertex stride");
+	}
+
+	GeometryArena::~GeometryArena() {
+		RAWRBOX_DESTROY(this->_vbh);
+		RAWRBOX_DESTROY(this->_ibh);
+	}
+
+	rawrbox::GeometryAllocation GeometryArena::allocate(uint64_t vertices, uint64_t indices) {
+		if (vertices == 0 || indices == 0) RAWRBOX_CRITICAL("Vertices / indices data cannot be empty!");
+
+		rawrbox::GeometryAllocation allocation = {};
+		allocation.vertexStride = this->_stride;
+
+		// VERTICES ----
+		allocation.vertexOffset = this->_vertices.allocate(vertices);
+		if (allocation.vertexOffset == rawrbox::RangeAllocator::INVALID_OFFSET) {
+			auto capacity = this->_vertices.getCapacity();
+			this->resizeVertices(std::max<uint64_t>({capacity * 2, capacity + vertices, RB_RENDER_GEOMETRY_ARENA_SIZE}));
+
+			allocation.vertexOffset = this->_vertices.allocate(vertices);
+		}
+		// -------------
+
+		// INDICES ----
+		allocation.indexOffset = this->_indices.allocate(indices);
+		if (allocation.indexOffset == rawrbox::RangeAllocator::INVALID_OFFSET) {
+			auto capacity = this->_indices.getCapacity();
+			this->resizeIndices(std::max<uint64_t>({capacity * 2, capacity + indices, RB_RENDER_GEOMETRY_ARENA_SIZE * 3}));
+
+			allocation.indexOffset = this->_indices.allocate(indices);
+		}
+		// -------------
+
+		if (!allocation.isValid()) RAWRBOX_CRITICAL("Failed to allocate arena geometry ({} vertices, {} indices)", vertices, indices);
+		return allocation;
+	}
+
+	void GeometryArena::free(const rawrbox::GeometryAllocation& allocation) {
+		if (!allocation.isValid()) return;
+		if (allocation.vertexStride != this->_stride) RAWRBOX_CRITICAL("Allocation does not belong to this arena");
+
+		this->_vertices.free(allocation.vertexOffset);
+		this->_indices.free(allocation.indexOffset);
+	}
+
+	void GeometryArena::upload(const rawrbox::GeometryAllocation& allocation, const void* vertices, uint64_t vertexCount, const uint32_t* indices, uint64_t indexCount) {
+		if (!allocation.isValid()) RAWRBOX_CRITICAL("Invalid arena allocation");
+		if (vertexCount > this->_vertices.getSize(allocation.vertexOffset) || indexCount > this->_indices.getSize(allocation.indexOffset)) RAWRBOX_CRITICAL("Upload is bigger than the arena allocation");
+
+		auto* context = rawrbox::RENDERER->context();
+
+		// BARRIER -----
+		rawrbox::BarrierUtils::barrier({{this->_vbh, Diligent::RESOURCE_STATE_VERTEX_BUFFER, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}, {this->_ibh, Diligent::RESOURCE_STATE_INDEX_BUFFER, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
+
+		if (vertexCount != 0) context->UpdateBuffer(this->_vbh, allocation.vertexOffset * this->_stride, vertexCount * this->_stride, vertices, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+		if (indexCount != 0) context->UpdateBuffer(this->_ibh, allocation.indexOffset * sizeof(uint32_t), indexCount * sizeof(uint32_t), indices, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+		rawrbox::BarrierUtils::barrier({{this->_vbh, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::RESOURCE_STATE_VERTEX_BUFFER, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}, {this->_ibh, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::RESOURCE_STATE_INDEX_BUFFER, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
+		// -----------
+	}
+
+	// UTILS ----
+	Diligent::IBuffer* GeometryArena::getVertexBuffer() const { return this->_vbh; }
+	Diligent::IBuffer* GeometryArena::getIndexBuffer() const { return this->_ibh; }
+
+	uint32_t GeometryArena::getStride() const { return this->_stride; }
+	rawrbox::GeometryArenaStats GeometryArena::getStats() const { return {this->_vertices.getStats(), this->_indices.getStats()}; }
+	// ----------
+
+	// GEOMETRY ----
+	std::unordered_map<uint32_t, std::unique_ptr<rawrbox::GeometryArena>> GEOMETRY::_arenas = {};
+	rawrbox::GeometryArena* GEOMETRY::_bound = nullptr;
+
+	void GEOMETRY::shutdown() {
+		_bound = nullptr;
+		_arenas.clear();
+	}
+
+	// BINDING ----
+	void GEOMETRY::bind(Diligent::IDeviceContext* context, uint32_t stride) {
+		if (context == nullptr) RAWRBOX_CRITICAL("Invalid context");
+
+		auto* arena = get(stride);
+		if (_bound == arena) return;
+
+		std::array<Diligent::IBuffer*, 1> pBuffs = {arena->getVertexBuffer()};
+		context->SetVertexBuffers(0, 1, pBuffs.data(), nullptr, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY, Diligent::SET_VERTEX_BUFFERS_FLAG_RESET);
+		context->SetIndexBuffer(arena->getIndexBuffer(), 0, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+		_bound = arena;
+	}
+
+	void GEOMETRY::unbind() { _bound = nullptr; }
+
+	bool GEOMETRY::isBound(uint32_t stride) {
+		return _bound != nullptr && _bound->getStride() == stride;
+	}
+	// ----------
+
+	rawrbox::GeometryArena* GEOMETRY::get(uint32_t stride) {
+		auto fnd = _arenas.find(stride);
+		if (fnd != _arenas.end()) return fnd->second.get();
+
+		auto arena = std::make_unique<rawrbox::GeometryArena>(stride);
+		auto* ptr = arena.get();
+
+		_arenas[stride] = std::move(arena);
+		return ptr;
+	}
+
+	rawrbox::GeometryAllocation GEOMETRY::allocate(uint32_t stride, uint64_t vertices, uint64_t indices) {
+		return get(stride)->allocate(vertices, indices);
+	}
+
+	void GEOMETRY::free(const rawrbox::GeometryAllocation& allocation) {
+		if (!allocation.isValid()) return;
+
+		auto fnd = _arenas.find(allocation.vertexStride);
+		if (fnd == _arenas.end()) return; // Already shutdown
+
+		fnd->second->free(allocation);
+	}
+
+	rawrbox::GeometryArenaStats GEOMETRY::getStats(uint32_t stride) {
+		auto fnd = _arenas.find(stride);
+		if (fnd == _arenas.end()) return {};
+
+		return fnd->second->getStats();
+	}
+	// ----------
+} // namespace rawrbox
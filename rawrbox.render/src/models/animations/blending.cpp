@@ -0,0 +1,208 @@
+#include <rawrbox/render/models/animations/blending.hpp>
+#include <rawrbox/utils/logger.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace rawrbox {
+	// FADE ----
+	void AnimationFade::fadeTo(float target, float duration) {
+		this->target = std::clamp(target, 0.F, 1.F);
+
+		if (duration <= 0.F) {
+			this->weight = this->target;
+			this->speed = 0.F;
+			return;
+		}
+
+		this->speed = std::abs(this->target - this->weight) / duration;
+	}
+
+	void AnimationFade::update(float deltaTime) {
+		if (!this->isFading()) return;
+
+		float step = this->speed * deltaTime;
+		if (this->speed <= 0.F || std::abs(this->target - this->weight) <= step) {
+			this->weight = this->target;
+			this->speed = 0.F;
+			return;
+		}
+
+		this->weight += this->target > this->weight ? step : -step;
+	}
+
+	bool AnimationFade::isFading() const { return this->weight != this->target; }
+	// ----------
+
+	// PRIVATE ----
+	rawrbox::AnimationFade* AnimationGraph::find(const std::string& clip, size_t* layer) {
+		for (size_t i = 0; i < this->_layers.size(); i++) {
+			auto fnd = this->_layers[i].clips.find(clip);
+			if (fnd == this->_layers[i].clips.end()) continue;
+
+			if (layer != nullptr) *layer = i;
+			return &fnd->second;
+		}
+
+		return nullptr;
+	}
+
+	const rawrbox::AnimationFade* AnimationGraph::find(const std::string& clip, size_t* layer) const {
+		for (size_t i = 0; i < this->_layers.size(); i++) {
+			auto fnd = this->_layers[i].clips.find(clip);
+			if (fnd == this->_layers[i].clips.end()) continue;
+
+			if (layer != nullptr) *layer = i;
+			return &fnd->second;
+		}
+
+		return nullptr;
+	}
+
+	rawrbox::AnimationFade& AnimationGraph::insert(const std::string& clip, size_t layer) {
+		if (layer >= this->_layers.size()) RAWRBOX_CRITICAL("Invalid animation layer '{}'", layer);
+
+		// Clips can only live on one layer, keep the current weight when moving it
+		size_t oldLayer = 0;
+		auto* old = this->find(clip, &oldLayer);
+		if (old != nullptr && oldLayer == layer) return *old;
+
+		rawrbox::AnimationFade fade = {};
+		if (old != nullptr) {
+			fade = *old;
+			this->_layers[oldLayer].clips.erase(clip);
+		}
+
+		return this->_layers[layer].clips[clip] = fade;
+	}
+	// ------------
+
+	AnimationGraph::AnimationGraph(float threshold) : _threshold(threshold) {
+		this->addLayer("base");
+	}
+
+	// LAYERS ---
+	size_t AnimationGraph::addLayer(const std::string& name, bool additive, const std::vector<float>& jointMask) {
+		rawrbox::AnimationLayer layer = {};
+		layer.name = name;
+		layer.additive = additive;
+		layer.jointMask = jointMask;
+
+		this->_layers.push_back(layer);
+		return this->_layers.size() - 1;
+	}
+
+	void AnimationGraph::setLayerWeight(size_t layer, float weight) {
+		if (layer >= this->_layers.size()) RAWRBOX_CRITICAL("Invalid animation layer '{}'", layer);
+		this->_layers[layer].weight = std::clamp(weight, 0.F, 1.F);
+	}
+
+	void AnimationGraph::setJointMask(size_t layer, const std::vector<float>& jointMask) {
+		if (layer >= this->_layers.size()) RAWRBOX_CRITICAL("Invalid animation layer '{}'", layer);
+		this->_layers[layer].jointMask = jointMask;
+	}
+
+	const rawrbox::AnimationLayer& AnimationGraph::getLayer(size_t layer) const {
+		if (layer >= this->_layers.size()) RAWRBOX_CRITICAL("Invalid animation layer '{}'", layer);
+		return this->_layers[layer];
+	}
+
+	const std::vector<rawrbox::AnimationLayer>& AnimationGraph::getLayers() const { return this->_layers; }
+	// ----------
+
+	// CLIPS ---
+	void AnimationGraph::set(const std::string& clip, float weight, size_t layer) {
+		auto& fade = this->insert(clip, layer);
+
+		fade.fadeTo(weight, 0.F);
+		fade.release = false;
+	}
+
+	void AnimationGraph::play(const std::string& clip, float fadeTime, size_t layer) {
+		auto& fade = this->insert(clip, layer);
+
+		fade.fadeTo(1.F, fadeTime);
+		fade.release = false;
+
+		for (auto& other : this->_layers[layer].clips) {
+			if (other.first == clip) continue;
+
+			other.second.fadeTo(0.F, fadeTime);
+			other.second.release = true;
+		}
+	}
+
+	void AnimationGraph::fade(const std::string& clip, float weight, float fadeTime) {
+		auto* fade = this->find(clip);
+		if (fade == nullptr) return;
+
+		fade->fadeTo(weight, fadeTime);
+		fade->release = fade->target <= 0.F;
+	}
+
+	void AnimationGraph::remove(const std::string& clip) {
+		for (auto& layer : this->_layers) {
+			layer.clips.erase(clip);
+		}
+	}
+
+	void AnimationGraph::clear() {
+		for (auto& layer : this->_layers) {
+			layer.clips.clear();
+		}
+	}
+
+	std::vector<std::string> AnimationGraph::update(float deltaTime) {
+		std::vector<std::string> finished = {};
+
+		for (auto& layer : this->_layers) {
+			for (auto it = layer.clips.begin(); it != layer.clips.end();) {
+				it->second.update(deltaTime);
+
+				// Faded out, nothing left to sample
+				if (it->second.release && it->second.weight <= 0.F) {
+					finished.push_back(it->first);
+					it = layer.clips.erase(it);
+					continue;
+				}
+
+				++it;
+			}
+		}
+
+		return finished;
+	}
+	// ----------
+
+	// UTILS ---
+	bool AnimationGraph::has(const std::string& clip) const { return this->find(clip) != nullptr; }
+	bool AnimationGraph::isActive(const std::string& clip) const { return this->getWeight(clip) > this->_threshold; }
+
+	float AnimationGraph::getWeight(const std::string& clip) const {
+		size_t layer = 0;
+
+		const auto* fade = this->find(clip, &layer);
+		if (fade == nullptr) return 0.F;
+
+		return fade->weight * this->_layers[layer].weight;
+	}
+
+	void AnimationGraph::getActive(std::vector<rawrbox::AnimationBlendEntry>& out) const {
+		out.clear();
+
+		for (size_t i = 0; i < this->_layers.size(); i++) {
+			const auto& layer = this->_layers[i];
+			if (layer.weight <= this->_threshold) continue;
+
+			for (const auto& clip : layer.clips) {
+				float weight = clip.second.weight * layer.weight;
+				if (weight <= this->_threshold) continue;
+
+				out.push_back({&clip.first, i, weight, layer.additive});
+			}
+		}
+	}
+
+	float AnimationGraph::getThreshold() const { return this->_threshold; }
+	// ----------
+} // namespace rawrbox
@@ -0,0 +1,61 @@
+#include <rawrbox/render/models/animations/manager.hpp>
+#include <rawrbox/utils/threading.hpp>
+
+#include <algorithm>
+
+namespace rawrbox {
+	// PRIVATE ----
+	std::vector<rawrbox::AnimationTarget*> ANIMATIONS::_targets = {};
+	bool ANIMATIONS::_finishing = false;
+	// ------------
+
+	void ANIMATIONS::add(rawrbox::AnimationTarget* target) {
+		if (target == nullptr) return;
+		if (std::find(_targets.begin(), _targets.end(), target) != _targets.end()) return;
+
+		_targets.push_back(target);
+	}
+
+	void ANIMATIONS::remove(rawrbox::AnimationTarget* target) {
+		auto fnd = std::find(_targets.begin(), _targets.end(), target);
+		if (fnd == _targets.end()) return;
+
+		// Finishing walks the list by index, leave a tombstone so later targets keep their slot
+		if (_finishing) {
+			*fnd = nullptr;
+			return;
+		}
+
+		_targets.erase(fnd);
+	}
+
+	void ANIMATIONS::tick() {
+		if (_targets.empty()) return;
+
+		rawrbox::ASYNC::parallel(
+		    _targets.size(), [](size_t start, size_t end) {
+			    for (size_t i = start; i < end; i++) {
+				    _targets[i]->tickAnimations();
+			    }
+		    },
+		    4);
+
+		// Finishing can remove (and destroy) any target through callbacks, removed ones are tombstoned and skipped
+		_finishing = true;
+
+		const size_t total = _targets.size(); // Targets added while finishing start next tick
+		for (size_t i = 0; i < total; i++) {
+			auto* target = _targets[i];
+			if (target == nullptr) continue;
+
+			target->finishAnimations();
+		}
+
+		_finishing = false;
+		std::erase(_targets, nullptr);
+	}
+
+	// UTILS ----
+	size_t ANIMATIONS::count() { return _targets.size() - static_cast<size_t>(std::count(_targets.begin(), _targets.end(), nullptr)); }
+	// ----------
+} // namespace rawrbox
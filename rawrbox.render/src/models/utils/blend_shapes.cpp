@@ -0,0 +1,216 @@
+#include <rawrbox/render/models/utils/blend_shapes.hpp>
+#include <rawrbox/utils/logger.hpp>
+#include <rawrbox/utils/threading.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+	#include <xmmintrin.h>
+	#define RAWRBOX_BLEND_SSE
+#endif
+
+namespace {
+	constexpr uint32_t RUN_GAP = 4; // Zero deltas are cheaper than splitting a run
+
+	// out += in * weight
+	void axpy(float* out, const float* in, float weight, size_t count) {
+		size_t i = 0;
+
+#ifdef RAWRBOX_BLEND_SSE
+		const __m128 w = _mm_set1_ps(weight);
+		for (; i + 4 <= count; i += 4) {
+			_mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(_mm_loadu_ps(in + i), w)));
+		}
+#endif
+
+		for (; i < count; i++) {
+			out[i] += in[i] * weight;
+		}
+	}
+} // namespace
+
+namespace rawrbox {
+	// STREAM ----
+	rawrbox::BlendShapeStream BlendShapeStream::fromDeltas(const std::vector<rawrbox::Vector3f>& positions, const std::vector<rawrbox::Vector3f>& normals, float epsilon) {
+		if (!normals.empty() && !positions.empty() && normals.size() != positions.size()) RAWRBOX_CRITICAL("Blend shape positions ({}) and normals ({}) do not match", positions.size(), normals.size());
+
+		rawrbox::BlendShapeStream stream = {};
+		size_t total = std::max(positions.size(), normals.size());
+
+		auto moves = [&](size_t i) {
+			if (!positions.empty() && positions[i].sqrMagnitude() > epsilon * epsilon) return true;
+			if (!normals.empty() && normals[i].sqrMagnitude() > epsilon * epsilon) return true;
+
+			return false;
+		};
+
+		auto push = [&](size_t i) {
+			auto pos = positions.empty() ? rawrbox::Vector3f{} : positions[i];
+			stream.x.push_back(pos.x);
+			stream.y.push_back(pos.y);
+			stream.z.push_back(pos.z);
+
+			if (normals.empty()) return;
+			stream.nx.push_back(normals[i].x);
+			stream.ny.push_back(normals[i].y);
+			stream.nz.push_back(normals[i].z);
+		};
+
+		for (size_t i = 0; i < total; i++) {
+			if (!moves(i)) continue;
+
+			auto vertex = static_cast<uint32_t>(i);
+			if (!stream.runs.empty()) {
+				auto& run = stream.runs.back();
+				uint32_t runEnd = run.vertex + run.count;
+
+				if (vertex - runEnd <= RUN_GAP) {
+					for (uint32_t g = runEnd; g <= vertex; g++) {
+						push(g);
+					}
+
+					run.count = vertex - run.vertex + 1;
+					continue;
+				}
+			}
+
+			stream.runs.push_back({vertex, 1, static_cast<uint32_t>(stream.x.size())});
+			push(i);
+		}
+
+		if (!stream.runs.empty()) {
+			stream.start = stream.runs.front().vertex;
+			stream.end = stream.runs.back().vertex + stream.runs.back().count;
+		}
+
+		return stream;
+	}
+
+	bool BlendShapeStream::empty() const { return this->runs.empty(); }
+	bool BlendShapeStream::hasNormals() const { return !this->nx.empty(); }
+	size_t BlendShapeStream::size() const { return this->x.size(); }
+	// ----------
+
+	// PRIVATE ----
+	void BlendShapeAccumulator::accumulate(const rawrbox::BlendShapeStream& stream, float weight, uint32_t start, uint32_t end, float* x, float* y, float* z, float* nx, float* ny, float* nz) {
+		// First run that ends after start
+		auto it = std::partition_point(stream.runs.begin(), stream.runs.end(), [start](const rawrbox::BlendShapeRun& run) { return run.vertex + run.count <= start; });
+
+		bool normals = nx != nullptr && stream.hasNormals();
+		for (; it != stream.runs.end() && it->vertex < end; ++it) {
+			uint32_t from = std::max(it->vertex, start);
+			uint32_t to = std::min(it->vertex + it->count, end);
+			uint32_t offset = it->offset + (from - it->vertex);
+			uint32_t count = to - from;
+
+			axpy(x + from, stream.x.data() + offset, weight, count);
+			axpy(y + from, stream.y.data() + offset, weight, count);
+			axpy(z + from, stream.z.data() + offset, weight, count);
+
+			if (!normals) continue;
+			axpy(nx + from, stream.nx.data() + offset, weight, count);
+			axpy(ny + from, stream.ny.data() + offset, weight, count);
+			axpy(nz + from, stream.nz.data() + offset, weight, count);
+		}
+	}
+	// ------------
+
+	void BlendShapeAccumulator::setBase(const std::vector<rawrbox::Vector3f>& positions, const std::vector<rawrbox::Vector3f>& normals) {
+		if (!normals.empty() && normals.size() != positions.size()) RAWRBOX_CRITICAL("Base positions ({}) and normals ({}) do not match", positions.size(), normals.size());
+
+		auto split = [](const std::vector<rawrbox::Vector3f>& in, std::vector<float>& x, std::vector<float>& y, std::vector<float>& z) {
+			x.resize(in.size());
+			y.resize(in.size());
+			z.resize(in.size());
+
+			for (size_t i = 0; i < in.size(); i++) {
+				x[i] = in[i].x;
+				y[i] = in[i].y;
+				z[i] = in[i].z;
+			}
+		};
+
+		split(positions, this->_baseX, this->_baseY, this->_baseZ);
+		split(normals, this->_baseNX, this->_baseNY, this->_baseNZ);
+
+		this->_x = this->_baseX;
+		this->_y = this->_baseY;
+		this->_z = this->_baseZ;
+		this->_nx = this->_baseNX;
+		this->_ny = this->_baseNY;
+		this->_nz = this->_baseNZ;
+
+		this->_last = {0, static_cast<uint32_t>(positions.size())}; // First apply rebuilds everything, the mesh might not match the base
+		this->_dirty = {0, 0};
+	}
+
+	void BlendShapeAccumulator::apply(const std::vector<rawrbox::BlendShapeWeight>& shapes) {
+		auto total = static_cast<uint32_t>(this->_baseX.size());
+
+		// Range of the active shapes ---
+		std::pair<uint32_t, uint32_t> range = {total, 0};
+		for (const auto& shape : shapes) {
+			if (shape.stream == nullptr || shape.weight == 0.F || shape.stream->empty()) continue;
+			if (shape.stream->end > total) RAWRBOX_CRITICAL("Blend shape touches vertex {}, but the mesh only has {}", shape.stream->end - 1, total);
+
+			range.first = std::min(range.first, shape.stream->start);
+			range.second = std::max(range.second, shape.stream->end);
+		}
+
+		if (range.first >= range.second) range = {0, 0};
+		// ---------------
+
+		// Restore whatever the previous apply touched too ---
+		this->_dirty = range;
+		if (this->_last.first < this->_last.second) {
+			this->_dirty = range.first < range.second ? std::pair<uint32_t, uint32_t>{std::min(range.first, this->_last.first), std::max(range.second, this->_last.second)} : this->_last;
+		}
+
+		this->_last = range;
+		if (this->_dirty.first >= this->_dirty.second) return;
+		// ---------------
+
+		bool normals = this->hasNormals();
+		uint32_t dirtyStart = this->_dirty.first;
+
+		rawrbox::ASYNC::parallel(
+		    this->_dirty.second - this->_dirty.first, [&](size_t blockStart, size_t blockEnd) {
+			    auto start = static_cast<uint32_t>(dirtyStart + blockStart);
+			    auto end = static_cast<uint32_t>(dirtyStart + blockEnd);
+			    auto count = end - start;
+
+			    std::copy_n(this->_baseX.data() + start, count, this->_x.data() + start);
+			    std::copy_n(this->_baseY.data() + start, count, this->_y.data() + start);
+			    std::copy_n(this->_baseZ.data() + start, count, this->_z.data() + start);
+
+			    if (normals) {
+				    std::copy_n(this->_baseNX.data() + start, count, this->_nx.data() + start);
+				    std::copy_n(this->_baseNY.data() + start, count, this->_ny.data() + start);
+				    std::copy_n(this->_baseNZ.data() + start, count, this->_nz.data() + start);
+			    }
+
+			    for (const auto& shape : shapes) {
+				    if (shape.stream == nullptr || shape.weight == 0.F) continue;
+				    if (shape.stream->end <= start || shape.stream->start >= end) continue;
+
+				    accumulate(*shape.stream, shape.weight, start, end, this->_x.data(), this->_y.data(), this->_z.data(),
+					normals ? this->_nx.data() : nullptr, this->_ny.data(), this->_nz.data());
+			    }
+		    },
+		    BLOCK_SIZE);
+	}
+
+	// UTILS ---
+	std::pair<uint32_t, uint32_t> BlendShapeAccumulator::getDirty() const { return this->_dirty; }
+
+	rawrbox::Vector3f BlendShapeAccumulator::getPosition(size_t vertex) const { return {this->_x[vertex], this->_y[vertex], this->_z[vertex]}; }
+	rawrbox::Vector3f BlendShapeAccumulator::getNormal(size_t vertex) const { return {this->_nx[vertex], this->_ny[vertex], this->_nz[vertex]}; }
+
+	rawrbox::Vector3f BlendShapeAccumulator::getBasePosition(size_t vertex) const { return {this->_baseX[vertex], this->_baseY[vertex], this->_baseZ[vertex]}; }
+	rawrbox::Vector3f BlendShapeAccumulator::getBaseNormal(size_t vertex) const { return {this->_baseNX[vertex], this->_baseNY[vertex], this->_baseNZ[vertex]}; }
+
+	bool BlendShapeAccumulator::hasNormals() const { return !this->_baseNX.empty(); }
+	size_t BlendShapeAccumulator::size() const { return this->_baseX.size(); }
+	// ----------
+} // namespace rawrbox
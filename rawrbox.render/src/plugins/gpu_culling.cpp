@@ -0,0 +1,171 @@
+#include <rawrbox/math/utils/math.hpp>
+#include <rawrbox/render/plugins/gpu_culling.hpp>
+#include <rawrbox/render/static.hpp>
+#include <rawrbox/render/utils/barrier.hpp>
+#include <rawrbox/render/utils/pipeline.hpp>
+
+#include <MapHelper.hpp>
+
+namespace rawrbox {
+	GPUCullingPlugin::~GPUCullingPlugin() {
+		RAWRBOX_DESTROY(this->_signature);
+		RAWRBOX_DESTROY(this->_signatureBind);
+		RAWRBOX_DESTROY(this->_uniforms);
+
+		this->_registeredTargets.clear();
+	}
+
+	void GPUCullingPlugin::initialize(const rawrbox::Vector2u& /*size*/) {
+		this->createBuffers();
+		this->createSignatures();
+	}
+
+	void GPUCullingPlugin::createSignatures() {
+		if (this->_signature != nullptr || this->_signatureBind != nullptr) RAWRBOX_CRITICAL("Signatures already bound!");
+
+		std::vector<Diligent::PipelineResourceDesc> resources = {
+		    {Diligent::SHADER_TYPE_COMPUTE, "CullingConstants", 1, Diligent::SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, Diligent::SHADER_RESOURCE_VARIABLE_TYPE_STATIC},
+
+		    {Diligent::SHADER_TYPE_COMPUTE, "Instances", 1, Diligent::SHADER_RESOURCE_TYPE_BUFFER_SRV, Diligent::SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+		    {Diligent::SHADER_TYPE_COMPUTE, "CulledInstances", 1, Diligent::SHADER_RESOURCE_TYPE_BUFFER_UAV, Diligent::SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+		    {Diligent::SHADER_TYPE_COMPUTE, "DrawArgs", 1, Diligent::SHADER_RESOURCE_TYPE_BUFFER_UAV, Diligent::SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+		};
+
+		Diligent::PipelineResourceSignatureDesc PRSDesc;
+		PRSDesc.Name = "RawrBox::SIGNATURE::GPUCulling";
+		PRSDesc.BindingIndex = 0;
+
+		PRSDesc.ImmutableSamplers = nullptr;
+		PRSDesc.NumImmutableSamplers = 0;
+
+		PRSDesc.Resources = resources.data();
+		PRSDesc.NumResources = static_cast<uint8_t>(resources.size());
+
+		rawrbox::RENDERER->device()->CreatePipelineResourceSignature(PRSDesc, &this->_signature);
+	}
+
+	void GPUCullingPlugin::createBuffers() {
+		Diligent::BufferDesc BuffDesc;
+		BuffDesc.Name = "rawrbox::GPUCulling::Uniforms";
+		BuffDesc.Usage = Diligent::USAGE_DYNAMIC;
+		BuffDesc.CPUAccessFlags = Diligent::CPU_ACCESS_WRITE;
+		BuffDesc.BindFlags = Diligent::BIND_UNIFORM_BUFFER;
+		BuffDesc.Size = sizeof(rawrbox::GPUCullingUniforms);
+
+		rawrbox::RENDERER->device()->CreateBuffer(BuffDesc, nullptr, &this->_uniforms);
+
+		// BARRIER -----
+		rawrbox::BarrierUtils::barrier({{this->_uniforms, Diligent::RESOURCE_STATE_UNKNOWN, Diligent::RESOURCE_STATE_CONSTANT_BUFFER, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
+		// -----------
+	}
+
+	void GPUCullingPlugin::createPipelines() {
+		rawrbox::PipeComputeSettings settings;
+		settings.signatures = {this->_signature};
+		settings.macros.Add("THREAD_GROUP_SIZE", THREAD_GROUP_SIZE);
+
+		// CULL -----
+		settings.pCS = "instance_cull.csh";
+		this->_cullProgram = rawrbox::PipelineUtils::createComputePipeline("GPUCulling::Cull", settings);
+		// ---------
+	}
+
+	void GPUCullingPlugin::upload() {
+		if (this->_signature == nullptr || this->_uniforms == nullptr) RAWRBOX_CRITICAL("Plugin not initialized!");
+
+		// Compute bind ---
+		this->_signature->GetStaticVariableByName(Diligent::SHADER_TYPE_COMPUTE, "CullingConstants")->Set(this->_uniforms);
+		this->_signature->CreateShaderResourceBinding(&this->_signatureBind, true);
+		// ----------------
+
+		this->createPipelines();
+	}
+
+	void GPUCullingPlugin::preRender(const rawrbox::CameraBase& camera) {
+		if (this->_registeredTargets.empty()) return;
+
+		auto viewProj = camera.getViewProjMtx();
+		for (auto* target : this->_registeredTargets) {
+			if (target == nullptr || !target->isValid() || target->draw.numInstances == 0) continue;
+			this->cullTarget(rawrbox::Frustum(viewProj * target->world), target); // Model space frustum
+		}
+	}
+
+	bool GPUCullingPlugin::isSupported() {
+		if (rawrbox::RENDERER == nullptr || rawrbox::RENDERER->device() == nullptr) return false;
+		return (rawrbox::RENDERER->device()->GetAdapterInfo().DrawCommand.CapFlags & Diligent::DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT) != 0;
+	}
+
+	// REGISTER ----
+	void GPUCullingPlugin::registerTarget(rawrbox::GPUCullingTarget* target) {
+		if (target == nullptr) RAWRBOX_CRITICAL("Invalid culling target");
+		if (std::find(this->_registeredTargets.begin(), this->_registeredTargets.end(), target) != this->_registeredTargets.end()) return;
+
+		this->_registeredTargets.push_back(target);
+	}
+
+	void GPUCullingPlugin::unregisterTarget(rawrbox::GPUCullingTarget* target) {
+		std::erase(this->_registeredTargets, target);
+	}
+	// -------------
+
+	// RENDERING ---
+	void GPUCullingPlugin::cullTarget(const rawrbox::Frustum& frustum, rawrbox::GPUCullingTarget* target) {
+		if (this->_signatureBind == nullptr || this->_cullProgram == nullptr) RAWRBOX_CRITICAL("Plugin not uploaded!");
+
+		auto* context = rawrbox::RENDERER->context();
+		auto count = target->draw.numInstances;
+
+		// Update uniforms ----
+		{
+			Diligent::MapHelper<rawrbox::GPUCullingUniforms> Constants(context, this->_uniforms, Diligent::MAP_WRITE, Diligent::MAP_FLAG_DISCARD);
+			if (Constants == nullptr) RAWRBOX_CRITICAL("Failed to map culling constants buffer!");
+
+			Constants->planes = frustum.getPlanes();
+			Constants->center = rawrbox::Vector4f((target->bounds.min + target->bounds.max) * 0.5F, 0.F);
+			Constants->extents = rawrbox::Vector4f((target->bounds.max - target->bounds.min) * 0.5F, 0.F);
+			Constants->info = {count, 0, 0, 0};
+		}
+		// --------
+
+		// Reset draw args, the shader only increments numInstances ----
+		rawrbox::DrawIndexedIndirectArgs args = target->draw;
+		args.numInstances = 0;
+
+		rawrbox::BarrierUtils::barrier({{target->args, Diligent::RESOURCE_STATE_INDIRECT_ARGUMENT, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
+		context->UpdateBuffer(target->args, 0, sizeof(rawrbox::DrawIndexedIndirectArgs), &args, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+		// -------
+
+		// Barrier for writting -----
+		rawrbox::BarrierUtils::barrier({
+		    {target->instances, Diligent::RESOURCE_STATE_VERTEX_BUFFER, Diligent::RESOURCE_STATE_SHADER_RESOURCE, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE},
+		    {target->culled, Diligent::RESOURCE_STATE_VERTEX_BUFFER, Diligent::RESOURCE_STATE_UNORDERED_ACCESS, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE},
+		    {target->args, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::RESOURCE_STATE_UNORDERED_ACCESS, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE},
+		});
+		//  -----------
+
+		// Setup signature ---
+		this->_signatureBind->GetVariableByName(Diligent::SHADER_TYPE_COMPUTE, "Instances")->Set(target->instances->GetDefaultView(Diligent::BUFFER_VIEW_SHADER_RESOURCE));
+		this->_signatureBind->GetVariableByName(Diligent::SHADER_TYPE_COMPUTE, "CulledInstances")->Set(target->culled->GetDefaultView(Diligent::BUFFER_VIEW_UNORDERED_ACCESS));
+		this->_signatureBind->GetVariableByName(Diligent::SHADER_TYPE_COMPUTE, "DrawArgs")->Set(target->args->GetDefaultView(Diligent::BUFFER_VIEW_UNORDERED_ACCESS));
+
+		context->CommitShaderResources(this->_signatureBind, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+		//  ------------------
+
+		// Cull ---
+		context->SetPipelineState(this->_cullProgram);
+		context->DispatchCompute({rawrbox::MathUtils::divideRound<uint32_t>(count, THREAD_GROUP_SIZE), 1, 1});
+		// ------------
+
+		// Barrier for drawing -----
+		rawrbox::BarrierUtils::barrier({
+		    {target->instances, Diligent::RESOURCE_STATE_SHADER_RESOURCE, Diligent::RESOURCE_STATE_VERTEX_BUFFER, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE},
+		    {target->culled, Diligent::RESOURCE_STATE_UNORDERED_ACCESS, Diligent::RESOURCE_STATE_VERTEX_BUFFER, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE},
+		    {target->args, Diligent::RESOURCE_STATE_UNORDERED_ACCESS, Diligent::RESOURCE_STATE_INDIRECT_ARGUMENT, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE},
+		});
+		//  -----------
+	}
+	// ---------------------
+
+	std::string GPUCullingPlugin::getID() { return "GPUCulling"; }
+} // namespace rawrbox
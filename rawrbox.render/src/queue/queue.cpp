@@ -0,0 +1,136 @@
+#include <rawrbox/render/queue/queue.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+
+namespace rawrbox {
+	// PRIVATE ----
+	rawrbox::RenderQueueStats RenderQueue::_frameStats = {};
+	rawrbox::RenderQueueStats RenderQueue::_lastFrameStats = {};
+	// ------------
+
+	uint32_t RenderQueue::quantizeDepth(float depth) {
+		// Positive IEEE floats keep their order when compared as integers, drop the sign and the low mantissa bits
+		if (!(depth > 0.F)) return 0;
+		return std::bit_cast<uint32_t>(depth) >> 4U;
+	}
+
+	uint64_t RenderQueue::makeKey(uint8_t pass, bool transparent, uint16_t pipeline, uint16_t textures, float depth) {
+		uint64_t key = static_cast<uint64_t>(pass & 0xFU) << 60U;
+		uint64_t depthBits = rawrbox::RenderQueue::quantizeDepth(depth) & 0x7FFFFFFU;
+
+		if (transparent) {
+			key |= 1ULL << 59U;
+			key |= (~depthBits & 0x7FFFFFFU) << 32U;
+			key |= static_cast<uint64_t>(pipeline) << 16U;
+			key |= static_cast<uint64_t>(textures);
+		} else {
+			key |= static_cast<uint64_t>(pipeline) << 43U;
+			key |= static_cast<uint64_t>(textures) << 27U;
+			key |= depthBits;
+		}
+
+		return key;
+	}
+
+	uint16_t RenderQueue::getStateID(const void* state) {
+		auto fnd = this->_stateIDs.find(state);
+		if (fnd != this->_stateIDs.end()) return fnd->second;
+
+		auto id = static_cast<uint16_t>(this->_stateIDs.size());
+		this->_stateIDs[state] = id;
+		return id;
+	}
+
+	void RenderQueue::begin() {
+		this->_items.clear();
+		this->_lastPipeline = nullptr;
+		this->_stats = {};
+	}
+
+	void RenderQueue::add(uint64_t key, uint32_t index) {
+		this->_items.push_back({key, index});
+	}
+
+	void RenderQueue::sort() {
+		const size_t total = this->_items.size();
+		if (total < 2) return;
+
+		// Small lists are faster with a plain sort
+		if (total <= 32) {
+			std::stable_sort(this->_items.begin(), this->_items.end(), [](const auto& a, const auto& b) { return a.key < b.key; });
+			return;
+		}
+
+		// LSD radix sort, 8 bits per pass, skips the passes where every key has the same byte
+		this->_scratch.resize(total);
+
+		auto* src = &this->_items;
+		auto* dst = &this->_scratch;
+
+		for (uint32_t shift = 0; shift < 64; shift += 8) {
+			std::array<uint32_t, 256> count = {};
+			for (const auto& item : *src) {
+				count[(item.key >> shift) & 0xFFU]++;
+			}
+
+			if (count[((*src)[0].key >> shift) & 0xFFU] == total) continue;
+
+			uint32_t offset = 0;
+			for (auto& c : count) {
+				uint32_t n = c;
+				c = offset;
+				offset += n;
+			}
+
+			for (const auto& item : *src) {
+				(*dst)[count[(item.key >> shift) & 0xFFU]++] = item;
+			}
+
+			std::swap(src, dst);
+		}
+
+		if (src != &this->_items) this->_items.swap(this->_scratch);
+	}
+
+	void RenderQueue::end() {
+		_frameStats += this->_stats;
+	}
+
+	// STATE ---
+	bool RenderQueue::setPipeline(const void* pipeline) {
+		if (this->_lastPipeline == pipeline) {
+			this->_stats.pipelineSkips++;
+			return false;
+		}
+
+		this->_lastPipeline = pipeline;
+		this->_stats.pipelineBinds++;
+		return true;
+	}
+
+	void RenderQueue::countUniforms(bool uploaded) {
+		if (uploaded) {
+			this->_stats.uniformUploads++;
+		} else {
+			this->_stats.uniformSkips++;
+		}
+	}
+
+	void RenderQueue::countDraw() { this->_stats.draws++; }
+	// ----
+
+	const std::vector<rawrbox::RenderQueueItem>& RenderQueue::getItems() const { return this->_items; }
+	const rawrbox::RenderQueueStats& RenderQueue::getStats() const { return this->_stats; }
+	size_t RenderQueue::size() const { return this->_items.size(); }
+
+	// FRAME STATS ---
+	void RenderQueue::frame() {
+		_lastFrameStats = _frameStats;
+		_frameStats = {};
+	}
+
+	const rawrbox::RenderQueueStats& RenderQueue::getFrameStats() { return _lastFrameStats; }
+	// ----
+} // namespace rawrbox
@@ -24,9 +24,13 @@
 #endif
 
 #include <rawrbox/render/bindless.hpp>
+#include <rawrbox/render/geometry/arena.hpp>
+#include <rawrbox/render/models/animations/manager.hpp>
+#include <rawrbox/render/queue/queue.hpp>
 #include <rawrbox/render/renderer.hpp>
 #include <rawrbox/render/static.hpp>
 #include <rawrbox/render/text/engine.hpp>
+#include <rawrbox/render/textures/streamer.hpp>
 #include <rawrbox/render/textures/utils/utils.hpp>
 #include <rawrbox/render/textures/webp.hpp>
 #include <rawrbox/render/utils/barrier.hpp>
@@ -42,6 +46,7 @@ namespace rawrbox {
 	RendererBase::RendererBase(Diligent::RENDER_DEVICE_TYPE type, Diligent::NativeWindow window, const rawrbox::Vector2u& size, const rawrbox::Vector2u& monitorSize, const rawrbox::Colorf& clearColor) : _clearColor(clearColor), _size(size), _monitorSize(monitorSize), _window(window), _type(type) {}
 	RendererBase::~RendererBase() {
 		this->_stencil.reset();
+		this->_culling.reset();
 		this->_logger.reset();
 		this->_GPUBlit.reset();
 
@@ -412,10 +417,16 @@ namespace rawrbox {
 		this->clear();
 		// ---------------------
 
-		// Update textures ---
+		// Update textures, streamed levels first so their slots get bound ---
+		rawrbox::TextureStreamer::update();
 		rawrbox::BindlessManager::update();
 		// --------------------
 
+		// Tick animations on the worker pool, models skip their own tick on draw ---
+		rawrbox::ANIMATIONS::tick();
+		// --------------------
+
+		const rawrbox::CameraBase* culledCamera = nullptr;
 		for (auto& camera : this->_cameras) {
 			if (!camera->isEnabled()) continue;
 
@@ -434,7 +445,13 @@ namespace rawrbox {
 			this->_context->CommitShaderResources(rawrbox::BindlessManager::signatureBind, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 			// -----------------------
 
-			// Perform world --
+			// Frustum cull --
+			this->_culling->cull(camera->getViewProjMtx());
+			culledCamera = camera.get();
+			// -----------------------
+
+			// Perform world, arena buffers get bound once by the first model that uses them --
+			rawrbox::GEOMETRY::unbind();
 			camera->begin();
 			this->_drawCall(*camera, rawrbox::DrawPass::PASS_WORLD);
 			camera->end();
@@ -453,6 +470,8 @@ namespace rawrbox {
 		// ------------------
 
 		// Perform overlay, only MAIN camera does it --
+		if (culledCamera != rawrbox::MAIN_CAMERA) this->_culling->cull(rawrbox::MAIN_CAMERA->getViewProjMtx());
+		rawrbox::GEOMETRY::unbind();
 		this->_drawCall(*rawrbox::MAIN_CAMERA, rawrbox::DrawPass::PASS_OVERLAY);
 		if (this->_stencil != nullptr) this->_stencil->render();
 		// ---------------------------------------------
@@ -489,6 +508,8 @@ namespace rawrbox {
 	void RendererBase::frame() {
 		this->_swapChain->Present(this->_vsync ? 1 : 0); // Submit
 		rawrbox::FRAME = this->_context->GetFrameNumber();
+
+		rawrbox::RenderQueue::frame();
 	}
 
 	// INTRO ------
@@ -652,6 +673,7 @@ namespace rawrbox {
 	rawrbox::CameraBase* RendererBase::getActiveCamera() const { return rawrbox::MAIN_CAMERA; }
 
 	rawrbox::Stencil* RendererBase::stencil() const { return this->_stencil.get(); }
+	const std::shared_ptr<rawrbox::CullingList>& RendererBase::culling() const { return this->_culling; }
 
 	Diligent::IDeviceContext* RendererBase::context() const { return this->_context; }
 	Diligent::ISwapChain* RendererBase::swapChain() const { return this->_swapChain; }
@@ -47,6 +47,8 @@ namespace rawrbox {
 		       fileExtention == ".gif" ||
 		       fileExtention == ".tga" ||
 		       fileExtention == ".webp" ||
+		       fileExtention == ".ktx2" ||
+		       fileExtention == ".dds" ||
 		       fileExtention == ".jpeg";
 	}
 
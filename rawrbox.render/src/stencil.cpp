@@ -3,6 +3,7 @@
 #include <rawrbox/render/bindless.hpp>
 #include <rawrbox/render/static.hpp>
 #include <rawrbox/render/stencil.hpp>
+#include <rawrbox/render/text/engine.hpp>
 #include <rawrbox/utils/time.hpp>
 
 #pragma warning(push)
@@ -10,24 +11,32 @@
 #include <stb/stb_easy_font.hpp>
 #pragma warning(pop)
 
+#include <algorithm>
+
 namespace rawrbox {
 	Stencil::Stencil(const rawrbox::Vector2u& size) : _size(size) {
 		this->_streamingVB = std::make_unique<rawrbox::StreamingBuffer>("RawrBox::Stencil::VertexBuffer", Diligent::BIND_VERTEX_BUFFER, MaxVertsInStreamingBuffer * static_cast<uint32_t>(sizeof(rawrbox::PosUVColorVertexData)), 1);
 		this->_streamingIB = std::make_unique<rawrbox::StreamingBuffer>("RawrBox::Stencil::IndexBuffer", Diligent::BIND_INDEX_BUFFER, MaxVertsInStreamingBuffer * 3 * static_cast<uint32_t>(sizeof(uint32_t)), 1);
+		this->_streamingQuads = std::make_unique<rawrbox::StreamingBuffer>("RawrBox::Stencil::QuadBuffer", Diligent::BIND_VERTEX_BUFFER, MaxQuadsInStreamingBuffer * static_cast<uint32_t>(sizeof(rawrbox::StencilQuad)), 1);
 
 		// Only supported on DX12 / Vulkan --
 		this->_streamingVB->setPersistent(true);
 		this->_streamingIB->setPersistent(true);
+		this->_streamingQuads->setPersistent(true);
 		// --------------------------
+
+		this->updateClip();
 	}
 
 	Stencil::~Stencil() {
 		this->_drawCalls.clear();
+		this->_arena.clear();
 
 		this->_2dPipeline = nullptr;
 		this->_linePipeline = nullptr;
-		this->_textPipeline = nullptr;
+		this->_quadPipeline = nullptr;
 
+		this->_streamingQuads.reset();
 		this->_streamingIB.reset();
 		this->_streamingVB.reset();
 	}
@@ -51,33 +60,88 @@ namespace rawrbox {
 		settings.topology = Diligent::PRIMITIVE_TOPOLOGY_LINE_LIST;
 		this->_linePipeline = rawrbox::PipelineUtils::createPipeline("Stencil::2DLine", settings);
 
-		settings.topology = Diligent::PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-		settings.pPS = "stencil_text.psh";
-		this->_textPipeline = rawrbox::PipelineUtils::createPipeline("Stencil::2DText", settings);
+		// Instanced quads, 4 strip vertices from SV_VertexID
+		settings.topology = Diligent::PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+		settings.pVS = "stencil_quad.vsh";
+		settings.layout = rawrbox::StencilQuad::vLayout();
+		this->_quadPipeline = rawrbox::PipelineUtils::createPipeline("Stencil::2DQuad", settings);
 		// -------------
 	}
 
 	void Stencil::resize(const rawrbox::Vector2u& size) {
 		this->_size = size;
+		this->updateClip();
 	}
 
 	void Stencil::pushVertice(const uint32_t& textureID, rawrbox::Vector2f pos, const rawrbox::Vector4f& uv, const rawrbox::Color& col) {
+		this->pushVertice(textureID, pos, uv, col.pack());
+	}
+
+	void Stencil::pushVertice(const uint32_t& textureID, rawrbox::Vector2f pos, const rawrbox::Vector4f& uv, uint32_t col) {
 		this->applyScale(pos);
 		this->applyRotation(pos);
 
-		this->_currentDraw.vertices.emplace_back(textureID,
+		auto& vertex = this->_arena.pushVertex(textureID,
 		    rawrbox::Vector2f(pos.x + this->_offset.x, pos.y + this->_offset.y),
 		    uv,
 		    col);
+
+		vertex.clip = this->_clipRect;
 	}
 
-	void Stencil::pushIndices(std::vector<uint32_t> ind) {
-		this->_currentDraw.indices.insert(this->_currentDraw.indices.end(), ind.begin(), ind.end());
+	void Stencil::pushQuad(const uint32_t& textureID, rawrbox::Vector2f min, rawrbox::Vector2f max, const rawrbox::Vector2f& uvStart, const rawrbox::Vector2f& uvEnd, float slice, float flag, uint32_t col) {
+		if (this->_currentDraw.instanced) {
+			// Scale keeps it axis aligned, rotated quads never get here
+			this->applyScale(min);
+			this->applyScale(max);
+
+			min += this->_offset;
+			max += this->_offset;
+
+			// Fully clipped quads never reach the GPU
+			const auto& clip = this->_clipRect;
+			if (std::max(min.x, max.x) <= clip[0] || std::min(min.x, max.x) >= clip[2] || std::max(min.y, max.y) <= clip[1] || std::min(min.y, max.y) >= clip[3]) return;
+
+			auto& quad = this->_arena.pushInstance();
+			quad.rect = {min.x, min.y, max.x - min.x, max.y - min.y};
+			quad.uv = {uvStart.x, uvStart.y, uvEnd.x, uvEnd.y};
+			quad.color = col;
+			quad.textureID = textureID;
+			quad.slice = slice;
+			quad.flag = flag;
+			quad.clip = clip;
+			return;
+		}
+
+		this->pushVertice(textureID, min, {uvStart.x, uvStart.y, slice, flag}, col);
+		this->pushVertice(textureID, {min.x, max.y}, {uvStart.x, uvEnd.y, slice, flag}, col);
+		this->pushVertice(textureID, {max.x, min.y}, {uvEnd.x, uvStart.y, slice, flag}, col);
+		this->pushVertice(textureID, max, {uvEnd.x, uvEnd.y, slice, flag}, col);
+
+		this->_arena.pushQuad(this->_currentDraw.range);
 	}
 
 	void Stencil::applyRotation(rawrbox::Vector2f& vert) const {
 		if (this->_rotation.rotation == 0) return;
 
+		rawrbox::Vector4f v = {vert.x, vert.y, 0, -1.0F};
+		auto res = this->_rotationMtx.mulVec(v);
+
+		vert.x = res.x;
+		vert.y = res.y;
+	}
+
+	void Stencil::applyScale(rawrbox::Vector2f& vert) const {
+		if (this->_scale == 0) return;
+
+		rawrbox::Vector4f v = {vert.x, vert.y, 0, -1.0F};
+		auto res = this->_scaleMtx.mulVec(v);
+
+		vert.x = res.x;
+		vert.y = res.y;
+	}
+
+	void Stencil::updateRotation() {
 		rawrbox::Matrix4x4 translationMatrix = {};
 		translationMatrix.translate({-_rotation.origin.x, -_rotation.origin.y, 0});
 
@@ -87,26 +151,38 @@ namespace rawrbox {
 		rawrbox::Matrix4x4 reverseTranslationMatrix = {};
 		reverseTranslationMatrix.translate({_rotation.origin.x, _rotation.origin.y, 0});
 
-		rawrbox::Matrix4x4 mul = translationMatrix * rotationMatrix * reverseTranslationMatrix;
-
-		rawrbox::Vector4f v = {vert.x, vert.y, 0, -1.0F};
-		auto res = mul.mulVec(v);
+		this->_rotationMtx = translationMatrix * rotationMatrix * reverseTranslationMatrix;
+	}
 
-		vert.x = res.x;
-		vert.y = res.y;
+	void Stencil::updateScale() {
+		this->_scaleMtx = {};
+		this->_scaleMtx.scale({this->_scale.x, this->_scale.y, 1.F});
 	}
 
-	void Stencil::applyScale(rawrbox::Vector2f& vert) {
-		if (this->_scale == 0) return;
+	void Stencil::updateClip() {
+		uint32_t left = 0;
+		uint32_t top = 0;
+		uint32_t right = this->_size.x;
+		uint32_t bottom = this->_size.y;
 
-		rawrbox::Matrix4x4 scaleMtx = {};
-		scaleMtx.scale({this->_scale.x, this->_scale.y, 1.F});
+		if (!this->_clips.empty()) {
+			const auto& clip = this->_clips.back();
 
-		rawrbox::Vector4f v = {vert.x, vert.y, 0, -1.0F};
-		auto res = scaleMtx.mulVec(v);
+			if (clip.worldSpace) {
+				left = clip.bbox.pos.x;
+				top = clip.bbox.pos.y;
+				right = clip.bbox.size.x;
+				bottom = clip.bbox.size.y;
+			} else {
+				left = clip.bbox.left();
+				top = clip.bbox.top();
+				right = clip.bbox.right();
+				bottom = clip.bbox.bottom();
+			}
+		}
 
-		vert.x = res.x;
-		vert.y = res.y;
+		auto toPixel = [](uint32_t val, uint32_t max) { return static_cast<uint16_t>(std::min({val, max, 0xFFFFU})); };
+		this->_clipRect = {toPixel(left, this->_size.x), toPixel(top, this->_size.y), toPixel(right, this->_size.x), toPixel(bottom, this->_size.y)};
 	}
 
 	rawrbox::Vector2f Stencil::alignPosition(const rawrbox::Vector2f& pos, const rawrbox::Vector2f& size, rawrbox::Alignment alignX, rawrbox::Alignment alignY) const {
@@ -164,7 +240,7 @@ namespace rawrbox {
 			for (const auto& v : poly.verts)
 				this->pushVertice(textureID, v.pos, v.uv, v.col);
 
-			this->_currentDraw.indices.insert(this->_currentDraw.indices.end(), poly.indices.begin(), poly.indices.end());
+			this->_arena.pushIndices(poly.indices.begin(), poly.indices.end());
 		}
 
 		// Add to calls
@@ -191,7 +267,7 @@ namespace rawrbox {
 			this->pushVertice(textureID, b, bUV, colB);
 			this->pushVertice(textureID, c, cUV, colC);
 
-			this->pushIndices({0, 1, 2});
+			this->_arena.pushIndices({0, 1, 2});
 		}
 
 		// Add to calls
@@ -216,19 +292,12 @@ namespace rawrbox {
 		if (col.invisible()) return;
 
 		// Setup --------
-		this->setupDrawCall(this->_2dPipeline);
+		const bool instanced = this->_rotation.rotation == 0;
+		this->setupDrawCall(instanced ? this->_quadPipeline : this->_2dPipeline, instanced);
 		// ----
 
-		auto textureID = tex.getTextureID();
 		auto a = slice == -1 ? tex.getSlice() : static_cast<float>(slice);
-
-		this->pushVertice(textureID, {pos.x, pos.y}, {uvStart.x, uvStart.y, a}, col);
-		this->pushVertice(textureID, {pos.x, pos.y + size.y}, {uvStart.x, uvEnd.y, a}, col);
-		this->pushVertice(textureID, {pos.x + size.x, pos.y}, {uvEnd.x, uvStart.y, a}, col);
-		this->pushVertice(textureID, {pos.x + size.x, pos.y + size.y}, {uvEnd.x, uvEnd.y, a}, col);
-
-		this->pushIndices({0, 1, 2,
-		    1, 3, 2});
+		this->pushQuad(tex.getTextureID(), pos, pos + size, uvStart, uvEnd, a, 0.F, col.pack());
 
 		// Add to calls
 		this->pushDrawCall();
@@ -274,7 +343,7 @@ namespace rawrbox {
 		uint32_t textureID = rawrbox::WHITE_TEXTURE->getTextureID();
 
 		bool usePTLines = outline.thickness == 1.F;
-		float enableStipple = outline.stipple > 0.F ? 1.F : 0.F;
+		float enableStipple = static_cast<float>(outline.stipple > 0.F ? rawrbox::StencilMode::STIPPLE : rawrbox::StencilMode::TEXTURE);
 
 		// Setup --------
 		this->setupDrawCall(usePTLines ? this->_linePipeline : this->_2dPipeline);
@@ -283,7 +352,7 @@ namespace rawrbox {
 		if (usePTLines) {
 			this->pushVertice(textureID, from, {0, 0, 0, enableStipple}, col);
 			this->pushVertice(textureID, to, {outline.stipple, outline.stipple, 0, enableStipple}, col);
-			this->pushIndices({0, 1});
+			this->_arena.pushIndices({0, 1});
 		} else {
 			float angle = -from.angle(to);
 			float uvEnd = outline.stipple <= 0.F ? 1.F : outline.stipple;
@@ -298,8 +367,7 @@ namespace rawrbox {
 			this->pushVertice(textureID, vertC, {uvEnd, 0, 0, enableStipple}, col);
 			this->pushVertice(textureID, vertD, {uvEnd, uvEnd, 0, enableStipple}, col);
 
-			this->pushIndices({0, 1, 2,
-			    1, 3, 2});
+			this->_arena.pushQuad(this->_currentDraw.range);
 		}
 
 		// Add to calls
@@ -339,7 +407,7 @@ namespace rawrbox {
 		int num_quads = stb_easy_font_print(0, 0, textCh, nullptr, vertexBuffer.data(), static_cast<int>(vertexBuffer.size()));
 
 		auto* data = std::bit_cast<float*>(vertexBuffer.data());
-		std::vector<uint32_t> indices = {};
+		this->_arena.reserve(static_cast<size_t>(num_quads) * 4, static_cast<size_t>(num_quads) * 6, 0);
 
 		for (int quad = 0, stride = 0; quad < num_quads; ++quad, stride += 16) {
 			// Push vertices for the current quad
@@ -350,16 +418,10 @@ namespace rawrbox {
 
 			// Generate indices for the current quad
 			uint32_t base_index = quad * 4; //  4 vertices per quad
-			indices.push_back(base_index);
-			indices.push_back(base_index + 1);
-			indices.push_back(base_index + 2);
-			indices.push_back(base_index + 2);
-			indices.push_back(base_index + 3);
-			indices.push_back(base_index);
+			this->_arena.pushIndices({base_index, base_index + 1, base_index + 2,
+			    base_index + 2, base_index + 3, base_index});
 		}
 
-		this->pushIndices(indices);
-
 		// Add to calls
 		this->pushDrawCall();
 		// ----
@@ -368,33 +430,46 @@ namespace rawrbox {
 	void Stencil::drawText(const rawrbox::Font& font, const std::string& text, const rawrbox::Vector2f& pos, const rawrbox::Color& col, rawrbox::Alignment alignX, rawrbox::Alignment alignY) {
 		if (col.invisible() || text.empty()) return;
 
-		rawrbox::Vector2f tsize = font.getStringSize(text);
-		rawrbox::Vector2f startpos = this->alignPosition(pos, tsize, alignX, alignY);
+		const auto& layout = rawrbox::TextLayoutCache::get(font, text);
+		this->drawText(layout, this->alignPosition(pos, layout.getSize(), alignX, alignY), col);
+	}
+
+	void Stencil::drawText(const rawrbox::TextLayout& layout, const rawrbox::Vector2f& pos, const rawrbox::Color& col) {
+		if (col.invisible() || layout.empty()) return;
+
+		const auto& glyphs = layout.getGlyphs();
+		const uint32_t color = col.pack();
+		const float mode = static_cast<float>(layout.isSDF() ? rawrbox::StencilMode::GLYPH_SDF : rawrbox::StencilMode::GLYPH); // Tells the shader how to read the atlas
 
-		font.render(text, startpos, false, [this, &font, col](rawrbox::Glyph* glyph, float x0, float y0, float x1, float y1) {
-			uint32_t textureID = font.getPackTexture(glyph)->getTextureID();
+		// Setup --------
+		const bool instanced = this->_rotation.rotation == 0;
+		this->setupDrawCall(instanced ? this->_quadPipeline : this->_2dPipeline, instanced);
+		// ----
 
-			// Setup --------
-			this->setupDrawCall(this->_textPipeline);
-			// ----
+		if (instanced) {
+			this->_arena.reserve(0, 0, glyphs.size());
+		} else {
+			this->_arena.reserve(glyphs.size() * 4, glyphs.size() * 6, 0);
+		}
 
-			this->pushVertice(textureID, {x0, y0}, glyph->textureTopLeft, col);
-			this->pushVertice(textureID, {x0, y1}, {glyph->textureTopLeft.x, glyph->textureBottomRight.y}, col);
-			this->pushVertice(textureID, {x1, y0}, {glyph->textureBottomRight.x, glyph->textureTopLeft.y}, col);
-			this->pushVertice(textureID, {x1, y1}, glyph->textureBottomRight, col);
+		// Whole string is one draw, every glyph carries its own atlas id
+		rawrbox::TexturePack* pack = nullptr;
+		for (const auto& glyph : glyphs) {
+			if (pack == nullptr || pack->getTextureID() != glyph.textureID) pack = rawrbox::TextEngine::getPack(glyph.packID);
+			pack->touchSprite(glyph.spriteID); // Drawn glyphs are evicted last
 
-			this->pushIndices({0, 1, 2,
-			    1, 3, 2});
+			this->pushQuad(glyph.textureID, pos + glyph.min, pos + glyph.max, glyph.uvMin, glyph.uvMax, 0.F, mode, color);
+		}
 
-			// Add to calls
-			this->pushDrawCall();
-			// ----
-		});
+		// Add to calls
+		this->pushDrawCall();
+		// ----
 	}
 
 	void Stencil::drawLoading(const rawrbox::Vector2f& pos, const rawrbox::Vector2f& size, const rawrbox::Color& color) {
 		// Setup --------
-		this->setupDrawCall(this->_2dPipeline);
+		const bool instanced = this->_rotation.rotation == 0;
+		this->setupDrawCall(instanced ? this->_quadPipeline : this->_2dPipeline, instanced);
 		// ----
 
 		const auto textureID = rawrbox::CHECKER_TEXTURE->getTextureID();
@@ -402,13 +477,7 @@ namespace rawrbox {
 		if ((LOAD_OFFSET % static_cast<uint32_t>(size.x * size.y)) == 0U) LOAD_OFFSET = 0U;
 
 		float offset = static_cast<float>(LOAD_OFFSET) * 0.0005F;
-		this->pushVertice(textureID, {pos.x, pos.y}, {offset, 1.F + offset, 0.F}, color);
-		this->pushVertice(textureID, {pos.x, pos.y + size.y}, {offset, offset, 0.F}, color);
-		this->pushVertice(textureID, {pos.x + size.x, pos.y}, {1.F + offset, 1.F + offset, 0.F}, color);
-		this->pushVertice(textureID, {pos.x + size.x, pos.y + size.y}, {1.F + offset, offset, 0.F}, color);
-
-		this->pushIndices({0, 1, 2,
-		    1, 3, 2});
+		this->pushQuad(textureID, pos, pos + size, {offset, 1.F + offset}, {1.F + offset, offset}, 0.F, 0.F, color.pack());
 
 		// Add to calls
 		this->pushDrawCall();
@@ -422,8 +491,12 @@ namespace rawrbox {
 		this->setupDrawCall(this->_2dPipeline);
 		// ----
 
-		this->_currentDraw.vertices = vertices;
-		this->_currentDraw.indices = indices;
+		this->_arena.reserve(vertices.size(), indices.size(), 0);
+		for (const auto& vertex : vertices) {
+			this->_arena.pushVertex(vertex).clip = this->_clipRect;
+		}
+
+		this->_arena.pushIndices(indices.begin(), indices.end());
 
 		// Add to calls
 		this->pushDrawCall();
@@ -432,104 +505,181 @@ namespace rawrbox {
 	// --------------------
 
 	// ------RENDERING
-	void Stencil::setupDrawCall(Diligent::IPipelineState* program) {
+	void Stencil::setupDrawCall(Diligent::IPipelineState* program, bool instanced) {
 		this->_currentDraw.clear();
 
 		this->_currentDraw.optimize = this->_optimizations.empty() ? true : this->_optimizations.back();
 		this->_currentDraw.stencilProgram = program;
-		this->_currentDraw.clip = this->_clips.empty() ? rawrbox::Clip{{0, 0, this->_size.x, this->_size.y}} : this->_clips.back();
+		this->_currentDraw.instanced = instanced;
+		this->_currentDraw.range = this->_arena.begin();
 	}
 
 	void Stencil::pushDrawCall() {
+		auto& range = this->_currentDraw.range;
+
+		this->_arena.end(range);
+		if (range.empty()) return; // Nothing drawn, or a nested draw already added it
+
+		// Stats ----
+		if (this->_frameStats.calls != 0 && this->_clipRect != this->_lastClipRect) this->_frameStats.clipChanges++;
+
+		this->_frameStats.calls++;
+		this->_lastClipRect = this->_clipRect;
+		// ----------
+
+		// Clipping is per vertex, only state the shader can't see splits draws
 		if (this->_currentDraw.optimize && !this->_drawCalls.empty()) {
 			auto& oldCall = this->_drawCalls.back();
 
-			bool canMerge = oldCall.clip == this->_currentDraw.clip &&
-					oldCall.cull == this->_currentDraw.cull &&
+			bool canMerge = oldCall.cull == this->_currentDraw.cull &&
 					oldCall.stencilProgram == this->_currentDraw.stencilProgram &&
-					oldCall.vertices.size() + this->_currentDraw.vertices.size() < MaxVertsInStreamingBuffer;
+					oldCall.instanced == this->_currentDraw.instanced &&
+					oldCall.range.vertexCount + range.vertexCount < MaxVertsInStreamingBuffer &&
+					oldCall.range.indexCount + range.indexCount <= MaxVertsInStreamingBuffer * 3 &&
+					oldCall.range.instanceCount + range.instanceCount <= MaxQuadsInStreamingBuffer;
 
 			if (canMerge) {
-				for (auto& ind : this->_currentDraw.indices) {
-					oldCall.indices.push_back(static_cast<uint32_t>(oldCall.vertices.size()) + ind);
-				}
-
-				oldCall.vertices.insert(oldCall.vertices.end(), this->_currentDraw.vertices.begin(), this->_currentDraw.vertices.end());
+				this->_arena.merge(oldCall.range, range);
+				range = this->_arena.begin();
 				return;
 			}
 		}
 
-		this->_drawCalls.emplace_back(this->_currentDraw);
+		this->_drawCalls.push_back(this->_currentDraw);
+		range = this->_arena.begin();
 	}
 
 	void Stencil::internalDraw() {
-		if (this->_drawCalls.empty()) return;
+		if (this->_drawCalls.empty()) {
+			this->_arena.clear();
+
+			this->_stats = this->_frameStats;
+			this->_frameStats = {};
+			return;
+		}
 
 		auto* context = rawrbox::RENDERER->context();
 		size_t contextID = 0;
 
-		for (auto& group : this->_drawCalls) {
-			if (group.stencilProgram == nullptr) continue;
-			if (group.vertices.empty() || group.indices.empty()) continue;
+		// Clip rects travel with the vertices, the scissor only covers the target
+		Diligent::Rect scissor = {0, 0, static_cast<int>(this->_size.x), static_cast<int>(this->_size.y)};
+		context->SetScissorRects(1, &scissor, this->_size.x, this->_size.y);
+
+		const auto& vertices = this->_arena.getVertices();
+		const auto& indices = this->_arena.getIndices();
+		const auto& quads = this->_arena.getInstances();
+
+		size_t first = 0;
+		while (first < this->_drawCalls.size()) {
+			// Calls are back to back in the arena, upload as many as the buffers hold in one go
+			size_t last = first;
+			uint32_t vertSize = 0;
+			uint32_t indSize = 0;
+			uint32_t quadSize = 0;
+
+			for (; last < this->_drawCalls.size(); last++) {
+				const auto& range = this->_drawCalls[last].range;
+				if (last != first && (vertSize + range.vertexCount > MaxVertsInStreamingBuffer || indSize + range.indexCount > MaxVertsInStreamingBuffer * 3 || quadSize + range.instanceCount > MaxQuadsInStreamingBuffer)) break;
+
+				vertSize += range.vertexCount;
+				indSize += range.indexCount;
+				quadSize += range.instanceCount;
+			}
 
-			auto vertSize = static_cast<uint32_t>(group.vertices.size());
-			auto indSize = static_cast<uint32_t>(group.indices.size());
+			const auto& start = this->_drawCalls[first].range;
 
 			// Allocate data -----
-			auto VBOffset = static_cast<uint64_t>(this->_streamingVB->allocate(vertSize * sizeof(rawrbox::PosUVColorVertexData), contextID));
-			auto IBOffset = static_cast<uint64_t>(this->_streamingIB->allocate(indSize * sizeof(uint32_t), contextID));
+			uint64_t VBOffset = 0;
+			uint64_t IBOffset = 0;
+			uint64_t QuadOffset = 0;
 
-			auto* VertexData = std::bit_cast<rawrbox::PosUVColorVertexData*>(std::bit_cast<uint8_t*>(this->_streamingVB->getCPUAddress(contextID)) + VBOffset);
-			auto* IndexData = std::bit_cast<uint32_t*>(std::bit_cast<uint8_t*>(this->_streamingIB->getCPUAddress(contextID)) + IBOffset);
+			if (vertSize > 0) {
+				VBOffset = static_cast<uint64_t>(this->_streamingVB->allocate(vertSize * sizeof(rawrbox::PosUVColorVertexData), contextID));
+				IBOffset = static_cast<uint64_t>(this->_streamingIB->allocate(indSize * sizeof(uint32_t), contextID));
 
-			std::memcpy(VertexData, group.vertices.data(), vertSize * sizeof(rawrbox::PosUVColorVertexData));
-			std::memcpy(IndexData, group.indices.data(), indSize * sizeof(uint32_t));
+				auto* VertexData = std::bit_cast<uint8_t*>(this->_streamingVB->getCPUAddress(contextID)) + VBOffset;
+				auto* IndexData = std::bit_cast<uint8_t*>(this->_streamingIB->getCPUAddress(contextID)) + IBOffset;
 
-			this->_streamingVB->release(contextID);
-			this->_streamingIB->release(contextID);
-			//  -------------------
+				std::memcpy(VertexData, vertices.data() + start.vertexStart, vertSize * sizeof(rawrbox::PosUVColorVertexData));
+				std::memcpy(IndexData, indices.data() + start.indexStart, indSize * sizeof(uint32_t));
 
-			// Render ------------
-			auto* vertBuffer = this->_streamingVB->buffer();
-
-			context->SetVertexBuffers(0, 1, &vertBuffer, &VBOffset, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY, Diligent::SET_VERTEX_BUFFERS_FLAG_RESET);
-			context->SetIndexBuffer(this->_streamingIB->buffer(), IBOffset, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
-			context->SetPipelineState(group.stencilProgram);
-			// --------------
-
-			// SCISSOR ---
-			Diligent::Rect scissor;
-			if (group.clip.worldSpace) {
-				scissor.left = std::max<int>(group.clip.bbox.pos.x, 0);
-				scissor.top = std::max<int>(group.clip.bbox.pos.y, 0);
-				scissor.right = std::min<int>(group.clip.bbox.size.x, this->_size.x);
-				scissor.bottom = std::min<int>(group.clip.bbox.size.y, this->_size.y);
-			} else {
-				scissor.left = std::max<int>(group.clip.bbox.left(), 0);
-				scissor.top = std::max<int>(group.clip.bbox.top(), 0);
-				scissor.right = std::min<int>(group.clip.bbox.right(), this->_size.x);
-				scissor.bottom = std::min<int>(group.clip.bbox.bottom(), this->_size.y);
+				this->_streamingVB->release(contextID);
+				this->_streamingIB->release(contextID);
 			}
 
-			if (scissor.IsValid()) {
-				context->SetScissorRects(1, &scissor, this->_size.x, this->_size.y);
+			if (quadSize > 0) {
+				QuadOffset = static_cast<uint64_t>(this->_streamingQuads->allocate(quadSize * sizeof(rawrbox::StencilQuad), contextID));
+
+				auto* QuadData = std::bit_cast<uint8_t*>(this->_streamingQuads->getCPUAddress(contextID)) + QuadOffset;
+				std::memcpy(QuadData, quads.data() + start.instanceStart, quadSize * sizeof(rawrbox::StencilQuad));
+
+				this->_streamingQuads->release(contextID);
 			}
-			// -----------
+			//  -------------------
 
-			Diligent::DrawIndexedAttribs DrawAttrs;
-			DrawAttrs.IndexType = Diligent::VT_UINT32;
-			DrawAttrs.Flags = Diligent::DRAW_FLAG_VERIFY_ALL | Diligent::DRAW_FLAG_DYNAMIC_RESOURCE_BUFFERS_INTACT;
-			DrawAttrs.NumIndices = indSize;
-			DrawAttrs.BaseVertex = 0;
+			// Render ------------
+			int bound = -1; // 0 = vertices, 1 = quads
+			Diligent::IPipelineState* program = nullptr;
+
+			for (size_t i = first; i < last; i++) {
+				const auto& group = this->_drawCalls[i];
+				if (group.stencilProgram == nullptr || group.range.empty()) continue;
+
+				if (group.instanced && bound != 1) {
+					auto* quadBuffer = this->_streamingQuads->buffer();
+					context->SetVertexBuffers(0, 1, &quadBuffer, &QuadOffset, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY, Diligent::SET_VERTEX_BUFFERS_FLAG_RESET);
+					bound = 1;
+				} else if (!group.instanced && bound != 0) {
+					auto* vertBuffer = this->_streamingVB->buffer();
+					context->SetVertexBuffers(0, 1, &vertBuffer, &VBOffset, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY, Diligent::SET_VERTEX_BUFFERS_FLAG_RESET);
+					context->SetIndexBuffer(this->_streamingIB->buffer(), IBOffset, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+					bound = 0;
+				}
+
+				if (program != group.stencilProgram) {
+					context->SetPipelineState(group.stencilProgram);
+					program = group.stencilProgram;
+				}
+
+				if (group.instanced) {
+					Diligent::DrawAttribs DrawAttrs;
+					DrawAttrs.Flags = Diligent::DRAW_FLAG_VERIFY_ALL | Diligent::DRAW_FLAG_DYNAMIC_RESOURCE_BUFFERS_INTACT;
+					DrawAttrs.NumVertices = 4; // QUAD
+					DrawAttrs.NumInstances = group.range.instanceCount;
+					DrawAttrs.FirstInstanceLocation = group.range.instanceStart - start.instanceStart;
+
+					context->Draw(DrawAttrs);
+				} else {
+					Diligent::DrawIndexedAttribs DrawAttrs;
+					DrawAttrs.IndexType = Diligent::VT_UINT32;
+					DrawAttrs.Flags = Diligent::DRAW_FLAG_VERIFY_ALL | Diligent::DRAW_FLAG_DYNAMIC_RESOURCE_BUFFERS_INTACT;
+					DrawAttrs.NumIndices = group.range.indexCount;
+					DrawAttrs.FirstIndexLocation = group.range.indexStart - start.indexStart;
+					DrawAttrs.BaseVertex = group.range.vertexStart - start.vertexStart;
+
+					context->DrawIndexed(DrawAttrs);
+				}
 
-			context->DrawIndexed(DrawAttrs);
+				this->_frameStats.draws++;
+			}
 			// -------------------
+
+			first = last;
 		}
 
+		this->_streamingQuads->flush(contextID);
 		this->_streamingIB->flush(contextID);
 		this->_streamingVB->flush(contextID);
 
+		this->_frameStats.vertices = static_cast<uint32_t>(vertices.size());
+		this->_frameStats.indices = static_cast<uint32_t>(indices.size());
+		this->_frameStats.quads = static_cast<uint32_t>(quads.size());
+
+		this->_stats = this->_frameStats;
+		this->_frameStats = {};
+
 		this->_drawCalls.clear();
+		this->_arena.clear();
 	}
 
 	void Stencil::render() {
@@ -572,6 +722,8 @@ namespace rawrbox {
 	void Stencil::pushRotation(const rawrbox::StencilRotation& rot) {
 		this->_rotations.push_back(rot);
 		this->_rotation += rot;
+
+		this->updateRotation();
 	}
 
 	void Stencil::popRotation() {
@@ -579,6 +731,8 @@ namespace rawrbox {
 
 		this->_rotation -= this->_rotations.back();
 		this->_rotations.pop_back();
+
+		this->updateRotation();
 	}
 	// --------------------
 
@@ -602,11 +756,14 @@ namespace rawrbox {
 		fixedClip.bbox.pos = clip.bbox.pos + this->_offset.cast<uint32_t>();
 
 		this->_clips.emplace_back(fixedClip);
+		this->updateClip();
 	}
 
 	void Stencil::popClipping() {
 		if (this->_clips.empty()) RAWRBOX_CRITICAL("Clips is empty, failed to pop");
+
 		this->_clips.pop_back();
+		this->updateClip();
 	}
 	// --------------------
 
@@ -614,6 +771,8 @@ namespace rawrbox {
 	void Stencil::pushScale(const rawrbox::Vector2f& scale) {
 		this->_scales.push_back(scale);
 		this->_scale += scale;
+
+		this->updateScale();
 	}
 
 	void Stencil::popScale() {
@@ -621,6 +780,8 @@ namespace rawrbox {
 
 		this->_scale -= this->_scales.back();
 		this->_scales.pop_back();
+
+		this->updateScale();
 	}
 	// --------------------
 
@@ -637,8 +798,14 @@ namespace rawrbox {
 
 	// ------ OTHER
 	const rawrbox::Vector2u& Stencil::getSize() const { return this->_size; }
-	std::vector<rawrbox::StencilDraw> Stencil::getDrawCalls() const { return this->_drawCalls; }
+	const std::vector<rawrbox::StencilDraw>& Stencil::getDrawCalls() const { return this->_drawCalls; }
+	const rawrbox::DrawArena<rawrbox::PosUVColorVertexData, rawrbox::StencilQuad>& Stencil::getArena() const { return this->_arena; }
+	const rawrbox::StencilStats& Stencil::getStats() const { return this->_stats; }
 
-	void Stencil::clear() { this->_drawCalls.clear(); }
+	void Stencil::clear() {
+		this->_drawCalls.clear();
+		this->_arena.clear();
+		this->_frameStats = {};
+	}
 	// --------------------
 } // namespace rawrbox
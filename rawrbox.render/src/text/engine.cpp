@@ -1,10 +1,13 @@
 #include <rawrbox/render/static.hpp>
 #include <rawrbox/render/text/engine.hpp>
+#include <rawrbox/render/text/layout.hpp>
 #include <rawrbox/utils/file.hpp>
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <array>
+#include <unordered_set>
 
 #if WIN32
 	#include <windows.h>
@@ -14,6 +17,8 @@ namespace rawrbox {
 	// PROTECTED ----
 	std::map<std::string, std::unique_ptr<rawrbox::Font>> TextEngine::_fonts = {};
 	std::map<uint16_t, std::unique_ptr<rawrbox::TexturePack>> TextEngine::_packs = {};
+	std::map<std::string, std::unordered_map<uint32_t, rawrbox::Glyph>> TextEngine::_distanceFields = {};
+	size_t TextEngine::_maxPacks = 4;
 
 	// LOGGER ------
 	std::unique_ptr<rawrbox::Logger> TextEngine::_logger = std::make_unique<rawrbox::Logger>("RawrBox-TextEngine");
@@ -35,23 +40,101 @@ namespace rawrbox {
 #endif
 	}
 
+	// ATLAS ---
+	bool TextEngine::reclaim(uint16_t id, rawrbox::TexturePack& pack, uint16_t width, uint16_t height) {
+		if (pack.getOccupancy() < DEFRAGMENT_OCCUPANCY) {
+			relocateGlyphs(id, pack.defragment());
+			if (pack.canInsertNode(width, height)) return true;
+		}
+
+		evictGlyphs(id, pack.evictSprites(width, height));
+		return pack.canInsertNode(width, height);
+	}
+
+	void TextEngine::evictGlyphs(uint16_t id, const std::vector<rawrbox::AtlasRect>& evicted) {
+		if (evicted.empty()) return;
+
+		std::unordered_set<uint64_t> sprites = {};
+		for (const auto& rect : evicted) {
+			sprites.insert(rect.id);
+		}
+
+		for (auto& field : _distanceFields) {
+			std::erase_if(field.second, [id, &sprites](const auto& glyph) { return glyph.second.packID == id && sprites.contains(glyph.second.spriteID); });
+		}
+
+		for (auto& font : _fonts) {
+			auto generation = font.second->getGeneration();
+
+			font.second->evictGlyphs(id, sprites);
+			if (font.second->getGeneration() != generation) rawrbox::TextLayoutCache::invalidate(*font.second);
+		}
+	}
+
+	void TextEngine::relocateGlyphs(uint16_t id, const std::vector<rawrbox::AtlasRelocation>& relocations) {
+		if (relocations.empty()) return;
+
+		std::unordered_map<uint64_t, rawrbox::AtlasRect> moved = {};
+		for (const auto& move : relocations) {
+			moved[move.id] = move.to;
+		}
+
+		auto size = getPack(id)->getSize();
+		for (auto& field : _distanceFields) {
+			for (auto& glyph : field.second) {
+				if (glyph.second.packID != id) continue;
+
+				auto fnd = moved.find(glyph.second.spriteID);
+				if (fnd == moved.end()) continue;
+
+				const auto& rect = fnd->second;
+				glyph.second.textureTopLeft = {rect.x / static_cast<float>(size.x), rect.y / static_cast<float>(size.y)};
+				glyph.second.textureBottomRight = {(rect.x + rect.width) / static_cast<float>(size.x), (rect.y + rect.height) / static_cast<float>(size.y)};
+			}
+		}
+
+		for (auto& font : _fonts) {
+			auto generation = font.second->getGeneration();
+
+			font.second->relocateGlyphs(id, moved);
+			if (font.second->getGeneration() != generation) rawrbox::TextLayoutCache::invalidate(*font.second);
+		}
+	}
+	// -------
+
 	void TextEngine::shutdown() {
+		rawrbox::TextLayoutCache::clear(); // Keyed by font pointers
 		_fonts.clear();
 		_packs.clear();
+		_distanceFields.clear();
 		_logger.reset();
 
 		TextEngine::packID = 0;
 	}
 
 	std::pair<uint16_t, rawrbox::TexturePack*> TextEngine::requestPack(uint16_t width, uint16_t height, Diligent::TEXTURE_FORMAT format) {
+		const uint8_t channels = format == Diligent::TEXTURE_FORMAT::TEX_FORMAT_R8_UNORM ? 1U : 4U;
+
 		// Try to find a spot
+		size_t count = 0;
 		for (auto& at : _packs) {
+			if (at.second->getChannels() != channels) continue;
 			if (at.second->canInsertNode(width, height)) return {at.first, at.second.get()};
+
+			count++;
 		}
 
-		// Ok, make a new pack then
+		// Out of budget, make room in an existing pack instead, oldest first
+		if (count >= _maxPacks && width <= PACK_SIZE && height <= PACK_SIZE) {
+			for (auto& at : _packs) {
+				if (at.second->getChannels() != channels) continue;
+				if (reclaim(at.first, *at.second, width, height)) return {at.first, at.second.get()};
+			}
+		}
+
+		// Ok, make a new pack then. 1 texel of padding, glyphs are sampled with filtering
 		auto id = TextEngine::packID++;
-		auto pack = std::make_unique<rawrbox::TexturePack>(512U);
+		auto pack = std::make_unique<rawrbox::TexturePack>(PACK_SIZE, 1U, channels);
 		pack->upload(format);
 
 		_packs.emplace(id, std::move(pack));
@@ -64,8 +147,39 @@ namespace rawrbox {
 		return fnd->second.get();
 	}
 
-	rawrbox::Font* TextEngine::load(const std::filesystem::path& filename, uint16_t size, uint32_t index) {
-		std::string key = fmt::format("{}-{}", filename.generic_string(), size);
+	void TextEngine::setMaxPacks(size_t max) { _maxPacks = std::max<size_t>(max, 1); }
+	size_t TextEngine::getMaxPacks() { return _maxPacks; }
+
+	// SDF ---
+	const rawrbox::Glyph* TextEngine::getDistanceField(const std::string& font, uint32_t codePoint) {
+		auto fnd = _distanceFields.find(font);
+		if (fnd == _distanceFields.end()) return nullptr;
+
+		auto glyph = fnd->second.find(codePoint);
+		if (glyph == fnd->second.end()) return nullptr;
+
+		return &glyph->second;
+	}
+
+	void TextEngine::addDistanceField(const std::string& font, const rawrbox::Glyph& glyph) {
+		_distanceFields[font][glyph.codePoint] = glyph;
+	}
+	// -------
+
+	void TextEngine::restoreGlyphs(const rawrbox::Font& font, const std::string& text) {
+		if (!font.hasEvicted()) return;
+
+		// Fonts are owned here, find the mutable one
+		for (auto& at : _fonts) {
+			if (at.second.get() != &font) continue;
+
+			at.second->restoreGlyphs(text);
+			return;
+		}
+	}
+
+	rawrbox::Font* TextEngine::load(const std::filesystem::path& filename, uint16_t size, uint32_t index, rawrbox::FontType type) {
+		std::string key = fmt::format("{}-{}-{}-{}", filename.generic_string(), size, index, type == rawrbox::FontType::SDF ? "sdf" : "alpha");
 
 		// Check cache
 		auto fnd = _fonts.find(key);
@@ -88,7 +202,7 @@ namespace rawrbox {
 		if (bytes.empty()) RAWRBOX_CRITICAL("Failed to load font '{}'", filename.generic_string());
 
 		_fonts[key] = std::make_unique<rawrbox::Font>(filename);
-		_fonts[key]->load(bytes, size, index);
+		_fonts[key]->load(bytes, size, index, type);
 
 		return _fonts[key].get();
 	}
@@ -1,6 +1,6 @@
-#include <rawrbox/math/utils/color.hpp>
 #include <rawrbox/render/text/engine.hpp>
 #include <rawrbox/render/text/font.hpp>
+#include <rawrbox/utils/threading.hpp>
 
 // NOLINTBEGIN(clang-diagnostic-unknown-pragmas)
 #pragma warning(push)
@@ -14,13 +14,16 @@
 #include <fmt/format.h>
 #include <utf8.h>
 
+#include <algorithm>
 #include <string>
+#include <unordered_set>
 
 namespace rawrbox {
 	Font::~Font() {
 		if (this->_font == nullptr) return;
 
 		this->_font.reset();
+		this->_buffer.clear();
 		this->_glyphs.clear();
 	}
 
@@ -55,13 +58,11 @@ namespace rawrbox {
 		this->_info.underlineThickness = (x1 - x0) * this->_scale / 24.F;
 	}
 
-	std::unique_ptr<rawrbox::Glyph> Font::bakeGlyphAlpha(uint32_t codePoint) {
+	rawrbox::GlyphBitmap Font::bakeGlyphAlpha(uint32_t codePoint) const {
 		if (this->_font == nullptr) RAWRBOX_CRITICAL("Font not loaded");
 
-		int32_t ascent = 0;
-		int32_t descent = 0;
-		int32_t lineGap = 0;
-		stbtt_GetFontVMetrics(this->_font.get(), &ascent, &descent, &lineGap);
+		rawrbox::GlyphBitmap bitmap = {};
+		bitmap.codePoint = codePoint;
 
 		int32_t advance = 0;
 		int32_t lsb = 0;
@@ -74,57 +75,165 @@ namespace rawrbox {
 		int32_t y1 = 0;
 		stbtt_GetCodepointBitmapBox(this->_font.get(), codePoint, scale, scale, &x0, &y0, &x1, &y1);
 
-		const auto ww = static_cast<int16_t>(x1 - x0);
-		const auto hh = static_cast<int16_t>(y1 - y0);
+		bitmap.x = x0;
+		bitmap.y = y0;
+		bitmap.width = static_cast<uint32_t>(x1 - x0);
+		bitmap.height = static_cast<uint32_t>(y1 - y0);
+		bitmap.advance = std::round(static_cast<float>(advance) * scale);
+
+		bitmap.pixels.resize(static_cast<size_t>(bitmap.width) * bitmap.height);
+		stbtt_MakeCodepointBitmap(this->_font.get(), bitmap.pixels.data(), static_cast<int>(bitmap.width), static_cast<int>(bitmap.height), static_cast<int>(bitmap.width), scale, scale, codePoint);
+
+		return bitmap;
+	}
+
+	rawrbox::GlyphBitmap Font::bakeGlyphSDF(uint32_t codePoint) const {
+		if (this->_font == nullptr) RAWRBOX_CRITICAL("Font not loaded");
+
+		rawrbox::GlyphBitmap bitmap = {};
+		bitmap.codePoint = codePoint;
+
+		int32_t advance = 0;
+		int32_t lsb = 0;
+		stbtt_GetCodepointHMetrics(this->_font.get(), codePoint, &advance, &lsb);
+
+		// Always baked at SDF_SIZE, the same field is scaled to every font size
+		const float scale = stbtt_ScaleForMappingEmToPixels(this->_font.get(), SDF_SIZE);
+		bitmap.advance = static_cast<float>(advance) * scale;
+
+		int32_t width = 0;
+		int32_t height = 0;
+		int32_t xOff = 0;
+		int32_t yOff = 0;
+
+		auto* field = stbtt_GetCodepointSDF(this->_font.get(), scale, static_cast<int>(codePoint), SDF_PADDING, SDF_EDGE, static_cast<float>(SDF_EDGE) / static_cast<float>(SDF_PADDING), &width, &height, &xOff, &yOff);
+		if (field == nullptr) return bitmap; // Empty glyph, ex: space
+
+		bitmap.x = xOff;
+		bitmap.y = yOff;
+		bitmap.width = static_cast<uint32_t>(width);
+		bitmap.height = static_cast<uint32_t>(height);
+		bitmap.pixels.assign(field, field + static_cast<size_t>(width) * height);
 
-		std::unique_ptr<rawrbox::Glyph> glyph = std::make_unique<rawrbox::Glyph>();
-		glyph->codePoint = codePoint;
-		glyph->offset = {static_cast<float>(x0), static_cast<float>(y0)};
-		glyph->size = {static_cast<float>(ww), static_cast<float>(hh)};
-		glyph->advance = {std::round(static_cast<float>(advance) * scale), std::round((static_cast<float>(ascent + descent + lineGap)) * scale)};
+		stbtt_FreeSDF(field, nullptr);
+		return bitmap;
+	}
 
-		// Bitmap ----
-		uint16_t bpp = 1;
-		uint16_t dstPitch = ww * bpp;
+	void Font::packGlyphs(std::vector<rawrbox::GlyphBitmap>& bitmaps, const std::string& key) {
+		// Tallest first, packs tighter
+		std::sort(bitmaps.begin(), bitmaps.end(), [](const rawrbox::GlyphBitmap& a, const rawrbox::GlyphBitmap& b) {
+			if (a.height != b.height) return a.height > b.height;
+			return a.width > b.width;
+		});
 
-		std::vector<uint8_t> buffer = {};
-		buffer.resize(ww * hh * sizeof(uint8_t));
-		stbtt_MakeCodepointBitmap(this->_font.get(), buffer.data(), ww, hh, dstPitch, scale, scale, codePoint);
+		int32_t ascent = 0;
+		int32_t descent = 0;
+		int32_t lineGap = 0;
+		stbtt_GetFontVMetrics(this->_font.get(), &ascent, &descent, &lineGap);
 
-		auto pack = rawrbox::TextEngine::requestPack(ww, hh, Diligent::TEXTURE_FORMAT::TEX_FORMAT_RGBA8_UNORM); // FONT_TYPE_ALPHA
-		if (pack.second == nullptr) RAWRBOX_CRITICAL("Failed to generate / get atlas texture");
+		const float scale = this->_type == rawrbox::FontType::SDF ? stbtt_ScaleForMappingEmToPixels(this->_font.get(), SDF_SIZE) : this->_scale;
+		for (auto& bitmap : bitmaps) {
+			auto pack = rawrbox::TextEngine::requestPack(static_cast<uint16_t>(bitmap.width), static_cast<uint16_t>(bitmap.height), Diligent::TEXTURE_FORMAT::TEX_FORMAT_R8_UNORM);
+			if (pack.second == nullptr) RAWRBOX_CRITICAL("Failed to generate / get atlas texture");
 
-		auto& packNode = pack.second->addSprite(ww, hh, rawrbox::ColorUtils::setChannels(1, 4, ww, hh, buffer));
-		auto size = pack.second->getSize();
+			auto packNode = pack.second->addSprite(bitmap.width, bitmap.height, bitmap.pixels);
+			auto size = pack.second->getSize();
 
-		glyph->packID = pack.first;
-		glyph->textureTopLeft = {packNode.x / static_cast<float>(size.x), packNode.y / static_cast<float>(size.y)};
-		glyph->textureBottomRight = {(packNode.x + packNode.width) / static_cast<float>(size.x), (packNode.y + packNode.height) / static_cast<float>(size.y)};
+			rawrbox::Glyph glyph = {};
+			glyph.codePoint = bitmap.codePoint;
+			glyph.packID = pack.first;
+			glyph.spriteID = packNode.id;
 
-		glyph->scale = this->_info.scale;
+			glyph.offset = {static_cast<float>(bitmap.x), static_cast<float>(bitmap.y)};
+			glyph.size = {static_cast<float>(bitmap.width), static_cast<float>(bitmap.height)};
+			glyph.advance = {bitmap.advance, std::round((static_cast<float>(ascent + descent + lineGap)) * scale)};
 
-		glyph->advance *= this->_info.scale;
-		glyph->offset *= this->_info.scale;
-		glyph->size *= this->_info.scale;
+			glyph.textureTopLeft = {packNode.x / static_cast<float>(size.x), packNode.y / static_cast<float>(size.y)};
+			glyph.textureBottomRight = {(packNode.x + packNode.width) / static_cast<float>(size.x), (packNode.y + packNode.height) / static_cast<float>(size.y)};
+
+			glyph.scale = this->_info.scale;
+
+			glyph.advance *= this->_info.scale;
+			glyph.offset *= this->_info.scale;
+			glyph.size *= this->_info.scale;
+
+			if (this->_type == rawrbox::FontType::SDF) {
+				rawrbox::TextEngine::addDistanceField(key, glyph);
+			} else {
+				this->_glyphs[glyph.codePoint] = std::make_unique<rawrbox::Glyph>(glyph);
+			}
 
-		return glyph;
+			bitmap.pixels = {}; // Copied into the atlas, free it early
+		}
 	}
 
-	void Font::generateGlyph(uint32_t codePoint) {
-		if (this->hasGlyph(codePoint)) return;
-		this->_glyphs[codePoint] = this->bakeGlyphAlpha(codePoint);
+	void Font::generateGlyphs(const std::vector<uint32_t>& codePoints) {
+		const bool sdf = this->_type == rawrbox::FontType::SDF;
+		const auto key = fmt::format("{}-{}", this->_fileName.generic_string(), this->_fontIndex);
+
+		// Distance fields are shared with every other size of this font
+		std::vector<uint32_t> bake = {};
+		std::unordered_set<uint32_t> seen = {};
+
+		for (auto point : codePoints) {
+			if (this->hasGlyph(point) || !seen.insert(point).second) continue;
+			if (sdf && rawrbox::TextEngine::getDistanceField(key, point) != nullptr) continue;
+
+			bake.push_back(point);
+		}
+
+		// Rasterize on the workers, stbtt only reads the font here
+		std::vector<rawrbox::GlyphBitmap> bitmaps(bake.size());
+		rawrbox::ASYNC::parallel(
+		    bake.size(), [this, sdf, &bake, &bitmaps](size_t start, size_t end) {
+			    for (size_t i = start; i < end; i++) {
+				    bitmaps[i] = sdf ? this->bakeGlyphSDF(bake[i]) : this->bakeGlyphAlpha(bake[i]);
+			    }
+		    },
+		    8);
+
+		// Atlases are not thread safe, insert the whole batch here
+		this->packGlyphs(bitmaps, key);
+		this->_generation++;
+
+		if (sdf) {
+			const float scale = this->_pixelSize / SDF_SIZE;
+			for (auto point : seen) {
+				if (this->hasGlyph(point)) continue;
+
+				const auto* field = rawrbox::TextEngine::getDistanceField(key, point);
+				if (field == nullptr) {
+					this->_evicted.insert(point); // Lost to a later glyph of this batch
+					continue;
+				}
+
+				auto glyph = std::make_unique<rawrbox::Glyph>(*field);
+				glyph->offset *= scale;
+				glyph->size *= scale;
+				glyph->advance *= scale;
+
+				this->_glyphs[point] = std::move(glyph);
+			}
+		}
+
+		for (auto point : seen) {
+			if (this->hasGlyph(point)) this->_evicted.erase(point);
+		}
 	}
 	// ----
 
 	// LOADING ---
-	void Font::load(const std::vector<uint8_t>& buffer, uint16_t pixelHeight, uint32_t fontIndex) {
-		int offset = stbtt_GetFontOffsetForIndex(buffer.data(), fontIndex); // Get the offset for `otf` fonts
+	void Font::load(const std::vector<uint8_t>& buffer, uint16_t pixelHeight, uint32_t fontIndex, rawrbox::FontType type) {
+		this->_buffer = buffer;
+		int offset = stbtt_GetFontOffsetForIndex(this->_buffer.data(), fontIndex); // Get the offset for `otf` fonts
 
 		// Load
 		this->_font = std::make_shared<stbtt_fontinfo>();
-		if (stbtt_InitFont(this->_font.get(), buffer.data(), offset) == 0) RAWRBOX_CRITICAL("Failed to load font");
+		if (stbtt_InitFont(this->_font.get(), this->_buffer.data(), offset) == 0) RAWRBOX_CRITICAL("Failed to load font");
 		this->_scale = stbtt_ScaleForMappingEmToPixels(this->_font.get(), static_cast<float>(pixelHeight));
 		this->_pixelSize = static_cast<float>(pixelHeight);
+		this->_fontIndex = fontIndex;
+		this->_type = type;
 
 		this->loadFontInfo();
 		this->addChars("�~!@#$%^&*()_+`1234567890-=QWERTYUIOPASDFGHJKLZXCVBNMqwertyuiopasdfghjklzxcvbnm|<>?,./:;\"'}{][ \\§°Ø");
@@ -133,28 +242,100 @@ namespace rawrbox {
 	}
 
 	void Font::addChars(const std::string& chars) {
+		std::vector<uint32_t> codePoints = {};
+		codePoints.reserve(chars.size());
+
 		auto charsIter = chars.begin();
 		while (charsIter < chars.end()) {
-			this->generateGlyph(utf8::next(charsIter, chars.end()));
+			codePoints.push_back(utf8::next(charsIter, chars.end()));
 		}
+
+		this->generateGlyphs(codePoints);
 	}
 
 	rawrbox::Font* Font::scale(uint16_t size) {
 		if (size == this->getSize()) return this;
-		return rawrbox::TextEngine::load(this->_fileName, size);
+		return rawrbox::TextEngine::load(this->_fileName, size, this->_fontIndex, this->_type);
+	}
+
+	void Font::restoreGlyphs(const std::string& text) {
+		if (this->_evicted.empty()) return;
+
+		std::vector<uint32_t> codePoints = {};
+		if (this->_evicted.contains(65533)) codePoints.push_back(65533); // Fallback for everything else
+
+		auto beginIter = text.begin();
+		auto endIter = utf8::find_invalid(text.begin(), text.end());
+
+		while (beginIter != endIter) {
+			uint32_t point = utf8::next(beginIter, endIter);
+			if (this->_evicted.contains(point)) {
+				codePoints.push_back(point);
+				continue;
+			}
+
+			// Still resident, keep it that way while the rest gets baked
+			auto fnd = this->_glyphs.find(point);
+			if (fnd != this->_glyphs.end()) this->getPackTexture(fnd->second.get())->touchSprite(fnd->second->spriteID);
+		}
+
+		if (codePoints.empty()) return;
+		this->generateGlyphs(codePoints);
+	}
+	// ----
+
+	// ATLAS ---
+	void Font::evictGlyphs(uint16_t packID, const std::unordered_set<uint64_t>& sprites) {
+		auto removed = std::erase_if(this->_glyphs, [this, packID, &sprites](const auto& glyph) {
+			if (glyph.second->packID != packID || !sprites.contains(glyph.second->spriteID)) return false;
+
+			this->_evicted.insert(glyph.first);
+			return true;
+		});
+
+		if (removed != 0) this->_generation++;
+	}
+
+	void Font::relocateGlyphs(uint16_t packID, const std::unordered_map<uint64_t, rawrbox::AtlasRect>& moved) {
+		bool changed = false;
+
+		for (auto& glyph : this->_glyphs) {
+			if (glyph.second->packID != packID) continue;
+
+			auto fnd = moved.find(glyph.second->spriteID);
+			if (fnd == moved.end()) continue;
+
+			auto size = rawrbox::TextEngine::getPack(packID)->getSize();
+			const auto& rect = fnd->second;
+
+			glyph.second->textureTopLeft = {rect.x / static_cast<float>(size.x), rect.y / static_cast<float>(size.y)};
+			glyph.second->textureBottomRight = {(rect.x + rect.width) / static_cast<float>(size.x), (rect.y + rect.height) / static_cast<float>(size.y)};
+			changed = true;
+		}
+
+		if (changed) this->_generation++;
 	}
 	// ----
 
 	// UTILS ---
 	const rawrbox::FontInfo& Font::getFontInfo() const { return this->_info; }
+	rawrbox::FontType Font::getType() const { return this->_type; }
 
 	bool Font::hasGlyph(uint32_t codepoint) const {
 		return this->_glyphs.find(codepoint) != this->_glyphs.end();
 	}
 
+	size_t Font::getGlyphCount() const { return this->_glyphs.size(); }
+	bool Font::hasEvicted() const { return !this->_evicted.empty(); }
+	uint64_t Font::getGeneration() const { return this->_generation; }
+
 	rawrbox::Glyph* Font::getGlyph(uint32_t codepoint) const {
 		auto fnd = this->_glyphs.find(codepoint);
-		if (fnd == this->_glyphs.end()) return this->_glyphs.find(65533)->second.get(); // �
+		if (fnd == this->_glyphs.end()) {
+			fnd = this->_glyphs.find(65533); // �, can be evicted too until restoreGlyphs
+			if (fnd == this->_glyphs.end()) return nullptr;
+		}
+
 		return fnd->second.get();
 	}
 
@@ -240,6 +421,8 @@ namespace rawrbox {
 			}
 
 			auto* const glyph = this->getGlyph(point);
+			if (glyph == nullptr) continue;
+
 			float kerning = this->getKerning(prevCodePoint, point);
 			cursor.x += kerning;
 
@@ -248,6 +431,7 @@ namespace rawrbox {
 			float x1 = x0 + glyph->size.x;
 			float y1 = y0 + glyph->size.y;
 
+			this->getPackTexture(glyph)->touchSprite(glyph->spriteID);
 			renderGlyph(glyph, x0, y0, x1, y1);
 
 			cursor.x += glyph->advance.x;
@@ -0,0 +1,201 @@
+#include <rawrbox/render/text/engine.hpp>
+#include <rawrbox/render/text/layout.hpp>
+
+#include <utf8.h>
+
+#include <algorithm>
+
+namespace rawrbox {
+	// LAYOUT ----
+	TextLayout::TextLayout(const rawrbox::Font& font, const std::string& text, float wrapWidth) : _generation(font.getGeneration()), _sdf(font.getType() == rawrbox::FontType::SDF) {
+		const float lineHeight = font.getLineHeight();
+		const float baseline = lineHeight + font.getFontInfo().descender;
+
+		this->_size.y = lineHeight;
+		this->_lines = 1;
+		if (text.empty()) return;
+
+		std::vector<float> pens = {}; // Pen x + advance of each glyph, for the measured width
+		this->_glyphs.reserve(text.size());
+		pens.reserve(text.size());
+
+		rawrbox::Vector2f cursor = {0.F, baseline};
+		uint32_t prevCodePoint = 0;
+
+		size_t lineStart = 0;  // First glyph of the current line
+		size_t breakAt = 0;    // First glyph after the last space on this line
+		float breakX = 0.F;    // Pen x at breakAt
+
+		auto newLine = [&]() {
+			cursor.x = 0.F;
+			cursor.y += lineHeight;
+			prevCodePoint = 0;
+
+			lineStart = this->_glyphs.size();
+			breakAt = lineStart;
+
+			this->_size.y += lineHeight;
+			this->_lines++;
+		};
+
+		auto beginIter = text.begin();
+		auto endIter = utf8::find_invalid(text.begin(), text.end()); // Find invalid utf8
+
+		while (beginIter != endIter) {
+			uint32_t point = utf8::next(beginIter, endIter); // get codepoint
+			if (point == '\n') {
+				newLine();
+				continue;
+			}
+
+			auto* const glyph = font.getGlyph(point);
+			if (glyph == nullptr) continue;
+
+			cursor.x += font.getKerning(prevCodePoint, point);
+
+			// Wrap ---
+			if (wrapWidth > 0.F && point != ' ' && cursor.x + glyph->advance.x > wrapWidth && this->_glyphs.size() > lineStart) {
+				if (breakAt > lineStart) {
+					// Move the last word down, the space stays behind
+					for (size_t i = breakAt; i < this->_glyphs.size(); i++) {
+						this->_glyphs[i].min += {-breakX, lineHeight};
+						this->_glyphs[i].max += {-breakX, lineHeight};
+						pens[i] -= breakX;
+					}
+
+					cursor.x -= breakX;
+					cursor.y += lineHeight;
+					lineStart = breakAt;
+
+					this->_size.y += lineHeight;
+					this->_lines++;
+				} else {
+					newLine(); // Single word wider than the wrap, break it anywhere
+				}
+			}
+			// --------
+
+			auto* pack = font.getPackTexture(glyph);
+			pack->touchSprite(glyph->spriteID);
+
+			rawrbox::TextLayoutGlyph quad = {};
+			quad.textureID = pack->getTextureID();
+			quad.packID = glyph->packID;
+			quad.spriteID = glyph->spriteID;
+			quad.min = {cursor.x + glyph->offset.x, cursor.y + glyph->offset.y};
+			quad.max = quad.min + glyph->size;
+			quad.uvMin = glyph->textureTopLeft;
+			quad.uvMax = glyph->textureBottomRight;
+
+			this->_glyphs.push_back(quad);
+			pens.push_back(cursor.x + glyph->advance.x);
+
+			cursor.x += glyph->advance.x;
+			prevCodePoint = point;
+
+			if (point == ' ') {
+				breakAt = this->_glyphs.size();
+				breakX = cursor.x;
+			}
+		}
+
+		for (size_t i = 0; i < pens.size(); i++) {
+			this->_size.x = std::max(this->_size.x, pens[i]);
+		}
+
+		// Whitespace takes room but has nothing to draw
+		std::erase_if(this->_glyphs, [](const rawrbox::TextLayoutGlyph& quad) { return quad.min.x == quad.max.x || quad.min.y == quad.max.y; });
+	}
+
+	const std::vector<rawrbox::TextLayoutGlyph>& TextLayout::getGlyphs() const { return this->_glyphs; }
+	const rawrbox::Vector2f& TextLayout::getSize() const { return this->_size; }
+	size_t TextLayout::getLines() const { return this->_lines; }
+
+	bool TextLayout::isSDF() const { return this->_sdf; }
+	bool TextLayout::isStale(const rawrbox::Font& font) const { return this->_generation != font.getGeneration(); }
+	bool TextLayout::empty() const { return this->_glyphs.empty(); }
+	// -----------
+
+	// CACHE ----
+	std::list<TextLayoutCache::Entry> TextLayoutCache::_entries = {};
+	std::unordered_map<size_t, std::list<TextLayoutCache::Entry>::iterator> TextLayoutCache::_lookup = {};
+	size_t TextLayoutCache::_capacity = 2048;
+
+	size_t TextLayoutCache::hash(const rawrbox::Font& font, const std::string& text, float wrapWidth) {
+		size_t seed = std::hash<std::string>{}(text);
+		seed ^= std::hash<const rawrbox::Font*>{}(&font) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+		seed ^= std::hash<float>{}(wrapWidth) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+
+		return seed;
+	}
+
+	const rawrbox::TextLayout& TextLayoutCache::get(const rawrbox::Font& font, const std::string& text, float wrapWidth) {
+		auto key = hash(font, text, wrapWidth);
+
+		auto fnd = _lookup.find(key);
+		if (fnd != _lookup.end()) {
+			const auto& entry = *fnd->second;
+
+			if (entry.font == &font && entry.wrapWidth == wrapWidth && entry.text == text && !entry.layout->isStale(font)) {
+				_entries.splice(_entries.begin(), _entries, fnd->second);
+				return *entry.layout;
+			}
+		}
+
+		// Baking evicted glyphs can evict others and drop entries, look again after
+		rawrbox::TextEngine::restoreGlyphs(font, text);
+
+		fnd = _lookup.find(key);
+		if (fnd != _lookup.end()) {
+			auto& entry = *fnd->second;
+
+			// Hash collisions and stale layouts rebuild in place
+			entry.font = &font;
+			entry.text = text;
+			entry.wrapWidth = wrapWidth;
+			entry.layout = std::make_unique<rawrbox::TextLayout>(font, text, wrapWidth);
+
+			_entries.splice(_entries.begin(), _entries, fnd->second);
+			return *entry.layout;
+		}
+
+		_entries.push_front({key, &font, text, wrapWidth, std::make_unique<rawrbox::TextLayout>(font, text, wrapWidth)});
+		_lookup[key] = _entries.begin();
+
+		while (_entries.size() > _capacity) {
+			_lookup.erase(_entries.back().hash);
+			_entries.pop_back();
+		}
+
+		return *_entries.front().layout;
+	}
+
+	void TextLayoutCache::invalidate(const rawrbox::Font& font) {
+		for (auto it = _entries.begin(); it != _entries.end();) {
+			if (it->font != &font) {
+				++it;
+				continue;
+			}
+
+			_lookup.erase(it->hash);
+			it = _entries.erase(it);
+		}
+	}
+
+	void TextLayoutCache::clear() {
+		_lookup.clear();
+		_entries.clear();
+	}
+
+	void TextLayoutCache::setCapacity(size_t capacity) {
+		_capacity = std::max<size_t>(capacity, 1);
+
+		while (_entries.size() > _capacity) {
+			_lookup.erase(_entries.back().hash);
+			_entries.pop_back();
+		}
+	}
+
+	size_t TextLayoutCache::size() { return _entries.size(); }
+	// -----------
+} // namespace rawrbox
@@ -2,14 +2,59 @@
 #include <rawrbox/render/bindless.hpp>
 #include <rawrbox/render/static.hpp>
 #include <rawrbox/render/textures/base.hpp>
+#include <rawrbox/render/textures/streamer.hpp>
+#include <rawrbox/render/textures/utils/bc.hpp>
+#include <rawrbox/render/textures/utils/ktx2.hpp>
+#include <rawrbox/render/textures/utils/mips.hpp>
 #include <rawrbox/render/utils/pipeline.hpp>
+#include <rawrbox/utils/crc.hpp>
+#include <rawrbox/utils/file.hpp>
 
 #include <fmt/format.h>
 
+#include <array>
+#include <string>
+
+namespace {
+	constexpr auto SOURCE_HASH_KEY = "rawrbox.source";
+
+	// Hash of the uncompressed pixels and the settings that change the encoded result, stored on the KTX2 cache
+	std::string getSourceHash(const rawrbox::ImageData& data, bool sRGB, bool mipmaps) {
+		static const auto table = CRC::CRC_64().MakeTable();
+
+		std::array<uint32_t, 5> header = {data.size.x, data.size.y, data.channels, sRGB ? 1U : 0U, mipmaps ? 1U : 0U};
+		auto crc = CRC::Calculate(header.data(), header.size() * sizeof(uint32_t), table);
+
+		for (const auto& frame : data.frames) {
+			crc = CRC::Calculate(frame.pixels.data(), frame.pixels.size(), table, crc);
+		}
+
+		return fmt::format("{:016x}", crc);
+	}
+
+	Diligent::TEXTURE_FORMAT getBCFormat(rawrbox::TEXTURE_COMPRESSION compression, bool sRGB) {
+		switch (compression) {
+			case rawrbox::TEXTURE_COMPRESSION::BC1:
+				return sRGB ? Diligent::TEXTURE_FORMAT::TEX_FORMAT_BC1_UNORM_SRGB : Diligent::TEXTURE_FORMAT::TEX_FORMAT_BC1_UNORM;
+			case rawrbox::TEXTURE_COMPRESSION::BC3:
+				return sRGB ? Diligent::TEXTURE_FORMAT::TEX_FORMAT_BC3_UNORM_SRGB : Diligent::TEXTURE_FORMAT::TEX_FORMAT_BC3_UNORM;
+			case rawrbox::TEXTURE_COMPRESSION::BC4:
+				return Diligent::TEXTURE_FORMAT::TEX_FORMAT_BC4_UNORM;
+			case rawrbox::TEXTURE_COMPRESSION::BC5:
+				return Diligent::TEXTURE_FORMAT::TEX_FORMAT_BC5_UNORM;
+			case rawrbox::TEXTURE_COMPRESSION::BC7:
+				return sRGB ? Diligent::TEXTURE_FORMAT::TEX_FORMAT_BC7_UNORM_SRGB : Diligent::TEXTURE_FORMAT::TEX_FORMAT_BC7_UNORM;
+			default:
+				return Diligent::TEXTURE_FORMAT::TEX_FORMAT_UNKNOWN;
+		}
+	}
+} // namespace
+
 namespace rawrbox {
 	TextureBase::~TextureBase() {
 		if (this->_failedToLoad) return; // Don't delete the fallback
 
+		rawrbox::TextureStreamer::remove(*this);
 		rawrbox::BindlessManager::unregisterTexture(*this);
 		this->_textureID = 0; // Back to MISSING
 
@@ -36,6 +81,12 @@ namespace rawrbox {
 	}
 
 	void TextureBase::tryGetFormatChannels(Diligent::TEXTURE_FORMAT& format, uint8_t& channels) {
+		if (this->_data.isCompressed()) {
+			format = getBCFormat(this->_data.compression, this->_sRGB || this->_data.sRGB); // Blocks decide the format
+			channels = rawrbox::BC::getChannels(this->_data.compression);
+			return;
+		}
+
 		if (format == Diligent::TEXTURE_FORMAT::TEX_FORMAT_UNKNOWN) {
 			switch (channels) {
 				case 1:
@@ -73,13 +124,74 @@ namespace rawrbox {
 		if (this->_data.channels == 3U) {
 			this->_data.channels = 4U;
 
-			auto& pixels = this->_data.pixels();
-			if (!pixels.empty()) {
-				pixels = rawrbox::ColorUtils::setChannels(3U, 4U, this->_data.size.x, this->_data.size.y, pixels);
+			// Every frame, mips are rebuilt from them
+			for (auto& frame : this->_data.frames) {
+				frame.mips.clear();
+				if (frame.pixels.empty()) continue;
+
+				frame.pixels = rawrbox::ColorUtils::setChannels(3U, 4U, this->_data.size.x, this->_data.size.y, frame.pixels);
 			}
 		}
 	}
 
+	uint32_t TextureBase::getMipLevels(Diligent::TEXTURE_FORMAT format, bool dynamic) const {
+		if (!this->_mipmaps || dynamic || this->_type != rawrbox::TEXTURE_TYPE::PIXEL) return 1U; // Dynamic textures only update the base level
+		if (this->_data.isCompressed()) return this->_data.mipLevels();                                 // Can't filter blocks, use what was stored
+
+		// CPU filter only knows 8 bit formats
+		switch (format) {
+			case Diligent::TEXTURE_FORMAT::TEX_FORMAT_A8_UNORM:
+			case Diligent::TEXTURE_FORMAT::TEX_FORMAT_R8_UNORM:
+			case Diligent::TEXTURE_FORMAT::TEX_FORMAT_RG8_UNORM:
+			case Diligent::TEXTURE_FORMAT::TEX_FORMAT_RGBA8_UNORM:
+			case Diligent::TEXTURE_FORMAT::TEX_FORMAT_RGBA8_UNORM_SRGB:
+				return rawrbox::MipUtils::getLevels(this->_data.size);
+			default:
+				return 1U;
+		}
+	}
+
+	void TextureBase::compress() {
+		if (this->_data.size.x % 4 != 0 || this->_data.size.y % 4 != 0) {
+			this->_logger->warn("Texture '{}' size ({}x{}) is not a multiple of 4, skipping compression", this->_name, this->_data.size.x, this->_data.size.y);
+			return;
+		}
+
+		bool mipmaps = this->_mipmaps && this->_type == rawrbox::TEXTURE_TYPE::PIXEL;
+		std::string sourceHash = this->_compressionCache.empty() ? "" : getSourceHash(this->_data, this->_sRGB, mipmaps);
+
+		// Cached, only if it was built from the same pixels ---
+		if (!this->_compressionCache.empty() && std::filesystem::exists(this->_compressionCache)) {
+			try {
+				auto raw = rawrbox::FileUtils::getRawData(this->_compressionCache);
+				auto keyValues = rawrbox::KTX2::getKeyValues(raw);
+				auto fnd = keyValues.find(SOURCE_HASH_KEY);
+
+				if (fnd != keyValues.end() && fnd->second == sourceHash) {
+					auto cached = rawrbox::KTX2::decode(raw);
+					if (cached.compression == this->_compression && cached.size == this->_data.size && cached.total() == this->_data.total()) {
+						this->_data = std::move(cached);
+						return;
+					}
+				}
+
+				this->_logger->debug("Compressed cache '{}' is out of date, rebuilding", this->_compressionCache.generic_string());
+			} catch (const std::exception& e) {
+				this->_logger->warn("Failed to load compressed cache '{}' ──> {}", this->_compressionCache.generic_string(), e.what());
+			}
+		}
+		// ----------
+
+		if (mipmaps) rawrbox::MipUtils::generate(this->_data, this->_sRGB); // Mips are encoded too
+
+		this->_data.sRGB = this->_sRGB;
+		this->_data = rawrbox::BC::encode(this->_data, this->_compression);
+
+		if (!this->_compressionCache.empty() && !rawrbox::FileUtils::saveData(this->_compressionCache, rawrbox::KTX2::encode(this->_data, {{SOURCE_HASH_KEY, sourceHash}}))) {
+			this->_logger->warn("Failed to save compressed cache '{}'", this->_compressionCache.generic_string());
+		}
+	}
+
 	// UTILS ---
 	void TextureBase::setID(uint64_t id) { this->_id = id; }
 	uint64_t TextureBase::getID() const { return this->_id; }
@@ -130,6 +242,28 @@ namespace rawrbox {
 
 	void TextureBase::setSRGB(bool set) { this->_sRGB = set; }
 
+	void TextureBase::setMipmaps(bool enabled, bool gpu) {
+		this->_mipmaps = enabled;
+		this->_gpuMipmaps = gpu;
+	}
+
+	bool TextureBase::hasMipmaps() const { return this->_tex != nullptr && this->_tex->GetDesc().MipLevels > 1; }
+
+	void TextureBase::setCompression(rawrbox::TEXTURE_COMPRESSION format, const std::filesystem::path& cachePath) {
+		this->_compression = format;
+		this->_compressionCache = cachePath;
+	}
+
+	rawrbox::TEXTURE_COMPRESSION TextureBase::getCompression() const { return this->_data.compression; }
+
+	void TextureBase::setStreaming(bool enabled) { this->_streaming = enabled; }
+	bool TextureBase::isStreaming() const { return this->_streaming; }
+
+	uint64_t TextureBase::getStreamID() const { return this->_streamID; }
+	void TextureBase::setStreamID(uint64_t id) { this->_streamID = id; }
+
+	uint32_t TextureBase::getResidentMip() const { return this->_residentMip; }
+
 	void TextureBase::setSlice(uint32_t id) { this->_slice = id; }
 	uint32_t TextureBase::getSlice() const { return this->_slice; }
 	// ----
@@ -139,16 +273,47 @@ namespace rawrbox {
 		if (!this->_data.valid()) RAWRBOX_CRITICAL("Cannot upload invalid image data");
 		if (this->_data.total() > 2048U) RAWRBOX_CRITICAL("Cannot upload more than 2048 image frames");
 
+		// Compress on load, transparency is checked before we lose it
+		bool encoded = false;
+		if (this->_compression != rawrbox::TEXTURE_COMPRESSION::NONE && !dynamic && !this->_data.empty() && !this->_data.isCompressed()) {
+			this->_transparent = this->_data.transparent();
+			this->compress();
+			encoded = true;
+		}
+		// --------------------------------
+
 		// Try to determine texture format
 		this->tryGetFormatChannels(format, this->_data.channels);
+
+		if (this->_data.isCompressed() && !rawrbox::RENDERER->device()->GetTextureFormatInfo(format).Supported) {
+			this->_logger->warn("Block compressed textures are not supported by the GPU, decoding '{}' on the CPU", this->_name);
+
+			this->_data = rawrbox::BC::decode(this->_data);
+			format = Diligent::TEXTURE_FORMAT::TEX_FORMAT_UNKNOWN;
+			this->tryGetFormatChannels(format, this->_data.channels);
+		}
 		// --------------------------------
 
 		if (this->_data.empty()) {
 			this->_data.createFrame();
-		} else {
+		} else if (!encoded) {
 			this->_transparent = this->_data.transparent();
 		}
 
+		// Mips --
+		uint32_t mipLevels = this->getMipLevels(format, dynamic);
+		bool gpuMips = false;
+
+		if (mipLevels > 1 && this->_gpuMipmaps && !this->_data.isCompressed()) {
+			const auto& info = rawrbox::RENDERER->device()->GetTextureFormatInfoExt(format);
+			gpuMips = info.Filterable && (info.BindFlags & Diligent::BIND_RENDER_TARGET) != 0;
+		}
+
+		if (mipLevels > 1 && !gpuMips && !this->_data.isCompressed()) {
+			rawrbox::MipUtils::generate(this->_data, format == Diligent::TEXTURE_FORMAT::TEX_FORMAT_RGBA8_UNORM_SRGB, mipLevels); // Stored levels (ex: cached) are reused
+		}
+		// -------
+
 		Diligent::TextureDesc desc;
 		desc.Type = Diligent::RESOURCE_DIM_TEX_2D_ARRAY;
 		desc.BindFlags = Diligent::BIND_SHADER_RESOURCE;
@@ -156,40 +321,112 @@ namespace rawrbox {
 		desc.CPUAccessFlags = Diligent::CPU_ACCESS_NONE;
 		desc.Width = this->_data.size.x;
 		desc.Height = this->_data.size.y;
-		desc.MipLevels = 1;
+		desc.MipLevels = mipLevels;
 		desc.Format = format;
 		desc.Name = this->_name.c_str();
 
-		std::vector<Diligent::TextureSubResData> subresData = {};
 		// NOLINTBEGIN(cppcoreguidelines-pro-type-union-access)
 		desc.ArraySize = static_cast<uint32_t>(this->_data.total());
 		// NOLINTEND(cppcoreguidelines-pro-type-union-access)
 
-		subresData.resize(desc.ArraySize);
-		for (uint32_t slice = 0; slice < subresData.size(); slice++) {
-			auto& res = subresData[slice];
+		if (gpuMips) {
+			// Base levels are uploaded on the render thread, then the chain is built there
+			desc.Usage = Diligent::USAGE_DEFAULT;
+			desc.BindFlags |= Diligent::BIND_RENDER_TARGET;
+			desc.MiscFlags = Diligent::MISC_TEXTURE_FLAG_GENERATE_MIPS;
 
-			res.pData = this->_data.frames[slice].pixels.data();
-			res.Stride = desc.Width * this->_data.channels;
-		}
+			this->_desc = desc;
+			rawrbox::RENDERER->device()->CreateTexture(desc, nullptr, &this->_tex);
+		} else {
+			this->_desc = desc;
+			this->_residentMip = 0;
 
-		Diligent::TextureData data;
-		data.pSubResources = subresData.data();
-		data.NumSubresources = static_cast<uint32_t>(subresData.size());
+			// Small mips first, the rest is streamed in on demand
+			if (this->_streaming && !dynamic && mipLevels > 1) this->_residentMip = rawrbox::TextureStreamer::add(*this, mipLevels);
+			this->_tex = this->createTexture(this->_residentMip);
+		}
 
-		rawrbox::RENDERER->device()->CreateTexture(desc, &data, &this->_tex);
 		if (this->_tex == nullptr) RAWRBOX_CRITICAL("Failed to create texture '{}'", this->_name);
 
 		// Get handles --
 		this->_handle = this->_tex->GetDefaultView(Diligent::TEXTURE_VIEW_SHADER_RESOURCE);
 		// -------
 
-		rawrbox::runOnRenderThread([this]() {
-			rawrbox::BarrierUtils::barrier({{this->_tex, Diligent::RESOURCE_STATE_UNKNOWN, Diligent::RESOURCE_STATE_SHADER_RESOURCE, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
+		rawrbox::runOnRenderThread([this, gpuMips]() {
+			if (gpuMips) {
+				auto* context = rawrbox::RENDERER->context();
+
+				Diligent::Box box;
+				box.MaxX = this->_data.size.x;
+				box.MaxY = this->_data.size.y;
+
+				rawrbox::BarrierUtils::barrier({{this->_tex, Diligent::RESOURCE_STATE_UNKNOWN, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
+				for (uint32_t slice = 0; slice < this->_data.total(); slice++) {
+					Diligent::TextureSubResData res;
+					res.pData = this->_data.frames[slice].pixels.data();
+					res.Stride = this->_data.size.x * this->_data.channels;
+
+					context->UpdateTexture(this->_tex, 0, slice, box, res, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+				}
+
+				rawrbox::BarrierUtils::barrier({{this->_tex, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::RESOURCE_STATE_SHADER_RESOURCE, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
+				context->GenerateMips(this->_handle);
+			} else {
+				rawrbox::BarrierUtils::barrier({{this->_tex, Diligent::RESOURCE_STATE_UNKNOWN, Diligent::RESOURCE_STATE_SHADER_RESOURCE, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
+			}
+
 			rawrbox::BindlessManager::registerTexture(*this);
 		});
 	}
 
+	Diligent::RefCntAutoPtr<Diligent::ITexture> TextureBase::createTexture(uint32_t firstMip) const {
+		auto desc = this->_desc;
+		auto size = rawrbox::MipUtils::getSize(this->_data.size, firstMip);
+
+		desc.Width = size.x;
+		desc.Height = size.y;
+		desc.MipLevels = this->_desc.MipLevels - firstMip;
+		desc.Name = this->_name.c_str();
+
+		// Subresources go slice by slice, each with its mip chain
+		std::vector<Diligent::TextureSubResData> subresData = {};
+		subresData.resize(static_cast<size_t>(desc.ArraySize) * desc.MipLevels);
+
+		for (uint32_t slice = 0; slice < desc.ArraySize; slice++) {
+			const auto& frame = this->_data.frames[slice];
+
+			for (uint32_t level = 0; level < desc.MipLevels; level++) {
+				auto& res = subresData[static_cast<size_t>(slice) * desc.MipLevels + level];
+				auto mip = firstMip + level;
+
+				res.pData = mip == 0 ? frame.pixels.data() : frame.mips[mip - 1].data();
+				auto width = rawrbox::MipUtils::getSize(this->_data.size, mip).x;
+				res.Stride = this->_data.isCompressed() ? rawrbox::BC::getRowBytes(this->_data.compression, width) : width * this->_data.channels; // Compressed = a row of blocks
+			}
+		}
+
+		Diligent::TextureData data;
+		data.pSubResources = subresData.data();
+		data.NumSubresources = static_cast<uint32_t>(subresData.size());
+
+		Diligent::RefCntAutoPtr<Diligent::ITexture> texture;
+		rawrbox::RENDERER->device()->CreateTexture(desc, &data, &texture);
+
+		return texture;
+	}
+
+	void TextureBase::setResident(uint32_t firstMip, Diligent::RefCntAutoPtr<Diligent::ITexture> texture) {
+		if (texture == nullptr) RAWRBOX_CRITICAL("Invalid resident texture for '{}'", this->_name);
+
+		// The old one is kept alive by the device until the GPU is done with it
+		this->_tex = std::move(texture);
+		this->_handle = this->_tex->GetDefaultView(Diligent::TEXTURE_VIEW_SHADER_RESOURCE);
+		this->_residentMip = firstMip;
+
+		rawrbox::BarrierUtils::barrier({{this->_tex, Diligent::RESOURCE_STATE_UNKNOWN, Diligent::RESOURCE_STATE_SHADER_RESOURCE, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
+		rawrbox::BindlessManager::updateTexture(*this);
+	}
+
 	void TextureBase::update() {}
 	bool TextureBase::requiresUpdate() const { return false; }
 
@@ -1,13 +1,31 @@
 #include <rawrbox/render/textures/image.hpp>
+#include <rawrbox/render/textures/utils/dds.hpp>
+#include <rawrbox/render/textures/utils/ktx2.hpp>
 #include <rawrbox/render/textures/utils/stbi.hpp>
+#include <rawrbox/render/textures/utils/utils.hpp>
+#include <rawrbox/utils/file.hpp>
 
 #include <fmt/format.h>
 
+namespace {
+	// Containers with block compressed data are not handled by stbi
+	rawrbox::ImageData decodeBuffer(const uint8_t* buffer, size_t bufferSize) {
+		switch (rawrbox::TextureUtils::getImageType(buffer, bufferSize)) {
+			case rawrbox::ImageType::IMAGE_KTX2:
+				return rawrbox::KTX2::decode(buffer, bufferSize);
+			case rawrbox::ImageType::IMAGE_DDS:
+				return rawrbox::DDS::decode(buffer, bufferSize);
+			default:
+				return rawrbox::STBI::decode(buffer, static_cast<int>(bufferSize));
+		}
+	}
+} // namespace
+
 namespace rawrbox {
 	// NOLINTBEGIN(modernize-pass-by-value)
 	TextureImage::TextureImage(const std::filesystem::path& filePath, const std::vector<uint8_t>& buffer, bool useFallback) : _filePath(filePath) {
 		try {
-			this->_data = rawrbox::STBI::decode(buffer);
+			this->_data = decodeBuffer(buffer.data(), buffer.size());
 			if (!this->_data.valid() || this->_data.total() == 0) RAWRBOX_CRITICAL("Invalid image data!");
 		} catch (const std::exception& e) {
 			if (useFallback) {
@@ -22,7 +40,14 @@ namespace rawrbox {
 
 	TextureImage::TextureImage(const std::filesystem::path& filePath, bool useFallback) : _filePath(filePath) {
 		try {
-			this->_data = rawrbox::STBI::decode(filePath);
+			auto extension = filePath.extension();
+			if (extension == ".ktx2" || extension == ".dds") {
+				auto buffer = rawrbox::FileUtils::getRawData(filePath);
+				this->_data = decodeBuffer(buffer.data(), buffer.size());
+			} else {
+				this->_data = rawrbox::STBI::decode(filePath);
+			}
+
 			if (!this->_data.valid() || this->_data.total() == 0) RAWRBOX_CRITICAL("Invalid image data!");
 		} catch (const std::exception& e) {
 			if (useFallback) {
@@ -37,7 +62,7 @@ namespace rawrbox {
 
 	TextureImage::TextureImage(const uint8_t* buffer, int bufferSize, bool useFallback) {
 		try {
-			this->_data = rawrbox::STBI::decode(buffer, bufferSize);
+			this->_data = decodeBuffer(buffer, static_cast<size_t>(bufferSize));
 			if (!this->_data.valid() || this->_data.total() == 0) RAWRBOX_CRITICAL("Invalid image data!");
 		} catch (const std::exception& e) {
 			if (useFallback) {
@@ -8,167 +8,158 @@
 #include <fmt/format.h>
 
 namespace rawrbox {
-	TexturePack::TexturePack(uint32_t size) {
+	TexturePack::TexturePack(uint32_t size, uint32_t padding, uint8_t channels) : _packer(size, 1U, padding) {
+		if (channels != 1U && channels != 4U) RAWRBOX_CRITICAL("Texture packs only support 1 or 4 channels, got {}", channels);
+
 		this->_data.size = {size, size};
-		this->_data.channels = 4;
+		this->_data.channels = channels;
 		this->_data.createFrame(); // Create empty frame to be filled later
 
-		this->_root = std::make_unique<rawrbox::PackNode>(0U, 0U, size, size);
 		this->_name = "RawrBox::Texture::Pack";
 	}
 
-	TexturePack::~TexturePack() { this->_root.reset(); }
+	// PRIVATE ----
+	void TexturePack::clearSprite(const rawrbox::AtlasRect& rect) {
+		if (rect.width == 0 || rect.height == 0) return;
+
+		const auto stride = rect.width * this->_data.channels;
+		for (size_t y = 0; y < rect.height; y++) {
+			auto* dest = this->_data.pixels().data() + ((rect.y + y) * this->_data.size.x + rect.x) * this->_data.channels;
+			std::fill(dest, dest + stride, 0);
+		}
 
-	size_t TexturePack::getSpriteCount() const {
-		return this->_spriteCount;
+		bool pending = !this->_dirty.empty();
+		this->_dirty.mark(rect.x, rect.y, rect.width, rect.height);
+
+		if (!pending) rawrbox::BindlessManager::registerUpdateTexture(*this);
 	}
+	// ------------
 
-	rawrbox::PackNode& TexturePack::addSprite(uint32_t width, uint32_t height, const std::vector<uint8_t>& data) {
-		if (this->_tex == nullptr) RAWRBOX_CRITICAL("Texture not bound");
+	size_t TexturePack::getSpriteCount() const { return this->_packer.getSpriteCount(); }
+	float TexturePack::getOccupancy() const { return this->_packer.getOccupancy(); }
 
-		auto nodeOpt = this->_root->InsertNode(width, height);
-		if (!nodeOpt.has_value()) RAWRBOX_CRITICAL("Failed to add sprite with size {}, {}", width, height);
+	bool TexturePack::canInsertNode(uint32_t width, uint32_t height) {
+		return this->_packer.canInsert(width, height);
+	}
 
-		auto& node = (*nodeOpt).get();
-		node.data = data; // Set the data of that node
+	rawrbox::AtlasRect TexturePack::addSprite(uint32_t width, uint32_t height, const std::vector<uint8_t>& data) {
+		if (this->_tex == nullptr) RAWRBOX_CRITICAL("Texture not bound");
 
+		auto rectOpt = this->_packer.insert(width, height);
+		if (!rectOpt.has_value()) RAWRBOX_CRITICAL("Failed to add sprite with size {}, {}", width, height);
+
+		const auto& rect = rectOpt.value();
 		if (!data.empty()) {
-			Diligent::Box UpdateBox;
-			UpdateBox.MinX = node.x;
-			UpdateBox.MinY = node.y;
-			UpdateBox.MaxX = node.x + node.width;
-			UpdateBox.MaxY = node.y + node.height;
+			if (data.size() < static_cast<size_t>(width) * height * this->_data.channels) RAWRBOX_CRITICAL("Sprite data is too small for size {}, {}", width, height);
 
-			for (size_t y = 0; y < node.height; y++) {
-				const auto stride = node.width * this->_data.channels;
+			const auto stride = rect.width * this->_data.channels;
+			for (size_t y = 0; y < rect.height; y++) {
 				const auto* start = data.data() + y * stride;
-				const auto* last = start + stride;
+				auto* dest = this->_data.pixels().data() + ((rect.y + y) * this->_data.size.x + rect.x) * this->_data.channels;
 
-				auto startPointY = UpdateBox.MinY + y;
-				auto startPointX = UpdateBox.MinX;
-
-				auto* dest = this->_data.pixels().data() + (startPointY * this->_data.size.x + startPointX) * this->_data.channels;
-				std::copy(start, last, dest);
+				std::copy(start, start + stride, dest);
 			}
 
-			if (!this->_pendingUpdate) {
-				this->_pendingUpdate = true;
-				rawrbox::BindlessManager::registerUpdateTexture(*this);
-			}
+			bool pending = !this->_dirty.empty();
+			this->_dirty.mark(rect.x, rect.y, rect.width, rect.height);
+
+			if (!pending) rawrbox::BindlessManager::registerUpdateTexture(*this);
 		}
 
-		this->_spriteCount++;
-		return node;
+		return rect;
 	}
 
-	bool TexturePack::canInsertNode(uint32_t width, uint32_t height) {
-		return this->_root->canInsertNode(width, height);
-	}
-
-	bool PackNode::canInsertNode(uint32_t insertedWidth, uint32_t insertedHeight) {
-		if (!data.empty()) return false;
-
-		if (left && right) {
-			if (left->canInsertNode(insertedWidth, insertedHeight)) return true;
-			if (right->canInsertNode(insertedWidth, insertedHeight)) return true;
-
-			return false;
-		}
+	void TexturePack::removeSprite(uint64_t id) {
+		auto rect = this->_packer.get(id);
+		if (!rect.has_value()) return;
 
-		if (insertedWidth > width || insertedHeight > height) return false;
-		if (width == insertedWidth && height == insertedHeight) return true;
-
-		// if all of the above didn't return, the current leaf is large enough,
-		// with some space to spare, so we split up the current node so we have
-		// one prefectly fitted node and some spare nodes
-		int remainingWidth = std::max<int>(0, static_cast<int>(width) - static_cast<int>(insertedWidth));
-		int remainingHeight = std::max<int>(0, static_cast<int>(height) - static_cast<int>(insertedHeight));
+		this->clearSprite(rect.value());
+		this->_packer.remove(id);
+	}
 
-		bool isRemainderWiderThanHigh = remainingWidth > remainingHeight;
+	void TexturePack::touchSprite(uint64_t id) { this->_packer.touch(id); }
 
-		if (isRemainderWiderThanHigh) { // if wider than high, split verticallly
-			left = std::make_unique<rawrbox::PackNode>(x, y, insertedWidth, height);
-			right = std::make_unique<rawrbox::PackNode>(x + insertedWidth, y, remainingWidth, height);
-		} else { // That'd make the remainder higher than it's wide, split horizontally
-			left = std::make_unique<rawrbox::PackNode>(x, y, width, insertedHeight);
-			right = std::make_unique<rawrbox::PackNode>(x, y + insertedHeight, width, remainingHeight);
+	std::vector<rawrbox::AtlasRect> TexturePack::evictSprites(uint32_t width, uint32_t height) {
+		auto evicted = this->_packer.evict(width, height);
+		for (const auto& rect : evicted) {
+			this->clearSprite(rect);
 		}
 
-		return left->canInsertNode(insertedWidth, insertedHeight);
+		return evicted;
 	}
 
-	std::optional<std::reference_wrapper<rawrbox::PackNode>> PackNode::InsertNode(uint32_t insertedWidth, uint32_t insertedHeight) {
-		if (!data.empty()) return std::nullopt;
+	std::vector<rawrbox::AtlasRelocation> TexturePack::defragment() {
+		auto relocations = this->_packer.defragment();
+		if (relocations.empty()) return relocations;
 
-		if (left && right) {
-			// both children exist, which means this node is full, try left then right
-			if (auto node = left->InsertNode(insertedWidth, insertedHeight); node != std::nullopt) {
-				return node;
-			}
+		// Sprites can land on each other's old spot, so copy from a snapshot
+		const auto old = this->_data.pixels();
+		auto& pixels = this->_data.pixels();
 
-			if (auto node = right->InsertNode(insertedWidth, insertedHeight); node != std::nullopt) {
-				return node;
-			}
+		const auto channels = this->_data.channels;
+		const auto width = this->_data.size.x;
 
-			return std::nullopt;
+		for (const auto& move : relocations) {
+			const auto stride = move.from.width * channels;
+			for (size_t y = 0; y < move.from.height; y++) {
+				auto* dest = pixels.data() + ((move.from.y + y) * width + move.from.x) * channels;
+				std::fill(dest, dest + stride, 0);
+			}
 		}
 
-		if (insertedWidth > width || insertedHeight > height) {
-			// to be insterted node is too big, can't fit here
-			return std::nullopt;
-		}
+		for (const auto& move : relocations) {
+			const auto stride = move.from.width * channels;
+			for (size_t y = 0; y < move.from.height; y++) {
+				const auto* start = old.data() + ((move.from.y + y) * width + move.from.x) * channels;
+				auto* dest = pixels.data() + ((move.to.y + y) * width + move.to.x) * channels;
 
-		if (width == insertedWidth && height == insertedHeight) {
-			// fits perfectly
-			return *this;
+				std::copy(start, start + stride, dest);
+			}
 		}
 
-		// if all of the above didn't return, the current leaf is large enough,
-		// with some space to spare, so we split up the current node so we have
-		// one prefectly fitted node and some spare nodes
-		int remainingWidth = width - insertedWidth;
-		int remainingHeight = height - insertedHeight;
-
-		bool isRemainderWiderThanHigh = remainingWidth > remainingHeight;
-
-		if (isRemainderWiderThanHigh) { // if wider than high, split verticallly
-			left = std::make_unique<rawrbox::PackNode>(x, y, insertedWidth, height);
-			right = std::make_unique<rawrbox::PackNode>(x + insertedWidth, y, remainingWidth, height);
-		} else { // That'd make the remainder higher than it's wide, split horizontally
-			left = std::make_unique<rawrbox::PackNode>(x, y, width, insertedHeight);
-			right = std::make_unique<rawrbox::PackNode>(x, y + insertedHeight, width, remainingHeight);
-		}
+		bool pending = !this->_dirty.empty();
+		this->_dirty.mark(0, 0, this->_data.size.x, this->_data.size.y);
 
-		return left->InsertNode(insertedWidth, insertedHeight);
+		if (!pending) rawrbox::BindlessManager::registerUpdateTexture(*this);
+		return relocations;
 	}
 
 	void TexturePack::upload(Diligent::TEXTURE_FORMAT format, bool /*dynamic*/) {
 		if (this->_failedToLoad || this->_handle != nullptr) return; // Failed texture is already bound, so skip it
+		if (format == Diligent::TEXTURE_FORMAT::TEX_FORMAT_UNKNOWN && this->_data.channels == 1U) format = Diligent::TEXTURE_FORMAT::TEX_FORMAT_R8_UNORM; // Shaders read .r, A8 would be empty there
+
 		rawrbox::TextureBase::upload(format, true);
 	}
 
 	void TexturePack::update() {
-		if (!this->_pendingUpdate) return;
+		if (this->_dirty.empty()) return;
 		auto* context = rawrbox::RENDERER->context();
 
-		Diligent::Box UpdateBox;
-		UpdateBox.MinX = 0;
-		UpdateBox.MinY = 0;
-		UpdateBox.MaxX = this->_data.size.x;
-		UpdateBox.MaxY = this->_data.size.y;
-
-		Diligent::TextureSubResData SubresData;
-		SubresData.Stride = this->_data.size.x * this->_data.channels;
-		SubresData.pData = this->_data.pixels().data();
+		const auto stride = this->_data.size.x * this->_data.channels;
 
 		// BARRIER ----
 		rawrbox::BarrierUtils::barrier({{this->_tex, Diligent::RESOURCE_STATE_SHADER_RESOURCE, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
-		context->UpdateTexture(this->_tex, 0, 0, UpdateBox, SubresData, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+		// Only the dirty regions, reading straight from the atlas frame
+		for (const auto& rect : this->_dirty.getRects()) {
+			Diligent::Box UpdateBox;
+			UpdateBox.MinX = rect.minX;
+			UpdateBox.MinY = rect.minY;
+			UpdateBox.MaxX = rect.maxX;
+			UpdateBox.MaxY = rect.maxY;
+
+			Diligent::TextureSubResData SubresData;
+			SubresData.Stride = stride;
+			SubresData.pData = this->_data.pixels().data() + (static_cast<size_t>(rect.minY) * this->_data.size.x + rect.minX) * this->_data.channels;
+
+			context->UpdateTexture(this->_tex, 0, 0, UpdateBox, SubresData, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+		}
+
 		rawrbox::BarrierUtils::barrier({{this->_tex, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::RESOURCE_STATE_SHADER_RESOURCE, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
 		// ------------
 
-		this->_pendingUpdate = false;
+		this->_dirty.clear();
 	}
 
-	[[nodiscard]] bool TexturePack::requiresUpdate() const { return this->_pendingUpdate; };
+	[[nodiscard]] bool TexturePack::requiresUpdate() const { return !this->_dirty.empty(); };
 } // namespace rawrbox
@@ -0,0 +1,197 @@
+#include <rawrbox/render/cameras/base.hpp>
+#include <rawrbox/render/models/mesh.hpp>
+#include <rawrbox/render/static.hpp>
+#include <rawrbox/render/textures/streamer.hpp>
+#include <rawrbox/utils/threading.hpp>
+
+#include <algorithm>
+
+namespace rawrbox {
+	// PRIVATE ----
+	rawrbox::TextureResidency TextureStreamer::_residency = {};
+	std::unordered_map<uint64_t, TextureStreamer::StreamEntry> TextureStreamer::_textures = {};
+	std::vector<rawrbox::StreamedTexture> TextureStreamer::_completed = {};
+
+	std::mutex TextureStreamer::_lock;
+	std::condition_variable TextureStreamer::_built;
+	uint64_t TextureStreamer::_nextID = 1;
+
+	// LOGGER ------
+	std::unique_ptr<rawrbox::Logger> TextureStreamer::_logger = std::make_unique<rawrbox::Logger>("RawrBox-TextureStreamer");
+	// -------------
+	// ------------
+
+	uint32_t TextureStreamer::add(rawrbox::TextureBase& texture, uint32_t levels) {
+		if (texture.getStreamID() != 0) remove(texture);
+
+		std::scoped_lock lock(_lock);
+		auto id = _nextID++;
+
+		_textures[id] = {&texture, 0};
+		texture.setStreamID(id);
+
+		return _residency.add(id, texture.getSize(), rawrbox::TextureResidency::getLevelBytes(texture.getData(), levels));
+	}
+
+	void TextureStreamer::remove(rawrbox::TextureBase& texture) {
+		auto id = texture.getStreamID();
+		if (id == 0) return;
+
+		// Only waits if a worker is building this texture right now
+		std::unique_lock lock(_lock);
+		_built.wait(lock, [id]() {
+			auto fnd = _textures.find(id);
+			return fnd == _textures.end() || fnd->second.building == 0;
+		});
+
+		_textures.erase(id);
+		_residency.remove(id);
+
+		texture.setStreamID(0);
+	}
+
+	void TextureStreamer::update() {
+		// Swap finished levels ---
+		std::vector<rawrbox::StreamedTexture> completed = {};
+		{
+			std::scoped_lock lock(_lock);
+			completed.swap(_completed);
+		}
+
+		for (auto& level : completed) {
+			rawrbox::TextureBase* texture = nullptr;
+			{
+				std::scoped_lock lock(_lock);
+
+				auto fnd = _textures.find(level.change.id);
+				if (fnd != _textures.end()) texture = fnd->second.texture;
+			}
+
+			if (texture == nullptr) continue; // Removed while it was being built
+			if (level.texture == nullptr) {
+				_logger->warn("Failed to stream level {} of texture '{}', keeping level {}", level.change.to, texture->getName(), level.change.from);
+
+				std::scoped_lock lock(_lock);
+				_residency.fail(level.change);
+				continue;
+			}
+
+			texture->setResident(level.change.to, level.texture);
+
+			std::scoped_lock lock(_lock);
+			_residency.complete(level.change.id);
+		}
+		// ------------
+
+		// Start new ones ---
+		std::vector<rawrbox::ResidencyChange> changes = {};
+		{
+			std::scoped_lock lock(_lock);
+			changes = _residency.update();
+		}
+
+		for (const auto& change : changes) {
+			rawrbox::ASYNC::run([change]() {
+				rawrbox::TextureBase* texture = nullptr;
+				{
+					std::scoped_lock lock(_lock);
+
+					auto fnd = _textures.find(change.id);
+					if (fnd == _textures.end()) return;
+
+					fnd->second.building++;
+					texture = fnd->second.texture;
+				}
+
+				// Levels come from the CPU copy, other textures keep building in parallel
+				Diligent::RefCntAutoPtr<Diligent::ITexture> level;
+				try {
+					level = texture->createTexture(change.to);
+				} catch (const std::exception& err) {
+					_logger->warn("{}", err.what());
+				}
+
+				{
+					std::scoped_lock lock(_lock);
+
+					auto fnd = _textures.find(change.id);
+					if (fnd != _textures.end()) fnd->second.building--;
+
+					_completed.push_back({change, level});
+				}
+
+				_built.notify_all();
+			});
+		}
+		// ------------
+	}
+
+	void TextureStreamer::shutdown() {
+		std::unique_lock lock(_lock);
+		_built.wait(lock, []() {
+			return std::all_of(_textures.begin(), _textures.end(), [](const auto& texture) { return texture.second.building == 0; });
+		});
+
+		for (auto& texture : _textures) {
+			texture.second.texture->setStreamID(0);
+		}
+
+		_textures.clear();
+		_completed.clear();
+		_residency = rawrbox::TextureResidency(_residency.getBudget());
+	}
+
+	// FEEDBACK ---
+	void TextureStreamer::request(const rawrbox::TextureBase* texture, float screenPixels) {
+		if (texture == nullptr || texture->getStreamID() == 0) return;
+
+		std::scoped_lock lock(_lock);
+		_residency.request(texture->getStreamID(), rawrbox::TextureResidency::estimateLevel(texture->getSize(), screenPixels));
+	}
+
+	void TextureStreamer::request(const rawrbox::MeshTextures& textures, float screenPixels) {
+		request(textures.texture, screenPixels);
+		request(textures.normal, screenPixels);
+		request(textures.roughtMetal, screenPixels);
+		request(textures.emission, screenPixels);
+	}
+
+	float TextureStreamer::getScreenSize(float worldSize, float distance) {
+		if (rawrbox::MAIN_CAMERA == nullptr) return 0.F;
+
+		const auto* target = rawrbox::MAIN_CAMERA->getRenderTarget();
+		if (target == nullptr) return 0.F;
+
+		// Perspective scale (cot(fov / 2)) from the projection, half the screen height per unit at distance 1
+		auto scale = rawrbox::MAIN_CAMERA->getProjMtx().mtx[5] * static_cast<float>(target->getSize().y) * 0.5F;
+		return worldSize * scale / std::max(distance, rawrbox::MAIN_CAMERA->getZNear());
+	}
+	// ----------
+
+	// UTILS ---
+	void TextureStreamer::setBudget(size_t bytes) {
+		std::scoped_lock lock(_lock);
+		_residency.setBudget(bytes);
+	}
+
+	size_t TextureStreamer::getBudget() {
+		std::scoped_lock lock(_lock);
+		return _residency.getBudget();
+	}
+
+	size_t TextureStreamer::getUsed() {
+		std::scoped_lock lock(_lock);
+		return _residency.getUsed();
+	}
+
+	void TextureStreamer::setUploadLimit(size_t bytes) {
+		std::scoped_lock lock(_lock);
+		_residency.setUploadLimit(bytes);
+	}
+
+	bool TextureStreamer::isActive() {
+		std::scoped_lock lock(_lock);
+		return _residency.size() != 0;
+	}
+	// ----------
+} // namespace rawrbox
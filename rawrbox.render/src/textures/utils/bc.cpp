@@ -0,0 +1,751 @@
+#include <rawrbox/render/textures/utils/bc.hpp>
+#include <rawrbox/render/textures/utils/mips.hpp>
+#include <rawrbox/utils/logger.hpp>
+#include <rawrbox/utils/threading.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+	using Texel = std::array<uint8_t, 4>;
+
+	constexpr std::array<uint32_t, 16> BC7_WEIGHTS = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+	// BITS ---
+	struct BitWriter {
+		uint8_t* out = nullptr;
+		size_t pos = 0;
+
+		void write(uint32_t value, uint32_t bits) {
+			for (uint32_t i = 0; i < bits; i++, pos++) {
+				if (((value >> i) & 1U) != 0U) out[pos / 8] |= static_cast<uint8_t>(1U << (pos % 8));
+			}
+		}
+	};
+
+	struct BitReader {
+		const uint8_t* in = nullptr;
+		size_t pos = 0;
+
+		uint32_t read(uint32_t bits) {
+			uint32_t value = 0;
+			for (uint32_t i = 0; i < bits; i++, pos++) {
+				value |= static_cast<uint32_t>((in[pos / 8] >> (pos % 8)) & 1U) << i;
+			}
+
+			return value;
+		}
+	};
+	// ------
+
+	// FITTING ---
+	// Endpoints along the principal axis of the masked texels, first N channels
+	template <size_t N>
+	void principalRange(const rawrbox::BCBlock& block, const std::array<bool, 16>& mask, std::array<float, N>& lo, std::array<float, N>& hi) {
+		std::array<float, N> mean = {};
+
+		float count = 0.F;
+		for (size_t i = 0; i < 16; i++) {
+			if (!mask[i]) continue;
+
+			for (size_t c = 0; c < N; c++) {
+				mean[c] += static_cast<float>(block[i * 4 + c]);
+			}
+
+			count++;
+		}
+
+		if (count == 0.F) {
+			lo = {};
+			hi = {};
+			return;
+		}
+
+		for (auto& m : mean) {
+			m /= count;
+		}
+
+		std::array<float, N * N> cov = {};
+		for (size_t i = 0; i < 16; i++) {
+			if (!mask[i]) continue;
+
+			for (size_t a = 0; a < N; a++) {
+				for (size_t b = 0; b < N; b++) {
+					cov[a * N + b] += (block[i * 4 + a] - mean[a]) * (block[i * 4 + b] - mean[b]);
+				}
+			}
+		}
+
+		// Power iteration, starting from the row of the channel with the most variance
+		size_t widest = 0;
+		for (size_t c = 1; c < N; c++) {
+			if (cov[c * N + c] > cov[widest * N + widest]) widest = c;
+		}
+
+		std::array<float, N> axis = {};
+		for (size_t c = 0; c < N; c++) {
+			axis[c] = cov[widest * N + c];
+		}
+
+		for (int iter = 0; iter < 8; iter++) {
+			std::array<float, N> next = {};
+			float len = 0.F;
+
+			for (size_t a = 0; a < N; a++) {
+				for (size_t b = 0; b < N; b++) {
+					next[a] += cov[a * N + b] * axis[b];
+				}
+
+				len += next[a] * next[a];
+			}
+
+			if (len < 1e-8F) break;
+
+			len = std::sqrt(len);
+			for (size_t c = 0; c < N; c++) {
+				axis[c] = next[c] / len;
+			}
+		}
+
+		float axisLen = 0.F;
+		for (auto a : axis) {
+			axisLen += a * a;
+		}
+
+		if (axisLen < 1e-8F) {
+			for (size_t c = 0; c < N; c++) {
+				lo[c] = hi[c] = mean[c];
+			}
+
+			return;
+		}
+
+		axisLen = std::sqrt(axisLen);
+		for (auto& a : axis) {
+			a /= axisLen;
+		}
+
+		float tMin = 1e9F;
+		float tMax = -1e9F;
+
+		for (size_t i = 0; i < 16; i++) {
+			if (!mask[i]) continue;
+
+			float t = 0.F;
+			for (size_t c = 0; c < N; c++) {
+				t += (block[i * 4 + c] - mean[c]) * axis[c];
+			}
+
+			tMin = std::min(tMin, t);
+			tMax = std::max(tMax, t);
+		}
+
+		// Inset a bit, the extremes are rarely hit exactly
+		float inset = (tMax - tMin) / 16.F;
+		tMin += inset;
+		tMax -= inset;
+
+		for (size_t c = 0; c < N; c++) {
+			lo[c] = std::clamp(mean[c] + axis[c] * tMin, 0.F, 255.F);
+			hi[c] = std::clamp(mean[c] + axis[c] * tMax, 0.F, 255.F);
+		}
+	}
+
+	// Least squares endpoints for the given interpolation weights (0 = lo, 1 = hi)
+	template <size_t N>
+	bool refineEndpoints(const rawrbox::BCBlock& block, const std::array<bool, 16>& mask, const std::array<float, 16>& weights, std::array<float, N>& lo, std::array<float, N>& hi) {
+		float aa = 0.F;
+		float ab = 0.F;
+		float bb = 0.F;
+
+		std::array<float, N> xa = {};
+		std::array<float, N> xb = {};
+
+		for (size_t i = 0; i < 16; i++) {
+			if (!mask[i]) continue;
+
+			float w = weights[i];
+			aa += (1.F - w) * (1.F - w);
+			ab += (1.F - w) * w;
+			bb += w * w;
+
+			for (size_t c = 0; c < N; c++) {
+				xa[c] += (1.F - w) * block[i * 4 + c];
+				xb[c] += w * block[i * 4 + c];
+			}
+		}
+
+		float det = aa * bb - ab * ab;
+		if (std::abs(det) < 1e-6F) return false;
+
+		for (size_t c = 0; c < N; c++) {
+			lo[c] = std::clamp((bb * xa[c] - ab * xb[c]) / det, 0.F, 255.F);
+			hi[c] = std::clamp((aa * xb[c] - ab * xa[c]) / det, 0.F, 255.F);
+		}
+
+		return true;
+	}
+
+	template <size_t N>
+	uint32_t distance(const uint8_t* a, const Texel& b) {
+		uint32_t d = 0;
+		for (size_t c = 0; c < N; c++) {
+			int diff = static_cast<int>(a[c]) - static_cast<int>(b[c]);
+			d += static_cast<uint32_t>(diff * diff);
+		}
+
+		return d;
+	}
+	// ------
+
+	// BC1 ---
+	uint16_t pack565(const std::array<float, 3>& c) {
+		auto r = static_cast<uint16_t>(std::clamp(std::lround(c[0] * 31.F / 255.F), 0L, 31L));
+		auto g = static_cast<uint16_t>(std::clamp(std::lround(c[1] * 63.F / 255.F), 0L, 63L));
+		auto b = static_cast<uint16_t>(std::clamp(std::lround(c[2] * 31.F / 255.F), 0L, 31L));
+
+		return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+	}
+
+	Texel unpack565(uint16_t c) {
+		auto r = static_cast<uint8_t>((c >> 11) & 31U);
+		auto g = static_cast<uint8_t>((c >> 5) & 63U);
+		auto b = static_cast<uint8_t>(c & 31U);
+
+		return {static_cast<uint8_t>((r << 3) | (r >> 2)), static_cast<uint8_t>((g << 2) | (g >> 4)), static_cast<uint8_t>((b << 3) | (b >> 2)), 255};
+	}
+
+	// fourColor = BC3 color block / BC1 with c0 > c1
+	std::array<Texel, 4> bc1Palette(uint16_t c0, uint16_t c1, bool fourColor) {
+		auto a = unpack565(c0);
+		auto b = unpack565(c1);
+
+		std::array<Texel, 4> pal = {a, b, {}, {}};
+		for (size_t c = 0; c < 3; c++) {
+			if (fourColor) {
+				pal[2][c] = static_cast<uint8_t>((2 * a[c] + b[c] + 1) / 3);
+				pal[3][c] = static_cast<uint8_t>((a[c] + 2 * b[c] + 1) / 3);
+			} else {
+				pal[2][c] = static_cast<uint8_t>((a[c] + b[c] + 1) / 2);
+			}
+		}
+
+		pal[2][3] = 255;
+		pal[3][3] = fourColor ? 255 : 0; // Transparent black
+		return pal;
+	}
+
+	// Writes the block, returns the error
+	uint32_t writeBC1(const rawrbox::BCBlock& block, const std::array<bool, 16>& opaque, uint16_t c0, uint16_t c1, bool threeColor, uint8_t* out, std::array<float, 16>* weights) {
+		if (threeColor ? c0 > c1 : c0 < c1) std::swap(c0, c1);
+
+		bool fourColor = c0 > c1;
+		auto pal = bc1Palette(c0, c1, fourColor);
+
+		constexpr std::array<float, 4> paletteWeights = {0.F, 1.F, 1.F / 3.F, 2.F / 3.F};
+		uint32_t indices = 0;
+		uint32_t error = 0;
+
+		for (size_t i = 0; i < 16; i++) {
+			uint32_t best = 0;
+
+			if (!opaque[i]) {
+				best = 3; // Only reached in 3 color mode
+			} else if (c0 != c1) {
+				uint32_t bestDist = UINT32_MAX;
+				uint32_t count = fourColor ? 4 : 3;
+
+				for (uint32_t p = 0; p < count; p++) {
+					uint32_t d = distance<3>(&block[i * 4], pal[p]);
+					if (d < bestDist) {
+						bestDist = d;
+						best = p;
+					}
+				}
+			}
+
+			if (opaque[i]) error += distance<3>(&block[i * 4], pal[best]);
+			if (weights != nullptr) (*weights)[i] = fourColor ? paletteWeights[best] : (best == 2 ? 0.5F : static_cast<float>(best));
+
+			indices |= best << (i * 2);
+		}
+
+		out[0] = static_cast<uint8_t>(c0 & 0xFF);
+		out[1] = static_cast<uint8_t>(c0 >> 8);
+		out[2] = static_cast<uint8_t>(c1 & 0xFF);
+		out[3] = static_cast<uint8_t>(c1 >> 8);
+		std::memcpy(out + 4, &indices, sizeof(uint32_t));
+
+		return error;
+	}
+	// ------
+
+	// BC7 ---
+	struct BC7Endpoint {
+		std::array<uint8_t, 4> value = {}; // 7 bits
+		uint8_t pbit = 0;
+
+		[[nodiscard]] uint8_t get(size_t c) const { return static_cast<uint8_t>((value[c] << 1) | pbit); }
+	};
+
+	BC7Endpoint quantizeBC7(const std::array<float, 4>& color) {
+		BC7Endpoint best = {};
+		float bestErr = 1e9F;
+
+		// The p-bit is shared by every channel, opaque endpoints need p = 1 or alpha ends up at 254
+		bool opaque = color[3] >= 254.5F;
+
+		for (uint8_t p = opaque ? 1 : 0; p < 2; p++) {
+			BC7Endpoint e = {};
+			e.pbit = p;
+
+			float err = 0.F;
+			for (size_t c = 0; c < 4; c++) {
+				e.value[c] = static_cast<uint8_t>(std::clamp(std::lround((color[c] - p) / 2.F), 0L, 127L));
+
+				float diff = static_cast<float>(e.get(c)) - color[c];
+				err += diff * diff;
+			}
+
+			if (err < bestErr) {
+				bestErr = err;
+				best = e;
+			}
+		}
+
+		return best;
+	}
+
+	uint32_t writeBC7(const rawrbox::BCBlock& block, BC7Endpoint e0, BC7Endpoint e1, uint8_t* out, std::array<float, 16>* weights) {
+		std::array<Texel, 16> pal = {};
+		for (size_t i = 0; i < 16; i++) {
+			for (size_t c = 0; c < 4; c++) {
+				pal[i][c] = static_cast<uint8_t>(((64 - BC7_WEIGHTS[i]) * e0.get(c) + BC7_WEIGHTS[i] * e1.get(c) + 32) >> 6);
+			}
+		}
+
+		std::array<uint32_t, 16> indices = {};
+		uint32_t error = 0;
+
+		for (size_t i = 0; i < 16; i++) {
+			uint32_t bestDist = UINT32_MAX;
+			for (uint32_t p = 0; p < 16; p++) {
+				uint32_t d = distance<4>(&block[i * 4], pal[p]);
+				if (d < bestDist) {
+					bestDist = d;
+					indices[i] = p;
+				}
+			}
+
+			error += bestDist;
+		}
+
+		// The first index has an implicit 0 msb, flip the endpoints if needed
+		if ((indices[0] & 8U) != 0U) {
+			std::swap(e0, e1);
+			for (auto& index : indices) {
+				index = 15 - index;
+			}
+		}
+
+		if (weights != nullptr) {
+			for (size_t i = 0; i < 16; i++) {
+				(*weights)[i] = static_cast<float>(BC7_WEIGHTS[indices[i]]) / 64.F;
+			}
+		}
+
+		std::memset(out, 0, 16);
+		BitWriter writer = {out, 0};
+		writer.write(1U << 6, 7); // Mode 6
+
+		for (size_t c = 0; c < 4; c++) {
+			writer.write(e0.value[c], 7);
+			writer.write(e1.value[c], 7);
+		}
+
+		writer.write(e0.pbit, 1);
+		writer.write(e1.pbit, 1);
+
+		for (size_t i = 0; i < 16; i++) {
+			writer.write(indices[i], i == 0 ? 3 : 4);
+		}
+
+		return error;
+	}
+	// ------
+
+	// Edge blocks repeat the last texel
+	void fetchBlock(const rawrbox::Vector2u& size, const std::vector<uint8_t>& pixels, uint8_t channels, uint32_t bx, uint32_t by, rawrbox::BCBlock& block) {
+		for (uint32_t y = 0; y < 4; y++) {
+			uint32_t py = std::min(by * 4 + y, size.y - 1);
+
+			for (uint32_t x = 0; x < 4; x++) {
+				uint32_t px = std::min(bx * 4 + x, size.x - 1);
+
+				const uint8_t* src = pixels.data() + (static_cast<size_t>(py) * size.x + px) * channels;
+				uint8_t* dst = block.data() + (y * 4 + x) * 4;
+
+				switch (channels) {
+					case 1:
+						dst[0] = dst[1] = dst[2] = src[0];
+						dst[3] = 255;
+						break;
+					case 2:
+						dst[0] = src[0];
+						dst[1] = src[1];
+						dst[2] = 0;
+						dst[3] = 255;
+						break;
+					case 3:
+						std::memcpy(dst, src, 3);
+						dst[3] = 255;
+						break;
+					default:
+						std::memcpy(dst, src, 4);
+						break;
+				}
+			}
+		}
+	}
+} // namespace
+
+namespace rawrbox {
+	// BLOCKS ---
+	void BC::encodeBC1(const rawrbox::BCBlock& block, uint8_t* out, bool alpha) {
+		std::array<bool, 16> opaque = {};
+		bool threeColor = false;
+
+		for (size_t i = 0; i < 16; i++) {
+			opaque[i] = !alpha || block[i * 4 + 3] >= 128;
+			threeColor |= !opaque[i];
+		}
+
+		std::array<float, 3> lo = {};
+		std::array<float, 3> hi = {};
+		principalRange<3>(block, opaque, lo, hi);
+
+		std::array<float, 16> weights = {};
+		uint32_t error = writeBC1(block, opaque, pack565(hi), pack565(lo), threeColor, out, &weights);
+		if (error == 0 || threeColor) return;
+
+		// One least squares pass, kept only if it helps
+		if (!refineEndpoints<3>(block, opaque, weights, lo, hi)) return;
+
+		std::array<uint8_t, 8> refined = {};
+		if (writeBC1(block, opaque, pack565(lo), pack565(hi), false, refined.data(), nullptr) < error) std::memcpy(out, refined.data(), refined.size());
+	}
+
+	void BC::encodeBC4(const rawrbox::BCBlock& block, uint8_t* out, uint8_t channel) {
+		uint8_t min = 255;
+		uint8_t max = 0;
+
+		for (size_t i = 0; i < 16; i++) {
+			min = std::min(min, block[i * 4 + channel]);
+			max = std::max(max, block[i * 4 + channel]);
+		}
+
+		out[0] = max; // max > min = 8 value mode
+		out[1] = min;
+
+		uint64_t indices = 0;
+		if (max != min) {
+			std::array<uint8_t, 8> pal = {max, min};
+			for (uint32_t code = 2; code < 8; code++) {
+				pal[code] = static_cast<uint8_t>(((8 - code) * max + (code - 1) * min + 3) / 7);
+			}
+
+			for (size_t i = 0; i < 16; i++) {
+				uint64_t best = 0;
+				int bestDist = 256;
+
+				for (uint32_t code = 0; code < 8; code++) {
+					int d = std::abs(static_cast<int>(block[i * 4 + channel]) - static_cast<int>(pal[code]));
+					if (d < bestDist) {
+						bestDist = d;
+						best = code;
+					}
+				}
+
+				indices |= best << (i * 3);
+			}
+		}
+
+		for (size_t i = 0; i < 6; i++) {
+			out[2 + i] = static_cast<uint8_t>((indices >> (i * 8)) & 0xFF);
+		}
+	}
+
+	void BC::encodeBC7(const rawrbox::BCBlock& block, uint8_t* out) {
+		std::array<bool, 16> mask = {};
+		mask.fill(true);
+
+		std::array<float, 4> lo = {};
+		std::array<float, 4> hi = {};
+		principalRange<4>(block, mask, lo, hi);
+
+		std::array<float, 16> weights = {};
+		uint32_t error = writeBC7(block, quantizeBC7(lo), quantizeBC7(hi), out, &weights);
+		if (error == 0) return;
+
+		if (!refineEndpoints<4>(block, mask, weights, lo, hi)) return;
+
+		std::array<uint8_t, 16> refined = {};
+		if (writeBC7(block, quantizeBC7(lo), quantizeBC7(hi), refined.data(), nullptr) < error) std::memcpy(out, refined.data(), refined.size());
+	}
+
+	void BC::decodeBC1(const uint8_t* in, rawrbox::BCBlock& block, bool alpha) {
+		auto c0 = static_cast<uint16_t>(in[0] | (in[1] << 8));
+		auto c1 = static_cast<uint16_t>(in[2] | (in[3] << 8));
+
+		uint32_t indices = 0;
+		std::memcpy(&indices, in + 4, sizeof(uint32_t));
+
+		auto pal = bc1Palette(c0, c1, !alpha || c0 > c1);
+		for (size_t i = 0; i < 16; i++) {
+			const auto& texel = pal[(indices >> (i * 2)) & 3U];
+			std::memcpy(block.data() + i * 4, texel.data(), alpha ? 4 : 3); // BC3 keeps the alpha block
+		}
+	}
+
+	void BC::decodeBC4(const uint8_t* in, rawrbox::BCBlock& block, uint8_t channel) {
+		uint8_t a0 = in[0];
+		uint8_t a1 = in[1];
+
+		std::array<uint8_t, 8> pal = {a0, a1};
+		if (a0 > a1) {
+			for (uint32_t code = 2; code < 8; code++) {
+				pal[code] = static_cast<uint8_t>(((8 - code) * a0 + (code - 1) * a1 + 3) / 7);
+			}
+		} else {
+			for (uint32_t code = 2; code < 6; code++) {
+				pal[code] = static_cast<uint8_t>(((6 - code) * a0 + (code - 1) * a1 + 2) / 5);
+			}
+
+			pal[6] = 0;
+			pal[7] = 255;
+		}
+
+		uint64_t indices = 0;
+		for (size_t i = 0; i < 6; i++) {
+			indices |= static_cast<uint64_t>(in[2 + i]) << (i * 8);
+		}
+
+		for (size_t i = 0; i < 16; i++) {
+			block[i * 4 + channel] = pal[(indices >> (i * 3)) & 7U];
+		}
+	}
+
+	bool BC::decodeBC7(const uint8_t* in, rawrbox::BCBlock& block) {
+		BitReader reader = {in, 0};
+		if (reader.read(7) != (1U << 6)) return false; // Not mode 6
+
+		std::array<uint32_t, 4> v0 = {};
+		std::array<uint32_t, 4> v1 = {};
+		for (size_t c = 0; c < 4; c++) {
+			v0[c] = reader.read(7);
+			v1[c] = reader.read(7);
+		}
+
+		uint32_t p0 = reader.read(1);
+		uint32_t p1 = reader.read(1);
+
+		for (size_t i = 0; i < 16; i++) {
+			uint32_t index = reader.read(i == 0 ? 3 : 4);
+			uint32_t w = BC7_WEIGHTS[index];
+
+			for (size_t c = 0; c < 4; c++) {
+				uint32_t e0 = (v0[c] << 1) | p0;
+				uint32_t e1 = (v1[c] << 1) | p1;
+
+				block[i * 4 + c] = static_cast<uint8_t>(((64 - w) * e0 + w * e1 + 32) >> 6);
+			}
+		}
+
+		return true;
+	}
+	// ----------
+
+	// UTILS ---
+	uint32_t BC::getBlockBytes(rawrbox::TEXTURE_COMPRESSION format) {
+		switch (format) {
+			case rawrbox::TEXTURE_COMPRESSION::BC1:
+			case rawrbox::TEXTURE_COMPRESSION::BC4:
+				return 8;
+			case rawrbox::TEXTURE_COMPRESSION::BC3:
+			case rawrbox::TEXTURE_COMPRESSION::BC5:
+			case rawrbox::TEXTURE_COMPRESSION::BC7:
+				return 16;
+			default:
+				RAWRBOX_CRITICAL("Texture is not block compressed");
+		}
+	}
+
+	uint8_t BC::getChannels(rawrbox::TEXTURE_COMPRESSION format) {
+		switch (format) {
+			case rawrbox::TEXTURE_COMPRESSION::BC4:
+				return 1;
+			case rawrbox::TEXTURE_COMPRESSION::BC5:
+				return 2;
+			default:
+				return 4;
+		}
+	}
+
+	uint32_t BC::getRowBytes(rawrbox::TEXTURE_COMPRESSION format, uint32_t width) {
+		return ((width + 3) / 4) * getBlockBytes(format);
+	}
+
+	size_t BC::getLevelBytes(rawrbox::TEXTURE_COMPRESSION format, const rawrbox::Vector2u& size) {
+		return static_cast<size_t>(getRowBytes(format, size.x)) * ((size.y + 3) / 4);
+	}
+	// ----------
+
+	std::vector<uint8_t> BC::encode(rawrbox::TEXTURE_COMPRESSION format, const rawrbox::Vector2u& size, const std::vector<uint8_t>& pixels, uint8_t channels) {
+		if (channels == 0U || channels > 4U || size.x == 0 || size.y == 0) RAWRBOX_CRITICAL("Invalid image size / channels");
+		if (pixels.size() < static_cast<size_t>(size.x) * size.y * channels) RAWRBOX_CRITICAL("Not enough pixels for a {}x{} image", size.x, size.y);
+
+		uint32_t blockBytes = getBlockBytes(format);
+		uint32_t blocksX = (size.x + 3) / 4;
+		uint32_t blocksY = (size.y + 3) / 4;
+
+		std::vector<uint8_t> out(getLevelBytes(format, size));
+
+		rawrbox::ASYNC::parallel(
+		    blocksY, [&](size_t start, size_t end) {
+			    rawrbox::BCBlock block = {};
+
+			    for (auto by = static_cast<uint32_t>(start); by < end; by++) {
+				    for (uint32_t bx = 0; bx < blocksX; bx++) {
+					    fetchBlock(size, pixels, channels, bx, by, block);
+					    uint8_t* dst = out.data() + (static_cast<size_t>(by) * blocksX + bx) * blockBytes;
+
+					    switch (format) {
+						    case rawrbox::TEXTURE_COMPRESSION::BC1:
+							    encodeBC1(block, dst, channels == 4U);
+							    break;
+						    case rawrbox::TEXTURE_COMPRESSION::BC3:
+							    encodeBC4(block, dst, 3);
+							    encodeBC1(block, dst + 8, false);
+							    break;
+						    case rawrbox::TEXTURE_COMPRESSION::BC4:
+							    encodeBC4(block, dst, 0);
+							    break;
+						    case rawrbox::TEXTURE_COMPRESSION::BC5:
+							    encodeBC4(block, dst, 0);
+							    encodeBC4(block, dst + 8, 1);
+							    break;
+						    case rawrbox::TEXTURE_COMPRESSION::BC7:
+							    encodeBC7(block, dst);
+							    break;
+						    default:
+							    break;
+					    }
+				    }
+			    }
+		    },
+		    std::max<size_t>(1, 1024 / blocksX));
+
+		return out;
+	}
+
+	std::vector<uint8_t> BC::decode(rawrbox::TEXTURE_COMPRESSION format, const rawrbox::Vector2u& size, const std::vector<uint8_t>& blocks) {
+		if (blocks.size() < getLevelBytes(format, size)) RAWRBOX_CRITICAL("Not enough blocks for a {}x{} image", size.x, size.y);
+
+		uint8_t channels = getChannels(format);
+		uint32_t blockBytes = getBlockBytes(format);
+		uint32_t blocksX = (size.x + 3) / 4;
+		uint32_t blocksY = (size.y + 3) / 4;
+
+		std::vector<uint8_t> out(static_cast<size_t>(size.x) * size.y * channels);
+		rawrbox::BCBlock block = {};
+
+		for (uint32_t by = 0; by < blocksY; by++) {
+			for (uint32_t bx = 0; bx < blocksX; bx++) {
+				const uint8_t* src = blocks.data() + (static_cast<size_t>(by) * blocksX + bx) * blockBytes;
+				block.fill(0);
+
+				switch (format) {
+					case rawrbox::TEXTURE_COMPRESSION::BC1:
+						decodeBC1(src, block, true);
+						break;
+					case rawrbox::TEXTURE_COMPRESSION::BC3:
+						decodeBC4(src, block, 3);
+						decodeBC1(src + 8, block, false);
+						break;
+					case rawrbox::TEXTURE_COMPRESSION::BC4:
+						decodeBC4(src, block, 0);
+						break;
+					case rawrbox::TEXTURE_COMPRESSION::BC5:
+						decodeBC4(src, block, 0);
+						decodeBC4(src + 8, block, 1);
+						break;
+					case rawrbox::TEXTURE_COMPRESSION::BC7:
+						if (!decodeBC7(src, block)) RAWRBOX_CRITICAL("Only BC7 mode 6 blocks can be decoded on the CPU");
+						break;
+					default:
+						break;
+				}
+
+				for (uint32_t y = 0; y < 4 && by * 4 + y < size.y; y++) {
+					for (uint32_t x = 0; x < 4 && bx * 4 + x < size.x; x++) {
+						uint8_t* dst = out.data() + ((static_cast<size_t>(by) * 4 + y) * size.x + bx * 4 + x) * channels;
+						std::memcpy(dst, block.data() + (y * 4 + x) * 4, channels);
+					}
+				}
+			}
+		}
+
+		return out;
+	}
+
+	rawrbox::ImageData BC::encode(const rawrbox::ImageData& data, rawrbox::TEXTURE_COMPRESSION format) {
+		if (!data.valid()) RAWRBOX_CRITICAL("Cannot compress invalid image data");
+		if (data.isCompressed()) RAWRBOX_CRITICAL("Image data is already compressed");
+
+		rawrbox::ImageData out = {};
+		out.size = data.size;
+		out.channels = getChannels(format);
+		out.compression = format;
+		out.sRGB = data.sRGB;
+		out.frames.reserve(data.frames.size());
+
+		for (const auto& frame : data.frames) {
+			rawrbox::ImageFrame compressed = {};
+			compressed.delay = frame.delay;
+			compressed.pixels = encode(format, data.size, frame.pixels, data.channels);
+
+			for (size_t mip = 0; mip < frame.mips.size(); mip++) {
+				compressed.mips.push_back(encode(format, rawrbox::MipUtils::getSize(data.size, static_cast<uint32_t>(mip + 1)), frame.mips[mip], data.channels));
+			}
+
+			out.frames.push_back(std::move(compressed));
+		}
+
+		return out;
+	}
+
+	rawrbox::ImageData BC::decode(const rawrbox::ImageData& data) {
+		if (!data.isCompressed()) RAWRBOX_CRITICAL("Image data is not compressed");
+
+		rawrbox::ImageData out = {};
+		out.size = data.size;
+		out.channels = getChannels(data.compression);
+		out.sRGB = data.sRGB;
+		out.frames.reserve(data.frames.size());
+
+		for (const auto& frame : data.frames) {
+			rawrbox::ImageFrame decoded = {};
+			decoded.delay = frame.delay;
+			decoded.pixels = decode(data.compression, data.size, frame.pixels);
+
+			for (size_t mip = 0; mip < frame.mips.size(); mip++) {
+				decoded.mips.push_back(decode(data.compression, rawrbox::MipUtils::getSize(data.size, static_cast<uint32_t>(mip + 1)), frame.mips[mip]));
+			}
+
+			out.frames.push_back(std::move(decoded));
+		}
+
+		return out;
+	}
+} // namespace rawrbox
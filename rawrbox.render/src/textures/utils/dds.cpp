@@ -0,0 +1,198 @@
+#include <rawrbox/render/textures/data.hpp>
+#include <rawrbox/render/textures/utils/bc.hpp>
+#include <rawrbox/render/textures/utils/dds.hpp>
+#include <rawrbox/render/textures/utils/mips.hpp>
+#include <rawrbox/utils/logger.hpp>
+
+#include <cstring>
+
+namespace {
+	constexpr size_t HEADER_SIZE = 128; // Magic + DDS_HEADER
+	constexpr size_t DX10_SIZE = 20;
+
+	constexpr uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+	constexpr uint32_t DDPF_ALPHAPIXELS = 0x1;
+	constexpr uint32_t DDPF_FOURCC = 0x4;
+	constexpr uint32_t DDPF_RGB = 0x40;
+	constexpr uint32_t DDPF_LUMINANCE = 0x20000;
+	constexpr uint32_t DDSCAPS2_CUBEMAP = 0x200;
+	constexpr uint32_t DDS_RESOURCE_MISC_TEXTURECUBE = 0x4;
+
+	constexpr uint32_t fourCC(const char (&code)[5]) {
+		return static_cast<uint32_t>(code[0]) | (static_cast<uint32_t>(code[1]) << 8) | (static_cast<uint32_t>(code[2]) << 16) | (static_cast<uint32_t>(code[3]) << 24);
+	}
+
+	template <typename T>
+	T read(const uint8_t* buffer, size_t offset) {
+		T value = {};
+		std::memcpy(&value, buffer + offset, sizeof(T));
+		return value;
+	}
+
+	// DXGI_FORMAT ---
+	bool fromDXGI(uint32_t dxgi, rawrbox::ImageData& data, bool& bgra) {
+		bgra = false;
+
+		switch (dxgi) {
+			case 28: // R8G8B8A8_UNORM
+			case 29: // R8G8B8A8_UNORM_SRGB
+				data.channels = 4;
+				data.sRGB = dxgi == 29;
+				return true;
+			case 87: // B8G8R8A8_UNORM
+			case 91: // B8G8R8A8_UNORM_SRGB
+				data.channels = 4;
+				data.sRGB = dxgi == 91;
+				bgra = true;
+				return true;
+			case 61: // R8_UNORM
+				data.channels = 1;
+				return true;
+			case 49: // R8G8_UNORM
+				data.channels = 2;
+				return true;
+			case 71: // BC1_UNORM
+			case 72: // BC1_UNORM_SRGB
+				data.compression = rawrbox::TEXTURE_COMPRESSION::BC1;
+				data.sRGB = dxgi == 72;
+				break;
+			case 77: // BC3_UNORM
+			case 78: // BC3_UNORM_SRGB
+				data.compression = rawrbox::TEXTURE_COMPRESSION::BC3;
+				data.sRGB = dxgi == 78;
+				break;
+			case 80: // BC4_UNORM
+				data.compression = rawrbox::TEXTURE_COMPRESSION::BC4;
+				break;
+			case 83: // BC5_UNORM
+				data.compression = rawrbox::TEXTURE_COMPRESSION::BC5;
+				break;
+			case 98: // BC7_UNORM
+			case 99: // BC7_UNORM_SRGB
+				data.compression = rawrbox::TEXTURE_COMPRESSION::BC7;
+				data.sRGB = dxgi == 99;
+				break;
+			default:
+				return false;
+		}
+
+		data.channels = rawrbox::BC::getChannels(data.compression);
+		return true;
+	}
+	// ------
+
+	size_t levelBytes(const rawrbox::ImageData& data, const rawrbox::Vector2u& size) {
+		if (data.isCompressed()) return rawrbox::BC::getLevelBytes(data.compression, size);
+		return static_cast<size_t>(size.x) * size.y * data.channels;
+	}
+} // namespace
+
+namespace rawrbox {
+	rawrbox::ImageData DDS::decode(const uint8_t* buffer, size_t bufferSize) {
+		if (buffer == nullptr || bufferSize < HEADER_SIZE) RAWRBOX_CRITICAL("Invalid data, too small for a DDS file!");
+		if (read<uint32_t>(buffer, 0) != fourCC("DDS ")) RAWRBOX_CRITICAL("Invalid DDS magic!");
+
+		auto flags = read<uint32_t>(buffer, 8);
+		auto height = read<uint32_t>(buffer, 12);
+		auto width = read<uint32_t>(buffer, 16);
+		auto mipCount = read<uint32_t>(buffer, 28);
+		auto pfFlags = read<uint32_t>(buffer, 80);
+		auto pfFourCC = read<uint32_t>(buffer, 84);
+		auto bitCount = read<uint32_t>(buffer, 88);
+		auto maskR = read<uint32_t>(buffer, 92);
+		auto maskA = read<uint32_t>(buffer, 104);
+		auto caps2 = read<uint32_t>(buffer, 112);
+
+		if (width == 0 || height == 0) RAWRBOX_CRITICAL("Invalid DDS size");
+
+		rawrbox::ImageData data = {};
+		data.size = {width, height};
+
+		size_t offset = HEADER_SIZE;
+		size_t slices = (caps2 & DDSCAPS2_CUBEMAP) != 0 ? 6 : 1;
+		bool bgra = false;
+
+		if ((pfFlags & DDPF_FOURCC) != 0) {
+			switch (pfFourCC) {
+				case fourCC("DXT1"):
+					data.compression = rawrbox::TEXTURE_COMPRESSION::BC1;
+					break;
+				case fourCC("DXT5"):
+					data.compression = rawrbox::TEXTURE_COMPRESSION::BC3;
+					break;
+				case fourCC("ATI1"):
+				case fourCC("BC4U"):
+					data.compression = rawrbox::TEXTURE_COMPRESSION::BC4;
+					break;
+				case fourCC("ATI2"):
+				case fourCC("BC5U"):
+					data.compression = rawrbox::TEXTURE_COMPRESSION::BC5;
+					break;
+				case fourCC("DX10"): {
+					if (bufferSize < HEADER_SIZE + DX10_SIZE) RAWRBOX_CRITICAL("Invalid DDS DX10 header");
+
+					auto dxgi = read<uint32_t>(buffer, HEADER_SIZE);
+					auto dimension = read<uint32_t>(buffer, HEADER_SIZE + 4);
+					auto misc = read<uint32_t>(buffer, HEADER_SIZE + 8);
+					auto arraySize = std::max(read<uint32_t>(buffer, HEADER_SIZE + 12), 1U);
+
+					if (dimension != 3) RAWRBOX_CRITICAL("Only 2D DDS textures are supported"); // D3D10_RESOURCE_DIMENSION_TEXTURE2D
+					if (!fromDXGI(dxgi, data, bgra)) RAWRBOX_CRITICAL("Unsupported DDS DXGI format {}", dxgi);
+
+					slices = arraySize * ((misc & DDS_RESOURCE_MISC_TEXTURECUBE) != 0 ? 6 : 1);
+					offset += DX10_SIZE;
+					break;
+				}
+				default:
+					RAWRBOX_CRITICAL("Unsupported DDS fourCC {:#x}", pfFourCC);
+			}
+
+			if (data.isCompressed()) data.channels = rawrbox::BC::getChannels(data.compression);
+		} else if ((pfFlags & DDPF_RGB) != 0 && bitCount == 32) {
+			if (maskR != 0x000000FF && maskR != 0x00FF0000) RAWRBOX_CRITICAL("Unsupported DDS channel masks");
+
+			data.channels = 4;
+			bgra = maskR == 0x00FF0000;
+		} else if ((pfFlags & DDPF_LUMINANCE) != 0 && bitCount == 8) {
+			data.channels = 1;
+		} else {
+			RAWRBOX_CRITICAL("Unsupported DDS pixel format");
+		}
+
+		bool alpha = (pfFlags & DDPF_ALPHAPIXELS) != 0 && maskA != 0;
+		uint32_t levels = (flags & DDSD_MIPMAPCOUNT) != 0 ? std::max(mipCount, 1U) : 1U;
+		levels = std::min(levels, rawrbox::MipUtils::getLevels(data.size));
+
+		// Each slice stores its full chain
+		data.frames.resize(slices);
+		for (auto& frame : data.frames) {
+			for (uint32_t level = 0; level < levels; level++) {
+				size_t bytes = levelBytes(data, rawrbox::MipUtils::getSize(data.size, level));
+				if (offset + bytes > bufferSize) RAWRBOX_CRITICAL("DDS file is truncated");
+
+				auto& dst = level == 0 ? frame.pixels : frame.mips.emplace_back();
+				dst.assign(buffer + offset, buffer + offset + bytes);
+				offset += bytes;
+
+				if (bgra) {
+					for (size_t i = 0; i < dst.size(); i += 4) {
+						std::swap(dst[i], dst[i + 2]);
+					}
+				}
+
+				// X8 formats
+				if (data.channels == 4 && !data.isCompressed() && !alpha && (pfFlags & DDPF_FOURCC) == 0) {
+					for (size_t i = 3; i < dst.size(); i += 4) {
+						dst[i] = 255;
+					}
+				}
+			}
+		}
+
+		return data;
+	}
+
+	rawrbox::ImageData DDS::decode(const std::vector<uint8_t>& data) {
+		return decode(data.data(), data.size());
+	}
+} // namespace rawrbox
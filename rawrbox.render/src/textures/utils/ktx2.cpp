@@ -0,0 +1,334 @@
+#include <rawrbox/render/textures/data.hpp>
+#include <rawrbox/render/textures/utils/bc.hpp>
+#include <rawrbox/render/textures/utils/ktx2.hpp>
+#include <rawrbox/render/textures/utils/mips.hpp>
+#include <rawrbox/utils/logger.hpp>
+
+#include <array>
+#include <cstring>
+
+namespace {
+	constexpr std::array<uint8_t, 12> IDENTIFIER = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+	constexpr size_t HEADER_SIZE = 80; // Identifier + header + index
+	constexpr size_t LEVEL_SIZE = 24;  // byteOffset, byteLength, uncompressedByteLength
+	constexpr size_t ALIGNMENT = 16;   // Covers lcm(texel block size, 4) of every format we write
+
+	// VkFormat ---
+	struct KTX2Format {
+		uint32_t vkFormat = 0;
+		rawrbox::TEXTURE_COMPRESSION compression = rawrbox::TEXTURE_COMPRESSION::NONE;
+		uint8_t channels = 0;
+		bool sRGB = false;
+	};
+
+	constexpr std::array<KTX2Format, 14> FORMATS = {{
+	    {9, rawrbox::TEXTURE_COMPRESSION::NONE, 1, false},  // R8_UNORM
+	    {16, rawrbox::TEXTURE_COMPRESSION::NONE, 2, false}, // R8G8_UNORM
+	    {37, rawrbox::TEXTURE_COMPRESSION::NONE, 4, false}, // R8G8B8A8_UNORM
+	    {43, rawrbox::TEXTURE_COMPRESSION::NONE, 4, true},  // R8G8B8A8_SRGB
+	    {131, rawrbox::TEXTURE_COMPRESSION::BC1, 4, false}, // BC1_RGB_UNORM_BLOCK
+	    {132, rawrbox::TEXTURE_COMPRESSION::BC1, 4, true},  // BC1_RGB_SRGB_BLOCK
+	    {133, rawrbox::TEXTURE_COMPRESSION::BC1, 4, false}, // BC1_RGBA_UNORM_BLOCK
+	    {134, rawrbox::TEXTURE_COMPRESSION::BC1, 4, true},  // BC1_RGBA_SRGB_BLOCK
+	    {137, rawrbox::TEXTURE_COMPRESSION::BC3, 4, false}, // BC3_UNORM_BLOCK
+	    {138, rawrbox::TEXTURE_COMPRESSION::BC3, 4, true},  // BC3_SRGB_BLOCK
+	    {139, rawrbox::TEXTURE_COMPRESSION::BC4, 1, false}, // BC4_UNORM_BLOCK
+	    {141, rawrbox::TEXTURE_COMPRESSION::BC5, 2, false}, // BC5_UNORM_BLOCK
+	    {145, rawrbox::TEXTURE_COMPRESSION::BC7, 4, false}, // BC7_UNORM_BLOCK
+	    {146, rawrbox::TEXTURE_COMPRESSION::BC7, 4, true},  // BC7_SRGB_BLOCK
+	}};
+
+	const KTX2Format* findFormat(uint32_t vkFormat) {
+		for (const auto& format : FORMATS) {
+			if (format.vkFormat == vkFormat) return &format;
+		}
+
+		return nullptr;
+	}
+
+	const KTX2Format* findFormat(const rawrbox::ImageData& data) {
+		for (const auto& format : FORMATS) {
+			if (format.compression != data.compression || format.sRGB != data.sRGB) continue;
+			if (format.compression == rawrbox::TEXTURE_COMPRESSION::NONE && format.channels != data.channels) continue;
+			if (format.vkFormat == 131 || format.vkFormat == 132) continue; // Prefer the RGBA BC1 variants
+
+			return &format;
+		}
+
+		return nullptr;
+	}
+	// ------
+
+	size_t levelBytes(const rawrbox::ImageData& data, const rawrbox::Vector2u& size) {
+		if (data.isCompressed()) return rawrbox::BC::getLevelBytes(data.compression, size);
+		return static_cast<size_t>(size.x) * size.y * data.channels;
+	}
+
+	template <typename T>
+	T read(const uint8_t* buffer, size_t offset) {
+		T value = {};
+		std::memcpy(&value, buffer + offset, sizeof(T));
+		return value;
+	}
+
+	template <typename T>
+	void write(std::vector<uint8_t>& out, size_t offset, T value) {
+		std::memcpy(out.data() + offset, &value, sizeof(T));
+	}
+
+	// Basic data format descriptor, so other tools can read the cache files
+	std::vector<uint8_t> buildDFD(const rawrbox::ImageData& data) {
+		struct Sample {
+			uint16_t offset = 0;
+			uint8_t length = 0; // Bits - 1
+			uint8_t channel = 0;
+			uint32_t upper = 0;
+		};
+
+		std::vector<Sample> samples = {};
+		uint8_t colorModel = 1; // RGBSDA
+		uint8_t blockSize = 0;  // Texel block dimension - 1
+		uint8_t bytesPlane = data.channels;
+
+		switch (data.compression) {
+			case rawrbox::TEXTURE_COMPRESSION::BC1:
+				colorModel = 128;
+				samples.push_back({0, 63, 0, UINT32_MAX});
+				break;
+			case rawrbox::TEXTURE_COMPRESSION::BC3:
+				colorModel = 130;
+				samples.push_back({0, 63, 15, UINT32_MAX}); // Alpha block first
+				samples.push_back({64, 63, 0, UINT32_MAX});
+				break;
+			case rawrbox::TEXTURE_COMPRESSION::BC4:
+				colorModel = 131;
+				samples.push_back({0, 63, 0, UINT32_MAX});
+				break;
+			case rawrbox::TEXTURE_COMPRESSION::BC5:
+				colorModel = 132;
+				samples.push_back({0, 63, 0, UINT32_MAX});
+				samples.push_back({64, 63, 1, UINT32_MAX});
+				break;
+			case rawrbox::TEXTURE_COMPRESSION::BC7:
+				colorModel = 134;
+				samples.push_back({0, 127, 0, UINT32_MAX});
+				break;
+			default:
+				for (uint8_t c = 0; c < data.channels; c++) {
+					samples.push_back({static_cast<uint16_t>(c * 8), 7, static_cast<uint8_t>(c == 3 ? 15 : c), 255});
+				}
+				break;
+		}
+
+		if (data.isCompressed()) {
+			blockSize = 3;
+			bytesPlane = static_cast<uint8_t>(rawrbox::BC::getBlockBytes(data.compression));
+		}
+
+		auto blockBytes = static_cast<uint16_t>(24 + samples.size() * 16);
+		std::vector<uint8_t> dfd(4 + blockBytes, 0);
+
+		write<uint32_t>(dfd, 0, static_cast<uint32_t>(dfd.size()));
+		write<uint32_t>(dfd, 4, 0);                                              // Khronos, basic descriptor
+		write<uint32_t>(dfd, 8, 2U | (static_cast<uint32_t>(blockBytes) << 16)); // Version 1.3
+
+		dfd[12] = colorModel;
+		dfd[13] = 1;                   // BT709 primaries
+		dfd[14] = data.sRGB ? 2 : 1;   // Transfer function
+		dfd[16] = dfd[17] = blockSize; // Texel block dimensions
+		dfd[20] = bytesPlane;
+
+		for (size_t i = 0; i < samples.size(); i++) {
+			size_t offset = 28 + i * 16;
+			const auto& sample = samples[i];
+
+			if (data.sRGB && sample.channel == 15 && !data.isCompressed()) dfd[offset + 3] |= 0x10; // Linear alpha
+
+			write<uint16_t>(dfd, offset, sample.offset);
+			dfd[offset + 2] = sample.length;
+			dfd[offset + 3] |= sample.channel;
+			write<uint32_t>(dfd, offset + 12, sample.upper);
+		}
+
+		return dfd;
+	}
+
+	// Entries sorted by key (std::map), value is stored with a trailing NUL
+	std::vector<uint8_t> buildKVD(const std::map<std::string, std::string>& keyValues) {
+		std::vector<uint8_t> kvd = {};
+
+		for (const auto& [key, value] : keyValues) {
+			if (key.empty()) RAWRBOX_CRITICAL("KTX2 keys cannot be empty");
+
+			auto length = static_cast<uint32_t>(key.size() + 1 + value.size() + 1);
+			size_t offset = kvd.size();
+
+			kvd.resize(offset + 4 + (length + 3) / 4 * 4, 0);
+			write<uint32_t>(kvd, offset, length);
+
+			std::memcpy(kvd.data() + offset + 4, key.data(), key.size());
+			std::memcpy(kvd.data() + offset + 4 + key.size() + 1, value.data(), value.size());
+		}
+
+		return kvd;
+	}
+} // namespace
+
+namespace rawrbox {
+	rawrbox::ImageData KTX2::decode(const uint8_t* buffer, size_t bufferSize) {
+		if (buffer == nullptr || bufferSize < HEADER_SIZE) RAWRBOX_CRITICAL("Invalid data, too small for a KTX2 file!");
+		if (std::memcmp(buffer, IDENTIFIER.data(), IDENTIFIER.size()) != 0) RAWRBOX_CRITICAL("Invalid KTX2 identifier!");
+
+		auto vkFormat = read<uint32_t>(buffer, 12);
+		auto width = read<uint32_t>(buffer, 20);
+		auto height = read<uint32_t>(buffer, 24);
+		auto depth = read<uint32_t>(buffer, 28);
+		auto layers = std::max(read<uint32_t>(buffer, 32), 1U);
+		auto faces = std::max(read<uint32_t>(buffer, 36), 1U);
+		auto levels = std::max(read<uint32_t>(buffer, 40), 1U);
+		auto supercompression = read<uint32_t>(buffer, 44);
+
+		if (vkFormat == 0 || supercompression == 1) RAWRBOX_CRITICAL("Basis Universal KTX2 payloads are not supported, they need a transcoder");
+		if (supercompression != 0) RAWRBOX_CRITICAL("Supercompressed KTX2 files are not supported (scheme {})", supercompression);
+		if (depth > 1) RAWRBOX_CRITICAL("3D KTX2 textures are not supported");
+		if (width == 0 || height == 0) RAWRBOX_CRITICAL("Invalid KTX2 size");
+
+		const auto* format = findFormat(vkFormat);
+		if (format == nullptr) RAWRBOX_CRITICAL("Unsupported KTX2 format {}", vkFormat);
+		if (bufferSize < HEADER_SIZE + LEVEL_SIZE * levels) RAWRBOX_CRITICAL("Invalid KTX2 level index");
+
+		rawrbox::ImageData data = {};
+		data.size = {width, height};
+		data.channels = format->channels;
+		data.compression = format->compression;
+		data.sRGB = format->sRGB;
+		data.frames.resize(static_cast<size_t>(layers) * faces);
+
+		levels = std::min(levels, rawrbox::MipUtils::getLevels(data.size));
+		for (uint32_t level = 0; level < levels; level++) {
+			auto offset = read<uint64_t>(buffer, HEADER_SIZE + level * LEVEL_SIZE);
+			auto length = read<uint64_t>(buffer, HEADER_SIZE + level * LEVEL_SIZE + 8);
+
+			size_t bytes = levelBytes(data, rawrbox::MipUtils::getSize(data.size, level));
+			if (length < bytes * data.frames.size() || offset + length > bufferSize) RAWRBOX_CRITICAL("Invalid KTX2 level {}", level);
+
+			// Layers, then faces
+			for (size_t frame = 0; frame < data.frames.size(); frame++) {
+				const uint8_t* src = buffer + offset + frame * bytes;
+				auto& dst = level == 0 ? data.frames[frame].pixels : data.frames[frame].mips.emplace_back();
+
+				dst.assign(src, src + bytes);
+			}
+		}
+
+		return data;
+	}
+
+	rawrbox::ImageData KTX2::decode(const std::vector<uint8_t>& data) {
+		return decode(data.data(), data.size());
+	}
+
+	std::map<std::string, std::string> KTX2::getKeyValues(const uint8_t* buffer, size_t bufferSize) {
+		if (buffer == nullptr || bufferSize < HEADER_SIZE) RAWRBOX_CRITICAL("Invalid data, too small for a KTX2 file!");
+		if (std::memcmp(buffer, IDENTIFIER.data(), IDENTIFIER.size()) != 0) RAWRBOX_CRITICAL("Invalid KTX2 identifier!");
+
+		size_t kvdOffset = read<uint32_t>(buffer, 56);
+		size_t kvdLength = read<uint32_t>(buffer, 60);
+		if (kvdOffset + kvdLength > bufferSize) RAWRBOX_CRITICAL("Invalid KTX2 key / value data");
+
+		std::map<std::string, std::string> keyValues = {};
+		size_t offset = kvdOffset;
+		size_t end = kvdOffset + kvdLength;
+
+		while (offset + 4 <= end) {
+			size_t length = read<uint32_t>(buffer, offset);
+			offset += 4;
+
+			if (length == 0 || offset + length > end) RAWRBOX_CRITICAL("Invalid KTX2 key / value entry");
+
+			const auto* entry = reinterpret_cast<const char*>(buffer + offset);
+			const auto* split = static_cast<const char*>(std::memchr(entry, '\0', length));
+			if (split == nullptr) RAWRBOX_CRITICAL("Invalid KTX2 key / value entry, missing key terminator");
+
+			std::string key(entry, split);
+			std::string value(split + 1, entry + length);
+			if (!value.empty() && value.back() == '\0') value.pop_back();
+
+			keyValues[key] = std::move(value);
+			offset += (length + 3) / 4 * 4;
+		}
+
+		return keyValues;
+	}
+
+	std::map<std::string, std::string> KTX2::getKeyValues(const std::vector<uint8_t>& data) {
+		return getKeyValues(data.data(), data.size());
+	}
+
+	std::vector<uint8_t> KTX2::encode(const rawrbox::ImageData& data, const std::map<std::string, std::string>& keyValues) {
+		if (!data.valid() || data.empty()) RAWRBOX_CRITICAL("Cannot encode invalid image data");
+
+		const auto* format = findFormat(data);
+		if (format == nullptr) RAWRBOX_CRITICAL("Image format cannot be stored in KTX2");
+
+		uint32_t levels = data.mipLevels();
+		auto dfd = buildDFD(data);
+		auto kvd = buildKVD(keyValues);
+
+		size_t dfdOffset = HEADER_SIZE + LEVEL_SIZE * levels;
+		size_t kvdOffset = dfdOffset + dfd.size();
+		size_t offset = kvdOffset + kvd.size();
+
+		// Levels go from the smallest to the largest
+		std::vector<std::pair<size_t, size_t>> placement(levels);
+		for (auto level = static_cast<int>(levels) - 1; level >= 0; level--) {
+			offset = (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+			size_t length = levelBytes(data, rawrbox::MipUtils::getSize(data.size, static_cast<uint32_t>(level))) * data.frames.size();
+			placement[level] = {offset, length};
+			offset += length;
+		}
+
+		std::vector<uint8_t> out(offset, 0);
+		std::memcpy(out.data(), IDENTIFIER.data(), IDENTIFIER.size());
+
+		write<uint32_t>(out, 12, format->vkFormat);
+		write<uint32_t>(out, 16, 1); // typeSize, 1 for 8 bit & block formats
+		write<uint32_t>(out, 20, data.size.x);
+		write<uint32_t>(out, 24, data.size.y);
+		write<uint32_t>(out, 28, 0);
+		write<uint32_t>(out, 32, data.frames.size() > 1 ? static_cast<uint32_t>(data.frames.size()) : 0U);
+		write<uint32_t>(out, 36, 1);
+		write<uint32_t>(out, 40, levels);
+		write<uint32_t>(out, 44, 0);
+
+		write<uint32_t>(out, 48, static_cast<uint32_t>(dfdOffset));
+		write<uint32_t>(out, 52, static_cast<uint32_t>(dfd.size()));
+		std::memcpy(out.data() + dfdOffset, dfd.data(), dfd.size());
+
+		if (!kvd.empty()) {
+			write<uint32_t>(out, 56, static_cast<uint32_t>(kvdOffset));
+			write<uint32_t>(out, 60, static_cast<uint32_t>(kvd.size()));
+			std::memcpy(out.data() + kvdOffset, kvd.data(), kvd.size());
+		}
+
+		for (uint32_t level = 0; level < levels; level++) {
+			auto [levelOffset, length] = placement[level];
+
+			write<uint64_t>(out, HEADER_SIZE + level * LEVEL_SIZE, levelOffset);
+			write<uint64_t>(out, HEADER_SIZE + level * LEVEL_SIZE + 8, length);
+			write<uint64_t>(out, HEADER_SIZE + level * LEVEL_SIZE + 16, length);
+
+			size_t bytes = length / data.frames.size();
+			for (size_t frame = 0; frame < data.frames.size(); frame++) {
+				const auto& src = level == 0 ? data.frames[frame].pixels : data.frames[frame].mips[level - 1];
+				if (src.size() < bytes) RAWRBOX_CRITICAL("Invalid level {} data on frame {}", level, frame);
+
+				std::memcpy(out.data() + levelOffset + frame * bytes, src.data(), bytes);
+			}
+		}
+
+		return out;
+	}
+} // namespace rawrbox
@@ -0,0 +1,149 @@
+#include <rawrbox/render/textures/data.hpp>
+#include <rawrbox/render/textures/utils/mips.hpp>
+#include <rawrbox/utils/logger.hpp>
+#include <rawrbox/utils/threading.hpp>
+
+#include <array>
+#include <bit>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+	#include <emmintrin.h>
+	#define RAWRBOX_MIPS_SSE
+#endif
+
+namespace {
+	constexpr size_t LINEAR_STEPS = 4096; // Linear -> sRGB table resolution
+	constexpr size_t BLOCK_PIXELS = 32768; // Destination pixels per job
+
+	struct SRGBTables {
+		std::array<float, 256> toLinear = {};
+		std::array<uint8_t, LINEAR_STEPS> toSRGB = {};
+
+		SRGBTables() {
+			for (size_t i = 0; i < toLinear.size(); i++) {
+				float c = static_cast<float>(i) / 255.F;
+				toLinear[i] = c <= 0.04045F ? c / 12.92F : std::pow((c + 0.055F) / 1.055F, 2.4F);
+			}
+
+			for (size_t i = 0; i < toSRGB.size(); i++) {
+				float c = static_cast<float>(i) / static_cast<float>(LINEAR_STEPS - 1);
+				float s = c <= 0.0031308F ? c * 12.92F : 1.055F * std::pow(c, 1.F / 2.4F) - 0.055F;
+				toSRGB[i] = static_cast<uint8_t>(std::clamp(s * 255.F + 0.5F, 0.F, 255.F));
+			}
+		}
+	};
+
+	const SRGBTables& tables() {
+		static const SRGBTables t = {};
+		return t;
+	}
+
+	// Averages 2 source rows into a destination row
+	void downsampleRow(const uint8_t* row0, const uint8_t* row1, uint8_t* out, uint32_t srcWidth, uint32_t dstWidth, uint8_t channels, bool sRGB) {
+		uint32_t x = 0;
+
+		if (sRGB) {
+			const auto& t = tables();
+			uint8_t colors = std::min<uint8_t>(channels, 3U); // Alpha stays linear
+
+			for (; x < dstWidth; x++) {
+				size_t a = static_cast<size_t>(x * 2) * channels;
+				size_t b = static_cast<size_t>(std::min(x * 2 + 1, srcWidth - 1)) * channels;
+
+				for (uint8_t c = 0; c < channels; c++) {
+					if (c < colors) {
+						float sum = t.toLinear[row0[a + c]] + t.toLinear[row0[b + c]] + t.toLinear[row1[a + c]] + t.toLinear[row1[b + c]];
+						out[x * channels + c] = t.toSRGB[static_cast<size_t>(sum * 0.25F * static_cast<float>(LINEAR_STEPS - 1) + 0.5F)];
+					} else {
+						out[x * channels + c] = static_cast<uint8_t>((row0[a + c] + row0[b + c] + row1[a + c] + row1[b + c] + 2) >> 2);
+					}
+				}
+			}
+
+			return;
+		}
+
+#ifdef RAWRBOX_MIPS_SSE
+		// 2 destination pixels per step, needs 4 full source pixels
+		if (channels == 4U) {
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i round = _mm_set1_epi16(2);
+
+			for (; x + 2 <= dstWidth && x * 2 + 4 <= srcWidth; x += 2) {
+				__m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + static_cast<size_t>(x) * 8));
+				__m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + static_cast<size_t>(x) * 8));
+
+				__m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(r0, zero), _mm_unpacklo_epi8(r1, zero)); // px 0 + px 1
+				__m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(r0, zero), _mm_unpackhi_epi8(r1, zero)); // px 2 + px 3
+
+				lo = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+				hi = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+
+				__m128i sum = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(lo, hi), round), 2);
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(out + static_cast<size_t>(x) * 4), _mm_packus_epi16(sum, zero));
+			}
+		}
+#endif
+
+		for (; x < dstWidth; x++) {
+			size_t a = static_cast<size_t>(x * 2) * channels;
+			size_t b = static_cast<size_t>(std::min(x * 2 + 1, srcWidth - 1)) * channels;
+
+			for (uint8_t c = 0; c < channels; c++) {
+				out[x * channels + c] = static_cast<uint8_t>((row0[a + c] + row0[b + c] + row1[a + c] + row1[b + c] + 2) >> 2);
+			}
+		}
+	}
+} // namespace
+
+namespace rawrbox {
+	uint32_t MipUtils::getLevels(const rawrbox::Vector2u& size) {
+		return static_cast<uint32_t>(std::bit_width(std::max({size.x, size.y, 1U})));
+	}
+
+	rawrbox::Vector2u MipUtils::getSize(const rawrbox::Vector2u& size, uint32_t level) {
+		return {std::max(size.x >> level, 1U), std::max(size.y >> level, 1U)};
+	}
+
+	std::vector<uint8_t> MipUtils::downsample(const rawrbox::Vector2u& size, const std::vector<uint8_t>& pixels, uint8_t channels, bool sRGB) {
+		if (channels == 0U || size.x == 0 || size.y == 0) RAWRBOX_CRITICAL("Invalid image size / channels");
+		if (pixels.size() < static_cast<size_t>(size.x) * size.y * channels) RAWRBOX_CRITICAL("Not enough pixels for a {}x{} image", size.x, size.y);
+
+		auto dst = getSize(size, 1);
+		std::vector<uint8_t> out(static_cast<size_t>(dst.x) * dst.y * channels);
+
+		size_t srcStride = static_cast<size_t>(size.x) * channels;
+		size_t dstStride = static_cast<size_t>(dst.x) * channels;
+
+		rawrbox::ASYNC::parallel(
+		    dst.y, [&](size_t start, size_t end) {
+			    for (size_t y = start; y < end; y++) {
+				    const uint8_t* row0 = pixels.data() + (y * 2) * srcStride;
+				    const uint8_t* row1 = pixels.data() + std::min<size_t>(y * 2 + 1, size.y - 1) * srcStride;
+
+				    downsampleRow(row0, row1, out.data() + y * dstStride, size.x, dst.x, channels, sRGB);
+			    }
+		    },
+		    std::max<size_t>(1, BLOCK_PIXELS / dst.x));
+
+		return out;
+	}
+
+	void MipUtils::generate(rawrbox::ImageData& data, bool sRGB, uint32_t levels) {
+		if (!data.valid()) RAWRBOX_CRITICAL("Cannot generate mips for invalid image data");
+		if (data.isCompressed()) RAWRBOX_CRITICAL("Cannot generate mips for block compressed data, generate them before encoding");
+
+		uint32_t maxLevels = getLevels(data.size);
+		levels = levels == 0 ? maxLevels : std::min(levels, maxLevels);
+
+		for (auto& frame : data.frames) {
+			if (frame.mips.size() + 1 >= levels) continue; // Already there
+
+			for (auto level = static_cast<uint32_t>(frame.mips.size()) + 1; level < levels; level++) {
+				const auto& src = level == 1 ? frame.pixels : frame.mips.back();
+				frame.mips.push_back(downsample(getSize(data.size, level - 1), src, data.channels, sRGB));
+			}
+		}
+	}
+} // namespace rawrbox
@@ -0,0 +1,82 @@
+#include <rawrbox/render/textures/utils/pack_node.hpp>
+
+#include <algorithm>
+
+namespace rawrbox {
+	bool PackNode::canInsertNode(uint32_t insertedWidth, uint32_t insertedHeight) {
+		if (used) return false;
+
+		if (left && right) {
+			if (left->canInsertNode(insertedWidth, insertedHeight)) return true;
+			if (right->canInsertNode(insertedWidth, insertedHeight)) return true;
+
+			return false;
+		}
+
+		if (insertedWidth > width || insertedHeight > height) return false;
+		if (width == insertedWidth && height == insertedHeight) return true;
+
+		// if all of the above didn't return, the current leaf is large enough,
+		// with some space to spare, so we split up the current node so we have
+		// one prefectly fitted node and some spare nodes
+		int remainingWidth = std::max<int>(0, static_cast<int>(width) - static_cast<int>(insertedWidth));
+		int remainingHeight = std::max<int>(0, static_cast<int>(height) - static_cast<int>(insertedHeight));
+
+		bool isRemainderWiderThanHigh = remainingWidth > remainingHeight;
+
+		if (isRemainderWiderThanHigh) { // if wider than high, split verticallly
+			left = std::make_unique<rawrbox::PackNode>(x, y, insertedWidth, height);
+			right = std::make_unique<rawrbox::PackNode>(x + insertedWidth, y, remainingWidth, height);
+		} else { // That'd make the remainder higher than it's wide, split horizontally
+			left = std::make_unique<rawrbox::PackNode>(x, y, width, insertedHeight);
+			right = std::make_unique<rawrbox::PackNode>(x, y + insertedHeight, width, remainingHeight);
+		}
+
+		return left->canInsertNode(insertedWidth, insertedHeight);
+	}
+
+	std::optional<std::reference_wrapper<rawrbox::PackNode>> PackNode::InsertNode(uint32_t insertedWidth, uint32_t insertedHeight) {
+		if (used) return std::nullopt;
+
+		if (left && right) {
+			// both children exist, which means this node is full, try left then right
+			if (auto node = left->InsertNode(insertedWidth, insertedHeight); node != std::nullopt) {
+				return node;
+			}
+
+			if (auto node = right->InsertNode(insertedWidth, insertedHeight); node != std::nullopt) {
+				return node;
+			}
+
+			return std::nullopt;
+		}
+
+		if (insertedWidth > width || insertedHeight > height) {
+			// to be insterted node is too big, can't fit here
+			return std::nullopt;
+		}
+
+		if (width == insertedWidth && height == insertedHeight) {
+			// fits perfectly
+			return *this;
+		}
+
+		// if all of the above didn't return, the current leaf is large enough,
+		// with some space to spare, so we split up the current node so we have
+		// one prefectly fitted node and some spare nodes
+		int remainingWidth = width - insertedWidth;
+		int remainingHeight = height - insertedHeight;
+
+		bool isRemainderWiderThanHigh = remainingWidth > remainingHeight;
+
+		if (isRemainderWiderThanHigh) { // if wider than high, split verticallly
+			left = std::make_unique<rawrbox::PackNode>(x, y, insertedWidth, height);
+			right = std::make_unique<rawrbox::PackNode>(x + insertedWidth, y, remainingWidth, height);
+		} else { // That'd make the remainder higher than it's wide, split horizontally
+			left = std::make_unique<rawrbox::PackNode>(x, y, width, insertedHeight);
+			right = std::make_unique<rawrbox::PackNode>(x, y + insertedHeight, width, remainingHeight);
+		}
+
+		return left->InsertNode(insertedWidth, insertedHeight);
+	}
+} // namespace rawrbox
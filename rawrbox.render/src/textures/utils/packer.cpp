@@ -0,0 +1,383 @@
+#include <rawrbox/render/textures/utils/packer.hpp>
+#include <rawrbox/utils/logger.hpp>
+
+#include <algorithm>
+
+namespace rawrbox {
+	AtlasPacker::AtlasPacker(uint32_t size, uint32_t maxPages, uint32_t padding) : _size(size), _maxPages(std::max(maxPages, 1U)), _padding(padding) {
+		if (size == 0) RAWRBOX_CRITICAL("Atlas size cannot be 0");
+		this->addPage();
+	}
+
+	// FREE AXIS ----
+	AtlasPacker::FreeAxis::FreeAxis(uint32_t extent) {
+		this->leaves = 1;
+		while (this->leaves < extent) {
+			this->leaves <<= 1;
+		}
+
+		this->tree.resize(static_cast<size_t>(this->leaves) * 2, 0U);
+	}
+
+	void AtlasPacker::FreeAxis::insert(uint32_t side, uint32_t other, uint32_t x, uint32_t y) {
+		this->buckets[side].insert({other, x, y});
+		this->refresh(side);
+	}
+
+	void AtlasPacker::FreeAxis::erase(uint32_t side, uint32_t other, uint32_t x, uint32_t y) {
+		auto fnd = this->buckets.find(side);
+		if (fnd == this->buckets.end()) return;
+
+		fnd->second.erase({other, x, y});
+		if (fnd->second.empty()) this->buckets.erase(fnd);
+
+		this->refresh(side);
+	}
+
+	std::optional<std::tuple<uint32_t, uint32_t, uint32_t, uint32_t>> AtlasPacker::FreeAxis::find(uint32_t side, uint32_t other) const {
+		auto bucket = this->first(1, 0, this->leaves - 1, side, other);
+		if (!bucket.has_value()) return std::nullopt;
+
+		// The tree says this bucket has one wide enough
+		auto [o, x, y] = *this->buckets.at(bucket.value()).lower_bound({other, 0U, 0U});
+		return std::make_tuple(bucket.value(), o, x, y);
+	}
+
+	void AtlasPacker::FreeAxis::refresh(uint32_t side) {
+		auto fnd = this->buckets.find(side);
+
+		size_t node = this->leaves + side;
+		this->tree[node] = fnd == this->buckets.end() ? 0U : std::get<0>(*fnd->second.rbegin());
+
+		for (node >>= 1; node > 0; node >>= 1) {
+			this->tree[node] = std::max(this->tree[node * 2], this->tree[node * 2 + 1]);
+		}
+	}
+
+	std::optional<uint32_t> AtlasPacker::FreeAxis::first(size_t node, uint32_t lo, uint32_t hi, uint32_t side, uint32_t other) const {
+		// Only the ranges straddling `side` get split, the rest answer from their max
+		if (hi < side || this->tree[node] < other) return std::nullopt;
+		if (lo == hi) return lo;
+
+		uint32_t mid = lo + (hi - lo) / 2;
+
+		auto left = this->first(node * 2, lo, mid, side, other);
+		if (left.has_value()) return left;
+
+		return this->first(node * 2 + 1, mid + 1, hi, side, other);
+	}
+	// ------------
+
+	// PRIVATE ----
+	std::optional<AtlasPacker::FreeRect> AtlasPacker::find(uint32_t page, uint32_t width, uint32_t height) const {
+		const auto& free = this->_free[page];
+
+		// Least height left over (narrowest on ties), then least width left over
+		std::optional<FreeRect> tall = free.byHeight.find(height, width);
+		std::optional<FreeRect> wide = std::nullopt;
+
+		auto byWidth = free.byWidth.find(width, height);
+		if (byWidth.has_value()) {
+			auto [w, h, x, y] = byWidth.value();
+			wide = FreeRect{h, w, x, y};
+		}
+
+		if (!tall.has_value() || !wide.has_value()) return tall.has_value() ? tall : wide;
+
+		// Best short side fit, ties go to the best long side
+		auto score = [width, height](const FreeRect& rect) {
+			auto leftH = std::get<0>(rect) - height;
+			auto leftW = std::get<1>(rect) - width;
+
+			return std::make_pair(std::min(leftW, leftH), std::max(leftW, leftH));
+		};
+
+		return score(wide.value()) < score(tall.value()) ? wide : tall;
+	}
+
+	void AtlasPacker::place(uint32_t page, const FreeRect& free, uint32_t width, uint32_t height) {
+		auto [freeH, freeW, freeX, freeY] = free;
+		this->eraseFree(page, free);
+
+		uint32_t leftoverW = freeW - width;
+		uint32_t leftoverH = freeH - height;
+
+		// Split along the shorter leftover, keeps the bigger piece as large as possible
+		FreeRect right = {};
+		FreeRect bottom = {};
+
+		if (leftoverW < leftoverH) {
+			right = {height, leftoverW, freeX + width, freeY};
+			bottom = {leftoverH, freeW, freeX, freeY + height};
+		} else {
+			right = {freeH, leftoverW, freeX + width, freeY};
+			bottom = {leftoverH, width, freeX, freeY + height};
+		}
+
+		if (std::get<0>(right) != 0 && std::get<1>(right) != 0) this->addFree(page, right);
+		if (std::get<0>(bottom) != 0 && std::get<1>(bottom) != 0) this->addFree(page, bottom);
+	}
+
+	void AtlasPacker::release(uint32_t page, FreeRect rect) {
+		// Merge with neighbours sharing a full edge, the grown rect can merge again
+		auto other = this->neighbour(page, rect);
+		while (other.has_value()) {
+			auto [h, w, x, y] = rect;
+			auto [oh, ow, ox, oy] = other.value();
+
+			if (oy == y && oh == h) {
+				rect = {h, w + ow, std::min(x, ox), y};
+			} else {
+				rect = {h + oh, w, x, std::min(y, oy)};
+			}
+
+			this->eraseFree(page, other.value());
+			other = this->neighbour(page, rect);
+		}
+
+		this->addFree(page, rect);
+	}
+
+	std::optional<AtlasPacker::FreeRect> AtlasPacker::neighbour(uint32_t page, const FreeRect& rect) const {
+		const auto& free = this->_free[page];
+		auto [h, w, x, y] = rect;
+
+		auto key = [](uint32_t cx, uint32_t cy) { return (static_cast<uint64_t>(cx) << 32U) | cy; };
+
+		auto left = free.topRight.find(key(x, y));
+		if (left != free.topRight.end() && std::get<0>(left->second) == h) return left->second;
+
+		auto right = free.topLeft.find(key(x + w, y));
+		if (right != free.topLeft.end() && std::get<0>(right->second) == h) return right->second;
+
+		auto up = free.bottomLeft.find(key(x, y));
+		if (up != free.bottomLeft.end() && std::get<1>(up->second) == w) return up->second;
+
+		auto down = free.topLeft.find(key(x, y + h));
+		if (down != free.topLeft.end() && std::get<1>(down->second) == w) return down->second;
+
+		return std::nullopt;
+	}
+
+	void AtlasPacker::addFree(uint32_t page, const FreeRect& rect) {
+		auto& free = this->_free[page];
+		auto [h, w, x, y] = rect;
+
+		free.byHeight.insert(h, w, x, y);
+		free.byWidth.insert(w, h, x, y);
+
+		free.topLeft[(static_cast<uint64_t>(x) << 32U) | y] = rect;
+		free.topRight[(static_cast<uint64_t>(x + w) << 32U) | y] = rect;
+		free.bottomLeft[(static_cast<uint64_t>(x) << 32U) | (y + h)] = rect;
+	}
+
+	void AtlasPacker::eraseFree(uint32_t page, FreeRect rect) {
+		auto& free = this->_free[page];
+		auto [h, w, x, y] = rect;
+
+		free.byHeight.erase(h, w, x, y);
+		free.byWidth.erase(w, h, x, y);
+
+		free.topLeft.erase((static_cast<uint64_t>(x) << 32U) | y);
+		free.topRight.erase((static_cast<uint64_t>(x + w) << 32U) | y);
+		free.bottomLeft.erase((static_cast<uint64_t>(x) << 32U) | (y + h));
+	}
+
+	void AtlasPacker::addPage() {
+		// Padding goes right / bottom of each sprite, so the page has room for the last one's
+		auto size = this->_size + this->_padding;
+
+		auto& free = this->_free.emplace_back();
+		free.byHeight = FreeAxis(size + 1);
+		free.byWidth = FreeAxis(size + 1);
+
+		this->addFree(static_cast<uint32_t>(this->_free.size() - 1), {size, size, 0U, 0U});
+	}
+	// ------------
+
+	std::optional<rawrbox::AtlasRect> AtlasPacker::insert(uint32_t width, uint32_t height) {
+		if (width > this->_size || height > this->_size) return std::nullopt;
+
+		rawrbox::AtlasRect rect = {};
+		rect.id = this->_nextID++;
+		rect.width = width;
+		rect.height = height;
+
+		// Empty sprites take no space
+		if (width != 0 && height != 0) {
+			auto paddedW = width + this->_padding;
+			auto paddedH = height + this->_padding;
+
+			std::optional<FreeRect> free = std::nullopt;
+			for (uint32_t page = 0; page < this->_free.size(); page++) {
+				free = this->find(page, paddedW, paddedH);
+				if (!free.has_value()) continue;
+
+				rect.page = page;
+				break;
+			}
+
+			if (!free.has_value()) {
+				if (this->_free.size() >= this->_maxPages) return std::nullopt;
+
+				this->addPage();
+				rect.page = static_cast<uint32_t>(this->_free.size() - 1);
+				free = this->find(rect.page, paddedW, paddedH);
+			}
+
+			rect.x = std::get<2>(*free);
+			rect.y = std::get<3>(*free);
+
+			this->place(rect.page, *free, paddedW, paddedH);
+			this->_usedArea += static_cast<uint64_t>(width) * height;
+		}
+
+		this->_lru.push_back(rect.id);
+		this->_sprites[rect.id] = {rect, std::prev(this->_lru.end())};
+
+		return rect;
+	}
+
+	bool AtlasPacker::remove(uint64_t id) {
+		auto fnd = this->_sprites.find(id);
+		if (fnd == this->_sprites.end()) return false;
+
+		const auto& rect = fnd->second.rect;
+		if (rect.width != 0 && rect.height != 0) {
+			this->release(rect.page, {rect.height + this->_padding, rect.width + this->_padding, rect.x, rect.y});
+			this->_usedArea -= static_cast<uint64_t>(rect.width) * rect.height;
+		}
+
+		this->_lru.erase(fnd->second.lru);
+		this->_sprites.erase(fnd);
+
+		return true;
+	}
+
+	void AtlasPacker::touch(uint64_t id) {
+		auto fnd = this->_sprites.find(id);
+		if (fnd == this->_sprites.end()) return;
+
+		this->_lru.splice(this->_lru.end(), this->_lru, fnd->second.lru);
+	}
+
+	std::vector<rawrbox::AtlasRect> AtlasPacker::evict(uint32_t width, uint32_t height) {
+		std::vector<rawrbox::AtlasRect> evicted = {};
+
+		while (!this->canInsert(width, height) && !this->_lru.empty()) {
+			auto id = this->_lru.front();
+
+			evicted.push_back(this->_sprites[id].rect);
+			this->remove(id);
+		}
+
+		return evicted;
+	}
+
+	std::vector<rawrbox::AtlasRelocation> AtlasPacker::defragment() {
+		std::vector<rawrbox::AtlasRelocation> relocations = {};
+
+		// Tallest first packs rows tight
+		std::vector<Sprite*> sprites = {};
+		sprites.reserve(this->_sprites.size());
+
+		for (auto& sprite : this->_sprites) {
+			if (sprite.second.rect.width == 0 || sprite.second.rect.height == 0) continue;
+			sprites.push_back(&sprite.second);
+		}
+
+		std::sort(sprites.begin(), sprites.end(), [](const Sprite* a, const Sprite* b) {
+			if (a->rect.height != b->rect.height) return a->rect.height > b->rect.height;
+			if (a->rect.width != b->rect.width) return a->rect.width > b->rect.width;
+			return a->rect.id < b->rect.id;
+		});
+
+		// Repack on fresh pages, keep the old layout around in case it doesn't fit
+		auto oldFree = std::move(this->_free);
+		auto pages = oldFree.size();
+
+		this->_free.clear();
+		for (size_t i = 0; i < pages; i++) {
+			this->addPage();
+		}
+
+		std::vector<rawrbox::AtlasRect> placed = {};
+		placed.reserve(sprites.size());
+
+		for (auto* sprite : sprites) {
+			auto rect = sprite->rect;
+			auto paddedW = rect.width + this->_padding;
+			auto paddedH = rect.height + this->_padding;
+
+			std::optional<FreeRect> free = std::nullopt;
+			for (uint32_t page = 0; page < this->_free.size() && !free.has_value(); page++) {
+				free = this->find(page, paddedW, paddedH);
+				rect.page = page;
+			}
+
+			if (!free.has_value()) {
+				this->_free = std::move(oldFree);
+				return {};
+			}
+
+			rect.x = std::get<2>(*free);
+			rect.y = std::get<3>(*free);
+
+			this->place(rect.page, *free, paddedW, paddedH);
+			placed.push_back(rect);
+		}
+
+		// Commit ---
+		for (size_t i = 0; i < sprites.size(); i++) {
+			auto& current = sprites[i]->rect;
+			const auto& next = placed[i];
+
+			if (current.page != next.page || current.x != next.x || current.y != next.y) {
+				relocations.push_back({current.id, current, next});
+			}
+
+			current = next;
+		}
+
+		return relocations;
+	}
+
+	// UTILS ---
+	bool AtlasPacker::canInsert(uint32_t width, uint32_t height) const {
+		if (width > this->_size || height > this->_size) return false;
+		if (width == 0 || height == 0) return true;
+		if (this->_free.size() < this->_maxPages) return true; // A new page always fits it
+
+		for (uint32_t page = 0; page < this->_free.size(); page++) {
+			if (this->find(page, width + this->_padding, height + this->_padding).has_value()) return true;
+		}
+
+		return false;
+	}
+
+	std::optional<rawrbox::AtlasRect> AtlasPacker::get(uint64_t id) const {
+		auto fnd = this->_sprites.find(id);
+		if (fnd == this->_sprites.end()) return std::nullopt;
+
+		return fnd->second.rect;
+	}
+
+	uint32_t AtlasPacker::getSize() const { return this->_size; }
+	uint32_t AtlasPacker::getPages() const { return static_cast<uint32_t>(this->_free.size()); }
+	size_t AtlasPacker::getSpriteCount() const { return this->_sprites.size(); }
+
+	size_t AtlasPacker::getFreeRects() const {
+		size_t total = 0;
+		for (const auto& free : this->_free) {
+			total += free.topLeft.size();
+		}
+
+		return total;
+	}
+
+	float AtlasPacker::getOccupancy() const {
+		auto area = static_cast<double>(this->_size) * this->_size * static_cast<double>(this->_free.size());
+		return static_cast<float>(static_cast<double>(this->_usedArea) / area);
+	}
+	// ---------
+} // namespace rawrbox
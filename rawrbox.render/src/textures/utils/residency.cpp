@@ -0,0 +1,230 @@
+#include <rawrbox/render/textures/utils/bc.hpp>
+#include <rawrbox/render/textures/utils/mips.hpp>
+#include <rawrbox/render/textures/utils/residency.hpp>
+#include <rawrbox/utils/logger.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace rawrbox {
+	TextureResidency::TextureResidency(size_t budget) : _budget(budget) {}
+
+	size_t TextureResidency::getBytes(const rawrbox::ResidencyEntry& entry, uint32_t from, uint32_t to) {
+		size_t bytes = 0;
+		for (uint32_t level = from; level < to && level < entry.levelBytes.size(); level++) {
+			bytes += entry.levelBytes[level];
+		}
+
+		return bytes;
+	}
+
+	bool TextureResidency::evict(size_t bytes, uint64_t skip, std::vector<rawrbox::ResidencyChange>& changes) {
+		struct Victim {
+			uint64_t id = 0;
+			rawrbox::ResidencyEntry* entry = nullptr;
+			uint32_t floor = 0; // Coarsest level we can drop it to
+		};
+
+		std::vector<Victim> victims = {};
+		size_t freeable = 0;
+
+		for (auto& [id, entry] : this->_entries) {
+			if (id == skip || entry.pending) continue;
+
+			// Used this frame, only the detail it does not need can go
+			uint32_t floor = entry.lastUsed == this->_frame ? entry.requested : entry.tail;
+			if (entry.resident >= floor) continue;
+
+			victims.push_back({id, &entry, floor});
+			freeable += getBytes(entry, entry.resident, floor);
+		}
+
+		if (freeable < bytes) return false;
+
+		// Oldest first, then the ones holding more memory
+		std::sort(victims.begin(), victims.end(), [](const Victim& a, const Victim& b) {
+			if (a.entry->lastUsed != b.entry->lastUsed) return a.entry->lastUsed < b.entry->lastUsed;
+			return a.entry->levelBytes[a.entry->resident] > b.entry->levelBytes[b.entry->resident];
+		});
+
+		size_t freed = 0;
+		for (auto& victim : victims) {
+			if (freed >= bytes) break;
+
+			auto& entry = *victim.entry;
+			uint32_t from = entry.resident;
+
+			// Drop the finest levels first, one at a time
+			while (entry.resident < victim.floor && freed < bytes) {
+				freed += entry.levelBytes[entry.resident];
+				entry.resident++;
+			}
+
+			entry.pending = true;
+			changes.push_back({victim.id, from, entry.resident});
+		}
+
+		this->_used -= freed;
+		return true;
+	}
+
+	uint32_t TextureResidency::add(uint64_t id, const rawrbox::Vector2u& size, const std::vector<size_t>& levelBytes) {
+		if (levelBytes.empty()) RAWRBOX_CRITICAL("Texture residency requires at least one level");
+		this->remove(id);
+
+		rawrbox::ResidencyEntry entry = {};
+		entry.levelBytes = levelBytes;
+
+		// First level small enough to always keep
+		auto levels = static_cast<uint32_t>(levelBytes.size());
+		while (entry.tail + 1 < levels && std::max(size.x >> entry.tail, size.y >> entry.tail) > this->_tailSize) {
+			entry.tail++;
+		}
+
+		entry.resident = entry.tail;
+		entry.requested = entry.tail;
+
+		this->_used += getBytes(entry, entry.tail, levels);
+		this->_entries[id] = std::move(entry);
+
+		return this->_entries[id].tail;
+	}
+
+	void TextureResidency::remove(uint64_t id) {
+		auto fnd = this->_entries.find(id);
+		if (fnd == this->_entries.end()) return;
+
+		this->_used -= getBytes(fnd->second, fnd->second.resident, static_cast<uint32_t>(fnd->second.levelBytes.size()));
+		this->_entries.erase(fnd);
+	}
+
+	void TextureResidency::request(uint64_t id, uint32_t level) {
+		auto fnd = this->_entries.find(id);
+		if (fnd == this->_entries.end()) return;
+
+		auto& entry = fnd->second;
+		level = std::min(level, entry.tail);
+
+		entry.requested = entry.lastUsed == this->_frame ? std::min(entry.requested, level) : level;
+		entry.lastUsed = this->_frame;
+	}
+
+	void TextureResidency::complete(uint64_t id) {
+		auto fnd = this->_entries.find(id);
+		if (fnd == this->_entries.end()) return;
+
+		fnd->second.pending = false;
+	}
+
+	void TextureResidency::fail(const rawrbox::ResidencyChange& change) {
+		auto fnd = this->_entries.find(change.id);
+		if (fnd == this->_entries.end()) return;
+
+		auto& entry = fnd->second;
+		entry.pending = false;
+		if (entry.resident != change.to) return; // Already moved on
+
+		if (change.isLoad()) {
+			this->_used -= getBytes(entry, change.to, change.from);
+		} else {
+			this->_used += getBytes(entry, change.from, change.to);
+		}
+
+		entry.resident = change.from;
+	}
+
+	std::vector<rawrbox::ResidencyChange> TextureResidency::update() {
+		std::vector<rawrbox::ResidencyChange> changes = {};
+
+		// Textures seen this frame that want more detail ---
+		std::vector<std::pair<uint64_t, rawrbox::ResidencyEntry*>> wants = {};
+		for (auto& [id, entry] : this->_entries) {
+			if (entry.pending || entry.lastUsed != this->_frame || entry.requested >= entry.resident) continue;
+			wants.emplace_back(id, &entry);
+		}
+
+		// Largest gap first, so blurry textures catch up before sharp ones get sharper
+		std::sort(wants.begin(), wants.end(), [](const auto& a, const auto& b) {
+			auto gapA = a.second->resident - a.second->requested;
+			auto gapB = b.second->resident - b.second->requested;
+			if (gapA != gapB) return gapA > gapB;
+
+			return a.first < b.first; // Keep it stable between runs
+		});
+		// ----------
+
+		size_t uploaded = 0;
+		for (auto& [id, entryPtr] : wants) {
+			auto& entry = *entryPtr;
+			if (entry.pending) continue; // Could have been evicted by an earlier load
+
+			// Finest level first, back off a level at a time until it fits
+			uint32_t target = entry.requested;
+			size_t bytes = 0;
+
+			for (; target < entry.resident; target++) {
+				bytes = getBytes(entry, target, entry.resident);
+
+				if (this->_uploadLimit != 0 && uploaded + bytes > this->_uploadLimit) continue;
+				if (this->_used + bytes <= this->_budget) break;
+
+				auto missing = this->_used + bytes - this->_budget;
+				if (this->evict(missing, id, changes)) break;
+			}
+
+			if (target >= entry.resident) continue;
+
+			changes.push_back({id, entry.resident, target});
+
+			entry.resident = target;
+			entry.pending = true;
+
+			this->_used += bytes;
+			uploaded += bytes;
+		}
+
+		this->_frame++;
+		return changes;
+	}
+
+	// UTILS ---
+	void TextureResidency::setBudget(size_t budget) { this->_budget = budget; }
+	size_t TextureResidency::getBudget() const { return this->_budget; }
+	size_t TextureResidency::getUsed() const { return this->_used; }
+
+	void TextureResidency::setUploadLimit(size_t bytes) { this->_uploadLimit = bytes; }
+	void TextureResidency::setTailSize(uint32_t size) { this->_tailSize = std::max(size, 1U); }
+
+	bool TextureResidency::has(uint64_t id) const { return this->_entries.contains(id); }
+	uint32_t TextureResidency::getResident(uint64_t id) const {
+		auto fnd = this->_entries.find(id);
+		if (fnd == this->_entries.end()) RAWRBOX_CRITICAL("Texture '{}' not found on residency", id);
+
+		return fnd->second.resident;
+	}
+
+	size_t TextureResidency::size() const { return this->_entries.size(); }
+
+	uint32_t TextureResidency::estimateLevel(const rawrbox::Vector2u& textureSize, float screenPixels) {
+		auto texels = static_cast<float>(std::max(textureSize.x, textureSize.y));
+		if (screenPixels <= 0.F || !std::isfinite(screenPixels)) return rawrbox::MipUtils::getLevels(textureSize) - 1U; // Off screen, coarsest
+		if (screenPixels >= texels) return 0U;
+
+		return static_cast<uint32_t>(std::floor(std::log2(texels / screenPixels)));
+	}
+
+	std::vector<size_t> TextureResidency::getLevelBytes(const rawrbox::ImageData& data, uint32_t levels) {
+		std::vector<size_t> bytes = {};
+		bytes.reserve(levels);
+
+		for (uint32_t level = 0; level < levels; level++) {
+			auto size = rawrbox::MipUtils::getSize(data.size, level);
+			size_t levelBytes = data.isCompressed() ? rawrbox::BC::getLevelBytes(data.compression, size) : static_cast<size_t>(size.x) * size.y * data.channels;
+
+			bytes.push_back(levelBytes * data.total());
+		}
+
+		return bytes;
+	}
+	// ---------
+} // namespace rawrbox
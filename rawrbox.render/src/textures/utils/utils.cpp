@@ -1,5 +1,7 @@
 #include <rawrbox/render/textures/base.hpp>
+#include <rawrbox/render/textures/utils/dds.hpp>
 #include <rawrbox/render/textures/utils/gif.hpp>
+#include <rawrbox/render/textures/utils/ktx2.hpp>
 #include <rawrbox/render/textures/utils/stbi.hpp>
 #include <rawrbox/render/textures/utils/utils.hpp>
 #include <rawrbox/render/textures/utils/webp.hpp>
@@ -100,8 +102,8 @@ namespace rawrbox {
 		return resizedData;
 	}
 
-	rawrbox::ImageType TextureUtils::getImageType(const std::vector<uint8_t>& data) {
-		if (data.empty() || data.size() < 16) return rawrbox::ImageType::IMAGE_INVALID;
+	rawrbox::ImageType TextureUtils::getImageType(const uint8_t* data, size_t size) {
+		if (data == nullptr || size < 20) return rawrbox::ImageType::IMAGE_INVALID;
 
 		// Check for JPEG
 		if (data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF) {
@@ -134,6 +136,16 @@ namespace rawrbox {
 			return rawrbox::ImageType::IMAGE_WEBP;
 		}
 
+		// Check for KTX2
+		if (data[0] == 0xAB && data[1] == 'K' && data[2] == 'T' && data[3] == 'X' && data[4] == ' ' && data[5] == '2' && data[6] == '0' && data[7] == 0xBB && data[8] == 0x0D && data[9] == 0x0A && data[10] == 0x1A && data[11] == 0x0A) {
+			return rawrbox::ImageType::IMAGE_KTX2;
+		}
+
+		// Check for DDS
+		if (data[0] == 'D' && data[1] == 'D' && data[2] == 'S' && data[3] == ' ') {
+			return rawrbox::ImageType::IMAGE_DDS;
+		}
+
 		// Check for TGA
 		if (data[2] == 0x02 && data[16] == 0x20 && data[17] == 0x20 && data[18] == 0x20 && data[19] == 0x20) {
 			return rawrbox::ImageType::IMAGE_TGA;
@@ -142,6 +154,10 @@ namespace rawrbox {
 		return rawrbox::ImageType::IMAGE_INVALID;
 	}
 
+	rawrbox::ImageType TextureUtils::getImageType(const std::vector<uint8_t>& data) {
+		return getImageType(data.data(), data.size());
+	}
+
 	rawrbox::ImageData TextureUtils::decodeImage(const std::vector<uint8_t>& data) {
 		switch (getImageType(data)) {
 			case IMAGE_JPG:
@@ -154,6 +170,10 @@ namespace rawrbox {
 				return rawrbox::GIF::decode(data);
 			case IMAGE_WEBP:
 				return rawrbox::WEBP::decode(data);
+			case IMAGE_KTX2:
+				return rawrbox::KTX2::decode(data);
+			case IMAGE_DDS:
+				return rawrbox::DDS::decode(data);
 			default:
 			case IMAGE_INVALID:
 				RAWRBOX_CRITICAL("Invalid image type!");
@@ -0,0 +1,82 @@
+#include <rawrbox/render/utils/dirty_ranges.hpp>
+
+#include <algorithm>
+
+namespace rawrbox {
+	void DirtyRanges::mark(uint64_t start, uint64_t count) {
+		if (count == 0) return;
+		uint64_t end = start + count;
+
+		// First range that ends at or after our start (touching ranges get merged too)
+		auto it = std::lower_bound(this->_ranges.begin(), this->_ranges.end(), start, [](const std::pair<uint64_t, uint64_t>& range, uint64_t value) { return range.second < value; });
+
+		// Swallow every range that overlaps / touches the new one
+		auto last = it;
+		while (last != this->_ranges.end() && last->first <= end) {
+			start = std::min(start, last->first);
+			end = std::max(end, last->second);
+			++last;
+		}
+
+		if (it == last) {
+			this->_ranges.insert(it, {start, end});
+			return;
+		}
+
+		*it = {start, end};
+		this->_ranges.erase(it + 1, last);
+	}
+
+	void DirtyRanges::clear() { this->_ranges.clear(); }
+
+	void DirtyRanges::coalesce(uint64_t gap) {
+		if (this->_ranges.size() < 2) return;
+
+		size_t write = 0;
+		for (size_t read = 1; read < this->_ranges.size(); read++) {
+			auto& current = this->_ranges[write];
+			const auto& next = this->_ranges[read];
+
+			if (next.first - current.second <= gap) {
+				current.second = std::max(current.second, next.second);
+			} else {
+				this->_ranges[++write] = next;
+			}
+		}
+
+		this->_ranges.resize(write + 1);
+	}
+
+	void DirtyRanges::clamp(uint64_t size) {
+		while (!this->_ranges.empty()) {
+			auto& last = this->_ranges.back();
+			if (last.first >= size) {
+				this->_ranges.pop_back();
+				continue;
+			}
+
+			last.second = std::min(last.second, size);
+			break;
+		}
+	}
+
+	// UTILS ---
+	const std::vector<std::pair<uint64_t, uint64_t>>& DirtyRanges::getRanges() const { return this->_ranges; }
+	std::pair<uint64_t, uint64_t> DirtyRanges::getBounds() const {
+		if (this->_ranges.empty()) return {0, 0};
+		return {this->_ranges.front().first, this->_ranges.back().second};
+	}
+
+	uint64_t DirtyRanges::getCoverage() const {
+		uint64_t total = 0;
+		for (const auto& range : this->_ranges) {
+			total += range.second - range.first;
+		}
+
+		return total;
+	}
+
+	bool DirtyRanges::empty() const { return this->_ranges.empty(); }
+	size_t DirtyRanges::size() const { return this->_ranges.size(); }
+	// ------
+} // namespace rawrbox
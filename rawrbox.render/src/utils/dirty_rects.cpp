@@ -0,0 +1,76 @@
+#include <rawrbox/render/utils/dirty_rects.hpp>
+
+#include <algorithm>
+
+namespace rawrbox {
+	rawrbox::DirtyRect DirtyRect::merge(const DirtyRect& other) const {
+		return {std::min(this->minX, other.minX), std::min(this->minY, other.minY), std::max(this->maxX, other.maxX), std::max(this->maxY, other.maxY)};
+	}
+
+	void DirtyRects::mark(uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+		if (width == 0 || height == 0) return;
+		rawrbox::DirtyRect rect = {x, y, x + width, y + height};
+
+		// Keep swallowing rects until nothing else is worth merging, the grown rect can reach new ones
+		bool merged = true;
+		while (merged) {
+			merged = false;
+
+			for (size_t i = 0; i < this->_rects.size(); i++) {
+				const auto& other = this->_rects[i];
+				auto combined = rect.merge(other);
+
+				// Neighbours and overlaps merge for free, far apart ones would upload too much in between
+				if (static_cast<float>(combined.area()) > static_cast<float>(rect.area() + other.area()) * this->_waste) continue;
+
+				rect = combined;
+				this->_rects[i] = this->_rects.back();
+				this->_rects.pop_back();
+
+				merged = true;
+				break;
+			}
+		}
+
+		this->_rects.push_back(rect);
+
+		// Too many small uploads, one big one is cheaper
+		if (this->_rects.size() > this->_maxRects) {
+			auto bounds = this->getBounds();
+
+			this->_rects.clear();
+			this->_rects.push_back(bounds);
+		}
+	}
+
+	void DirtyRects::clear() { this->_rects.clear(); }
+
+	void DirtyRects::setWaste(float waste) { this->_waste = std::max(waste, 1.F); }
+	void DirtyRects::setMaxRects(size_t max) { this->_maxRects = std::max<size_t>(max, 1); }
+
+	// UTILS ---
+	const std::vector<rawrbox::DirtyRect>& DirtyRects::getRects() const { return this->_rects; }
+	rawrbox::DirtyRect DirtyRects::getBounds() const {
+		if (this->_rects.empty()) return {};
+
+		auto bounds = this->_rects.front();
+		for (const auto& rect : this->_rects) {
+			bounds = bounds.merge(rect);
+		}
+
+		return bounds;
+	}
+
+	uint64_t DirtyRects::getCoverage() const {
+		uint64_t total = 0;
+		for (const auto& rect : this->_rects) {
+			total += rect.area();
+		}
+
+		return total;
+	}
+
+	bool DirtyRects::empty() const { return this->_rects.empty(); }
+	size_t DirtyRects::size() const { return this->_rects.size(); }
+	// ------
+} // namespace rawrbox
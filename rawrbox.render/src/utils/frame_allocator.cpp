@@ -0,0 +1,52 @@
+#include <rawrbox/render/utils/frame_allocator.hpp>
+#include <rawrbox/utils/logger.hpp>
+
+namespace rawrbox {
+	FrameAllocator::FrameAllocator(uint64_t capacity, uint64_t alignment) : _capacity(capacity), _alignment(alignment) {
+		if (alignment == 0 || (alignment & (alignment - 1)) != 0) RAWRBOX_CRITICAL("Alignment must be a power of two, got {}", alignment);
+		if (capacity < alignment) RAWRBOX_CRITICAL("Capacity must be at least the alignment size");
+	}
+
+	rawrbox::FrameAllocation FrameAllocator::allocate(uint64_t size, uint64_t frame) {
+		uint64_t alignedSize = this->align(size);
+		if (alignedSize > this->_capacity) RAWRBOX_CRITICAL("Allocation of {} bytes exceeds the frame buffer capacity ({})", size, this->_capacity);
+
+		rawrbox::FrameAllocation allocation = {};
+
+		// New frame, previous memory is still in use by the gpu so rename it
+		if (frame != this->_frame) {
+			this->_frame = frame;
+			this->_head = 0;
+			this->_stats = {};
+
+			allocation.discard = true;
+		}
+
+		// Out of space, rename and start over. Previous draws keep the old memory
+		if (this->_head + alignedSize > this->_capacity) {
+			this->_head = 0;
+			allocation.discard = true;
+		}
+
+		if (allocation.discard) this->_stats.discards++;
+
+		allocation.offset = this->_head;
+		this->_head += alignedSize;
+
+		this->_stats.allocations++;
+		this->_stats.bytes += alignedSize;
+
+		return allocation;
+	}
+
+	void FrameAllocator::reset() {
+		this->_frame = UINT64_MAX;
+		this->_head = 0;
+		this->_stats = {};
+	}
+
+	uint64_t FrameAllocator::align(uint64_t size) const { return (size + this->_alignment - 1) & ~(this->_alignment - 1); }
+	uint64_t FrameAllocator::getCapacity() const { return this->_capacity; }
+	uint64_t FrameAllocator::getUsed() const { return this->_head; }
+	const rawrbox::FrameAllocatorStats& FrameAllocator::getStats() const { return this->_stats; }
+} // namespace rawrbox
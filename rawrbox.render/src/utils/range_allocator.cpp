@@ -0,0 +1,121 @@
+#include <rawrbox/render/utils/range_allocator.hpp>
+#include <rawrbox/utils/logger.hpp>
+
+namespace rawrbox {
+	// PRIVATE ----
+	void RangeAllocator::addFree(uint64_t offset, uint64_t size) {
+		if (size == 0) return;
+
+		// Merge with next block
+		auto next = this->_freeByOffset.find(offset + size);
+		if (next != this->_freeByOffset.end()) {
+			size += next->second;
+			this->removeFree(next);
+		}
+
+		// Merge with previous block
+		auto prev = this->_freeByOffset.lower_bound(offset);
+		if (prev != this->_freeByOffset.begin()) {
+			--prev;
+			if (prev->first + prev->second == offset) {
+				offset = prev->first;
+				size += prev->second;
+				this->removeFree(prev);
+			}
+		}
+
+		this->_freeByOffset[offset] = size;
+		this->_freeBySize.emplace(size, offset);
+	}
+
+	void RangeAllocator::removeFree(std::map<uint64_t, uint64_t>::iterator it) {
+		auto range = this->_freeBySize.equal_range(it->second);
+		for (auto sizeIt = range.first; sizeIt != range.second; ++sizeIt) {
+			if (sizeIt->second != it->first) continue;
+
+			this->_freeBySize.erase(sizeIt);
+			break;
+		}
+
+		this->_freeByOffset.erase(it);
+	}
+	// ------------
+
+	RangeAllocator::RangeAllocator(uint64_t capacity) : _capacity(capacity) {
+		this->addFree(0, capacity);
+	}
+
+	uint64_t RangeAllocator::allocate(uint64_t size) {
+		if (size == 0) RAWRBOX_CRITICAL("Cannot allocate an empty range");
+
+		auto fit = this->_freeBySize.lower_bound(size); // Best fit
+		if (fit == this->_freeBySize.end()) return INVALID_OFFSET;
+
+		uint64_t offset = fit->second;
+		uint64_t blockSize = fit->first;
+
+		this->removeFree(this->_freeByOffset.find(offset));
+		if (blockSize > size) this->addFree(offset + size, blockSize - size);
+
+		this->_allocated[offset] = size;
+		this->_used += size;
+
+		return offset;
+	}
+
+	void RangeAllocator::free(uint64_t offset) {
+		auto fnd = this->_allocated.find(offset);
+		if (fnd == this->_allocated.end()) RAWRBOX_CRITICAL("Offset '{}' is not allocated", offset);
+
+		this->_used -= fnd->second;
+		this->addFree(fnd->first, fnd->second);
+
+		this->_allocated.erase(fnd);
+	}
+
+	void RangeAllocator::grow(uint64_t capacity) {
+		if (capacity <= this->_capacity) return;
+
+		this->addFree(this->_capacity, capacity - this->_capacity);
+		this->_capacity = capacity;
+	}
+
+	void RangeAllocator::reset() {
+		this->_freeByOffset.clear();
+		this->_freeBySize.clear();
+		this->_allocated.clear();
+
+		this->_used = 0;
+		this->addFree(0, this->_capacity);
+	}
+
+	// UTILS ---
+	bool RangeAllocator::isAllocated(uint64_t offset) const { return this->_allocated.contains(offset); }
+	uint64_t RangeAllocator::getSize(uint64_t offset) const {
+		auto fnd = this->_allocated.find(offset);
+		if (fnd == this->_allocated.end()) return 0;
+		return fnd->second;
+	}
+
+	uint64_t RangeAllocator::getCapacity() const { return this->_capacity; }
+	uint64_t RangeAllocator::getUsed() const { return this->_used; }
+	uint64_t RangeAllocator::getFree() const { return this->_capacity - this->_used; }
+	uint64_t RangeAllocator::getLargestFree() const {
+		if (this->_freeBySize.empty()) return 0;
+		return this->_freeBySize.rbegin()->first;
+	}
+
+	rawrbox::RangeAllocatorStats RangeAllocator::getStats() const {
+		rawrbox::RangeAllocatorStats stats = {};
+		stats.capacity = this->_capacity;
+		stats.used = this->_used;
+		stats.free = this->getFree();
+		stats.largestFree = this->getLargestFree();
+		stats.allocations = static_cast<uint32_t>(this->_allocated.size());
+		stats.freeBlocks = static_cast<uint32_t>(this->_freeByOffset.size());
+		stats.fragmentation = stats.free == 0 ? 0.F : 1.F - (static_cast<float>(stats.largestFree) / static_cast<float>(stats.free));
+
+		return stats;
+	}
+	// ------
+} // namespace rawrbox
@@ -31,7 +31,9 @@
 #include <rawrbox/engine/engine.hpp>
 #include <rawrbox/math/matrix4x4.hpp>
 #include <rawrbox/render/bindless.hpp>
+#include <rawrbox/render/geometry/arena.hpp>
 #include <rawrbox/render/text/engine.hpp>
+#include <rawrbox/render/textures/streamer.hpp>
 #include <rawrbox/render/window.hpp>
 #include <rawrbox/utils/string.hpp>
 
@@ -129,6 +131,8 @@ namespace rawrbox {
 			// ----------------------
 
 			// SHUTDOWN PLUGINS ----
+			rawrbox::GEOMETRY::shutdown();
+			rawrbox::TextureStreamer::shutdown();
 			rawrbox::BindlessManager::shutdown();
 			rawrbox::PipelineUtils::shutdown();
 			// ---------------
@@ -0,0 +1,95 @@
+#include <rawrbox/render/models/animations/manager.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace {
+	class TestTarget : public rawrbox::AnimationTarget {
+	public:
+		std::atomic<int> ticks = 0;
+		int finishes = 0;
+		bool done = false;
+
+		std::unique_ptr<TestTarget>* victim = nullptr;
+
+		void tickAnimations() override { this->ticks++; }
+		void finishAnimations() override {
+			this->finishes++;
+			if (this->done) rawrbox::ANIMATIONS::remove(this);
+
+			// Destroys another target mid-finish
+			if (this->victim != nullptr && *this->victim != nullptr) {
+				rawrbox::ANIMATIONS::remove(this->victim->get());
+				this->victim->reset();
+			}
+		}
+	};
+} // namespace
+
+TEST_CASE("ANIMATIONS should behave as expected", "[rawrbox::ANIMATIONS]") {
+	SECTION("rawrbox::ANIMATIONS::add") {
+		TestTarget a;
+		rawrbox::ANIMATIONS::add(&a);
+		rawrbox::ANIMATIONS::add(&a);
+		rawrbox::ANIMATIONS::add(nullptr);
+
+		REQUIRE(rawrbox::ANIMATIONS::count() == 1);
+
+		rawrbox::ANIMATIONS::remove(&a);
+		rawrbox::ANIMATIONS::remove(&a);
+		REQUIRE(rawrbox::ANIMATIONS::count() == 0);
+	}
+
+	SECTION("rawrbox::ANIMATIONS::tick") {
+		std::vector<std::unique_ptr<TestTarget>> targets = {};
+		for (size_t i = 0; i < 64; i++) {
+			targets.push_back(std::make_unique<TestTarget>());
+			rawrbox::ANIMATIONS::add(targets.back().get());
+		}
+
+		targets[3]->done = true;
+		rawrbox::ANIMATIONS::tick();
+
+		for (auto& target : targets) {
+			REQUIRE(target->ticks == 1);
+			REQUIRE(target->finishes == 1);
+		}
+
+		// Removed while finishing
+		REQUIRE(rawrbox::ANIMATIONS::count() == 63);
+		rawrbox::ANIMATIONS::tick();
+
+		REQUIRE(targets[3]->ticks == 1);
+		REQUIRE(targets[4]->ticks == 2);
+
+		for (auto& target : targets) {
+			rawrbox::ANIMATIONS::remove(target.get());
+		}
+
+		REQUIRE(rawrbox::ANIMATIONS::count() == 0);
+	}
+
+	SECTION("rawrbox::ANIMATIONS::tick (destroyed while finishing)") {
+		std::vector<std::unique_ptr<TestTarget>> targets = {};
+		for (size_t i = 0; i < 8; i++) {
+			targets.push_back(std::make_unique<TestTarget>());
+			rawrbox::ANIMATIONS::add(targets.back().get());
+		}
+
+		targets[1]->victim = &targets[5];
+		rawrbox::ANIMATIONS::tick();
+
+		REQUIRE(targets[5] == nullptr);
+		REQUIRE(rawrbox::ANIMATIONS::count() == 7);
+		REQUIRE(targets[6]->finishes == 1);
+
+		for (auto& target : targets) {
+			if (target != nullptr) rawrbox::ANIMATIONS::remove(target.get());
+		}
+
+		REQUIRE(rawrbox::ANIMATIONS::count() == 0);
+	}
+}
@@ -0,0 +1,297 @@
+#include <rawrbox/render/textures/data.hpp>
+#include <rawrbox/render/textures/utils/bc.hpp>
+#include <rawrbox/render/textures/utils/dds.hpp>
+#include <rawrbox/render/textures/utils/ktx2.hpp>
+#include <rawrbox/render/textures/utils/mips.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace {
+	// Smooth gradients with a bit of noise, close to what real textures look like
+	std::vector<uint8_t> makeImage(const rawrbox::Vector2u& size, uint8_t channels) {
+		std::vector<uint8_t> pixels(static_cast<size_t>(size.x) * size.y * channels);
+		uint32_t seed = 1337;
+
+		for (uint32_t y = 0; y < size.y; y++) {
+			for (uint32_t x = 0; x < size.x; x++) {
+				for (uint8_t c = 0; c < channels; c++) {
+					seed = seed * 1664525U + 1013904223U;
+
+					float v = 127.F + 100.F * std::sin(static_cast<float>(x) * 0.05F * (c + 1)) * std::cos(static_cast<float>(y) * 0.03F) + static_cast<float>(seed >> 28);
+					pixels[(static_cast<size_t>(y) * size.x + x) * channels + c] = static_cast<uint8_t>(std::clamp(v, 0.F, 255.F));
+				}
+			}
+		}
+
+		return pixels;
+	}
+
+	double psnr(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b, uint8_t channelsA, uint8_t channelsB, uint8_t compare) {
+		double mse = 0.0;
+		size_t texels = a.size() / channelsA;
+
+		for (size_t i = 0; i < texels; i++) {
+			for (uint8_t c = 0; c < compare; c++) {
+				double diff = static_cast<double>(a[i * channelsA + c]) - static_cast<double>(b[i * channelsB + c]);
+				mse += diff * diff;
+			}
+		}
+
+		mse /= static_cast<double>(texels * compare);
+		return mse == 0.0 ? 100.0 : 10.0 * std::log10(255.0 * 255.0 / mse);
+	}
+} // namespace
+
+TEST_CASE("BC should behave as expected", "[rawrbox::BC]") {
+	rawrbox::Vector2u size = {64, 36}; // Not a multiple of 4 on purpose
+	auto rgba = makeImage(size, 4);
+
+	SECTION("rawrbox::BC::getLevelBytes") {
+		REQUIRE(rawrbox::BC::getLevelBytes(rawrbox::TEXTURE_COMPRESSION::BC1, {256, 256}) == 256 * 256 / 2); // 8x smaller than RGBA8
+		REQUIRE(rawrbox::BC::getLevelBytes(rawrbox::TEXTURE_COMPRESSION::BC7, {256, 256}) == 256 * 256);     // 4x smaller
+		REQUIRE(rawrbox::BC::getLevelBytes(rawrbox::TEXTURE_COMPRESSION::BC4, {5, 3}) == 2 * 8);
+		REQUIRE(rawrbox::BC::getRowBytes(rawrbox::TEXTURE_COMPRESSION::BC3, 9) == 3 * 16);
+	}
+
+	SECTION("rawrbox::BC::encode (solid blocks are exact)") {
+		rawrbox::BCBlock block = {};
+		for (size_t i = 0; i < 16; i++) {
+			block[i * 4 + 0] = 255;
+			block[i * 4 + 1] = 0;
+			block[i * 4 + 2] = 255;
+			block[i * 4 + 3] = 200;
+		}
+
+		std::array<uint8_t, 16> out = {};
+		rawrbox::BCBlock decoded = {};
+
+		rawrbox::BC::encodeBC1(block, out.data());
+		rawrbox::BC::decodeBC1(out.data(), decoded);
+		REQUIRE(decoded[0] == 255);
+		REQUIRE(decoded[1] == 0);
+		REQUIRE(decoded[2] == 255);
+
+		rawrbox::BC::encodeBC4(block, out.data(), 3);
+		rawrbox::BC::decodeBC4(out.data(), decoded, 3);
+		REQUIRE(decoded[3] == 200);
+		REQUIRE(decoded[63] == 200);
+
+		rawrbox::BC::encodeBC7(block, out.data());
+		REQUIRE(rawrbox::BC::decodeBC7(out.data(), decoded));
+		REQUIRE(std::abs(decoded[3] - 200) <= 1); // 7 bit endpoints + shared p-bit
+		REQUIRE(std::abs(decoded[0] - 255) <= 1);
+	}
+
+	SECTION("rawrbox::BC::encodeBC1 (punch-through alpha)") {
+		rawrbox::BCBlock block = {};
+		for (size_t i = 0; i < 16; i++) {
+			block[i * 4 + 0] = static_cast<uint8_t>(i * 16);
+			block[i * 4 + 3] = i % 2 == 0 ? 255 : 0;
+		}
+
+		std::array<uint8_t, 8> out = {};
+		rawrbox::BCBlock decoded = {};
+
+		rawrbox::BC::encodeBC1(block, out.data(), true);
+		rawrbox::BC::decodeBC1(out.data(), decoded);
+
+		for (size_t i = 0; i < 16; i++) {
+			REQUIRE(decoded[i * 4 + 3] == (i % 2 == 0 ? 255 : 0));
+		}
+	}
+
+	SECTION("rawrbox::BC::encode / decode round trip") {
+		auto rgb = makeImage(size, 3); // RGBA would use punch-through alpha on this image
+		auto bc1 = rawrbox::BC::encode(rawrbox::TEXTURE_COMPRESSION::BC1, size, rgb, 3);
+		REQUIRE(bc1.size() == rawrbox::BC::getLevelBytes(rawrbox::TEXTURE_COMPRESSION::BC1, size));
+		REQUIRE(psnr(rgb, rawrbox::BC::decode(rawrbox::TEXTURE_COMPRESSION::BC1, size, bc1), 3, 4, 3) > 30.0);
+
+		auto bc3 = rawrbox::BC::encode(rawrbox::TEXTURE_COMPRESSION::BC3, size, rgba, 4);
+		auto bc3Decoded = rawrbox::BC::decode(rawrbox::TEXTURE_COMPRESSION::BC3, size, bc3);
+		REQUIRE(psnr(rgba, bc3Decoded, 4, 4, 4) > 30.0);
+
+		auto bc4 = rawrbox::BC::encode(rawrbox::TEXTURE_COMPRESSION::BC4, size, rgba, 4);
+		REQUIRE(psnr(rgba, rawrbox::BC::decode(rawrbox::TEXTURE_COMPRESSION::BC4, size, bc4), 4, 1, 1) > 38.0);
+
+		auto bc5 = rawrbox::BC::encode(rawrbox::TEXTURE_COMPRESSION::BC5, size, rgba, 4);
+		REQUIRE(psnr(rgba, rawrbox::BC::decode(rawrbox::TEXTURE_COMPRESSION::BC5, size, bc5), 4, 2, 2) > 38.0);
+
+		auto bc7 = rawrbox::BC::encode(rawrbox::TEXTURE_COMPRESSION::BC7, size, rgba, 4);
+		REQUIRE(psnr(rgba, rawrbox::BC::decode(rawrbox::TEXTURE_COMPRESSION::BC7, size, bc7), 4, 4, 4) > 32.0);
+
+		// Other channel counts
+		auto rg = makeImage(size, 2);
+		auto rgBC5 = rawrbox::BC::encode(rawrbox::TEXTURE_COMPRESSION::BC5, size, rg, 2);
+		REQUIRE(psnr(rg, rawrbox::BC::decode(rawrbox::TEXTURE_COMPRESSION::BC5, size, rgBC5), 2, 2, 2) > 38.0);
+	}
+
+	SECTION("rawrbox::BC::encode (image data)") {
+		rawrbox::ImageData data = {};
+		data.size = size;
+		data.channels = 4;
+		data.createFrame(rgba);
+		data.createFrame(rgba);
+		rawrbox::MipUtils::generate(data);
+
+		auto compressed = rawrbox::BC::encode(data, rawrbox::TEXTURE_COMPRESSION::BC7);
+		REQUIRE(compressed.isCompressed());
+		REQUIRE(compressed.total() == 2);
+		REQUIRE(compressed.mipLevels() == data.mipLevels());
+		REQUIRE(compressed.frames[1].mips.back().size() == 16); // 1x1 is still a full block
+
+		auto decoded = rawrbox::BC::decode(compressed);
+		REQUIRE_FALSE(decoded.isCompressed());
+		REQUIRE(decoded.frames[0].mips[0].size() == data.frames[0].mips[0].size());
+		REQUIRE(psnr(data.frames[1].pixels, decoded.frames[1].pixels, 4, 4, 4) > 32.0);
+	}
+
+	SECTION("rawrbox::ImageData::transparent (blocks)") {
+		auto opaque = rgba;
+		for (size_t i = 3; i < opaque.size(); i += 4) {
+			opaque[i] = 255;
+		}
+
+		for (auto format : {rawrbox::TEXTURE_COMPRESSION::BC3, rawrbox::TEXTURE_COMPRESSION::BC7}) {
+			rawrbox::ImageData data = {};
+			data.size = size;
+			data.channels = 4;
+			data.createFrame(opaque);
+			REQUIRE_FALSE(rawrbox::BC::encode(data, format).transparent());
+
+			data.frames[0].pixels[3] = 0;
+			REQUIRE(rawrbox::BC::encode(data, format).transparent());
+		}
+	}
+}
+
+TEST_CASE("KTX2 should behave as expected", "[rawrbox::KTX2]") {
+	rawrbox::ImageData data = {};
+	data.size = {32, 16};
+	data.channels = 4;
+	data.createFrame(makeImage(data.size, 4));
+	data.createFrame(makeImage(data.size, 4));
+	rawrbox::MipUtils::generate(data);
+
+	SECTION("rawrbox::KTX2::encode / decode (raw)") {
+		auto file = rawrbox::KTX2::encode(data);
+		auto loaded = rawrbox::KTX2::decode(file);
+
+		REQUIRE(loaded.size == data.size);
+		REQUIRE(loaded.channels == 4);
+		REQUIRE_FALSE(loaded.isCompressed());
+		REQUIRE(loaded.total() == 2);
+		REQUIRE(loaded.mipLevels() == data.mipLevels());
+		REQUIRE(loaded.frames[1].pixels == data.frames[1].pixels);
+		REQUIRE(loaded.frames[0].mips.back() == data.frames[0].mips.back());
+	}
+
+	SECTION("rawrbox::KTX2::encode / decode (BC)") {
+		auto compressed = rawrbox::BC::encode(data, rawrbox::TEXTURE_COMPRESSION::BC1);
+		compressed.sRGB = true;
+
+		auto loaded = rawrbox::KTX2::decode(rawrbox::KTX2::encode(compressed));
+
+		REQUIRE(loaded.compression == rawrbox::TEXTURE_COMPRESSION::BC1);
+		REQUIRE(loaded.sRGB);
+		REQUIRE(loaded.frames[0].pixels == compressed.frames[0].pixels);
+		REQUIRE(loaded.frames[1].mips[2] == compressed.frames[1].mips[2]);
+	}
+
+	SECTION("rawrbox::KTX2::getKeyValues") {
+		REQUIRE(rawrbox::KTX2::getKeyValues(rawrbox::KTX2::encode(data)).empty());
+
+		auto file = rawrbox::KTX2::encode(data, {{"rawrbox.source", "0123456789abcdef"}, {"KTXwriter", "rawrbox"}});
+		auto keyValues = rawrbox::KTX2::getKeyValues(file);
+
+		REQUIRE(keyValues.size() == 2);
+		REQUIRE(keyValues["rawrbox.source"] == "0123456789abcdef");
+		REQUIRE(keyValues["KTXwriter"] == "rawrbox");
+		REQUIRE(rawrbox::KTX2::decode(file).frames[1].pixels == data.frames[1].pixels);
+	}
+
+	SECTION("rawrbox::KTX2::decode (invalid)") {
+		auto file = rawrbox::KTX2::encode(data);
+		std::memset(file.data() + 12, 0, 4); // vkFormat UNDEFINED = Basis
+
+		REQUIRE_THROWS(rawrbox::KTX2::decode(file));
+		REQUIRE_THROWS(rawrbox::KTX2::decode(std::vector<uint8_t>(10, 0)));
+	}
+}
+
+TEST_CASE("DDS should behave as expected", "[rawrbox::DDS]") {
+	auto header = [](uint32_t width, uint32_t height, uint32_t mips, uint32_t pfFlags, uint32_t fourCC, uint32_t bits, uint32_t maskR) {
+		std::vector<uint8_t> file(128, 0);
+		auto put = [&file](size_t offset, uint32_t value) { std::memcpy(file.data() + offset, &value, 4); };
+
+		put(0, 0x20534444); // "DDS "
+		put(4, 124);
+		put(8, 0x1007 | (mips > 1 ? 0x20000 : 0));
+		put(12, height);
+		put(16, width);
+		put(28, mips);
+		put(76, 32);
+		put(80, pfFlags);
+		put(84, fourCC);
+		put(88, bits);
+		put(92, maskR);
+
+		return file;
+	};
+
+	SECTION("rawrbox::DDS::decode (DXT5)") {
+		rawrbox::ImageData data = {};
+		data.size = {16, 8};
+		data.channels = 4;
+		data.createFrame(makeImage(data.size, 4));
+		rawrbox::MipUtils::generate(data);
+
+		auto compressed = rawrbox::BC::encode(data, rawrbox::TEXTURE_COMPRESSION::BC3);
+
+		auto file = header(16, 8, data.mipLevels(), 0x4, 0x35545844, 0, 0); // DXT5
+		file.insert(file.end(), compressed.frames[0].pixels.begin(), compressed.frames[0].pixels.end());
+		for (const auto& mip : compressed.frames[0].mips) {
+			file.insert(file.end(), mip.begin(), mip.end());
+		}
+
+		auto loaded = rawrbox::DDS::decode(file);
+		REQUIRE(loaded.compression == rawrbox::TEXTURE_COMPRESSION::BC3);
+		REQUIRE(loaded.mipLevels() == data.mipLevels());
+		REQUIRE(loaded.frames[0].pixels == compressed.frames[0].pixels);
+		REQUIRE(loaded.frames[0].mips.back() == compressed.frames[0].mips.back());
+
+		file.resize(file.size() - 4);
+		REQUIRE_THROWS(rawrbox::DDS::decode(file));
+	}
+
+	SECTION("rawrbox::DDS::decode (BGRX)") {
+		auto file = header(2, 1, 1, 0x40, 0, 32, 0x00FF0000);
+		std::vector<uint8_t> pixels = {10, 20, 30, 0, 40, 50, 60, 0}; // BGRX
+		file.insert(file.end(), pixels.begin(), pixels.end());
+
+		auto loaded = rawrbox::DDS::decode(file);
+		REQUIRE(loaded.channels == 4);
+		REQUIRE(loaded.pixels() == std::vector<uint8_t>{30, 20, 10, 255, 60, 50, 40, 255});
+	}
+}
+
+TEST_CASE("BC benchmark", "[.benchmark][rawrbox::BC]") {
+	rawrbox::Vector2u size = {512, 512};
+	auto rgba = makeImage(size, 4);
+
+	BENCHMARK("BC1 encode 512x512") {
+		return rawrbox::BC::encode(rawrbox::TEXTURE_COMPRESSION::BC1, size, rgba, 4);
+	};
+
+	BENCHMARK("BC3 encode 512x512") {
+		return rawrbox::BC::encode(rawrbox::TEXTURE_COMPRESSION::BC3, size, rgba, 4);
+	};
+
+	BENCHMARK("BC7 encode 512x512") {
+		return rawrbox::BC::encode(rawrbox::TEXTURE_COMPRESSION::BC7, size, rgba, 4);
+	};
+}
@@ -0,0 +1,178 @@
+#include <rawrbox/render/models/utils/blend_shapes.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <random>
+#include <vector>
+
+TEST_CASE("BlendShapeStream should behave as expected", "[rawrbox::BlendShapeStream]") {
+	SECTION("rawrbox::BlendShapeStream::fromDeltas") {
+		std::vector<rawrbox::Vector3f> deltas(100);
+		deltas[10] = {1, 0, 0};
+		deltas[11] = {0, 1, 0};
+		deltas[14] = {0, 0, 1}; // Small gap, same run
+		deltas[60] = {2, 0, 0};
+
+		auto stream = rawrbox::BlendShapeStream::fromDeltas(deltas);
+
+		REQUIRE_FALSE(stream.hasNormals());
+		REQUIRE(stream.runs.size() == 2);
+		REQUIRE(stream.runs[0].vertex == 10);
+		REQUIRE(stream.runs[0].count == 5);
+		REQUIRE(stream.runs[1].vertex == 60);
+		REQUIRE(stream.runs[1].offset == 5);
+
+		REQUIRE(stream.size() == 6);
+		REQUIRE(stream.start == 10);
+		REQUIRE(stream.end == 61);
+		REQUIRE(stream.z[4] == 1.F);
+
+		auto empty = rawrbox::BlendShapeStream::fromDeltas(std::vector<rawrbox::Vector3f>(10));
+		REQUIRE(empty.empty());
+	}
+}
+
+TEST_CASE("BlendShapeAccumulator should behave as expected", "[rawrbox::BlendShapeAccumulator]") {
+	SECTION("rawrbox::BlendShapeAccumulator::apply") {
+		std::vector<rawrbox::Vector3f> base(50);
+		for (size_t i = 0; i < base.size(); i++) {
+			base[i] = {static_cast<float>(i), 0, 0};
+		}
+
+		std::vector<rawrbox::Vector3f> deltaA(50);
+		std::vector<rawrbox::Vector3f> deltaB(50);
+		deltaA[5] = {0, 1, 0};
+		deltaA[6] = {0, 1, 0};
+		deltaB[6] = {0, 0, 2};
+		deltaB[40] = {0, 0, 2};
+
+		auto a = rawrbox::BlendShapeStream::fromDeltas(deltaA);
+		auto b = rawrbox::BlendShapeStream::fromDeltas(deltaB);
+
+		rawrbox::BlendShapeAccumulator acc;
+		acc.setBase(base);
+
+		acc.apply({{&a, 0.5F}, {&b, 0.F}});
+		REQUIRE(acc.getDirty() == std::pair<uint32_t, uint32_t>{0, 50}); // Rebuilds everything after setBase
+		REQUIRE(acc.getPosition(5) == rawrbox::Vector3f{5, 0.5F, 0});
+
+		acc.apply({{&a, 0.5F}, {&b, 0.F}});
+		REQUIRE(acc.getDirty() == std::pair<uint32_t, uint32_t>{5, 7});
+		REQUIRE(acc.getPosition(5) == rawrbox::Vector3f{5, 0.5F, 0});
+		REQUIRE(acc.getPosition(40) == rawrbox::Vector3f{40, 0, 0});
+
+		// Shapes add up
+		acc.apply({{&a, 1.F}, {&b, 0.5F}});
+		REQUIRE(acc.getDirty() == std::pair<uint32_t, uint32_t>{5, 41});
+		REQUIRE(acc.getPosition(6) == rawrbox::Vector3f{6, 1, 1});
+		REQUIRE(acc.getPosition(40) == rawrbox::Vector3f{40, 0, 1});
+
+		// Zero weights restore the base
+		acc.apply({{&a, 0.F}, {&b, 0.F}});
+		REQUIRE(acc.getDirty() == std::pair<uint32_t, uint32_t>{5, 41});
+		REQUIRE(acc.getPosition(6) == base[6]);
+		REQUIRE(acc.getPosition(40) == base[40]);
+
+		acc.apply({});
+		REQUIRE(acc.getDirty() == std::pair<uint32_t, uint32_t>{0, 0});
+	}
+
+	SECTION("rawrbox::BlendShapeAccumulator::apply (dense)") {
+		std::mt19937 rng(42);
+		std::uniform_real_distribution<float> dist(-1.F, 1.F);
+
+		const size_t verts = 10000;
+		std::vector<rawrbox::Vector3f> base(verts);
+		std::vector<rawrbox::Vector3f> normals(verts, {0, 1, 0});
+		for (auto& v : base) {
+			v = {dist(rng), dist(rng), dist(rng)};
+		}
+
+		std::vector<std::vector<rawrbox::Vector3f>> deltas(4, std::vector<rawrbox::Vector3f>(verts));
+		std::vector<std::vector<rawrbox::Vector3f>> normalDeltas(4, std::vector<rawrbox::Vector3f>(verts));
+		std::vector<rawrbox::BlendShapeStream> streams = {};
+
+		for (size_t s = 0; s < deltas.size(); s++) {
+			for (size_t i = s * 1000; i < s * 1000 + 3000; i++) {
+				if (i % 7 == 0) continue;
+
+				deltas[s][i] = {dist(rng), dist(rng), dist(rng)};
+				normalDeltas[s][i] = {dist(rng), 0, 0};
+			}
+
+			streams.push_back(rawrbox::BlendShapeStream::fromDeltas(deltas[s], normalDeltas[s]));
+		}
+
+		std::vector<float> weights = {0.25F, 0.F, 1.F, 0.6F};
+
+		rawrbox::BlendShapeAccumulator acc;
+		acc.setBase(base, normals);
+		acc.apply({{&streams[0], weights[0]}, {&streams[1], weights[1]}, {&streams[2], weights[2]}, {&streams[3], weights[3]}});
+
+		// Same as the dense lerp
+		for (size_t i = 0; i < verts; i++) {
+			rawrbox::Vector3f pos = base[i];
+			rawrbox::Vector3f norm = normals[i];
+
+			for (size_t s = 0; s < deltas.size(); s++) {
+				pos += deltas[s][i] * weights[s];
+				norm += normalDeltas[s][i] * weights[s];
+			}
+
+			auto got = acc.getPosition(i);
+			REQUIRE_THAT(got.x, Catch::Matchers::WithinAbs(pos.x, 0.0001F));
+			REQUIRE_THAT(got.y, Catch::Matchers::WithinAbs(pos.y, 0.0001F));
+			REQUIRE_THAT(got.z, Catch::Matchers::WithinAbs(pos.z, 0.0001F));
+			REQUIRE_THAT(acc.getNormal(i).x, Catch::Matchers::WithinAbs(norm.x, 0.0001F));
+		}
+	}
+}
+
+TEST_CASE("BlendShapeAccumulator benchmark", "[rawrbox::BlendShapeAccumulator][.benchmark]") {
+	// Facial rig: 20k vertex head, 50 shapes each moving ~1.5k vertices
+	constexpr size_t VERTICES = 20000;
+	constexpr size_t SHAPES = 50;
+
+	std::mt19937 rng(1337);
+	std::uniform_real_distribution<float> dist(-0.01F, 0.01F);
+	std::uniform_int_distribution<size_t> region(0, VERTICES - 2000);
+
+	std::vector<rawrbox::Vector3f> base(VERTICES);
+	std::vector<rawrbox::Vector3f> normals(VERTICES, {0, 0, 1});
+
+	std::vector<rawrbox::BlendShapeStream> streams = {};
+	for (size_t s = 0; s < SHAPES; s++) {
+		std::vector<rawrbox::Vector3f> deltas(VERTICES);
+		std::vector<rawrbox::Vector3f> normalDeltas(VERTICES);
+
+		size_t start = region(rng);
+		for (size_t i = start; i < start + 1500; i++) {
+			deltas[i] = {dist(rng), dist(rng), dist(rng)};
+			normalDeltas[i] = {dist(rng), dist(rng), 0};
+		}
+
+		streams.push_back(rawrbox::BlendShapeStream::fromDeltas(deltas, normalDeltas));
+	}
+
+	rawrbox::BlendShapeAccumulator acc;
+	acc.setBase(base, normals);
+
+	std::vector<rawrbox::BlendShapeWeight> weights = {};
+	for (auto& stream : streams) {
+		weights.push_back({&stream, 0.F});
+	}
+
+	size_t frame = 0;
+	BENCHMARK("50 shapes, 20k vertices") {
+		frame++;
+		for (size_t s = 0; s < weights.size(); s++) {
+			weights[s].weight = (s + frame) % 3 == 0 ? 0.F : 0.5F; // A third of the shapes are off
+		}
+
+		acc.apply(weights);
+		return acc.getDirty();
+	};
+}
@@ -0,0 +1,158 @@
+#include <rawrbox/render/models/animations/blending.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <string>
+#include <vector>
+
+TEST_CASE("AnimationFade should behave as expected", "[rawrbox::AnimationFade]") {
+	SECTION("rawrbox::AnimationFade::fadeTo") {
+		rawrbox::AnimationFade fade;
+
+		fade.fadeTo(1.F, 0.F);
+		REQUIRE(fade.weight == 1.F);
+		REQUIRE_FALSE(fade.isFading());
+
+		fade.fadeTo(0.F, 0.5F);
+		REQUIRE(fade.isFading());
+
+		fade.update(0.25F);
+		REQUIRE_THAT(fade.weight, Catch::Matchers::WithinAbs(0.5F, 0.0001F));
+
+		fade.update(1.F); // Never overshoots
+		REQUIRE(fade.weight == 0.F);
+		REQUIRE_FALSE(fade.isFading());
+
+		fade.fadeTo(5.F, 0.F); // Clamped
+		REQUIRE(fade.weight == 1.F);
+	}
+}
+
+TEST_CASE("AnimationGraph should behave as expected", "[rawrbox::AnimationGraph]") {
+	SECTION("rawrbox::AnimationGraph::set") {
+		rawrbox::AnimationGraph graph;
+		REQUIRE(graph.getLayers().size() == 1);
+
+		graph.set("idle");
+		graph.set("walk", 0.F);
+
+		REQUIRE(graph.has("walk"));
+		REQUIRE(graph.isActive("idle"));
+		REQUIRE_FALSE(graph.isActive("walk"));
+
+		// Zero weight clips are skipped
+		std::vector<rawrbox::AnimationBlendEntry> active = {};
+		graph.getActive(active);
+
+		REQUIRE(active.size() == 1);
+		REQUIRE(*active[0].clip == "idle");
+
+		// Only released clips are removed
+		REQUIRE(graph.update(1.F).empty());
+		REQUIRE(graph.has("walk"));
+	}
+
+	SECTION("rawrbox::AnimationGraph::play") {
+		rawrbox::AnimationGraph graph;
+		graph.set("idle");
+		graph.set("run", 0.F);
+
+		graph.play("run", 0.5F);
+
+		graph.update(0.25F);
+		REQUIRE_THAT(graph.getWeight("idle"), Catch::Matchers::WithinAbs(0.5F, 0.0001F));
+		REQUIRE_THAT(graph.getWeight("run"), Catch::Matchers::WithinAbs(0.5F, 0.0001F));
+
+		auto finished = graph.update(0.25F);
+		REQUIRE(finished == std::vector<std::string>{"idle"});
+		REQUIRE_FALSE(graph.has("idle"));
+		REQUIRE(graph.getWeight("run") == 1.F);
+
+		// Instant swap
+		graph.set("jump", 0.F);
+		graph.play("jump");
+
+		REQUIRE(graph.getWeight("jump") == 1.F);
+		REQUIRE(graph.update(0.F) == std::vector<std::string>{"run"});
+	}
+
+	SECTION("rawrbox::AnimationGraph::addLayer") {
+		rawrbox::AnimationGraph graph;
+		graph.set("walk");
+
+		auto upper = graph.addLayer("upper", false, {0.F, 1.F, 1.F});
+		auto breathe = graph.addLayer("breathe", true);
+
+		REQUIRE(upper == 1);
+		REQUIRE(breathe == 2);
+		REQUIRE(graph.getLayer(upper).jointMask.size() == 3);
+
+		graph.set("wave", 1.F, upper);
+		graph.set("breath", 1.F, breathe);
+		graph.setLayerWeight(upper, 0.5F);
+
+		REQUIRE(graph.getWeight("wave") == 0.5F);
+
+		std::vector<rawrbox::AnimationBlendEntry> active = {};
+		graph.getActive(active);
+
+		REQUIRE(active.size() == 3);
+		REQUIRE(*active[0].clip == "walk");
+		REQUIRE(active[1].layer == upper);
+		REQUIRE(active[1].weight == 0.5F);
+		REQUIRE(active[2].additive);
+
+		// Cross-fading a layer leaves the others alone
+		graph.set("point", 0.F, upper);
+		graph.play("point", 0.F, upper);
+		graph.update(0.F);
+
+		REQUIRE(graph.has("walk"));
+		REQUIRE(graph.has("breath"));
+		REQUIRE_FALSE(graph.has("wave"));
+
+		// Moving a clip keeps its weight
+		graph.set("walk", 0.25F);
+		graph.set("walk", 0.25F, breathe);
+		REQUIRE(graph.getLayer(0).clips.empty());
+		REQUIRE(graph.getWeight("walk") == 0.25F);
+
+		// Muted layer
+		graph.setLayerWeight(upper, 0.F);
+		graph.getActive(active);
+		REQUIRE(active.size() == 2);
+	}
+}
+
+TEST_CASE("AnimationGraph crowd benchmark", "[rawrbox::AnimationGraph][.benchmark]") {
+	constexpr size_t CHARACTERS = 1000;
+
+	std::vector<rawrbox::AnimationGraph> graphs(CHARACTERS);
+	for (auto& graph : graphs) {
+		graph.addLayer("upper", false, std::vector<float>(64, 1.F));
+		graph.set("idle");
+		graph.set("wave", 1.F, 1);
+	}
+
+	std::vector<rawrbox::AnimationBlendEntry> active = {};
+	size_t frame = 0;
+
+	BENCHMARK("Tick 1k characters") {
+		size_t total = 0;
+		frame++;
+
+		for (size_t i = 0; i < graphs.size(); i++) {
+			auto& graph = graphs[i];
+			if ((i + frame) % 120 == 0) graph.play((frame / 120) % 2 == 0 ? "run" : "idle", 0.3F);
+
+			graph.update(1.F / 60.F);
+			graph.getActive(active);
+			total += active.size();
+		}
+
+		return total;
+	};
+}
@@ -0,0 +1,102 @@
+#include <rawrbox/math/matrix4x4.hpp>
+#include <rawrbox/render/culling/list.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+
+TEST_CASE("CullingList should behave as expected", "[rawrbox::CullingList]") {
+	rawrbox::Matrix4x4::MTX_RIGHT_HANDED = false;
+
+	rawrbox::Matrix4x4 view = {};
+	view.lookAt({0, 0, 0}, {0, 0, 1}, {0, 1, 0});
+
+	auto viewProj = rawrbox::Matrix4x4::mtxProj(60.F, 1.F, 0.1F, 100.F) * view;
+
+	int front = 1;
+	int behind = 2;
+	int far = 3;
+
+	SECTION("rawrbox::CullingList::add") {
+		rawrbox::CullingList list;
+
+		auto a = list.add({{-1, -1, 9}, {1, 1, 11}, {2, 2, 2}}, &front);
+		auto b = list.add({{-1, -1, -11}, {1, 1, -9}, {2, 2, 2}}, &behind);
+
+		REQUIRE(list.size() == 2);
+		REQUIRE(list.getOwner(a) == &front);
+		REQUIRE(list.getOwner(b) == &behind);
+
+		// Visible until culled
+		REQUIRE(list.isVisible(a) == true);
+		REQUIRE(list.isVisible(b) == true);
+	}
+
+	SECTION("rawrbox::CullingList::cull") {
+		rawrbox::CullingList list;
+
+		auto a = list.add({{-1, -1, 9}, {1, 1, 11}, {2, 2, 2}}, &front);
+		auto b = list.add({{-1, -1, -11}, {1, 1, -9}, {2, 2, 2}}, &behind);
+		auto c = list.add({{-1, -1, 199}, {1, 1, 201}, {2, 2, 2}}, &far);
+
+		list.cull(viewProj);
+
+		REQUIRE(list.isVisible(a) == true);
+		REQUIRE(list.isVisible(b) == false);
+		REQUIRE(list.isVisible(c) == false);
+
+		REQUIRE(list.getStats().total == 3);
+		REQUIRE(list.getStats().visible == 1);
+		REQUIRE(list.getStats().culled == 2);
+
+		// Move it into view
+		list.update(b, {{-1, -1, 19}, {1, 1, 21}, {2, 2, 2}});
+		list.cull(viewProj);
+
+		REQUIRE(list.isVisible(b) == true);
+		REQUIRE(list.getStats().visible == 2);
+	}
+
+	SECTION("rawrbox::CullingList::remove") {
+		rawrbox::CullingList list;
+
+		auto a = list.add({{-1, -1, 9}, {1, 1, 11}, {2, 2, 2}}, &front);
+		auto b = list.add({{-1, -1, -11}, {1, 1, -9}, {2, 2, 2}}, &behind);
+		auto c = list.add({{-1, -1, 199}, {1, 1, 201}, {2, 2, 2}}, &far);
+
+		list.remove(a);
+		REQUIRE(list.size() == 2);
+		REQUIRE(list.isValid(a) == false);
+
+		// Handles stay stable after swap-remove
+		REQUIRE(list.getOwner(b) == &behind);
+		REQUIRE(list.getOwner(c) == &far);
+
+		list.cull(viewProj);
+		REQUIRE(list.isVisible(b) == false);
+		REQUIRE(list.isVisible(c) == false);
+		REQUIRE(list.getStats().visible == 0);
+
+		// Free handles get reused
+		auto d = list.add({{-1, -1, 9}, {1, 1, 11}, {2, 2, 2}}, &front);
+		REQUIRE(d == a);
+		REQUIRE(list.getOwner(d) == &front);
+	}
+
+	SECTION("rawrbox::CullingList::cull (batch)") {
+		rawrbox::CullingList list;
+
+		std::vector<uint32_t> handles = {};
+		for (int i = 0; i < 5000; i++) {
+			float z = (i % 2 == 0) ? 10.F : -10.F;
+			handles.push_back(list.add({{-1, -1, z - 1}, {1, 1, z + 1}, {2, 2, 2}}, nullptr));
+		}
+
+		list.cull(viewProj);
+		REQUIRE(list.getStats().visible == 2500);
+
+		for (size_t i = 0; i < handles.size(); i++) {
+			REQUIRE(list.isVisible(handles[i]) == (i % 2 == 0));
+		}
+	}
+}
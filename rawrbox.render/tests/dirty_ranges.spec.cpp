@@ -0,0 +1,101 @@
+#include <rawrbox/render/utils/dirty_ranges.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <vector>
+
+TEST_CASE("DirtyRanges should behave as expected", "[rawrbox::DirtyRanges]") {
+	SECTION("rawrbox::DirtyRanges::mark") {
+		rawrbox::DirtyRanges ranges;
+		REQUIRE(ranges.empty());
+
+		ranges.mark(10, 5); // [10, 15)
+		ranges.mark(30, 5); // [30, 35)
+		ranges.mark(0, 2);  // [0, 2)
+
+		REQUIRE(ranges.size() == 3);
+		REQUIRE(ranges.getRanges()[0] == std::pair<uint64_t, uint64_t>{0, 2});
+		REQUIRE(ranges.getRanges()[1] == std::pair<uint64_t, uint64_t>{10, 15});
+		REQUIRE(ranges.getRanges()[2] == std::pair<uint64_t, uint64_t>{30, 35});
+
+		// Touching ranges merge
+		ranges.mark(15, 1);
+		REQUIRE(ranges.size() == 3);
+		REQUIRE(ranges.getRanges()[1] == std::pair<uint64_t, uint64_t>{10, 16});
+
+		// Overlapping several ranges
+		ranges.mark(1, 30);
+		REQUIRE(ranges.size() == 1);
+		REQUIRE(ranges.getRanges()[0] == std::pair<uint64_t, uint64_t>{0, 35});
+		REQUIRE(ranges.getCoverage() == 35);
+
+		// Already covered
+		ranges.mark(5, 5);
+		REQUIRE(ranges.size() == 1);
+
+		ranges.mark(0, 0); // Ignored
+		REQUIRE(ranges.getCoverage() == 35);
+
+		ranges.clear();
+		REQUIRE(ranges.empty());
+	}
+
+	SECTION("rawrbox::DirtyRanges::coalesce") {
+		rawrbox::DirtyRanges ranges;
+		ranges.mark(0, 2);
+		ranges.mark(4, 2);
+		ranges.mark(20, 2);
+
+		ranges.coalesce(2);
+		REQUIRE(ranges.size() == 2);
+		REQUIRE(ranges.getRanges()[0] == std::pair<uint64_t, uint64_t>{0, 6});
+		REQUIRE(ranges.getBounds() == std::pair<uint64_t, uint64_t>{0, 22});
+
+		ranges.coalesce(100);
+		REQUIRE(ranges.size() == 1);
+		REQUIRE(ranges.getCoverage() == 22);
+	}
+
+	SECTION("rawrbox::DirtyRanges::clamp") {
+		rawrbox::DirtyRanges ranges;
+		ranges.mark(0, 2);
+		ranges.mark(8, 4);
+		ranges.mark(20, 2);
+
+		ranges.clamp(10);
+		REQUIRE(ranges.size() == 2);
+		REQUIRE(ranges.getBounds() == std::pair<uint64_t, uint64_t>{0, 10});
+	}
+
+	SECTION("rawrbox::DirtyRanges::stress") {
+		rawrbox::DirtyRanges ranges;
+		std::vector<uint8_t> reference(512, 0);
+
+		std::mt19937 rng(1337); // NOLINT(cert-msc32-c,cert-msc51-cpp)
+		for (int i = 0; i < 2000; i++) {
+			uint64_t start = rng() % 500;
+			uint64_t count = 1 + (rng() % 8);
+
+			ranges.mark(start, count);
+			for (uint64_t j = start; j < start + count; j++) {
+				reference[j] = 1;
+			}
+		}
+
+		std::vector<uint8_t> result(512, 0);
+		uint64_t prevEnd = 0;
+		for (const auto& range : ranges.getRanges()) {
+			REQUIRE(range.first < range.second);
+			if (range.first != 0) REQUIRE(range.first > prevEnd); // Sorted, never touching
+
+			for (uint64_t j = range.first; j < range.second; j++) {
+				result[j] = 1;
+			}
+
+			prevEnd = range.second;
+		}
+
+		REQUIRE(result == reference);
+	}
+}
@@ -0,0 +1,106 @@
+#include <rawrbox/render/utils/dirty_rects.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <vector>
+
+TEST_CASE("DirtyRects should behave as expected", "[rawrbox::DirtyRects]") {
+	SECTION("rawrbox::DirtyRects::mark") {
+		rawrbox::DirtyRects rects;
+		REQUIRE(rects.empty());
+
+		rects.mark(0, 0, 0, 10); // Empty, ignored
+		REQUIRE(rects.empty());
+
+		rects.mark(0, 0, 16, 16);
+		rects.mark(512, 512, 16, 16);
+		REQUIRE(rects.size() == 2);
+
+		// Neighbour on the same row merges into a strip
+		rects.mark(16, 0, 16, 16);
+		REQUIRE(rects.size() == 2);
+		REQUIRE(rects.getCoverage() == 32 * 16 + 16 * 16);
+
+		bool found = false;
+		for (const auto& rect : rects.getRects()) {
+			if (rect == rawrbox::DirtyRect{0, 0, 32, 16}) found = true;
+		}
+		REQUIRE(found);
+
+		// Contained rect changes nothing
+		rects.mark(4, 4, 4, 4);
+		REQUIRE(rects.size() == 2);
+		REQUIRE(rects.getCoverage() == 32 * 16 + 16 * 16);
+
+		REQUIRE(rects.getBounds() == rawrbox::DirtyRect{0, 0, 528, 528});
+
+		rects.clear();
+		REQUIRE(rects.empty());
+	}
+
+	SECTION("rawrbox::DirtyRects::chain") {
+		rawrbox::DirtyRects rects;
+
+		// Two far strips, a rect bridging them makes the whole thing worth merging
+		rects.mark(0, 0, 10, 10);
+		rects.mark(20, 0, 10, 10);
+		REQUIRE(rects.size() == 2);
+
+		rects.mark(10, 0, 10, 10);
+		REQUIRE(rects.size() == 1);
+		REQUIRE(rects.getRects()[0] == rawrbox::DirtyRect{0, 0, 30, 10});
+	}
+
+	SECTION("rawrbox::DirtyRects::setMaxRects") {
+		rawrbox::DirtyRects rects;
+		rects.setMaxRects(4);
+
+		for (uint32_t i = 0; i < 4; i++) {
+			rects.mark(i * 100, i * 100, 8, 8);
+		}
+		REQUIRE(rects.size() == 4);
+
+		rects.mark(1000, 1000, 8, 8);
+		REQUIRE(rects.size() == 1);
+		REQUIRE(rects.getRects()[0] == rawrbox::DirtyRect{0, 0, 1008, 1008});
+	}
+
+	SECTION("rawrbox::DirtyRects::coverage") {
+		// Every marked texel stays covered, whatever gets merged
+		std::mt19937 rng(42); // NOLINT(cert-msc32-c,cert-msc51-cpp)
+		std::uniform_int_distribution<uint32_t> pos(0, 200);
+		std::uniform_int_distribution<uint32_t> size(1, 24);
+
+		rawrbox::DirtyRects rects;
+		std::vector<uint8_t> marked(256 * 256, 0);
+
+		for (int i = 0; i < 64; i++) {
+			uint32_t x = pos(rng);
+			uint32_t y = pos(rng);
+			uint32_t w = size(rng);
+			uint32_t h = size(rng);
+
+			rects.mark(x, y, w, h);
+			for (uint32_t py = y; py < y + h; py++) {
+				for (uint32_t px = x; px < x + w; px++) {
+					marked[py * 256 + px] = 1;
+				}
+			}
+		}
+
+		REQUIRE(rects.size() <= 16);
+		for (uint32_t py = 0; py < 256; py++) {
+			for (uint32_t px = 0; px < 256; px++) {
+				if (marked[py * 256 + px] == 0) continue;
+
+				bool covered = false;
+				for (const auto& rect : rects.getRects()) {
+					if (px >= rect.minX && px < rect.maxX && py >= rect.minY && py < rect.maxY) covered = true;
+				}
+
+				REQUIRE(covered);
+			}
+		}
+	}
+}
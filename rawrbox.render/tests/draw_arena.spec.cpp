@@ -0,0 +1,261 @@
+#include <rawrbox/render/utils/draw_arena.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+	// Same size as the stencil types, without the renderer
+	struct TestVertex {
+		uint32_t textureID = 0;
+		float x = 0.F;
+		float y = 0.F;
+		uint32_t color = 0;
+		float uv[4] = {};
+
+		TestVertex() = default;
+		TestVertex(uint32_t _textureID, float _x, float _y, uint32_t _color) : textureID(_textureID), x(_x), y(_y), color(_color) {}
+	};
+
+	struct TestQuad {
+		float rect[4] = {};
+		float uv[4] = {};
+		uint32_t color = 0;
+		uint32_t textureID = 0;
+		float slice = 0.F;
+		float flag = 0.F;
+	};
+
+	using TestArena = rawrbox::DrawArena<TestVertex, TestQuad>;
+
+	// Stencil draw call handling before the arena, every call owns its vectors
+	struct LegacyDraw {
+		std::vector<TestVertex> vertices = {};
+		std::vector<uint32_t> indices = {};
+	};
+
+	struct LegacyStencil {
+		LegacyDraw current = {};
+		std::vector<LegacyDraw> calls = {};
+
+		void pushIndices(std::vector<uint32_t> ind) {
+			this->current.indices.insert(this->current.indices.end(), ind.begin(), ind.end());
+		}
+
+		void pushDrawCall() {
+			if (!this->calls.empty()) {
+				auto& oldCall = this->calls.back();
+				if (oldCall.vertices.size() + this->current.vertices.size() < 65536) {
+					for (auto& ind : this->current.indices) {
+						oldCall.indices.push_back(static_cast<uint32_t>(oldCall.vertices.size()) + ind);
+					}
+
+					oldCall.vertices.insert(oldCall.vertices.end(), this->current.vertices.begin(), this->current.vertices.end());
+					return;
+				}
+			}
+
+			this->calls.emplace_back(this->current);
+		}
+
+		void drawBox(float x, float y, float w, float h, uint32_t col) {
+			this->current = {};
+
+			this->current.vertices.emplace_back(1, x, y, col);
+			this->current.vertices.emplace_back(1, x, y + h, col);
+			this->current.vertices.emplace_back(1, x + w, y, col);
+			this->current.vertices.emplace_back(1, x + w, y + h, col);
+			this->pushIndices({0, 1, 2,
+			    1, 3, 2});
+
+			this->pushDrawCall();
+		}
+
+		[[nodiscard]] std::vector<LegacyDraw> getDrawCalls() const { return this->calls; }
+	};
+
+	// Stencil's arena path, merging every quad into the previous range
+	struct ArenaStencil {
+		TestArena arena = {};
+		std::vector<rawrbox::DrawRange> calls = {};
+
+		void pushDrawCall(rawrbox::DrawRange range) {
+			this->arena.end(range);
+			if (!this->calls.empty()) {
+				auto& oldCall = this->calls.back();
+				if (oldCall.vertexCount + range.vertexCount < 65536 && oldCall.instanceCount + range.instanceCount <= 16384) {
+					this->arena.merge(oldCall, range);
+					return;
+				}
+			}
+
+			this->calls.push_back(range);
+		}
+
+		void drawBox(float x, float y, float w, float h, uint32_t col) {
+			auto range = this->arena.begin();
+
+			this->arena.pushVertex(1, x, y, col);
+			this->arena.pushVertex(1, x, y + h, col);
+			this->arena.pushVertex(1, x + w, y, col);
+			this->arena.pushVertex(1, x + w, y + h, col);
+			this->arena.pushQuad(range);
+
+			this->pushDrawCall(range);
+		}
+
+		void drawQuad(float x, float y, float w, float h, uint32_t col) {
+			auto range = this->arena.begin();
+
+			auto& quad = this->arena.pushInstance();
+			quad.rect[0] = x;
+			quad.rect[1] = y;
+			quad.rect[2] = w;
+			quad.rect[3] = h;
+			quad.color = col;
+			quad.textureID = 1;
+
+			this->pushDrawCall(range);
+		}
+
+		void clear() {
+			this->calls.clear();
+			this->arena.clear();
+		}
+	};
+
+	constexpr size_t UI_QUADS = 100000;
+} // namespace
+
+TEST_CASE("DrawArena should behave as expected", "[rawrbox::DrawArena]") {
+	SECTION("rawrbox::DrawArena::begin") {
+		TestArena arena = {};
+
+		auto first = arena.begin();
+		arena.pushVertex(1, 0.F, 0.F, 0xFFFFFFFF);
+		arena.pushVertex(1, 0.F, 1.F, 0xFFFFFFFF);
+		arena.pushVertex(1, 1.F, 0.F, 0xFFFFFFFF);
+		arena.pushIndices({0, 1, 2});
+		arena.end(first);
+
+		REQUIRE(first.vertexStart == 0);
+		REQUIRE(first.vertexCount == 3);
+		REQUIRE(first.indexCount == 3);
+		REQUIRE(first.instanceCount == 0);
+		REQUIRE_FALSE(first.empty());
+
+		auto second = arena.begin();
+		REQUIRE(second.vertexStart == 3);
+		REQUIRE(second.indexStart == 3);
+
+		arena.end(second);
+		REQUIRE(second.empty());
+	}
+
+	SECTION("rawrbox::DrawArena::pushQuad") {
+		TestArena arena = {};
+
+		auto range = arena.begin();
+		for (int i = 0; i < 8; i++) {
+			arena.pushVertex();
+		}
+
+		arena.pushQuad(range); // Over vertices 4..7
+		arena.end(range);
+
+		std::vector<uint32_t> expected = {4, 5, 6, 5, 7, 6};
+		REQUIRE(arena.getIndices() == expected);
+	}
+
+	SECTION("rawrbox::DrawArena::merge") {
+		TestArena arena = {};
+
+		auto a = arena.begin();
+		for (int i = 0; i < 4; i++) {
+			arena.pushVertex();
+		}
+		arena.pushQuad(a);
+		arena.end(a);
+
+		auto b = arena.begin();
+		for (int i = 0; i < 4; i++) {
+			arena.pushVertex();
+		}
+		arena.pushQuad(b); // Local to b, 0..3
+		arena.end(b);
+
+		arena.merge(a, b);
+
+		REQUIRE(a.vertexCount == 8);
+		REQUIRE(a.indexCount == 12);
+
+		std::vector<uint32_t> expected = {0, 1, 2, 1, 3, 2, 4, 5, 6, 5, 7, 6};
+		REQUIRE(arena.getIndices() == expected);
+
+		// Instances have nothing to rebase
+		auto c = arena.begin();
+		arena.pushInstance();
+		arena.end(c);
+
+		auto d = arena.begin();
+		arena.pushInstance();
+		arena.pushInstance();
+		arena.end(d);
+
+		arena.merge(c, d);
+		REQUIRE(c.instanceStart == 0);
+		REQUIRE(c.instanceCount == 3);
+	}
+
+	SECTION("rawrbox::DrawArena::clear") {
+		TestArena arena = {};
+		arena.reserve(64, 96, 16);
+
+		auto range = arena.begin();
+		for (int i = 0; i < 64; i++) {
+			arena.pushVertex();
+		}
+		arena.end(range);
+
+		auto capacity = arena.getVertices().capacity();
+		arena.clear();
+
+		REQUIRE(arena.getVertices().empty());
+		REQUIRE(arena.getVertices().capacity() == capacity); // Next frame reuses it
+		REQUIRE(arena.begin().vertexStart == 0);
+	}
+}
+
+TEST_CASE("DrawArena benchmark", "[.benchmark][rawrbox::DrawArena]") {
+	LegacyStencil legacy = {};
+	ArenaStencil arena = {};
+
+	BENCHMARK("Legacy stencil 100k quads") {
+		legacy.calls.clear();
+		for (size_t i = 0; i < UI_QUADS; i++) {
+			legacy.drawBox(static_cast<float>(i % 1920), static_cast<float>(i % 1080), 16.F, 16.F, 0xFFFFFFFF);
+		}
+
+		return legacy.getDrawCalls().size();
+	};
+
+	BENCHMARK("Arena indexed 100k quads") {
+		arena.clear();
+		for (size_t i = 0; i < UI_QUADS; i++) {
+			arena.drawBox(static_cast<float>(i % 1920), static_cast<float>(i % 1080), 16.F, 16.F, 0xFFFFFFFF);
+		}
+
+		return arena.calls.size();
+	};
+
+	BENCHMARK("Arena instanced 100k quads") {
+		arena.clear();
+		for (size_t i = 0; i < UI_QUADS; i++) {
+			arena.drawQuad(static_cast<float>(i % 1920), static_cast<float>(i % 1080), 16.F, 16.F, 0xFFFFFFFF);
+		}
+
+		return arena.calls.size();
+	};
+}
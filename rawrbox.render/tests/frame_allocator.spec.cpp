@@ -0,0 +1,50 @@
+#include <rawrbox/render/utils/frame_allocator.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <tuple>
+
+TEST_CASE("FrameAllocator should behave as expected", "[rawrbox::FrameAllocator]") {
+	SECTION("rawrbox::FrameAllocator::allocate") {
+		rawrbox::FrameAllocator alloc(1024, 256);
+
+		auto a = alloc.allocate(16, 1);
+		REQUIRE(a.offset == 0);
+		REQUIRE(a.discard == true); // First use in the frame
+
+		auto b = alloc.allocate(300, 1);
+		REQUIRE(b.offset == 256);
+		REQUIRE(b.discard == false);
+
+		auto c = alloc.allocate(256, 1);
+		REQUIRE(c.offset == 768);
+		REQUIRE(alloc.getUsed() == 1024);
+
+		// Full, wraps and renames
+		auto d = alloc.allocate(1, 1);
+		REQUIRE(d.offset == 0);
+		REQUIRE(d.discard == true);
+
+		REQUIRE(alloc.getStats().allocations == 4);
+		REQUIRE(alloc.getStats().discards == 2);
+	}
+
+	SECTION("rawrbox::FrameAllocator::frame") {
+		rawrbox::FrameAllocator alloc(1024, 256);
+
+		std::ignore = alloc.allocate(512, 1);
+		auto next = alloc.allocate(16, 2);
+
+		REQUIRE(next.offset == 0);
+		REQUIRE(next.discard == true);
+		REQUIRE(alloc.getStats().allocations == 1);
+	}
+
+	SECTION("rawrbox::FrameAllocator::align") {
+		rawrbox::FrameAllocator alloc(1024, 256);
+
+		REQUIRE(alloc.align(1) == 256);
+		REQUIRE(alloc.align(256) == 256);
+		REQUIRE(alloc.align(272) == 512);
+	}
+}
@@ -0,0 +1,77 @@
+#include <rawrbox/math/matrix4x4.hpp>
+#include <rawrbox/render/culling/instances.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+TEST_CASE("InstanceCuller should behave as expected", "[rawrbox::InstanceCuller]") {
+	rawrbox::Matrix4x4::MTX_RIGHT_HANDED = false;
+
+	rawrbox::Matrix4x4 view = {};
+	view.lookAt({0, 0, 0}, {0, 0, 1}, {0, 1, 0});
+
+	rawrbox::Frustum frustum(rawrbox::Matrix4x4::mtxProj(60.F, 1.F, 0.1F, 100.F) * view);
+	rawrbox::BBOX bounds = {{-0.5F, -0.5F, -0.5F}, {0.5F, 0.5F, 0.5F}, {1, 1, 1}};
+
+	auto makeInstance = [](const rawrbox::Vector3f& pos, const rawrbox::Vector3f& scale = {1, 1, 1}) {
+		return rawrbox::Instance(rawrbox::Matrix4x4::mtxSRT(scale, {0, 0, 0, 1}, pos));
+	};
+
+	SECTION("rawrbox::InstanceCuller::cull") {
+		rawrbox::InstanceCuller culler;
+
+		std::vector<rawrbox::Instance> instances = {
+		    makeInstance({0, 0, 10}),   // Front
+		    makeInstance({0, 0, -10}),  // Behind
+		    makeInstance({0, 0, 200}),  // Too far
+		    makeInstance({0, 0, 20}),   // Front
+		    makeInstance({100, 0, 10}), // Outside left / right
+		};
+
+		instances[3].setSlice(3);
+
+		std::vector<rawrbox::Instance> out = {};
+		rawrbox::DrawIndexedIndirectArgs args = {36, 0, 0, 0, 0};
+
+		REQUIRE(culler.cull(frustum, bounds, instances, out, args) == 2);
+		REQUIRE(args.numInstances == 2);
+		REQUIRE(args.numIndices == 36);
+
+		// Order is kept
+		REQUIRE(out.size() == 2);
+		REQUIRE(out[0].getSlice() == 0);
+		REQUIRE(out[1].getSlice() == 3);
+	}
+
+	SECTION("rawrbox::InstanceCuller::cull (scaled)") {
+		rawrbox::InstanceCuller culler;
+
+		// Centered behind the camera, but big enough to reach the frustum
+		std::vector<rawrbox::Instance> instances = {makeInstance({0, 0, -10}, {40, 40, 40})};
+		std::vector<rawrbox::Instance> out = {};
+		rawrbox::DrawIndexedIndirectArgs args = {};
+
+		REQUIRE(culler.cull(frustum, bounds, instances, out, args) == 1);
+	}
+
+	SECTION("rawrbox::InstanceCuller::cull (batches)") {
+		rawrbox::InstanceCuller culler;
+
+		std::vector<rawrbox::Instance> instances = {};
+		for (size_t i = 0; i < rawrbox::InstanceCuller::CULL_BATCH_SIZE * 3 + 7; i++) {
+			instances.push_back(makeInstance({0, 0, (i % 2) == 0 ? 10.F : -10.F}));
+		}
+
+		std::vector<rawrbox::Instance> out = {};
+		rawrbox::DrawIndexedIndirectArgs args = {};
+
+		REQUIRE(culler.cull(frustum, bounds, instances, out, args) == (instances.size() + 1) / 2);
+		REQUIRE(out.size() == args.numInstances);
+
+		// Empty input resets the output
+		REQUIRE(culler.cull(frustum, bounds, nullptr, 0, out, args) == 0);
+		REQUIRE(out.empty());
+		REQUIRE(args.numInstances == 0);
+	}
+}
@@ -0,0 +1,152 @@
+#include <rawrbox/render/models/utils/merge.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+	// Mirrors Mesh merge rules without needing the renderer
+	struct TestMesh {
+		std::vector<uint32_t> vertices = {}; // Vertex = source mesh id, so the merge order is visible
+		std::vector<uint32_t> indices = {};
+		uint32_t totalVertex = 0;
+
+		uint32_t state = 0;
+		bool mergeable = true;
+
+		size_t maxVertices = 0;
+
+		[[nodiscard]] bool isMergeable() const { return this->mergeable; }
+		[[nodiscard]] size_t getMergeHash() const { return this->state % 3; } // Force collisions
+		[[nodiscard]] bool isMergeCompatible(const TestMesh& other) const { return this->state == other.state; }
+
+		[[nodiscard]] bool canMerge(const TestMesh& other) const {
+			if (!this->mergeable || !other.mergeable) return false;
+			if (this->vertices.size() + other.vertices.size() >= this->maxVertices) return false;
+
+			return this->isMergeCompatible(other);
+		}
+
+		void merge(const TestMesh& other) {
+			for (auto val : other.indices) {
+				this->indices.push_back(this->totalVertex + val);
+			}
+
+			this->vertices.insert(this->vertices.end(), other.vertices.begin(), other.vertices.end());
+			this->totalVertex = static_cast<uint32_t>(this->vertices.size());
+		}
+	};
+
+	// Original pairwise implementation of Model::merge
+	void legacyMerge(std::vector<std::unique_ptr<TestMesh>>& meshes) {
+		for (size_t i1 = 0; i1 < meshes.size(); i1++) {
+			auto& mesh1 = meshes[i1];
+
+			for (size_t i2 = meshes.size() - 1; i2 > i1; i2--) {
+				auto& mesh2 = meshes[i2];
+				if (!mesh1->canMerge(*mesh2)) continue;
+
+				mesh1->merge(*mesh2);
+				meshes.erase(meshes.begin() + i2);
+			}
+		}
+	}
+
+	std::vector<std::unique_ptr<TestMesh>> generate(std::mt19937& rng, size_t count, uint32_t states, size_t maxVertices) {
+		std::uniform_int_distribution<uint32_t> stateDist(0, states - 1);
+		std::uniform_int_distribution<uint32_t> sizeDist(1, 12);
+		std::uniform_int_distribution<uint32_t> mergeDist(0, 9);
+
+		std::vector<std::unique_ptr<TestMesh>> meshes = {};
+		for (size_t i = 0; i < count; i++) {
+			auto mesh = std::make_unique<TestMesh>();
+			mesh->state = stateDist(rng);
+			mesh->mergeable = mergeDist(rng) != 0;
+			mesh->maxVertices = maxVertices;
+
+			uint32_t verts = sizeDist(rng);
+			for (uint32_t v = 0; v < verts; v++) {
+				mesh->vertices.push_back(static_cast<uint32_t>(i));
+				mesh->indices.push_back(verts - v - 1);
+			}
+
+			mesh->totalVertex = verts;
+			meshes.push_back(std::move(mesh));
+		}
+
+		return meshes;
+	}
+
+	std::vector<std::unique_ptr<TestMesh>> clone(const std::vector<std::unique_ptr<TestMesh>>& meshes) {
+		std::vector<std::unique_ptr<TestMesh>> out = {};
+		for (const auto& mesh : meshes) {
+			out.push_back(std::make_unique<TestMesh>(*mesh));
+		}
+
+		return out;
+	}
+} // namespace
+
+TEST_CASE("MeshMerger should behave as expected", "[rawrbox::MeshMerger]") {
+	SECTION("rawrbox::MeshMerger::merge") {
+		std::vector<std::unique_ptr<TestMesh>> meshes = {};
+		for (uint32_t i = 0; i < 5; i++) {
+			auto mesh = std::make_unique<TestMesh>();
+			mesh->state = i % 2;
+			mesh->maxVertices = 100;
+			mesh->vertices = {i};
+			mesh->indices = {0};
+			mesh->totalVertex = 1;
+
+			meshes.push_back(std::move(mesh));
+		}
+
+		rawrbox::MeshMerger::merge(meshes);
+
+		REQUIRE(meshes.size() == 2);
+		REQUIRE(meshes[0]->vertices == std::vector<uint32_t>{0, 4, 2}); // Absorbed back to front
+		REQUIRE(meshes[0]->indices == std::vector<uint32_t>{0, 1, 2});
+		REQUIRE(meshes[1]->vertices == std::vector<uint32_t>{1, 3});
+	}
+
+	SECTION("rawrbox::MeshMerger::merge (limits)") {
+		std::vector<std::unique_ptr<TestMesh>> meshes = {};
+		for (uint32_t i = 0; i < 6; i++) {
+			auto mesh = std::make_unique<TestMesh>();
+			mesh->maxVertices = 5; // 2 meshes of 2 verts max
+			mesh->vertices = {i, i};
+			mesh->indices = {0, 1};
+			mesh->totalVertex = 2;
+
+			meshes.push_back(std::move(mesh));
+		}
+
+		rawrbox::MeshMerger::merge(meshes);
+
+		REQUIRE(meshes.size() == 3);
+		REQUIRE(meshes[0]->vertices == std::vector<uint32_t>{0, 0, 5, 5});
+		REQUIRE(meshes[1]->vertices == std::vector<uint32_t>{1, 1, 4, 4});
+		REQUIRE(meshes[2]->vertices == std::vector<uint32_t>{2, 2, 3, 3});
+	}
+
+	SECTION("rawrbox::MeshMerger::merge (legacy)") {
+		std::mt19937 rng(1337);
+
+		for (size_t run = 0; run < 50; run++) {
+			auto meshes = generate(rng, 1 + run * 7, 1 + static_cast<uint32_t>(run % 6), 8 + run * 3);
+			auto legacy = clone(meshes);
+
+			rawrbox::MeshMerger::merge(meshes);
+			legacyMerge(legacy);
+
+			REQUIRE(meshes.size() == legacy.size());
+			for (size_t i = 0; i < meshes.size(); i++) {
+				REQUIRE(meshes[i]->vertices == legacy[i]->vertices);
+				REQUIRE(meshes[i]->indices == legacy[i]->indices);
+			}
+		}
+	}
+}
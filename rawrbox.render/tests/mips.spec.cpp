@@ -0,0 +1,131 @@
+#include <rawrbox/render/textures/data.hpp>
+#include <rawrbox/render/textures/utils/mips.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+TEST_CASE("MipUtils should behave as expected", "[rawrbox::MipUtils]") {
+	SECTION("rawrbox::MipUtils::getLevels") {
+		REQUIRE(rawrbox::MipUtils::getLevels({1, 1}) == 1);
+		REQUIRE(rawrbox::MipUtils::getLevels({256, 256}) == 9);
+		REQUIRE(rawrbox::MipUtils::getLevels({300, 20}) == 9);
+
+		REQUIRE(rawrbox::MipUtils::getSize({300, 20}, 3) == rawrbox::Vector2u{37, 2});
+		REQUIRE(rawrbox::MipUtils::getSize({300, 20}, 8) == rawrbox::Vector2u{1, 1});
+	}
+
+	SECTION("rawrbox::MipUtils::downsample") {
+		// 4x2 RGBA, each 2x2 block averages to a known value
+		std::vector<uint8_t> pixels = {
+		    0, 0, 0, 255, 4, 8, 12, 255, 100, 100, 100, 0, 100, 100, 100, 0,
+		    0, 0, 0, 255, 4, 8, 12, 255, 200, 200, 200, 0, 200, 200, 200, 0};
+
+		auto out = rawrbox::MipUtils::downsample({4, 2}, pixels, 4);
+		REQUIRE(out == std::vector<uint8_t>{2, 4, 6, 255, 150, 150, 150, 0});
+
+		// Gamma correct: black + white averages brighter than 128
+		std::vector<uint8_t> bw = {0, 0, 0, 255, 255, 255, 255, 255, 0, 0, 0, 255, 255, 255, 255, 255};
+		auto srgb = rawrbox::MipUtils::downsample({2, 2}, bw, 4, true);
+
+		REQUIRE(srgb.size() == 4);
+		REQUIRE(srgb[0] >= 186);
+		REQUIRE(srgb[0] <= 189);
+		REQUIRE(srgb[3] == 255); // Alpha is linear
+
+		// Odd sizes & other channel counts
+		std::vector<uint8_t> gray = {10, 20, 30, 40, 50, 60, 70, 80, 90};
+		auto small = rawrbox::MipUtils::downsample({3, 3}, gray, 1);
+		REQUIRE(small == std::vector<uint8_t>{30});
+
+		REQUIRE(rawrbox::MipUtils::downsample({1, 1}, {7, 9}, 2) == std::vector<uint8_t>{7, 9});
+	}
+
+	SECTION("rawrbox::MipUtils::downsample (SIMD matches scalar)") {
+		std::mt19937 rng(1337);
+		std::uniform_int_distribution<int> dist(0, 255);
+
+		rawrbox::Vector2u size = {37, 19};
+		std::vector<uint8_t> pixels(size.x * size.y * 4);
+		for (auto& p : pixels) {
+			p = static_cast<uint8_t>(dist(rng));
+		}
+
+		auto out = rawrbox::MipUtils::downsample(size, pixels, 4);
+		auto dst = rawrbox::MipUtils::getSize(size, 1);
+
+		for (uint32_t y = 0; y < dst.y; y++) {
+			for (uint32_t x = 0; x < dst.x; x++) {
+				for (uint32_t c = 0; c < 4; c++) {
+					auto at = [&](uint32_t sx, uint32_t sy) { return pixels[(sy * size.x + sx) * 4 + c]; };
+					int sum = at(x * 2, y * 2) + at(x * 2 + 1, y * 2) + at(x * 2, y * 2 + 1) + at(x * 2 + 1, y * 2 + 1);
+
+					REQUIRE(out[(y * dst.x + x) * 4 + c] == (sum + 2) / 4);
+				}
+			}
+		}
+	}
+
+	SECTION("rawrbox::MipUtils::generate") {
+		rawrbox::ImageData data = {};
+		data.size = {64, 16};
+		data.channels = 4;
+		data.createFrame(std::vector<uint8_t>(64 * 16 * 4, 128));
+		data.createFrame(std::vector<uint8_t>(64 * 16 * 4, 64));
+
+		REQUIRE(data.mipLevels() == 1);
+		rawrbox::MipUtils::generate(data);
+
+		REQUIRE(data.mipLevels() == 7);
+		REQUIRE(data.frames[0].mips[0].size() == 32 * 8 * 4);
+		REQUIRE(data.frames[1].mips.back() == std::vector<uint8_t>{64, 64, 64, 64});
+
+		// Stored levels are kept (cached data)
+		data.frames[0].mips.back()[0] = 1;
+		rawrbox::MipUtils::generate(data);
+		REQUIRE(data.frames[0].mips.back()[0] == 1);
+
+		data.clearMips();
+		rawrbox::MipUtils::generate(data, false, 3);
+		REQUIRE(data.mipLevels() == 3);
+	}
+}
+
+TEST_CASE("MipUtils benchmark", "[.benchmark][rawrbox::MipUtils]") {
+	rawrbox::Vector2u size = {2048, 2048};
+
+	std::mt19937 rng(1337);
+	std::uniform_int_distribution<int> dist(0, 255);
+
+	std::vector<uint8_t> pixels(size.x * size.y * 4);
+	for (auto& p : pixels) {
+		p = static_cast<uint8_t>(dist(rng));
+	}
+
+	BENCHMARK("downsample 2048x2048 RGBA8") {
+		return rawrbox::MipUtils::downsample(size, pixels, 4);
+	};
+
+	BENCHMARK("downsample 2048x2048 RGBA8 sRGB") {
+		return rawrbox::MipUtils::downsample(size, pixels, 4, true);
+	};
+
+	// Throughput, in source megapixels per second
+	for (bool sRGB : {false, true}) {
+		constexpr int runs = 20;
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < runs; i++) {
+			auto out = rawrbox::MipUtils::downsample(size, pixels, 4, sRGB);
+			REQUIRE_FALSE(out.empty());
+		}
+
+		std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+		double mpix = static_cast<double>(size.x) * size.y * runs / 1000000.0 / elapsed.count();
+
+		WARN((sRGB ? "sRGB: " : "Linear: ") << mpix << " MPix/s");
+	}
+}
@@ -0,0 +1,271 @@
+#include <rawrbox/render/textures/utils/pack_node.hpp>
+#include <rawrbox/render/textures/utils/packer.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <vector>
+
+namespace {
+	bool overlaps(const rawrbox::AtlasRect& a, const rawrbox::AtlasRect& b, uint32_t padding) {
+		if (a.page != b.page) return false;
+		if (a.width == 0 || a.height == 0 || b.width == 0 || b.height == 0) return false;
+
+		return a.x < b.x + b.width + padding && b.x < a.x + a.width + padding && a.y < b.y + b.height + padding && b.y < a.y + a.height + padding;
+	}
+
+	bool validLayout(const rawrbox::AtlasPacker& packer, const std::vector<uint64_t>& ids, uint32_t padding) {
+		std::vector<rawrbox::AtlasRect> rects = {};
+		for (auto id : ids) {
+			auto rect = packer.get(id);
+			if (!rect.has_value()) return false;
+			if (rect->x + rect->width > packer.getSize() || rect->y + rect->height > packer.getSize()) return false;
+
+			rects.push_back(rect.value());
+		}
+
+		for (size_t i = 0; i < rects.size(); i++) {
+			for (size_t j = i + 1; j < rects.size(); j++) {
+				if (overlaps(rects[i], rects[j], padding)) return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Glyph-ish sizes, mostly small with the odd big one
+	std::vector<std::pair<uint32_t, uint32_t>> makeSizes(size_t count, uint32_t seed) {
+		std::mt19937 rng(seed);
+		std::uniform_int_distribution<uint32_t> small(6, 32);
+		std::uniform_int_distribution<uint32_t> big(32, 96);
+		std::uniform_int_distribution<uint32_t> pick(0, 9);
+
+		std::vector<std::pair<uint32_t, uint32_t>> sizes = {};
+		sizes.reserve(count);
+
+		for (size_t i = 0; i < count; i++) {
+			if (pick(rng) == 0) {
+				sizes.emplace_back(big(rng), big(rng));
+			} else {
+				sizes.emplace_back(small(rng), small(rng));
+			}
+		}
+
+		return sizes;
+	}
+} // namespace
+
+TEST_CASE("AtlasPacker should behave as expected", "[rawrbox::AtlasPacker]") {
+	SECTION("rawrbox::AtlasPacker::insert") {
+		rawrbox::AtlasPacker packer(256, 1, 1);
+		std::vector<uint64_t> ids = {};
+
+		for (const auto& size : makeSizes(200, 1)) {
+			auto rect = packer.insert(size.first, size.second);
+			if (!rect.has_value()) break;
+
+			REQUIRE(rect->width == size.first);
+			REQUIRE(rect->height == size.second);
+			ids.push_back(rect->id);
+		}
+
+		REQUIRE(ids.size() > 20);
+		REQUIRE(packer.getSpriteCount() == ids.size());
+		REQUIRE(validLayout(packer, ids, 1));
+
+		// Too big never fits, empty always does
+		REQUIRE_FALSE(packer.insert(257, 1).has_value());
+		REQUIRE(packer.insert(0, 0).has_value());
+	}
+
+	SECTION("rawrbox::AtlasPacker::remove") {
+		rawrbox::AtlasPacker packer(64);
+
+		std::vector<uint64_t> ids = {};
+		for (int i = 0; i < 16; i++) {
+			auto rect = packer.insert(16, 16);
+			REQUIRE(rect.has_value());
+			ids.push_back(rect->id);
+		}
+
+		REQUIRE(packer.getOccupancy() == 1.F);
+		REQUIRE_FALSE(packer.canInsert(16, 16));
+
+		for (auto id : ids) {
+			REQUIRE(packer.remove(id));
+		}
+
+		REQUIRE_FALSE(packer.remove(ids.front()));
+		REQUIRE(packer.getSpriteCount() == 0);
+
+		// Everything merged back into one rect, the whole page fits again
+		REQUIRE(packer.getFreeRects() == 1);
+		REQUIRE(packer.insert(64, 64).has_value());
+
+		// Same with padding and mixed sizes, removed in the order they went in
+		rawrbox::AtlasPacker padded(256, 1, 1);
+		ids.clear();
+
+		for (const auto& size : makeSizes(200, 3)) {
+			auto rect = padded.insert(size.first, size.second);
+			if (rect.has_value()) ids.push_back(rect->id);
+		}
+
+		for (auto id : ids) {
+			REQUIRE(padded.remove(id));
+		}
+
+		REQUIRE(padded.getFreeRects() == 1);
+		REQUIRE(padded.insert(256, 256).has_value());
+	}
+
+	SECTION("rawrbox::AtlasPacker::pages") {
+		rawrbox::AtlasPacker packer(64, 3);
+
+		for (int i = 0; i < 3; i++) {
+			auto rect = packer.insert(64, 64);
+			REQUIRE(rect.has_value());
+			REQUIRE(rect->page == static_cast<uint32_t>(i));
+		}
+
+		REQUIRE(packer.getPages() == 3);
+		REQUIRE_FALSE(packer.canInsert(1, 1));
+		REQUIRE_FALSE(packer.insert(1, 1).has_value());
+	}
+
+	SECTION("rawrbox::AtlasPacker::evict") {
+		rawrbox::AtlasPacker packer(64);
+
+		std::vector<uint64_t> ids = {};
+		for (int i = 0; i < 4; i++) {
+			ids.push_back(packer.insert(32, 32)->id);
+		}
+
+		packer.touch(ids[0]); // 0 is now the most recent
+
+		auto evicted = packer.evict(32, 32);
+		REQUIRE(evicted.size() == 1);
+		REQUIRE(evicted[0].id == ids[1]);
+
+		REQUIRE(packer.canInsert(32, 32));
+		REQUIRE(packer.evict(32, 32).empty()); // Already fits
+
+		// Needs the whole page, everyone goes, least recent first
+		evicted = packer.evict(64, 64);
+		REQUIRE(evicted.size() == 3);
+		REQUIRE(evicted[0].id == ids[2]);
+		REQUIRE(evicted[1].id == ids[3]);
+		REQUIRE(evicted[2].id == ids[0]);
+		REQUIRE(packer.getSpriteCount() == 0);
+	}
+
+	SECTION("rawrbox::AtlasPacker::defragment") {
+		rawrbox::AtlasPacker packer(256, 1, 1);
+		std::vector<uint64_t> ids = {};
+
+		auto sizes = makeSizes(400, 7);
+		for (const auto& size : sizes) {
+			auto rect = packer.insert(size.first, size.second);
+			if (!rect.has_value()) break;
+
+			ids.push_back(rect->id);
+		}
+
+		// Punch holes, every other sprite
+		std::vector<uint64_t> kept = {};
+		for (size_t i = 0; i < ids.size(); i++) {
+			if (i % 2 == 0) {
+				packer.remove(ids[i]);
+			} else {
+				kept.push_back(ids[i]);
+			}
+		}
+
+		auto freeBefore = packer.getFreeRects();
+		auto relocations = packer.defragment();
+
+		REQUIRE_FALSE(relocations.empty());
+		REQUIRE(packer.getFreeRects() < freeBefore);
+		REQUIRE(validLayout(packer, kept, 1));
+
+		for (const auto& move : relocations) {
+			auto rect = packer.get(move.id);
+			REQUIRE(rect.has_value());
+			REQUIRE(rect->x == move.to.x);
+			REQUIRE(rect->y == move.to.y);
+			REQUIRE(move.from.width == move.to.width);
+			REQUIRE(move.from.height == move.to.height);
+		}
+	}
+}
+
+TEST_CASE("AtlasPacker benchmark", "[.benchmark][rawrbox::AtlasPacker]") {
+	auto sizes = makeSizes(8192, 1337);
+
+	// Occupancy when the atlas first refuses a sprite
+	auto nodeOccupancy = [&sizes]() {
+		rawrbox::PackNode root(0, 0, 2048, 2048);
+		uint64_t area = 0;
+
+		for (const auto& size : sizes) {
+			auto node = root.InsertNode(size.first, size.second);
+			if (!node.has_value()) break;
+
+			node->get().used = true;
+			area += static_cast<uint64_t>(size.first) * size.second;
+		}
+
+		return static_cast<float>(area) / (2048.F * 2048.F);
+	}();
+
+	auto packerOccupancy = [&sizes]() {
+		rawrbox::AtlasPacker packer(2048);
+		for (const auto& size : sizes) {
+			if (!packer.insert(size.first, size.second).has_value()) break;
+		}
+
+		return packer.getOccupancy();
+	}();
+
+	WARN("PackNode occupancy: " << nodeOccupancy << ", AtlasPacker occupancy: " << packerOccupancy);
+
+	BENCHMARK("PackNode insert 2048x2048") {
+		rawrbox::PackNode root(0, 0, 2048, 2048);
+		size_t count = 0;
+
+		for (const auto& size : sizes) {
+			auto node = root.InsertNode(size.first, size.second);
+			if (!node.has_value()) break;
+
+			node->get().used = true;
+			count++;
+		}
+
+		return count;
+	};
+
+	BENCHMARK("AtlasPacker insert 2048x2048") {
+		rawrbox::AtlasPacker packer(2048);
+		size_t count = 0;
+
+		for (const auto& size : sizes) {
+			if (!packer.insert(size.first, size.second).has_value()) break;
+			count++;
+		}
+
+		return count;
+	};
+
+	BENCHMARK("AtlasPacker churn 2048x2048") {
+		rawrbox::AtlasPacker packer(2048);
+
+		size_t count = 0;
+		for (const auto& size : sizes) {
+			if (!packer.canInsert(size.first, size.second)) packer.evict(size.first, size.second);
+			if (packer.insert(size.first, size.second).has_value()) count++;
+		}
+
+		return count;
+	};
+}
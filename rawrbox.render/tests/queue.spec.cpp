@@ -0,0 +1,98 @@
+#include <rawrbox/render/queue/queue.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <random>
+#include <tuple>
+
+TEST_CASE("RenderQueue should behave as expected", "[rawrbox::RenderQueue]") {
+	SECTION("rawrbox::RenderQueue::makeKey") {
+		// Opaque before transparent
+		REQUIRE(rawrbox::RenderQueue::makeKey(0, false, 10, 10, 100.F) < rawrbox::RenderQueue::makeKey(0, true, 0, 0, 1.F));
+
+		// Pass has priority
+		REQUIRE(rawrbox::RenderQueue::makeKey(0, true, 10, 10, 100.F) < rawrbox::RenderQueue::makeKey(1, false, 0, 0, 1.F));
+
+		// Opaque groups by pipeline, then front-to-back
+		REQUIRE(rawrbox::RenderQueue::makeKey(0, false, 1, 0, 100.F) < rawrbox::RenderQueue::makeKey(0, false, 2, 0, 1.F));
+		REQUIRE(rawrbox::RenderQueue::makeKey(0, false, 1, 0, 1.F) < rawrbox::RenderQueue::makeKey(0, false, 1, 0, 100.F));
+
+		// Transparent back-to-front, ignoring pipeline
+		REQUIRE(rawrbox::RenderQueue::makeKey(0, true, 2, 0, 100.F) < rawrbox::RenderQueue::makeKey(0, true, 1, 0, 1.F));
+
+		// Negative depth acts as zero
+		REQUIRE(rawrbox::RenderQueue::quantizeDepth(-5.F) == 0);
+		REQUIRE(rawrbox::RenderQueue::quantizeDepth(1.F) < rawrbox::RenderQueue::quantizeDepth(2.F));
+	}
+
+	SECTION("rawrbox::RenderQueue::sort") {
+		rawrbox::RenderQueue queue;
+
+		std::mt19937_64 rng(1234); // NOLINT(cert-msc32-c,cert-msc51-cpp)
+		std::vector<uint64_t> keys = {};
+
+		queue.begin();
+		for (uint32_t i = 0; i < 5000; i++) {
+			uint64_t key = rng() & 0xFFFF00FFFFFFFFFFULL; // Leave a constant byte, so one pass gets skipped
+			keys.push_back(key);
+			queue.add(key, i);
+		}
+
+		queue.sort();
+		std::sort(keys.begin(), keys.end());
+
+		const auto& items = queue.getItems();
+		REQUIRE(items.size() == keys.size());
+
+		for (size_t i = 0; i < items.size(); i++) {
+			REQUIRE(items[i].key == keys[i]);
+		}
+
+		// Stable, equal keys keep insertion order
+		queue.begin();
+		for (uint32_t i = 0; i < 100; i++) {
+			queue.add(i % 2, i);
+		}
+
+		queue.sort();
+		for (size_t i = 1; i < 50; i++) {
+			REQUIRE(queue.getItems()[i].index > queue.getItems()[i - 1].index);
+		}
+	}
+
+	SECTION("rawrbox::RenderQueue::setPipeline") {
+		rawrbox::RenderQueue queue;
+
+		int pipeA = 0;
+		int pipeB = 0;
+
+		// Two pipelines, interleaved draws
+		std::vector<const void*> pipelines = {&pipeA, &pipeB, &pipeA, &pipeB, &pipeA, &pipeB};
+
+		queue.begin();
+		for (uint32_t i = 0; i < pipelines.size(); i++) {
+			queue.add(rawrbox::RenderQueue::makeKey(0, false, queue.getStateID(pipelines[i]), 0, static_cast<float>(i)), i);
+		}
+
+		queue.sort();
+		for (const auto& item : queue.getItems()) {
+			std::ignore = queue.setPipeline(pipelines[item.index]);
+			queue.countUniforms(item.index < 2);
+			queue.countDraw();
+		}
+		queue.end();
+
+		REQUIRE(queue.getStats().draws == 6);
+		REQUIRE(queue.getStats().pipelineBinds == 2);
+		REQUIRE(queue.getStats().pipelineSkips == 4);
+		REQUIRE(queue.getStats().uniformUploads == 2);
+		REQUIRE(queue.getStats().uniformSkips == 4);
+
+		rawrbox::RenderQueue::frame();
+		REQUIRE(rawrbox::RenderQueue::getFrameStats().pipelineBinds == 2);
+
+		rawrbox::RenderQueue::frame();
+		REQUIRE(rawrbox::RenderQueue::getFrameStats().pipelineBinds == 0);
+	}
+}
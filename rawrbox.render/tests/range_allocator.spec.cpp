@@ -0,0 +1,100 @@
+#include <rawrbox/render/utils/range_allocator.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <random>
+#include <tuple>
+#include <vector>
+
+TEST_CASE("RangeAllocator should behave as expected", "[rawrbox::RangeAllocator]") {
+	SECTION("rawrbox::RangeAllocator::allocate") {
+		rawrbox::RangeAllocator alloc(100);
+
+		auto a = alloc.allocate(10);
+		auto b = alloc.allocate(20);
+		auto c = alloc.allocate(70);
+
+		REQUIRE(a == 0);
+		REQUIRE(b == 10);
+		REQUIRE(c == 30);
+		REQUIRE(alloc.getFree() == 0);
+
+		REQUIRE(alloc.allocate(1) == rawrbox::RangeAllocator::INVALID_OFFSET);
+		REQUIRE(alloc.getSize(b) == 20);
+	}
+
+	SECTION("rawrbox::RangeAllocator::free") {
+		rawrbox::RangeAllocator alloc(100);
+
+		auto a = alloc.allocate(10);
+		auto b = alloc.allocate(10);
+		auto c = alloc.allocate(10);
+
+		alloc.free(a);
+		alloc.free(c);
+
+		// [free 10][b][free 80]
+		auto stats = alloc.getStats();
+		REQUIRE(stats.freeBlocks == 2);
+		REQUIRE(stats.largestFree == 80);
+		REQUIRE(stats.allocations == 1);
+		REQUIRE_THAT(stats.fragmentation, Catch::Matchers::WithinAbs(1.F - 80.F / 90.F, 0.0001F));
+
+		// Best fit picks the small hole
+		REQUIRE(alloc.allocate(5) == 0);
+
+		// Coalesce everything back
+		alloc.free(0);
+		alloc.free(b);
+
+		stats = alloc.getStats();
+		REQUIRE(stats.freeBlocks == 1);
+		REQUIRE(stats.largestFree == 100);
+		REQUIRE_THAT(stats.fragmentation, Catch::Matchers::WithinAbs(0.F, 0.0001F));
+	}
+
+	SECTION("rawrbox::RangeAllocator::grow") {
+		rawrbox::RangeAllocator alloc(10);
+
+		std::ignore = alloc.allocate(5);
+		REQUIRE(alloc.allocate(10) == rawrbox::RangeAllocator::INVALID_OFFSET);
+
+		alloc.grow(20);
+		REQUIRE(alloc.getLargestFree() == 15); // Tail merged with the grown range
+		REQUIRE(alloc.allocate(10) == 5);
+	}
+
+	SECTION("rawrbox::RangeAllocator::stress") {
+		rawrbox::RangeAllocator alloc(1 << 16);
+
+		std::mt19937 rng(42); // NOLINT(cert-msc32-c,cert-msc51-cpp)
+		std::vector<uint64_t> live = {};
+
+		for (int i = 0; i < 5000; i++) {
+			if (!live.empty() && (rng() % 3) == 0) {
+				size_t idx = rng() % live.size();
+				alloc.free(live[idx]);
+				live.erase(live.begin() + static_cast<std::ptrdiff_t>(idx));
+			} else {
+				auto offset = alloc.allocate(1 + (rng() % 64));
+				if (offset != rawrbox::RangeAllocator::INVALID_OFFSET) live.push_back(offset);
+			}
+		}
+
+		uint64_t used = 0;
+		for (auto offset : live) {
+			used += alloc.getSize(offset);
+		}
+
+		REQUIRE(alloc.getUsed() == used);
+
+		for (auto offset : live) {
+			alloc.free(offset);
+		}
+
+		REQUIRE(alloc.getUsed() == 0);
+		REQUIRE(alloc.getStats().freeBlocks == 1);
+	}
+}
@@ -0,0 +1,222 @@
+#include <rawrbox/render/textures/data.hpp>
+#include <rawrbox/render/textures/utils/residency.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+	// 1024x1024 RGBA8, 11 levels
+	std::vector<size_t> makeLevels(uint32_t size = 1024) {
+		rawrbox::ImageData data = {};
+		data.size = {size, size};
+		data.channels = 4;
+		data.frames.resize(1);
+
+		uint32_t levels = 0;
+		for (uint32_t s = size; s > 0; s >>= 1) {
+			levels++;
+		}
+
+		return rawrbox::TextureResidency::getLevelBytes(data, levels);
+	}
+
+	void completeAll(rawrbox::TextureResidency& residency, const std::vector<rawrbox::ResidencyChange>& changes) {
+		for (const auto& change : changes) {
+			residency.complete(change.id);
+		}
+	}
+} // namespace
+
+TEST_CASE("TextureResidency should behave as expected", "[rawrbox::TextureResidency]") {
+	SECTION("rawrbox::TextureResidency::estimateLevel") {
+		REQUIRE(rawrbox::TextureResidency::estimateLevel({1024, 1024}, 2048.F) == 0);
+		REQUIRE(rawrbox::TextureResidency::estimateLevel({1024, 1024}, 1024.F) == 0);
+		REQUIRE(rawrbox::TextureResidency::estimateLevel({1024, 1024}, 300.F) == 1);
+		REQUIRE(rawrbox::TextureResidency::estimateLevel({1024, 512}, 64.F) == 4);
+		REQUIRE(rawrbox::TextureResidency::estimateLevel({1024, 1024}, 0.F) == 10);
+	}
+
+	SECTION("rawrbox::TextureResidency::add") {
+		rawrbox::TextureResidency residency(64ULL * 1024ULL * 1024ULL);
+
+		auto levels = makeLevels();
+		REQUIRE(levels.size() == 11);
+		REQUIRE(levels[0] == 1024ULL * 1024ULL * 4ULL);
+
+		// Only the 64x64 tail is loaded at first
+		REQUIRE(residency.add(1, {1024, 1024}, levels) == 4);
+		REQUIRE(residency.getResident(1) == 4);
+
+		size_t tail = 0;
+		for (size_t i = 4; i < levels.size(); i++) {
+			tail += levels[i];
+		}
+		REQUIRE(residency.getUsed() == tail);
+
+		// Small textures are fully resident
+		REQUIRE(residency.add(2, {32, 32}, makeLevels(32)) == 0);
+
+		residency.remove(1);
+		residency.remove(2);
+		REQUIRE(residency.size() == 0);
+		REQUIRE(residency.getUsed() == 0);
+	}
+
+	SECTION("rawrbox::TextureResidency::update") {
+		rawrbox::TextureResidency residency(64ULL * 1024ULL * 1024ULL);
+		auto levels = makeLevels();
+
+		residency.add(1, {1024, 1024}, levels);
+
+		// Nothing requested, nothing to do
+		REQUIRE(residency.update().empty());
+
+		residency.request(1, 6); // Already resident
+		REQUIRE(residency.update().empty());
+
+		// Several requests keep the finest one
+		residency.request(1, 3);
+		residency.request(1, 1);
+		residency.request(1, 2);
+
+		auto changes = residency.update();
+		REQUIRE(changes.size() == 1);
+		REQUIRE(changes[0].id == 1);
+		REQUIRE(changes[0].from == 4);
+		REQUIRE(changes[0].to == 1);
+		REQUIRE(changes[0].isLoad());
+
+		// Still pending, no new changes until it's applied
+		residency.request(1, 0);
+		REQUIRE(residency.update().empty());
+
+		residency.complete(1);
+		residency.request(1, 0);
+
+		changes = residency.update();
+		REQUIRE(changes.size() == 1);
+		REQUIRE(changes[0].to == 0);
+		REQUIRE(residency.getUsed() == std::accumulate(levels.begin(), levels.end(), size_t{0})); // Full chain
+	}
+
+	SECTION("rawrbox::TextureResidency::fail") {
+		rawrbox::TextureResidency residency(64ULL * 1024ULL * 1024ULL);
+		residency.add(1, {1024, 1024}, makeLevels());
+
+		auto used = residency.getUsed();
+		residency.request(1, 1);
+
+		auto changes = residency.update();
+		REQUIRE(changes.size() == 1);
+		REQUIRE(residency.getUsed() > used);
+
+		// Level failed to build, back to where it was and free to retry
+		residency.fail(changes[0]);
+		REQUIRE(residency.getResident(1) == changes[0].from);
+		REQUIRE(residency.getUsed() == used);
+
+		residency.request(1, 1);
+		REQUIRE(residency.update().size() == 1);
+	}
+
+	SECTION("rawrbox::TextureResidency::budget") {
+		auto levels = makeLevels();
+		auto full = std::accumulate(levels.begin(), levels.end(), size_t{0});
+
+		// Room for two full textures + a few tails
+		rawrbox::TextureResidency residency(full * 2 + 64ULL * 1024ULL);
+		for (uint64_t id = 1; id <= 3; id++) {
+			residency.add(id, {1024, 1024}, levels);
+		}
+
+		// Frame 1: 1 & 2 up close
+		residency.request(1, 0);
+		residency.request(2, 0);
+
+		auto changes = residency.update();
+		REQUIRE(changes.size() == 2);
+		completeAll(residency, changes);
+		REQUIRE(residency.getUsed() <= residency.getBudget());
+
+		// Frame 2: only 3 is visible, the oldest one (1 & 2) give memory back
+		residency.request(3, 0);
+		changes = residency.update();
+		completeAll(residency, changes);
+
+		REQUIRE(residency.getResident(3) == 0);
+		REQUIRE(residency.getUsed() <= residency.getBudget());
+
+		size_t evictions = 0;
+		for (const auto& change : changes) {
+			if (!change.isLoad()) evictions++;
+		}
+		REQUIRE(evictions >= 1);
+
+		// Frame 3: everything visible, can't fit so some stay blurry but nothing goes over budget
+		residency.request(1, 0);
+		residency.request(2, 0);
+		residency.request(3, 0);
+
+		changes = residency.update();
+		completeAll(residency, changes);
+		REQUIRE(residency.getUsed() <= residency.getBudget());
+
+		// In use textures are never dropped below what they request
+		for (const auto& change : changes) {
+			REQUIRE(change.isLoad());
+		}
+	}
+
+	SECTION("rawrbox::TextureResidency::trace") {
+		auto levels = makeLevels(512);
+		constexpr size_t textures = 200;
+
+		rawrbox::TextureResidency residency(16ULL * 1024ULL * 1024ULL);
+		residency.setUploadLimit(4ULL * 1024ULL * 1024ULL);
+
+		for (uint64_t id = 0; id < textures; id++) {
+			residency.add(id, {512, 512}, levels);
+		}
+
+		// Random walk camera, visible textures are a window over the list
+		std::mt19937 rng(1234); // NOLINT(cert-msc32-c,cert-msc51-cpp)
+		std::uniform_int_distribution<int> step(-4, 4);
+		std::uniform_int_distribution<uint32_t> detail(0, 6);
+
+		int center = 100;
+		for (int frame = 0; frame < 500; frame++) {
+			center = std::clamp(center + step(rng), 10, static_cast<int>(textures) - 10);
+			for (int i = center - 10; i < center + 10; i++) {
+				residency.request(static_cast<uint64_t>(i), detail(rng));
+			}
+
+			auto changes = residency.update();
+
+			size_t loaded = 0;
+			for (const auto& change : changes) {
+				REQUIRE(change.from != change.to);
+				if (!change.isLoad()) continue;
+
+				for (uint32_t level = change.to; level < change.from; level++) {
+					loaded += levels[level];
+				}
+			}
+
+			REQUIRE(loaded <= 4ULL * 1024ULL * 1024ULL);
+			REQUIRE(residency.getUsed() <= residency.getBudget());
+
+			completeAll(residency, changes);
+		}
+
+		// Visible textures ended up sharper than their tails
+		size_t sharp = 0;
+		for (int i = center - 10; i < center + 10; i++) {
+			if (residency.getResident(static_cast<uint64_t>(i)) < 3) sharp++;
+		}
+
+		REQUIRE(sharp > 10);
+	}
+}
@@ -7,6 +7,10 @@
 #include <rawrbox/utils/file_watcher.hpp>
 #include <rawrbox/utils/logger.hpp>
 #include <rawrbox/utils/string.hpp>
+#include <rawrbox/utils/threading.hpp>
+
+#include <deque>
+#include <mutex>
 
 namespace rawrbox {
 	class SCRIPTING {
@@ -14,6 +18,72 @@ namespace rawrbox {
 		static std::unordered_map<std::string, std::unique_ptr<rawrbox::Mod>> _mods;
 		static std::unordered_map<std::string, std::vector<std::filesystem::path>> _loadedLuaFiles;
 
+		// HOOKS ---
+		struct HookSubscribers {
+			uint32_t version = 0; // Mod::getHooksVersion() when built
+			std::vector<rawrbox::Mod*> mods = {};
+		};
+
+		static std::deque<HookSubscribers> _subscribers; // By HookID index
+
+		// unloadMod waits for the outermost dispatch to return, so the Mod* it walks stay alive
+		static uint32_t _dispatchDepth;
+		static std::vector<std::string> _pendingUnloads;
+
+		struct DispatchGuard {
+			DispatchGuard() { _dispatchDepth++; }
+			DispatchGuard(const DispatchGuard&) = delete;
+			DispatchGuard(DispatchGuard&&) = delete;
+			DispatchGuard& operator=(const DispatchGuard&) = delete;
+			DispatchGuard& operator=(DispatchGuard&&) = delete;
+			~DispatchGuard() {
+				if (--_dispatchDepth == 0) flushUnloads();
+			}
+		};
+
+		static void flushUnloads();
+		[[nodiscard]] static bool isUnloading(const rawrbox::Mod* mod);
+		// ---------
+
+		// STEP ---
+		static std::vector<rawrbox::Mod*> _ordered; // By id, steps and message routing follow it so runs are repeatable
+		static std::vector<rawrbox::Mod*> _stepMods;
+		static std::vector<rawrbox::Mod*> _threadedStep;
+		static std::vector<rawrbox::Mod*> _serialStep;
+
+		static std::vector<rawrbox::ModMessage> _engineOutbox;
+		static uint64_t _engineMessages;
+
+		static void sortMods();
+		static void beginStep(const std::vector<rawrbox::Mod*>& mods);
+		static void endStep();
+
+		// Hooks / cross-mod calls refuse to run while it's alive, restored however the job leaves
+		struct WorkerGuard {
+			bool previous = rawrbox::Mod::onWorker();
+
+			WorkerGuard() { rawrbox::Mod::setWorker(true); }
+			WorkerGuard(const WorkerGuard&) = delete;
+			WorkerGuard(WorkerGuard&&) = delete;
+			WorkerGuard& operator=(const WorkerGuard&) = delete;
+			WorkerGuard& operator=(WorkerGuard&&) = delete;
+			~WorkerGuard() { rawrbox::Mod::setWorker(this->previous); }
+		};
+
+		template <typename... CallbackArgs>
+		static void runStep(rawrbox::Mod& mod, const rawrbox::HookID& hook, const CallbackArgs&... args) {
+			if (isUnloading(&mod)) return;
+
+			// One mod failing can't take the pool job (and the mods after it) down
+			try {
+				mod.deliverMessages();
+				mod.call(hook, args...);
+			} catch (const std::exception& err) {
+				_logger->error("Mod '{}' failed to step\n  └── {}", mod.getID(), err.what());
+			}
+		}
+		// ---------
+
 		static std::vector<std::unique_ptr<rawrbox::ScriptingPlugin>> _plugins;
 		static std::unique_ptr<rawrbox::FileWatcher> _watcher;
 
@@ -23,12 +93,22 @@ namespace rawrbox {
 
 		static rawrbox::Console* _console;
 		static bool _hotReloadEnabled;
+		static bool _diskBytecodeCache;
+		static rawrbox::LuaNativeMode _nativeMode;
+
+		// BUDGET ---
+		static float _budgetMs;
+		static rawrbox::ModBudgetAction _budgetAction;
+		static size_t _memoryLimit;
+		// ---------
 
 		// LOAD ----
 		static void loadLibraries(rawrbox::Mod& mod);
 		static void loadTypes(rawrbox::Mod& mod);
 		static void loadGlobals(rawrbox::Mod& mod);
 		static void loadModifiers(rawrbox::Mod& mod);
+
+		static void removePlugins(rawrbox::Mod& mod); // Plugins drop their refs into the mod's state, before it closes
 		// ----
 
 		// MOD LOAD ---
@@ -36,6 +116,9 @@ namespace rawrbox {
 		// ------------
 
 		// HOT RELOAD ---
+		static std::mutex _workerFilesMutex;
+		static std::vector<std::pair<std::string, std::filesystem::path>> _workerFiles; // include() from threaded steps, registered on endStep
+
 		static void registerLoadedFile(const std::string& modId, const std::filesystem::path& filePath);
 		static void hotReload(const std::filesystem::path& filePath);
 		// -------------
@@ -43,12 +126,17 @@ namespace rawrbox {
 	public:
 		static bool initialized;
 
+		// Reserved message targets, no mod can use them as id
+		static inline const std::string ENGINE_ID = "engine";
+		static inline const std::string BROADCAST_ID = "*";
+
 		// EVENTS ----
 		static rawrbox::Event<rawrbox::Mod&> onRegisterTypes;
 		static rawrbox::Event<rawrbox::Mod&> onRegisterGlobals;
 		static rawrbox::Event<rawrbox::Mod&> onLoadLibraries;
 		static rawrbox::Event<rawrbox::Mod&> onLoadModifiers;
 		static rawrbox::Event<rawrbox::Mod&> onModHotReload;
+		static rawrbox::Event<const rawrbox::ModMessage&> onMessage; // Sent to ENGINE_ID, fired on the calling thread of step()
 		// -------
 
 		// PLUGINS ---
@@ -63,19 +151,70 @@ namespace rawrbox {
 		}
 		// -----
 
+		// HOOKS ---
+		// Mods implementing the hook, rebuilt only after a MOD function changes or mods load / unload
+		[[nodiscard]] static const std::vector<rawrbox::Mod*>& getSubscribers(const rawrbox::HookID& hook);
+
 		template <typename... CallbackArgs>
-		static void call(const std::string& hookName, CallbackArgs&&... args) {
-			for (auto& mod : _mods) {
-				mod.second->call(hookName, std::forward<CallbackArgs>(args)...);
+		static void call(const rawrbox::HookID& hook, const CallbackArgs&... args) {
+			auto mods = getSubscribers(hook); // Copy, hooks can load mods or change MOD and rebuild the list
+			DispatchGuard guard = {};
+
+			for (auto* mod : mods) {
+				if (isUnloading(mod)) continue;
+				mod->call(hook, args...);
 			}
 		}
 
-		static void init(int hotReloadMs = 0);
+		template <typename... CallbackArgs>
+		static void call(const std::string& hookName, const CallbackArgs&... args) {
+			call(rawrbox::HookID(hookName), args...);
+		}
+		// ---------
+
+		// STEP ---
+		// Calls the hook on every mod in id order, threaded ones ("threaded": true in mod.json) in parallel on the job pool and the rest on this thread after them.
+		// Each mod first gets MOD:onMessage for what was routed at the end of the last step, so a message sent on step N arrives on step N + 1,
+		// ordered by sender (engine first, then mod id) and send order, no matter which thread finished first
+		template <typename... CallbackArgs>
+		static void step(const rawrbox::HookID& hook, const CallbackArgs&... args) {
+			step(_ordered, hook, args...);
+		}
+
+		// Same, on your own set of mods. Messages only route between them
+		template <typename... CallbackArgs>
+		static void step(const std::vector<rawrbox::Mod*>& mods, const rawrbox::HookID& hook, const CallbackArgs&... args) {
+			DispatchGuard guard = {}; // unloadMod from a hook waits for the step, the lists below stay valid
+			beginStep(mods);
+
+			rawrbox::ASYNC::parallel(
+			    _threadedStep.size(), [&](size_t start, size_t end) {
+				    WorkerGuard worker = {};
+				    for (size_t i = start; i < end; i++) {
+					    runStep(*_threadedStep[i], hook, args...);
+				    }
+			    },
+			    1);
+
+			for (size_t i = 0; i < _serialStep.size(); i++) {
+				runStep(*_serialStep[i], hook, args...);
+			}
+
+			endStep();
+		}
+
+		// Queued as ENGINE_ID, delivered on the next step. BROADCAST_ID sends it to every mod
+		static void send(const std::string& to, const std::string& topic, glz::generic payload = {});
+		// ---------
+
+		// diskBytecodeCache keeps compiled chunks in a `.luau` folder beside the mods root, so restarts skip compiling
+		static void init(int hotReloadMs = 0, bool diskBytecodeCache = false);
 
 		// LOADING ----
 		static std::unordered_map<std::filesystem::path, rawrbox::Mod*> loadMods(const std::filesystem::path& rootFolder);
 		static rawrbox::Mod* loadMod(const std::string& id, const std::filesystem::path& modFolder);
 
+		// From inside a hook / step the mod stops getting calls right away, but is only unloaded once the outermost dispatch returns
 		static bool unloadMod(const std::filesystem::path& modFolder);
 		static bool unloadMod(const std::string& modId);
 		// -----------
@@ -84,6 +223,17 @@ namespace rawrbox {
 
 		static void setConsole(rawrbox::Console* console);
 
+		// Applied to mods loaded after this, 0 = off
+		static void setModBudget(float ms, rawrbox::ModBudgetAction action = rawrbox::ModBudgetAction::ABORT);
+		static void setModMemoryLimit(size_t bytes);
+
+		// Incremental GC across every mod, call once per frame with what you can spare
+		static void gcStep(float budgetMs);
+		[[nodiscard]] static std::string getStatsReport();
+
+		// Default for mods without "native" in their mod.json, set before loading them. ANNOTATED with RAWRBOX_SCRIPTING_NATIVE, OFF otherwise
+		static void setNativeMode(rawrbox::LuaNativeMode mode);
+
 		// UTILS ---
 		[[nodiscard]] static rawrbox::Mod* getMod(const std::string& id);
 		[[nodiscard]] static bool hasMod(const std::string& id);
@@ -91,6 +241,7 @@ namespace rawrbox {
 		[[nodiscard]] static const std::unordered_map<std::string, std::unique_ptr<rawrbox::Mod>>& getMods();
 		[[nodiscard]] static std::vector<std::string> getModsIds();
 		[[nodiscard]] static bool hotReloadEnabled();
+		[[nodiscard]] static rawrbox::LuaNativeMode getNativeMode();
 		[[nodiscard]] static bool isLuaFileMounted(const std::string& path);
 
 #ifdef RAWRBOX_SCRIPTING_WORKSHOP_MODDING
@@ -1,20 +1,134 @@
 
 #pragma once
 
+#include <rawrbox/scripting/utils/hook_id.hpp>
 #include <rawrbox/scripting/utils/lua.hpp>
 #include <rawrbox/utils/logger.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <filesystem>
 #include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace rawrbox {
+	struct ModHookStats {
+		uint64_t calls = 0;
+		uint64_t totalNs = 0;
+		uint64_t maxNs = 0;
+		uint64_t lastNs = 0;
+
+		[[nodiscard]] double avgMs() const { return this->calls == 0 ? 0.0 : static_cast<double>(this->totalNs) / static_cast<double>(this->calls) / 1e6; }
+	};
+
+	struct ModMemoryStats {
+		size_t bytes = 0;            // Live lua heap
+		size_t peakBytes = 0;
+		size_t limit = 0;            // 0 = unlimited, allocations over it fail with a lua memory error
+		uint64_t allocations = 0;
+		uint64_t allocatedBytes = 0; // Everything ever requested, shows churn
+		uint64_t failed = 0;
+	};
+
+	struct ModStats {
+		rawrbox::ModMemoryStats memory = {};
+
+		uint64_t gcSteps = 0;
+		uint64_t gcNs = 0;
+		uint64_t gcMaxNs = 0;
+
+		uint64_t budgetOverruns = 0;
+	};
+
+	struct ModMessage {
+		std::string from;           // Sender mod id, SCRIPTING::ENGINE_ID for engine sent ones
+		std::string to;             // Mod id, SCRIPTING::ENGINE_ID or SCRIPTING::BROADCAST_ID
+		std::string topic;
+		glz::generic payload = {};  // Plain data copy, nothing is shared between states
+		uint64_t sequence = 0;      // Per sender, keeps delivery order stable
+	};
+
+	enum class ModBudgetAction {
+		ABORT, // Errors out of the overrunning call
+		PAUSE  // Same, then skips the mod's hooks until resume()
+	};
+
 	class Mod {
+		// STATS ---
+		rawrbox::ModMemoryStats _memory = {}; // Before _L, the allocator writes to it while the state is created
+		// ---------
+
 		// LUA ----
 		lua_State* _L = nullptr;
 		// --------
 
 		// TABLE ---
-		luabridge::LuaRef _modTable;
+		std::optional<luabridge::LuaRef> _modTable = std::nullopt; // Set on init, released before the state closes
+		// ---------
+
+		// HOOKS ---
+		struct HookSlot {
+			rawrbox::HookID hook = {};
+			uint32_t generation = 0;
+			std::optional<luabridge::LuaRef> func = std::nullopt; // Empty = mod doesn't implement it
+
+			rawrbox::ModHookStats stats = {}; // Survives re-resolving
+		};
+
+		std::deque<HookSlot> _hookSlots = {}; // By HookID index, deque so nested calls can grow it mid-dispatch
+		uint32_t _hookGeneration = 1;
+
+		static std::atomic<uint32_t> _hooksVersion; // Any mod, keys SCRIPTING's dispatch lists
+
+		HookSlot& resolve(const rawrbox::HookID& hook);
+		[[nodiscard]] bool isCurrent(const HookSlot& slot) const;
+
+		static int onNewIndex(lua_State* L);
+		// ---------
+
+		// BUDGET ---
+		std::chrono::nanoseconds _budget = {}; // Per outermost call, 0 = off
+		rawrbox::ModBudgetAction _budgetAction = rawrbox::ModBudgetAction::ABORT;
+		std::chrono::steady_clock::time_point _deadline = {};
+
+		uint32_t _callDepth = 0;
+		uint32_t _interruptTicks = 0;
+		bool _paused = false;
+
+		rawrbox::ModStats _stats = {};
+
+		static void* allocate(void* ud, void* ptr, size_t osize, size_t nsize);
+		static void onInterrupt(lua_State* L, int gc);
+
+		std::chrono::steady_clock::time_point beginCall();
+		void endCall(HookSlot& slot, std::chrono::steady_clock::time_point start);
+
+		// Ends the call however it leaves, the budget depth and stats can't be skipped
+		struct CallScope {
+			rawrbox::Mod& mod;
+			HookSlot& slot;
+			std::chrono::steady_clock::time_point start;
+
+			CallScope(rawrbox::Mod& mod_, HookSlot& slot_) : mod(mod_), slot(slot_), start(mod_.beginCall()) {}
+			CallScope(const CallScope&) = delete;
+			CallScope(CallScope&&) = delete;
+			CallScope& operator=(const CallScope&) = delete;
+			CallScope& operator=(CallScope&&) = delete;
+			~CallScope() { this->mod.endCall(this->slot, this->start); }
+		};
+		void recordGC(std::chrono::steady_clock::time_point start);
+		// ---------
+
+		// THREADING ---
+		bool _threaded = false;
+
+		std::vector<rawrbox::ModMessage> _outbox = {}; // Only touched by whoever runs the mod
+		std::vector<rawrbox::ModMessage> _inbox = {};  // Filled by SCRIPTING between steps
+		uint64_t _sentMessages = 0;
 		// ---------
 
 		// LOGGER ------
@@ -45,7 +159,13 @@ namespace rawrbox {
 		virtual void init();
 		virtual void shutdown();
 
-		virtual void gc();
+		virtual void gc(); // Full collect, prefer gcStep outside of unload
+
+		// GC ---
+		// Incremental steps until the cycle ends or budgetMs runs out, returns true if the cycle finished
+		virtual bool gcStep(float budgetMs);
+		virtual void setGCTuning(int goal, int stepMul, int stepSizeKB);
+		// ------
 
 		// LOADING -------
 		virtual void load();
@@ -72,13 +192,66 @@ namespace rawrbox {
 #endif
 		// -----
 
+		// HOOKS ---
+		[[nodiscard]] virtual bool implements(const rawrbox::HookID& hook);
+		// Hooks resolve once and stay cached. Done after init / load / script / include, hot reload and on new MOD keys, a cached function MOD no longer holds is re-resolved on call.
+		// Call it (mod.invalidateHooks() from lua) if an existing non function MOD key becomes one, or after replacing MOD's metatable
+		virtual void invalidateHooks();
+
+		[[nodiscard]] static uint32_t getHooksVersion();
+		// ---------
+
+		// BUDGET ---
+		// Checked at lua safepoints (loops / calls), C functions that block can't be cut short
+		virtual void setBudget(float ms, rawrbox::ModBudgetAction action = rawrbox::ModBudgetAction::ABORT);
+		virtual void setMemoryLimit(size_t bytes);
+
+		[[nodiscard]] virtual bool isPaused() const;
+		virtual void resume();
+		// ---------
+
+		// THREADING ---
+		// Threaded mods run their SCRIPTING::step hook on the job pool, they can only reach other mods / the engine through messages.
+		// Set it before init: SCRIPTING skips plugin types / globals (render, ui, bass, network, ...) for them, and console / hooks / timers / mod.get throw on a worker.
+		// onRegisterTypes / onRegisterGlobals handlers should check isThreaded() the same way
+		virtual void setThreaded(bool threaded);
+		[[nodiscard]] virtual bool isThreaded() const;
+
+		virtual void send(const std::string& to, const std::string& topic, glz::generic payload = {});
+		virtual void receive(rawrbox::ModMessage message);
+		[[nodiscard]] virtual std::vector<rawrbox::ModMessage> takeOutbox();
+
+		// Calls MOD:onMessage(from, topic, payload) for each received message, in order. Returns how many were delivered
+		virtual size_t deliverMessages();
+		[[nodiscard]] virtual size_t pendingMessages() const;
+
+		[[nodiscard]] static rawrbox::Mod* fromState(lua_State* L);
+		[[nodiscard]] static bool onWorker(); // True while a threaded step runs on this thread
+		static void setWorker(bool worker);
+		// ---------
+
+		// STATS ---
+		[[nodiscard]] virtual rawrbox::ModStats getStats() const;
+		[[nodiscard]] virtual rawrbox::ModHookStats getHookStats(const rawrbox::HookID& hook) const;
+		[[nodiscard]] virtual std::vector<std::pair<std::string, rawrbox::ModHookStats>> getHooksStats() const; // Hooks called at least once
+		virtual void resetStats();
+		// ---------
+
 		template <typename... CallbackArgs>
 		std::optional<luabridge::LuaResult> call(const std::string& name, CallbackArgs&&... args) {
-			auto fnc = this->_modTable[name];
-			if (!fnc.isCallable()) return std::nullopt;
+			return this->call(rawrbox::HookID(name), std::forward<CallbackArgs>(args)...);
+		}
+
+		template <typename... CallbackArgs>
+		std::optional<luabridge::LuaResult> call(const rawrbox::HookID& hook, CallbackArgs&&... args) {
+			if (this->_paused) return std::nullopt;
+
+			auto& slot = this->resolve(hook);
+			if (!slot.func.has_value()) return std::nullopt;
 
+			CallScope scope(*this, slot);
 			try {
-				luabridge::LuaResult result = luabridge::call(fnc, this->_modTable, std::forward<CallbackArgs>(args)...);
+				luabridge::LuaResult result = luabridge::call(*slot.func, *this->_modTable, std::forward<CallbackArgs>(args)...);
 				if (result.hasFailed()) _logger->warn("Lua error on {}\n  └── {}", this->_id, result.errorMessage());
 
 				return result;
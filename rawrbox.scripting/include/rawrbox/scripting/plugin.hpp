@@ -18,5 +18,8 @@ namespace rawrbox {
 		virtual void registerTypes(lua_State* /*l*/){};
 		virtual void registerGlobal(lua_State* /*l*/){};
 		virtual void loadLibraries(lua_State* /*l*/){};
+
+		// A mod's state is about to close. Drop every ref into it (event callbacks, etc), a LuaRef that outlives the state crashes on release
+		virtual void removeState(lua_State* /*l*/){};
 	};
 } // namespace rawrbox
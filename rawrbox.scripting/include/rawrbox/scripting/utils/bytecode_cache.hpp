@@ -0,0 +1,57 @@
+#pragma once
+
+#include <rawrbox/utils/sha256.hpp>
+
+#include <Luau/Compiler.h>
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace rawrbox {
+	struct LuaBytecodeStats {
+		size_t compiles = 0;
+		size_t memoryHits = 0;
+		size_t diskHits = 0;
+	};
+
+	// Compiled Luau chunks keyed by (source hash, compile options), shared by every lua_State. Thread safe
+	class LuaBytecodeCache {
+	protected:
+		struct Entry {
+			std::string source = {}; // Compared on every hit, the key is only 64 bits
+			std::shared_ptr<const std::string> bytecode = nullptr;
+		};
+
+		static std::unordered_map<uint64_t, Entry> _entries;
+		static std::shared_mutex _mutex; // Guards the entries and the folder
+
+		static std::filesystem::path _folder; // Empty = memory only
+
+		static std::atomic<size_t> _compiles;
+		static std::atomic<size_t> _memoryHits;
+		static std::atomic<size_t> _diskHits;
+
+		// Disk entries carry the source SHA-256, a key collision never loads or replaces another chunk
+		[[nodiscard]] static std::shared_ptr<const std::string> loadDisk(const std::filesystem::path& folder, uint64_t key, const rawrbox::SHA256Digest& source);
+		static void saveDisk(const std::filesystem::path& folder, uint64_t key, const rawrbox::SHA256Digest& source, const std::string& bytecode);
+
+	public:
+		[[nodiscard]] static uint64_t hash(const std::string& source, const Luau::CompileOptions& options, const Luau::ParseOptions& parser);
+
+		// Throws with the compiler message on syntax errors, those are never cached
+		[[nodiscard]] static std::shared_ptr<const std::string> get(const std::string& source, const Luau::CompileOptions& options, const Luau::ParseOptions& parser);
+		static void clear();
+
+		// Writes new chunks to / reads missing chunks from this folder, empty disables it. Set before loading mods
+		static void setFolder(const std::filesystem::path& folder);
+		[[nodiscard]] static std::filesystem::path getFolder();
+
+		[[nodiscard]] static size_t size();
+		[[nodiscard]] static rawrbox::LuaBytecodeStats getStats();
+	};
+} // namespace rawrbox
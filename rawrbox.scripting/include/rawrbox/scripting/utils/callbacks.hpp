@@ -0,0 +1,34 @@
+#pragma once
+
+#include <rawrbox/scripting/utils/lua.hpp>
+
+#include <fmt/format.h>
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace rawrbox {
+	using LuaCallback = std::shared_ptr<std::optional<luabridge::LuaRef>>; // Empty once the mod that made it is gone
+
+	// Lua functions handed to engine events (ui, sounds, http, ...), those outlive the mod. Plugins keep one per module and drop it on ScriptingPlugin::removeState. Main thread only
+	class LuaCallbacks {
+	protected:
+		std::vector<std::pair<lua_State*, rawrbox::LuaCallback>> _callbacks = {}; // Main state of the mod -> callback
+
+	public:
+		[[nodiscard]] rawrbox::LuaCallback add(const luabridge::LuaRef& callback);
+		void removeState(lua_State* L); // Empties its callbacks, the events keep harmless handles
+
+		[[nodiscard]] size_t size() const;
+
+		template <typename... CallbackArgs>
+		static void call(const rawrbox::LuaCallback& callback, CallbackArgs&&... args) {
+			if (callback == nullptr || !callback->has_value()) return;
+
+			auto result = luabridge::call(callback->value(), std::forward<CallbackArgs>(args)...);
+			if (result.hasFailed()) fmt::print("Lua error\n  └── {}\n", result.errorMessage());
+		}
+	};
+} // namespace rawrbox
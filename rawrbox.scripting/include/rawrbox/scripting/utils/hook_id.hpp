@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace rawrbox {
+	// Interned hook name. Dispatch indexes by it instead of hashing / pushing the string per mod, keep them around (static) for per-frame hooks
+	class HookID {
+	protected:
+		struct NameHash {
+			using is_transparent = void;
+			size_t operator()(std::string_view str) const { return std::hash<std::string_view>{}(str); }
+		};
+
+		struct Registry {
+			std::deque<std::string> names = {}; // Deque so name() references stay valid
+			std::unordered_map<std::string, uint32_t, NameHash, std::equal_to<>> lookup = {};
+			std::shared_mutex mutex = {};
+		};
+
+		[[nodiscard]] static Registry& registry(); // Function static, HookIDs are often globals themselves
+
+		uint32_t _index = INVALID;
+
+	public:
+		static constexpr uint32_t INVALID = std::numeric_limits<uint32_t>::max();
+
+		HookID() = default;
+		explicit HookID(std::string_view name); // Interns it
+
+		// Invalid if it was never interned, doesn't grow the table
+		[[nodiscard]] static rawrbox::HookID find(std::string_view name);
+		[[nodiscard]] static size_t count();
+
+		[[nodiscard]] uint32_t index() const;
+		[[nodiscard]] const std::string& name() const;
+		[[nodiscard]] bool valid() const;
+
+		bool operator==(const rawrbox::HookID& other) const { return this->_index == other._index; }
+		bool operator!=(const rawrbox::HookID& other) const { return this->_index != other._index; }
+	};
+} // namespace rawrbox
@@ -24,11 +24,23 @@ namespace DFInt {
 */
 
 namespace rawrbox {
+	enum class LuaNativeMode {
+		OFF,       // Interpreted only
+		ANNOTATED, // Native for `--!native` scripts and `@native` functions
+		ALL        // Native for every chunk loaded in the state
+	};
+
 	class LuaUtils {
 	public:
 		static void compileAndLoadFile(lua_State* L, const std::string& chunkID, const std::filesystem::path& path);
 		static void compileAndLoadScript(lua_State* L, const std::string& chunkID, const std::string& script);
 
+		// NATIVE ---
+		// Returns false (and stays interpreted) when built without RAWRBOX_SCRIPTING_NATIVE or the cpu has no codegen backend
+		static bool enableNative(lua_State* L, rawrbox::LuaNativeMode mode);
+		[[nodiscard]] static rawrbox::LuaNativeMode getNativeMode(lua_State* L);
+		// ----------
+
 		static void resume(lua_State* L, lua_State* from);
 		static void run(lua_State* L);
 		static void collect_garbage(lua_State* L);
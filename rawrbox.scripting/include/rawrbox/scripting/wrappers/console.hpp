@@ -3,9 +3,14 @@
 #include <rawrbox/scripting/utils/lua.hpp>
 #include <rawrbox/utils/console.hpp>
 
+#include <string>
+#include <unordered_map>
+
 namespace rawrbox {
+	// Main thread only, every call throws from a threaded step
 	class ConsoleWrapper {
 		static rawrbox::Console* _console;
+		static std::unordered_map<std::string, lua_State*> _owners; // Command -> main state of the mod that registered it
 
 	public:
 		static void init(rawrbox::Console* console);
@@ -23,6 +28,8 @@ namespace rawrbox {
 
 		static bool removeCommand(const std::string& command);
 		static bool hasCommand(const std::string& command);
+
+		static void removeState(lua_State* L); // Removes its commands, they hold refs into it
 		// static bool registerVariable(const std::string& command, const luabridge::LuaRef& callback, std::optional<std::string> description, std::optional<uint32_t> flags);
 
 		static void registerLua(lua_State* L);
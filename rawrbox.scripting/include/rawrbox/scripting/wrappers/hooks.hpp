@@ -1,9 +1,10 @@
 #pragma once
+#include <rawrbox/scripting/utils/hook_id.hpp>
 #include <rawrbox/scripting/utils/lua.hpp>
 
 #include <string>
-#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace rawrbox {
 	struct Hook {
@@ -15,12 +16,14 @@ namespace rawrbox {
 
 	class Hooks {
 	private:
-		static std::unordered_map<std::string, std::vector<rawrbox::Hook>> _hooks;
+		static std::vector<std::vector<rawrbox::Hook>> _hooks; // By HookID index
 
 	public:
+		static void call(const rawrbox::HookID& id, const luabridge::LuaRef& args);
 		static void call(const std::string& id, const luabridge::LuaRef& args);
 		static void add(const std::string& id, const std::string& name, const luabridge::LuaRef& func);
 		static void remove(const std::string& id, const std::string& name);
+		static void removeState(lua_State* L); // Every hook added from this state, before it closes
 
 		// Utils ---
 		[[nodiscard]] static size_t count();
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <rawrbox/scripting/utils/lua.hpp>
+
+#include <string>
+
+namespace rawrbox {
+	class MessagesWrapper {
+	public:
+		// Queued on the sending mod, SCRIPTING routes them at the end of each step
+		static void send(const std::string& to, const std::string& topic, const luabridge::LuaRef& payload);
+		static void broadcast(const std::string& topic, const luabridge::LuaRef& payload);
+
+		// Plain data only, so the receiving state gets its own copy
+		[[nodiscard]] static glz::generic toPayload(const luabridge::LuaRef& ref);
+
+		static void registerLua(lua_State* L);
+	};
+} // namespace rawrbox
@@ -2,8 +2,13 @@
 
 #include <rawrbox/scripting/utils/lua.hpp>
 
+#include <string>
+#include <unordered_map>
+
 namespace rawrbox {
 	class TimerWrapper {
+		static std::unordered_map<std::string, lua_State*> _owners; // Timer id -> main state of the mod that made it
+
 	public:
 		// CREATE ---
 		static bool create(const std::string& id, int reps, float delay, const luabridge::LuaRef& callback, std::optional<luabridge::LuaRef> onComplete);
@@ -16,6 +21,8 @@ namespace rawrbox {
 		static bool pause(const std::string& id, bool pause);
 		// ----
 
+		static void removeState(lua_State* L); // Destroys its timers, they hold refs into it
+
 		static void registerLua(lua_State* L);
 	};
 } // namespace rawrbox
@@ -1,6 +1,7 @@
 #include <rawrbox/engine/static.hpp>
 #include <rawrbox/scripting/manager.hpp>
 #include <rawrbox/scripting/mod.hpp>
+#include <rawrbox/scripting/utils/bytecode_cache.hpp>
 #include <rawrbox/scripting/utils/lua.hpp>
 #include <rawrbox/scripting/wrappers/console.hpp>
 #include <rawrbox/scripting/wrappers/console_command.hpp>
@@ -14,6 +15,7 @@
 #include <rawrbox/scripting/wrappers/math/vector2.hpp>
 #include <rawrbox/scripting/wrappers/math/vector3.hpp>
 #include <rawrbox/scripting/wrappers/math/vector4.hpp>
+#include <rawrbox/scripting/wrappers/messages.hpp>
 #include <rawrbox/scripting/wrappers/mod.hpp>
 #include <rawrbox/scripting/wrappers/timer.hpp>
 #include <rawrbox/utils/i18n.hpp>
@@ -25,6 +27,9 @@
 #include <fmt/format.h>
 #include <fmt/ranges.h>
 
+#include <algorithm>
+#include <iterator>
+
 /*⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀
 ⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⢀⣀⣠⣤⣤⣤⣄⣀⡀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀
 ⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⢀⣤⣶⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣷⣤⣀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀
@@ -62,6 +67,20 @@ namespace rawrbox {
 	// PROTECTED ----
 	std::unordered_map<std::string, std::unique_ptr<rawrbox::Mod>> SCRIPTING::_mods = {};
 	std::unordered_map<std::string, std::vector<std::filesystem::path>> SCRIPTING::_loadedLuaFiles = {};
+	std::mutex SCRIPTING::_workerFilesMutex = {};
+	std::vector<std::pair<std::string, std::filesystem::path>> SCRIPTING::_workerFiles = {};
+
+	std::deque<SCRIPTING::HookSubscribers> SCRIPTING::_subscribers = {};
+	uint32_t SCRIPTING::_dispatchDepth = 0;
+	std::vector<std::string> SCRIPTING::_pendingUnloads = {};
+
+	std::vector<rawrbox::Mod*> SCRIPTING::_ordered = {};
+	std::vector<rawrbox::Mod*> SCRIPTING::_stepMods = {};
+	std::vector<rawrbox::Mod*> SCRIPTING::_threadedStep = {};
+	std::vector<rawrbox::Mod*> SCRIPTING::_serialStep = {};
+
+	std::vector<rawrbox::ModMessage> SCRIPTING::_engineOutbox = {};
+	uint64_t SCRIPTING::_engineMessages = 0;
 
 	std::unique_ptr<rawrbox::FileWatcher> SCRIPTING::_watcher = nullptr;
 	std::vector<std::unique_ptr<rawrbox::ScriptingPlugin>> SCRIPTING::_plugins = {};
@@ -72,6 +91,16 @@ namespace rawrbox {
 
 	rawrbox::Console* SCRIPTING::_console = nullptr;
 	bool SCRIPTING::_hotReloadEnabled = false;
+	bool SCRIPTING::_diskBytecodeCache = false;
+#ifdef RAWRBOX_SCRIPTING_NATIVE
+	rawrbox::LuaNativeMode SCRIPTING::_nativeMode = rawrbox::LuaNativeMode::ANNOTATED;
+#else
+	rawrbox::LuaNativeMode SCRIPTING::_nativeMode = rawrbox::LuaNativeMode::OFF; // No codegen compiled in, don't try per mod
+#endif
+
+	float SCRIPTING::_budgetMs = 0.F;
+	rawrbox::ModBudgetAction SCRIPTING::_budgetAction = rawrbox::ModBudgetAction::ABORT;
+	size_t SCRIPTING::_memoryLimit = 0;
 	// --------------
 
 	// PUBLIC ----
@@ -80,6 +109,7 @@ namespace rawrbox {
 	rawrbox::Event<rawrbox::Mod&> SCRIPTING::onLoadLibraries;
 	rawrbox::Event<rawrbox::Mod&> SCRIPTING::onLoadModifiers;
 	rawrbox::Event<rawrbox::Mod&> SCRIPTING::onModHotReload;
+	rawrbox::Event<const rawrbox::ModMessage&> SCRIPTING::onMessage;
 
 	bool SCRIPTING::initialized = false;
 	// ------
@@ -129,6 +159,7 @@ namespace rawrbox {
 		rawrbox::TimerWrapper::registerLua(L);
 		rawrbox::I18NWrapper::registerLua(L);
 		rawrbox::MODWrapper::registerLua(L);
+		rawrbox::MessagesWrapper::registerLua(L);
 
 #ifdef RAWRBOX_SCRIPTING_UNSAFE
 		rawrbox::IOWrapper::registerLua(L); // TODO: Might have security vulnerabilities
@@ -152,9 +183,11 @@ namespace rawrbox {
 		rawrbox::MatrixWrapper::registerLua(L);
 		// -------------
 
-		// Register plugins types ---
-		for (auto& p : _plugins)
-			p->registerTypes(L);
+		// Register plugins types, engine side and main thread only so threaded mods don't get them ---
+		if (!mod.isThreaded()) {
+			for (auto& p : _plugins)
+				p->registerTypes(L);
+		}
 		//  -----
 
 		// Custom ----
@@ -192,10 +225,24 @@ namespace rawrbox {
 
 			    auto fixedPath = LuaUtils::getContent(path, modFolder);
 			    if (!fixedPath.first.empty()) throw std::runtime_error("External mod lua loading not supported");
-			    rawrbox::LuaUtils::compileAndLoadFile(state, modID, fixedPath.second);
 
-			    // Register file for hot-reloading
-			    registerLoadedFile(modID, fixedPath.second);
+			    auto* mod = rawrbox::Mod::fromState(state);
+			    try {
+				    rawrbox::LuaUtils::compileAndLoadFile(state, modID, fixedPath.second);
+			    } catch (...) {
+				    if (mod != nullptr) mod->invalidateHooks(); // It may have got halfway
+				    throw;
+			    }
+
+			    if (mod != nullptr) mod->invalidateHooks();
+
+			    // Register file for hot-reloading, threaded mods leave it to endStep so workers don't race on the list / watcher
+			    if (rawrbox::Mod::onWorker()) {
+				    std::scoped_lock lock(_workerFilesMutex);
+				    _workerFiles.emplace_back(modID, fixedPath.second);
+			    } else {
+				    registerLoadedFile(modID, fixedPath.second);
+			    }
 			    // ----
 		    });
 		// ---------
@@ -220,6 +267,10 @@ namespace rawrbox {
 
 			    return rawrbox::MODWrapper(fnd->second.get());
 		    })
+		    .addFunction("invalidateHooks", [](lua_State* state) {
+			    auto* mod = rawrbox::Mod::fromState(state);
+			    if (mod != nullptr) mod->invalidateHooks();
+		    })
 		    .endNamespace();
 		// ----------
 
@@ -249,9 +300,11 @@ namespace rawrbox {
 		    .endNamespace();
 		// -------------
 
-		// Register plugins globals ---
-		for (auto& p : _plugins)
-			p->registerGlobal(L);
+		// Register plugins globals, same as the types ---
+		if (!mod.isThreaded()) {
+			for (auto& p : _plugins)
+				p->registerGlobal(L);
+		}
 		//  -----
 
 		// Custom ----
@@ -268,6 +321,15 @@ namespace rawrbox {
 		onLoadModifiers(mod);
 		// -------------
 	}
+
+	void SCRIPTING::removePlugins(rawrbox::Mod& mod) {
+		auto* L = mod.getEnvironment();
+		if (L == nullptr) return;
+
+		for (auto& p : _plugins) {
+			p->removeState(L);
+		}
+	}
 	// -------------
 
 	// MOD LOAD ---
@@ -310,7 +372,7 @@ namespace rawrbox {
 
 			// Cleanup and load -----
 			auto* env = md->second->getEnvironment();
-			md->second->gc(); // Cleanup
+			md->second->gcStep(1.F); // Cleanup, the rest is left to the incremental collector
 
 			try {
 				rawrbox::LuaUtils::compileAndLoadFile(env, md->first, filePath);
@@ -319,6 +381,7 @@ namespace rawrbox {
 			}
 			// ---------------
 
+			md->second->invalidateHooks(); // Re-resolve everything on the next dispatch
 			onModHotReload(*md->second);
 			break;
 		};
@@ -326,8 +389,10 @@ namespace rawrbox {
 	// -------------
 	// ----------
 
-	void SCRIPTING::init(int hotReloadMs) {
+	void SCRIPTING::init(int hotReloadMs, bool diskBytecodeCache) {
 		_hotReloadEnabled = hotReloadMs > 0;
+		_diskBytecodeCache = diskBytecodeCache;
+
 		if (_hotReloadEnabled) {
 			_logger->info("Enabled lua hot-reloading\n  └── Delay: {}ms", fmt::styled(hotReloadMs, fmt::fg(fmt::color::gold)));
 
@@ -341,7 +406,15 @@ namespace rawrbox {
 		}
 
 		// Setup  --
-		if (_console != nullptr) rawrbox::ConsoleWrapper::init(_console);
+		if (_console != nullptr) {
+			rawrbox::ConsoleWrapper::init(_console);
+			_console->registerCommand(
+			    "scripting_stats", [](const std::vector<std::string>& /*args*/) {
+				    _console->print(getStatsReport(), rawrbox::PrintType::LOG);
+				    return std::make_pair<bool, std::string>(true, "");
+			    },
+			    "Prints lua time, memory and gc usage per mod", rawrbox::ConsoleFlags::DEVELOPER);
+		}
 		// ----------------
 	}
 
@@ -349,6 +422,15 @@ namespace rawrbox {
 	std::unordered_map<std::filesystem::path, rawrbox::Mod*> SCRIPTING::loadMods(const std::filesystem::path& rootFolder) { // Load mods
 		if (!std::filesystem::exists(rootFolder)) RAWRBOX_CRITICAL("Failed to locate root folder '{}'", rootFolder.generic_string());
 
+		// Beside the mods, not inside, or it would load as a mod ---
+		if (_diskBytecodeCache && rawrbox::LuaBytecodeCache::getFolder().empty()) {
+			auto root = rootFolder.lexically_normal();
+			if (!root.has_filename()) root = root.parent_path(); // mods/ -> mods
+
+			rawrbox::LuaBytecodeCache::setFolder(root.parent_path() / ".luau");
+		}
+		// ----------
+
 		std::unordered_map<std::filesystem::path, rawrbox::Mod*> success = {};
 		for (const auto& p : std::filesystem::directory_iterator(rootFolder)) {
 			if (!p.is_directory()) continue;
@@ -362,6 +444,7 @@ namespace rawrbox {
 
 	rawrbox::Mod* SCRIPTING::loadMod(const std::string& id, const std::filesystem::path& modFolder) {
 		if (id.empty()) RAWRBOX_CRITICAL("Mod ID cannot be empty");
+		if (id == ENGINE_ID || id == BROADCAST_ID) RAWRBOX_CRITICAL("Mod ID '{}' is reserved", id);
 		if (!std::filesystem::exists(modFolder)) RAWRBOX_CRITICAL("Failed to locate mod folder '{}'", modFolder.generic_string());
 
 		if (_mods.find(id) != _mods.end()) {
@@ -379,7 +462,22 @@ namespace rawrbox {
 		}
 		// -----------------
 
+		// NATIVE ---
+		// "native": true / false in mod.json overrides the default for the whole mod
+		auto native = _nativeMode;
+		if (metadataJSON.contains("native") && metadataJSON["native"].holds<bool>()) {
+			native = metadataJSON["native"].get<bool>() ? rawrbox::LuaNativeMode::ALL : rawrbox::LuaNativeMode::OFF;
+		}
+		// -----------------
+
 		auto mod = std::make_unique<rawrbox::Mod>(id, modFolder, metadataJSON);
+		mod->setThreaded(metadataJSON.contains("threaded") && metadataJSON["threaded"].holds<bool>() && metadataJSON["threaded"].get<bool>());
+		mod->setBudget(_budgetMs, _budgetAction);
+		mod->setMemoryLimit(_memoryLimit);
+
+		if (native != rawrbox::LuaNativeMode::OFF && !rawrbox::LuaUtils::enableNative(mod->getEnvironment(), native)) {
+			_logger->debug("Native code unavailable for '{}', running interpreted", id);
+		}
 
 		// Prepare env ----------
 		loadLibraries(*mod);
@@ -399,11 +497,15 @@ namespace rawrbox {
 			registerLoadedFile(mod->getID(), mod->getEntryFilePath()); // Register file for hot-reloading
 		} catch (const std::runtime_error& err) {
 			_logger->error("{}", err.what());
+
+			removePlugins(*mod); // onInit can get far enough to hand out callbacks
 			return nullptr;
 		}
 
 		rawrbox::Mod* modPtr = mod.get();
 		_mods.emplace(id, std::move(mod));
+		modPtr->invalidateHooks(); // Now part of _mods, dispatch lists need it
+		sortMods();
 
 		return modPtr;
 	}
@@ -416,6 +518,11 @@ namespace rawrbox {
 		auto fnd = _mods.find(modId);
 		if (fnd == _mods.end()) return false;
 
+		if (_dispatchDepth > 0) {
+			if (std::find(_pendingUnloads.begin(), _pendingUnloads.end(), modId) == _pendingUnloads.end()) _pendingUnloads.push_back(modId);
+			return true;
+		}
+
 		auto fndLua = _loadedLuaFiles.find(modId);
 		if (fndLua != _loadedLuaFiles.end()) {
 			if (_watcher != nullptr) {
@@ -428,7 +535,10 @@ namespace rawrbox {
 		}
 
 		fnd->second->shutdown();
+		removePlugins(*fnd->second);
+
 		_mods.erase(fnd);
+		sortMods();
 
 		_logger->info("Mod '{}' unloaded", fmt::styled(modId, fmt::fg(fmt::color::coral)));
 		return true;
@@ -439,6 +549,7 @@ namespace rawrbox {
 		// Shutdown mods ---
 		for (auto& mod : _mods) {
 			mod.second->shutdown();
+			removePlugins(*mod.second);
 		}
 		// ----------------
 
@@ -447,11 +558,186 @@ namespace rawrbox {
 
 		_loadedLuaFiles.clear();
 		_mods.clear();
+		_subscribers.clear();
+		_pendingUnloads.clear();
+		_workerFiles.clear();
 		_plugins.clear();
+
+		_ordered.clear();
+		_stepMods.clear();
+		_threadedStep.clear();
+		_serialStep.clear();
+		_engineOutbox.clear();
+		_engineMessages = 0;
+
+		rawrbox::LuaBytecodeCache::clear();
 	}
 
 	void SCRIPTING::setConsole(rawrbox::Console* console) { _console = console; }
 
+	// HOOKS ---
+	const std::vector<rawrbox::Mod*>& SCRIPTING::getSubscribers(const rawrbox::HookID& hook) {
+		if (!hook.valid()) RAWRBOX_CRITICAL("Invalid hook id");
+		if (hook.index() >= _subscribers.size()) _subscribers.resize(hook.index() + 1);
+
+		auto& subs = _subscribers[hook.index()];
+
+		auto version = rawrbox::Mod::getHooksVersion();
+		if (subs.version != version) {
+			subs.version = version;
+			subs.mods.clear();
+
+			for (auto& mod : _mods) {
+				if (mod.second->implements(hook)) subs.mods.push_back(mod.second.get());
+			}
+		}
+
+		return subs.mods;
+	}
+
+	void SCRIPTING::flushUnloads() {
+		std::vector<std::string> pending = {};
+		pending.swap(_pendingUnloads);
+
+		for (const auto& id : pending) {
+			try {
+				unloadMod(id);
+			} catch (const std::exception& err) {
+				_logger->error("Failed to unload mod '{}'\n  └── {}", id, err.what());
+			}
+		}
+	}
+
+	bool SCRIPTING::isUnloading(const rawrbox::Mod* mod) {
+		if (_pendingUnloads.empty()) return false;
+		return std::find(_pendingUnloads.begin(), _pendingUnloads.end(), mod->getID()) != _pendingUnloads.end();
+	}
+	// ---------
+
+	// STEP ---
+	void SCRIPTING::sortMods() {
+		_ordered.clear();
+		_ordered.reserve(_mods.size());
+
+		for (auto& mod : _mods) {
+			_ordered.push_back(mod.second.get());
+		}
+
+		// _mods is unordered, its iteration order isn't something a test (or a replay) can rely on
+		std::sort(_ordered.begin(), _ordered.end(), [](const rawrbox::Mod* a, const rawrbox::Mod* b) { return a->getID() < b->getID(); });
+	}
+
+	void SCRIPTING::beginStep(const std::vector<rawrbox::Mod*>& mods) {
+		auto byId = [](const rawrbox::Mod* a, const rawrbox::Mod* b) { return a->getID() < b->getID(); };
+
+		_stepMods = mods; // Copy, hooks can load mods mid-step
+		if (!std::is_sorted(_stepMods.begin(), _stepMods.end(), byId)) std::sort(_stepMods.begin(), _stepMods.end(), byId);
+
+		_threadedStep.clear();
+		_serialStep.clear();
+
+		for (auto* mod : _stepMods) {
+			if (mod->isThreaded()) {
+				_threadedStep.push_back(mod);
+			} else {
+				_serialStep.push_back(mod);
+			}
+		}
+	}
+
+	void SCRIPTING::endStep() {
+		// Workers are done, safe to register what they included
+		std::vector<std::pair<std::string, std::filesystem::path>> files = {};
+		{
+			std::scoped_lock lock(_workerFilesMutex);
+			files.swap(_workerFiles);
+		}
+
+		for (const auto& [modId, path] : files) {
+			if (_mods.contains(modId)) registerLoadedFile(modId, path);
+		}
+
+		// Engine first, then mods by id, each in the order it sent them
+		std::vector<rawrbox::ModMessage> messages = {};
+		messages.swap(_engineOutbox);
+
+		for (auto* mod : _stepMods) {
+			auto outbox = mod->takeOutbox();
+			std::move(outbox.begin(), outbox.end(), std::back_inserter(messages));
+		}
+
+		for (auto& msg : messages) {
+			if (msg.to == ENGINE_ID) {
+				onMessage(msg);
+				continue;
+			}
+
+			if (msg.to == BROADCAST_ID) {
+				for (auto* mod : _stepMods) {
+					if (mod->getID() != msg.from) mod->receive(msg);
+				}
+
+				continue;
+			}
+
+			auto target = std::lower_bound(_stepMods.begin(), _stepMods.end(), msg.to, [](const rawrbox::Mod* mod, const std::string& id) { return mod->getID() < id; });
+			if (target == _stepMods.end() || (*target)->getID() != msg.to) {
+				_logger->warn("Dropped message '{}' from '{}', mod '{}' is not loaded", msg.topic, msg.from, msg.to);
+				continue;
+			}
+
+			(*target)->receive(std::move(msg));
+		}
+	}
+
+	void SCRIPTING::send(const std::string& to, const std::string& topic, glz::generic payload) {
+		if (to.empty()) throw std::runtime_error("Invalid message target");
+		if (topic.empty()) throw std::runtime_error("Invalid message topic");
+
+		_engineOutbox.push_back({ENGINE_ID, to, topic, std::move(payload), _engineMessages++});
+	}
+	// ---------
+
+	void SCRIPTING::setNativeMode(rawrbox::LuaNativeMode mode) { _nativeMode = mode; }
+
+	// BUDGET ---
+	void SCRIPTING::setModBudget(float ms, rawrbox::ModBudgetAction action) {
+		_budgetMs = ms;
+		_budgetAction = action;
+	}
+
+	void SCRIPTING::setModMemoryLimit(size_t bytes) { _memoryLimit = bytes; }
+
+	void SCRIPTING::gcStep(float budgetMs) {
+		if (_mods.empty()) return;
+
+		auto perMod = budgetMs / static_cast<float>(_mods.size());
+		for (auto& mod : _mods) {
+			mod.second->gcStep(perMod);
+		}
+	}
+
+	std::string SCRIPTING::getStatsReport() {
+		std::string report = {};
+
+		for (auto& mod : _mods) {
+			auto stats = mod.second->getStats();
+
+			report += fmt::format("[#1abc9c]{}[/] ── {:.1f}KB (peak {:.1f}KB, {} allocs) ── gc {:.2f}ms total, {:.2f}ms max ── {} overruns{}\n",
+			    mod.first,
+			    static_cast<double>(stats.memory.bytes) / 1024.0, static_cast<double>(stats.memory.peakBytes) / 1024.0, stats.memory.allocations,
+			    static_cast<double>(stats.gcNs) / 1e6, static_cast<double>(stats.gcMaxNs) / 1e6,
+			    stats.budgetOverruns, mod.second->isPaused() ? " [PAUSED]" : "");
+
+			for (const auto& [name, hook] : mod.second->getHooksStats()) {
+				report += fmt::format("  └── {}: {} calls, {:.3f}ms avg, {:.3f}ms max\n", name, hook.calls, hook.avgMs(), static_cast<double>(hook.maxNs) / 1e6);
+			}
+		}
+
+		return report;
+	}
+	// ---------
+
 	// UTILS ----
 	bool SCRIPTING::hasMod(const std::string& id) {
 		return _mods.contains(id);
@@ -476,6 +762,7 @@ namespace rawrbox {
 	}
 
 	bool SCRIPTING::hotReloadEnabled() { return _hotReloadEnabled; }
+	rawrbox::LuaNativeMode SCRIPTING::getNativeMode() { return _nativeMode; }
 	bool SCRIPTING::isLuaFileMounted(const std::string& path) {
 		for (auto& pt : _loadedLuaFiles) {
 			auto fnd = std::find(pt.second.begin(), pt.second.end(), path) != pt.second.end();
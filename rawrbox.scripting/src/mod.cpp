@@ -1,14 +1,270 @@
 
 #include <rawrbox/scripting/mod.hpp>
+#include <rawrbox/scripting/wrappers/console.hpp>
+#include <rawrbox/scripting/wrappers/hooks.hpp>
+#include <rawrbox/scripting/wrappers/timer.hpp>
 #include <rawrbox/utils/path.hpp>
 
+#include <algorithm>
+#include <cstdlib>
+
 namespace rawrbox {
-	Mod::Mod(std::string id, std::filesystem::path folderPath, glz::generic metadata) : _L(luaL_newstate()), _modTable(_L), _folder(std::move(folderPath)), _id(std::move(id)), _metadata(std::move(metadata)) {}
+	namespace {
+		thread_local bool WORKER = false;
+	} // namespace
+
+	// PROTECTED ----
+	std::atomic<uint32_t> Mod::_hooksVersion = 1;
+	// --------------
+
+	Mod::Mod(std::string id, std::filesystem::path folderPath, glz::generic metadata) : _L(lua_newstate(&Mod::allocate, &this->_memory)), _folder(std::move(folderPath)), _id(std::move(id)), _metadata(std::move(metadata)) {
+		lua_callbacks(this->_L)->userdata = this;
+	}
 	Mod::~Mod() {
-		this->gc();
+		_hooksVersion++; // Drop it from dispatch lists
+		if (this->_L == nullptr) return;
+
+		// Anything still holding a ref into the state goes first, SCRIPTING already had the plugins drop theirs
+		rawrbox::Hooks::removeState(this->_L);
+		rawrbox::TimerWrapper::removeState(this->_L);
+		rawrbox::ConsoleWrapper::removeState(this->_L);
+
+		this->_hookSlots.clear();
+		this->_modTable.reset();
+
+		// Finalizers can still run lua, nothing should find this mod from it
+		auto* callbacks = lua_callbacks(this->_L);
+		callbacks->userdata = nullptr;
+		callbacks->interrupt = nullptr;
+
+		lua_close(this->_L);
 		this->_L = nullptr;
 	}
 
+	// HOOKS ---
+	Mod::HookSlot& Mod::resolve(const rawrbox::HookID& hook) {
+		if (!hook.valid()) throw std::runtime_error("Invalid hook id");
+		if (hook.index() >= this->_hookSlots.size()) this->_hookSlots.resize(hook.index() + 1);
+
+		auto& slot = this->_hookSlots[hook.index()];
+		if (slot.generation == this->_hookGeneration && slot.func.has_value() && !this->isCurrent(slot)) this->invalidateHooks();
+
+		if (slot.generation != this->_hookGeneration) {
+			slot.hook = hook;
+			slot.generation = this->_hookGeneration;
+			slot.func.reset();
+
+			if (this->_modTable.has_value() && this->_modTable->isTable()) {
+				luabridge::LuaRef fnc = (*this->_modTable)[hook.name()];
+				if (fnc.isCallable()) slot.func = fnc;
+			}
+		}
+
+		return slot;
+	}
+
+	bool Mod::isCurrent(const HookSlot& slot) const {
+		// MOD.x = nil and replacing an existing key skip __newindex, compare with what MOD holds now
+		this->_modTable->push(this->_L);
+		lua_rawgetfield(this->_L, -1, slot.hook.name().c_str());
+		slot.func->push(this->_L);
+
+		bool current = lua_rawequal(this->_L, -1, -2) != 0;
+		lua_pop(this->_L, 3);
+
+		return current;
+	}
+
+	int Mod::onNewIndex(lua_State* L) {
+		// MOD, key, value. Data never becomes a hook, skip the re-resolve for it
+		if (lua_isfunction(L, 3) || lua_istable(L, 3) || lua_isuserdata(L, 3)) {
+			auto* mod = fromState(L);
+			if (mod != nullptr) mod->invalidateHooks();
+		}
+
+		lua_rawset(L, 1);
+		return 0;
+	}
+
+	bool Mod::implements(const rawrbox::HookID& hook) { return this->resolve(hook).func.has_value(); }
+
+	void Mod::invalidateHooks() {
+		this->_hookGeneration++;
+		_hooksVersion++;
+	}
+
+	uint32_t Mod::getHooksVersion() { return _hooksVersion.load(); }
+	// ---------
+
+	// BUDGET ---
+	void* Mod::allocate(void* ud, void* ptr, size_t osize, size_t nsize) {
+		auto* memory = static_cast<rawrbox::ModMemoryStats*>(ud);
+		if (ptr == nullptr) osize = 0;
+
+		if (nsize == 0) {
+			std::free(ptr); // NOLINT(cppcoreguidelines-no-malloc)
+			memory->bytes -= osize;
+			return nullptr;
+		}
+
+		// Shrinks never fail, lua expects that
+		if (memory->limit > 0 && nsize > osize && memory->bytes + (nsize - osize) > memory->limit) {
+			memory->failed++;
+			return nullptr;
+		}
+
+		auto* out = std::realloc(ptr, nsize); // NOLINT(cppcoreguidelines-no-malloc)
+		if (out == nullptr) {
+			memory->failed++;
+			return nullptr;
+		}
+
+		memory->bytes = memory->bytes - osize + nsize;
+		memory->peakBytes = std::max(memory->peakBytes, memory->bytes);
+
+		if (nsize > osize) {
+			memory->allocations++;
+			memory->allocatedBytes += nsize - osize;
+		}
+
+		return out;
+	}
+
+	void Mod::onInterrupt(lua_State* L, int gc) {
+		if (gc >= 0) return; // GC safepoint, not script code
+
+		auto* mod = fromState(L);
+		if (mod == nullptr || mod->_callDepth == 0) return;
+		if ((++mod->_interruptTicks & 0xFF) != 0) return; // Read the clock every 256 safepoints
+		if (std::chrono::steady_clock::now() < mod->_deadline) return;
+
+		mod->_stats.budgetOverruns++;
+		if (mod->_budgetAction == rawrbox::ModBudgetAction::PAUSE) mod->_paused = true;
+
+		luaL_error(L, "exceeded its %.2fms time budget", std::chrono::duration<double, std::milli>(mod->_budget).count());
+	}
+
+	std::chrono::steady_clock::time_point Mod::beginCall() {
+		auto now = std::chrono::steady_clock::now();
+		if (this->_callDepth++ == 0 && this->_budget.count() > 0) this->_deadline = now + this->_budget;
+
+		return now;
+	}
+
+	void Mod::endCall(HookSlot& slot, std::chrono::steady_clock::time_point start) {
+		this->_callDepth--;
+
+		auto ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+
+		auto& stats = slot.stats;
+		stats.calls++;
+		stats.totalNs += ns;
+		stats.lastNs = ns;
+		stats.maxNs = std::max(stats.maxNs, ns);
+	}
+
+	void Mod::setBudget(float ms, rawrbox::ModBudgetAction action) {
+		if (this->_L == nullptr) RAWRBOX_CRITICAL("Invalid lua handle");
+
+		this->_budget = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<float, std::milli>(std::max(ms, 0.F)));
+		this->_budgetAction = action;
+
+		// No interrupt at all when off, it runs on every safepoint
+		lua_callbacks(this->_L)->interrupt = this->_budget.count() > 0 ? &Mod::onInterrupt : nullptr;
+	}
+
+	void Mod::setMemoryLimit(size_t bytes) { this->_memory.limit = bytes; }
+
+	bool Mod::isPaused() const { return this->_paused; }
+	void Mod::resume() { this->_paused = false; }
+	// ---------
+
+	// THREADING ---
+	void Mod::setThreaded(bool threaded) {
+		if (this->_modTable.has_value()) RAWRBOX_CRITICAL("setThreaded has to be called before init, the mod's globals depend on it");
+		this->_threaded = threaded;
+	}
+	bool Mod::isThreaded() const { return this->_threaded; }
+
+	void Mod::send(const std::string& to, const std::string& topic, glz::generic payload) {
+		if (to.empty()) throw std::runtime_error("Invalid message target");
+		if (topic.empty()) throw std::runtime_error("Invalid message topic");
+
+		this->_outbox.push_back({this->_id, to, topic, std::move(payload), this->_sentMessages++});
+	}
+
+	void Mod::receive(rawrbox::ModMessage message) { this->_inbox.push_back(std::move(message)); }
+
+	std::vector<rawrbox::ModMessage> Mod::takeOutbox() {
+		std::vector<rawrbox::ModMessage> out = {};
+		out.swap(this->_outbox);
+
+		return out;
+	}
+
+	size_t Mod::deliverMessages() {
+		static const rawrbox::HookID HOOK_MESSAGE("onMessage");
+		if (this->_paused || this->_inbox.empty()) return 0; // Paused mods keep them until resume()
+
+		// Swap first, onMessage can send but never receives mid delivery
+		std::vector<rawrbox::ModMessage> inbox = {};
+		inbox.swap(this->_inbox);
+
+		if (!this->implements(HOOK_MESSAGE)) return 0;
+		for (auto& msg : inbox) {
+			this->call(HOOK_MESSAGE, msg.from, msg.topic, rawrbox::LuaUtils::jsonToLua(this->_L, msg.payload));
+		}
+
+		return inbox.size();
+	}
+
+	size_t Mod::pendingMessages() const { return this->_inbox.size(); }
+
+	rawrbox::Mod* Mod::fromState(lua_State* L) {
+		if (L == nullptr) return nullptr;
+		return static_cast<rawrbox::Mod*>(lua_callbacks(L)->userdata);
+	}
+
+	bool Mod::onWorker() { return WORKER; }
+	void Mod::setWorker(bool worker) { WORKER = worker; }
+	// ---------
+
+	// STATS ---
+	rawrbox::ModStats Mod::getStats() const {
+		auto stats = this->_stats;
+		stats.memory = this->_memory;
+
+		return stats;
+	}
+
+	rawrbox::ModHookStats Mod::getHookStats(const rawrbox::HookID& hook) const {
+		if (!hook.valid() || hook.index() >= this->_hookSlots.size()) return {};
+		return this->_hookSlots[hook.index()].stats;
+	}
+
+	std::vector<std::pair<std::string, rawrbox::ModHookStats>> Mod::getHooksStats() const {
+		std::vector<std::pair<std::string, rawrbox::ModHookStats>> hooks = {};
+		for (const auto& slot : this->_hookSlots) {
+			if (slot.stats.calls == 0) continue;
+			hooks.emplace_back(slot.hook.name(), slot.stats);
+		}
+
+		return hooks;
+	}
+
+	void Mod::resetStats() {
+		this->_stats = {};
+		for (auto& slot : this->_hookSlots) {
+			slot.stats = {};
+		}
+
+		this->_memory.peakBytes = this->_memory.bytes;
+		this->_memory.allocations = 0;
+		this->_memory.allocatedBytes = 0;
+		this->_memory.failed = 0;
+	}
+	// ---------
+
 	void Mod::shutdown() {
 		if (this->_L == nullptr) RAWRBOX_CRITICAL("Invalid lua handle");
 		this->call("onShutdown");
@@ -41,23 +297,86 @@ namespace rawrbox {
 
 		// Initialize mod table, this can be modified ---
 		this->_modTable = luabridge::newTable(this->_L);
-		luabridge::setGlobal(this->_L, this->_modTable, "MOD");
+		this->invalidateHooks();
+
+		// New keys can be hooks, existing ones are checked on call
+		this->_modTable->push(this->_L);
+		lua_newtable(this->_L);
+		lua_pushcfunction(this->_L, &Mod::onNewIndex, "MOD.__newindex");
+		lua_setfield(this->_L, -2, "__newindex");
+		lua_setmetatable(this->_L, -2);
+		lua_pop(this->_L, 1);
+
+		luabridge::setGlobal(this->_L, *this->_modTable, "MOD");
 		//  --------------------
 	}
 
 	void Mod::gc() {
 		if (this->_L == nullptr) RAWRBOX_CRITICAL("Invalid lua handle");
+
+		auto start = std::chrono::steady_clock::now();
 		rawrbox::LuaUtils::collect_garbage(this->_L);
+
+		this->recordGC(start);
+	}
+
+	void Mod::recordGC(std::chrono::steady_clock::time_point start) {
+		auto ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+
+		this->_stats.gcSteps++;
+		this->_stats.gcNs += ns;
+		this->_stats.gcMaxNs = std::max(this->_stats.gcMaxNs, ns);
+	}
+
+	bool Mod::gcStep(float budgetMs) {
+		if (this->_L == nullptr) RAWRBOX_CRITICAL("Invalid lua handle");
+
+		auto start = std::chrono::steady_clock::now();
+		auto end = start + std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<float, std::milli>(budgetMs));
+
+		// At least one step, a 0 budget still makes progress
+		bool finished = false;
+		do {
+			finished = lua_gc(this->_L, LUA_GCSTEP, 0) == 1;
+		} while (!finished && std::chrono::steady_clock::now() < end);
+
+		this->recordGC(start);
+
+		return finished;
+	}
+
+	void Mod::setGCTuning(int goal, int stepMul, int stepSizeKB) {
+		if (this->_L == nullptr) RAWRBOX_CRITICAL("Invalid lua handle");
+
+		lua_gc(this->_L, LUA_GCSETGOAL, goal);       // Heap % to reach before a new cycle starts
+		lua_gc(this->_L, LUA_GCSETSTEPMUL, stepMul); // Work per step, relative to allocation
+		lua_gc(this->_L, LUA_GCSETSTEPSIZE, stepSizeKB);
 	}
 
 	void Mod::load() {
 		if (this->_L == nullptr) RAWRBOX_CRITICAL("Invalid lua sandbox environment");
-		rawrbox::LuaUtils::compileAndLoadFile(this->_L, this->getID(), this->getEntryFilePath());
+
+		try {
+			rawrbox::LuaUtils::compileAndLoadFile(this->_L, this->getID(), this->getEntryFilePath());
+		} catch (...) {
+			this->invalidateHooks(); // It may have got halfway
+			throw;
+		}
+
+		this->invalidateHooks();
 	}
 
 	void Mod::script(const std::string& script) {
 		if (this->_L == nullptr) RAWRBOX_CRITICAL("Invalid lua sandbox environment");
-		rawrbox::LuaUtils::compileAndLoadScript(this->_L, "unknown", script);
+
+		try {
+			rawrbox::LuaUtils::compileAndLoadScript(this->_L, "unknown", script);
+		} catch (...) {
+			this->invalidateHooks(); // It may have got halfway
+			throw;
+		}
+
+		this->invalidateHooks();
 	}
 
 	// UTILS ----
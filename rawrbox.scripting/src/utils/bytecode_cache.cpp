@@ -0,0 +1,184 @@
+#include <rawrbox/scripting/utils/bytecode_cache.hpp>
+#include <rawrbox/utils/file.hpp>
+
+#include <Luau/Bytecode.h>
+
+#include <fmt/format.h>
+
+#include <array>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace rawrbox {
+	namespace {
+		constexpr uint32_t CACHE_MAGIC = 0x32424C52; // RLB2, RLBC entries only had the source size
+
+		struct CacheHeader {
+			uint32_t magic = CACHE_MAGIC;
+			uint32_t version = LBC_VERSION_MAX;
+			uint64_t key = 0;
+			rawrbox::SHA256Digest source = {};
+		};
+
+		std::filesystem::path getPath(const std::filesystem::path& folder, uint64_t key) { return folder / fmt::format("{:016x}.luac", key); }
+
+		// Nullopt if missing, too small or from another cache version
+		std::optional<CacheHeader> readHeader(const std::vector<uint8_t>& data) {
+			if (data.size() <= sizeof(CacheHeader) + 1) return std::nullopt; // getRawData appends a \0
+
+			CacheHeader header = {};
+			std::memcpy(&header, data.data(), sizeof(CacheHeader));
+			if (header.magic != CACHE_MAGIC || header.version != LBC_VERSION_MAX) return std::nullopt;
+
+			return header;
+		}
+
+		// FNV-1a, stable between runs and compilers so disk entries stay valid
+		uint64_t fnv1a(const void* data, size_t size, uint64_t seed = 0xcbf29ce484222325ULL) {
+			const auto* bytes = static_cast<const uint8_t*>(data);
+			for (size_t i = 0; i < size; i++) {
+				seed ^= bytes[i];
+				seed *= 0x100000001b3ULL;
+			}
+
+			return seed;
+		}
+	} // namespace
+
+	// PROTECTED ----
+	std::unordered_map<uint64_t, LuaBytecodeCache::Entry> LuaBytecodeCache::_entries = {};
+	std::shared_mutex LuaBytecodeCache::_mutex = {};
+
+	std::filesystem::path LuaBytecodeCache::_folder = "";
+	std::atomic<size_t> LuaBytecodeCache::_compiles = 0;
+	std::atomic<size_t> LuaBytecodeCache::_memoryHits = 0;
+	std::atomic<size_t> LuaBytecodeCache::_diskHits = 0;
+	// --------------
+
+	// DISK ----
+	std::shared_ptr<const std::string> LuaBytecodeCache::loadDisk(const std::filesystem::path& folder, uint64_t key, const rawrbox::SHA256Digest& source) {
+		if (folder.empty()) return nullptr;
+
+		auto data = rawrbox::FileUtils::getRawData(getPath(folder, key));
+
+		auto header = readHeader(data);
+		if (!header.has_value() || header->key != key || header->source != source) return nullptr;
+
+		auto bytecode = std::make_shared<std::string>(data.begin() + sizeof(CacheHeader), data.end() - 1);
+		if (bytecode->front() == '\0') return nullptr; // Error chunk, never written but don't trust the disk
+
+		return bytecode;
+	}
+
+	void LuaBytecodeCache::saveDisk(const std::filesystem::path& folder, uint64_t key, const rawrbox::SHA256Digest& source, const std::string& bytecode) {
+		if (folder.empty()) return;
+
+		auto path = getPath(folder, key);
+
+		// Another source owns this key, keep it. Old versions and broken files get replaced
+		auto existing = readHeader(rawrbox::FileUtils::getRawData(path));
+		if (existing.has_value() && existing->key == key && existing->source != source) return;
+
+		CacheHeader header = {};
+		header.key = key;
+		header.source = source;
+
+		std::vector<uint8_t> data(sizeof(CacheHeader) + bytecode.size());
+		std::memcpy(data.data(), &header, sizeof(CacheHeader));
+		std::memcpy(data.data() + sizeof(CacheHeader), bytecode.data(), bytecode.size());
+
+		// Write aside and swap in, another process can be reading the same entry
+		auto tmpPath = path;
+		tmpPath += fmt::format(".{}", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+		if (!rawrbox::FileUtils::saveData(tmpPath, data)) return;
+
+		std::error_code ec;
+		std::filesystem::rename(tmpPath, path, ec);
+		if (ec) std::filesystem::remove(tmpPath, ec);
+	}
+	// ---------
+
+	uint64_t LuaBytecodeCache::hash(const std::string& source, const Luau::CompileOptions& options, const Luau::ParseOptions& parser) {
+		const std::array<int, 6> settings = {options.optimizationLevel, options.debugLevel, options.typeInfoLevel, options.coverageLevel, parser.allowDeclarationSyntax ? 1 : 0, LBC_VERSION_MAX};
+
+		auto key = fnv1a(source.data(), source.size());
+		return fnv1a(settings.data(), settings.size() * sizeof(int), key);
+	}
+
+	std::shared_ptr<const std::string> LuaBytecodeCache::get(const std::string& source, const Luau::CompileOptions& options, const Luau::ParseOptions& parser) {
+		auto key = hash(source, options, parser);
+		std::filesystem::path folder = {};
+
+		{
+			std::shared_lock lock(_mutex);
+
+			auto fnd = _entries.find(key);
+			if (fnd != _entries.end() && fnd->second.source == source) {
+				_memoryHits++;
+				return fnd->second.bytecode;
+			}
+
+			folder = _folder;
+		}
+
+		// Compile outside the lock, two states racing on the same chunk both compile and the first one wins
+		rawrbox::SHA256Digest digest = {};
+		if (!folder.empty()) digest = rawrbox::SHA256::hash(source);
+
+		auto bytecode = loadDisk(folder, key, digest);
+		if (bytecode != nullptr) {
+			_diskHits++;
+		} else {
+			auto compiled = Luau::compile(source, options, parser);
+			if (compiled.empty() || compiled[0] == '\0') {
+				size_t pos = compiled.find(':'); // extract the error message
+				throw std::runtime_error(pos != std::string::npos ? compiled.substr(pos + 1) : "Unknown lua error");
+			}
+
+			saveDisk(folder, key, digest, compiled);
+			bytecode = std::make_shared<const std::string>(std::move(compiled));
+			_compiles++;
+		}
+
+		std::unique_lock lock(_mutex);
+
+		auto [entry, inserted] = _entries.try_emplace(key, Entry{source, bytecode});
+		if (!inserted && entry->second.source != source) return bytecode; // Hash collision, the first chunk keeps the slot
+
+		return entry->second.bytecode;
+	}
+
+	void LuaBytecodeCache::clear() {
+		std::unique_lock lock(_mutex);
+		_entries.clear();
+
+		_compiles = 0;
+		_memoryHits = 0;
+		_diskHits = 0;
+	}
+
+	void LuaBytecodeCache::setFolder(const std::filesystem::path& folder) {
+		std::unique_lock lock(_mutex);
+
+		_folder = folder;
+		if (!_folder.empty() && !std::filesystem::exists(_folder)) {
+			std::filesystem::create_directories(_folder);
+		}
+	}
+
+	std::filesystem::path LuaBytecodeCache::getFolder() {
+		std::shared_lock lock(_mutex);
+		return _folder;
+	}
+
+	size_t LuaBytecodeCache::size() {
+		std::shared_lock lock(_mutex);
+		return _entries.size();
+	}
+
+	rawrbox::LuaBytecodeStats LuaBytecodeCache::getStats() { return {_compiles.load(), _memoryHits.load(), _diskHits.load()}; }
+} // namespace rawrbox
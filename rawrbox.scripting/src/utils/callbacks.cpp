@@ -0,0 +1,29 @@
+#include <rawrbox/scripting/utils/callbacks.hpp>
+
+#include <algorithm>
+
+namespace rawrbox {
+	rawrbox::LuaCallback LuaCallbacks::add(const luabridge::LuaRef& callback) {
+		if (!callback.isCallable()) throw std::runtime_error("Callback not a function");
+
+		// Events that went away took their handle with them
+		std::erase_if(this->_callbacks, [](const auto& pair) { return pair.second.use_count() == 1; });
+
+		auto handle = std::make_shared<std::optional<luabridge::LuaRef>>(callback);
+		this->_callbacks.emplace_back(lua_mainthread(callback.state()), handle);
+
+		return handle;
+	}
+
+	void LuaCallbacks::removeState(lua_State* L) {
+		auto* main = lua_mainthread(L); // Callbacks come from the sandbox thread
+		std::erase_if(this->_callbacks, [main](const auto& pair) {
+			if (pair.first != main) return false;
+
+			pair.second->reset(); // Unref now, while the state is still open
+			return true;
+		});
+	}
+
+	size_t LuaCallbacks::size() const { return this->_callbacks.size(); }
+} // namespace rawrbox
@@ -0,0 +1,71 @@
+#include <rawrbox/scripting/utils/hook_id.hpp>
+
+#include <mutex>
+#include <stdexcept>
+
+namespace rawrbox {
+	// PROTECTED ----
+	HookID::Registry& HookID::registry() {
+		static Registry reg = {};
+		return reg;
+	}
+	// --------------
+
+	HookID::HookID(std::string_view name) {
+		auto& reg = registry();
+
+		{
+			std::shared_lock lock(reg.mutex);
+
+			auto fnd = reg.lookup.find(name);
+			if (fnd != reg.lookup.end()) {
+				this->_index = fnd->second;
+				return;
+			}
+		}
+
+		std::unique_lock lock(reg.mutex);
+
+		auto fnd = reg.lookup.find(name); // Interned while we waited
+		if (fnd != reg.lookup.end()) {
+			this->_index = fnd->second;
+			return;
+		}
+
+		this->_index = static_cast<uint32_t>(reg.names.size());
+		reg.names.emplace_back(name);
+		reg.lookup.emplace(reg.names.back(), this->_index);
+	}
+
+	rawrbox::HookID HookID::find(std::string_view name) {
+		auto& reg = registry();
+		std::shared_lock lock(reg.mutex);
+
+		rawrbox::HookID id = {};
+
+		auto fnd = reg.lookup.find(name);
+		if (fnd != reg.lookup.end()) id._index = fnd->second;
+
+		return id;
+	}
+
+	size_t HookID::count() {
+		auto& reg = registry();
+		std::shared_lock lock(reg.mutex);
+
+		return reg.names.size();
+	}
+
+	uint32_t HookID::index() const { return this->_index; }
+
+	const std::string& HookID::name() const {
+		if (!this->valid()) throw std::runtime_error("Invalid hook id");
+
+		auto& reg = registry();
+		std::shared_lock lock(reg.mutex);
+
+		return reg.names[this->_index];
+	}
+
+	bool HookID::valid() const { return this->_index != INVALID; }
+} // namespace rawrbox
@@ -1,9 +1,14 @@
+#include <rawrbox/scripting/utils/bytecode_cache.hpp>
 #include <rawrbox/scripting/utils/lua.hpp>
 #include <rawrbox/utils/file.hpp>
 #include <rawrbox/utils/string.hpp>
 
 #include <fmt/format.h>
 
+#ifdef RAWRBOX_SCRIPTING_NATIVE
+	#include <Luau/CodeGen.h>
+#endif
+
 /*
 namespace DFInt {
 	int LuauTypeSolverRelease = 999;
@@ -29,6 +34,7 @@ namespace rawrbox {
 
 		// Create a new thread ----
 		auto* loadThread = lua_newthread(L);
+		auto native = getNativeMode(L);
 		// --------------
 
 		// Compile ----
@@ -37,24 +43,27 @@ namespace rawrbox {
 		options.optimizationLevel = 2; // Remove debug info & inline lua
 		options.debugLevel = 0;
 #endif
+		if (native != rawrbox::LuaNativeMode::OFF) options.typeInfoLevel = 1; // Lets codegen specialize annotated args
 
 		Luau::ParseOptions parser = {};
 		parser.allowDeclarationSyntax = false;
 		parser.captureComments = false;
 
-		std::string bytecode = Luau::compile(script, options, parser);
-		if (bytecode.empty() || bytecode[0] == '\0') {
-			size_t pos = bytecode.find(':'); // extract the error message
-			std::string errorMessage = pos != std::string::npos ? bytecode.substr(pos + 1) : "Unknown lua error";
-			throw std::runtime_error(errorMessage);
-		}
+		auto bytecode = rawrbox::LuaBytecodeCache::get(script, options, parser); // Shared between states, only the first load compiles
 		// ----------
 
 		// Load -------
 		std::string chunk = fmt::format("={}", chunkID);
-		if (luau_load(loadThread, chunk.c_str(), bytecode.data(), bytecode.size(), 0) != 0) {
+		if (luau_load(loadThread, chunk.c_str(), bytecode->data(), bytecode->size(), 0) != 0) {
 			throw std::runtime_error(rawrbox::LuaUtils::getError(L));
 		}
+
+#ifdef RAWRBOX_SCRIPTING_NATIVE
+		// Functions codegen can't handle stay interpreted, so the result is not an error
+		if (native != rawrbox::LuaNativeMode::OFF) {
+			Luau::CodeGen::compile(loadThread, -1, native == rawrbox::LuaNativeMode::ANNOTATED ? Luau::CodeGen::CodeGen_OnlyNativeModules : 0);
+		}
+#endif
 		// -----------
 
 		// Run the thread ---
@@ -62,6 +71,36 @@ namespace rawrbox {
 		// -----------
 	}
 
+	// NATIVE ---
+	bool LuaUtils::enableNative(lua_State* L, rawrbox::LuaNativeMode mode) {
+		if (L == nullptr) throw std::runtime_error("Invalid lua state");
+
+#ifdef RAWRBOX_SCRIPTING_NATIVE
+		if (mode != rawrbox::LuaNativeMode::OFF && !Luau::CodeGen::isSupported()) mode = rawrbox::LuaNativeMode::OFF;
+		if (mode != rawrbox::LuaNativeMode::OFF && !Luau::CodeGen::isNativeExecutionEnabled(L)) {
+			Luau::CodeGen::create(L); // Once per state
+		}
+#else
+		mode = rawrbox::LuaNativeMode::OFF;
+#endif
+
+		lua_pushinteger(L, static_cast<int>(mode));
+		lua_setfield(L, LUA_REGISTRYINDEX, "__native_mode");
+
+		return mode != rawrbox::LuaNativeMode::OFF;
+	}
+
+	rawrbox::LuaNativeMode LuaUtils::getNativeMode(lua_State* L) {
+		if (L == nullptr) throw std::runtime_error("Invalid lua state");
+
+		lua_getfield(L, LUA_REGISTRYINDEX, "__native_mode");
+		auto mode = static_cast<rawrbox::LuaNativeMode>(lua_tointeger(L, -1)); // nil -> 0 -> OFF
+		lua_pop(L, 1);
+
+		return mode;
+	}
+	// ----------
+
 	void LuaUtils::resume(lua_State* L, lua_State* from) {
 		if (L == nullptr) throw std::runtime_error("Invalid lua state");
 		if (lua_resume(L, from, 0) != 0) {
@@ -1,10 +1,13 @@
 
 
+#include <rawrbox/scripting/mod.hpp>
 #include <rawrbox/scripting/wrappers/console.hpp>
+#include <rawrbox/utils/string.hpp>
 
 namespace rawrbox {
 	// PRIVATE ---
 	rawrbox::Console* ConsoleWrapper::_console = nullptr;
+	std::unordered_map<std::string, lua_State*> ConsoleWrapper::_owners = {};
 	// ------------
 
 	void ConsoleWrapper::init(rawrbox::Console* console) { _console = console; }
@@ -12,31 +15,36 @@ namespace rawrbox {
 
 	// UTILS ---
 	void ConsoleWrapper::clear() {
+		if (rawrbox::Mod::onWorker()) throw std::runtime_error("Console is not available to threaded mods");
 		if (_console == nullptr) throw std::runtime_error("Console instance not set!");
 		_console->clear();
 	}
 
 	const rawrbox::ConsoleCommand& ConsoleWrapper::get(const std::string& command) {
+		if (rawrbox::Mod::onWorker()) throw std::runtime_error("Console is not available to threaded mods");
 		if (_console == nullptr) throw std::runtime_error("Console instance not set!");
 		return _console->getCommand(command);
 	}
 	// ---------
 
 	std::pair<bool, std::string> ConsoleWrapper::execute(lua_State* L) {
+		if (rawrbox::Mod::onWorker()) throw std::runtime_error("Console is not available to threaded mods");
 		if (_console == nullptr) throw std::runtime_error("Console instance not set!");
 		return _console->executeCommand(rawrbox::LuaUtils::argsToString(L, true));
 	}
 
 	void ConsoleWrapper::print(const std::string& text, std::optional<rawrbox::PrintType> type) {
+		if (rawrbox::Mod::onWorker()) throw std::runtime_error("Console is not available to threaded mods");
 		if (_console == nullptr) throw std::runtime_error("Console instance not set!");
 		_console->print(text, type.value_or(rawrbox::PrintType::LOG));
 	}
 
 	bool ConsoleWrapper::registerMethod(const std::string& command, const luabridge::LuaRef& callback, const std::optional<std::string>& description, std::optional<uint32_t> flags) {
+		if (rawrbox::Mod::onWorker()) throw std::runtime_error("Console is not available to threaded mods");
 		if (_console == nullptr) throw std::runtime_error("Console instance not set!");
 		if (!callback.isCallable()) throw std::runtime_error("Invalid callback argument");
 
-		return _console->registerCommand(
+		bool registered = _console->registerCommand(
 		    command, [callback](const std::vector<std::string>& args) -> std::pair<bool, std::string> {
 			    auto tbl = rawrbox::LuaUtils::vectorToTable(callback.state(), args);
 			    auto ret = luabridge::call(callback, tbl);
@@ -49,18 +57,38 @@ namespace rawrbox {
 			    }
 		    },
 		    description.value_or(""), flags.value_or(rawrbox::ConsoleFlags::NONE));
+
+		if (registered) _owners[rawrbox::StrUtils::toLower(command)] = lua_mainthread(callback.state()); // Console keys are lowercase
+		return registered;
 	}
 
 	bool ConsoleWrapper::removeCommand(const std::string& command) {
+		if (rawrbox::Mod::onWorker()) throw std::runtime_error("Console is not available to threaded mods");
 		if (_console == nullptr) throw std::runtime_error("Console instance not set!");
+
+		_owners.erase(rawrbox::StrUtils::toLower(command));
 		return _console->removeCommand(command);
 	}
 
 	bool ConsoleWrapper::hasCommand(const std::string& command) {
+		if (rawrbox::Mod::onWorker()) throw std::runtime_error("Console is not available to threaded mods");
 		if (_console == nullptr) throw std::runtime_error("Console instance not set!");
 		return _console->hasCommand(command);
 	}
 
+	void ConsoleWrapper::removeState(lua_State* L) {
+		auto* main = lua_mainthread(L);
+		for (auto it = _owners.begin(); it != _owners.end();) {
+			if (it->second != main) {
+				++it;
+				continue;
+			}
+
+			if (_console != nullptr) _console->removeCommand(it->first);
+			it = _owners.erase(it);
+		}
+	}
+
 	void ConsoleWrapper::registerLua(lua_State* L) {
 		luabridge::getGlobalNamespace(L)
 		    .beginNamespace("console", {})
@@ -1,46 +1,71 @@
+#include <rawrbox/scripting/mod.hpp>
 #include <rawrbox/scripting/wrappers/hooks.hpp>
 
+#include <algorithm>
+
 namespace rawrbox {
 	// PRIVATE -----
-	std::unordered_map<std::string, std::vector<rawrbox::Hook>> Hooks::_hooks = {};
+	std::vector<std::vector<rawrbox::Hook>> Hooks::_hooks = {};
 	// -------------
 
-	void Hooks::call(const std::string& id, const luabridge::LuaRef& args) {
-		for (auto& hook : _hooks[id]) {
-			auto result = luabridge::call(hook.func, args);
+	void Hooks::call(const rawrbox::HookID& id, const luabridge::LuaRef& args) {
+		if (rawrbox::Mod::onWorker()) throw std::runtime_error("Hooks are not available to threaded mods, use messages");
+		if (!id.valid() || id.index() >= _hooks.size()) return;
+
+		// By index, callbacks can add / remove hooks
+		for (size_t i = 0; i < _hooks[id.index()].size(); i++) {
+			auto result = luabridge::call(_hooks[id.index()][i].func, args);
 			if (result.hasFailed()) fmt::print("Lua error\n  └── {}\n", result.errorMessage());
 		}
 	}
 
+	void Hooks::call(const std::string& id, const luabridge::LuaRef& args) {
+		call(rawrbox::HookID::find(id), args); // Never interned = nothing listens
+	}
+
 	void Hooks::add(const std::string& id, const std::string& name, const luabridge::LuaRef& func) {
+		if (rawrbox::Mod::onWorker()) throw std::runtime_error("Hooks are not available to threaded mods, use messages");
 		if (!func.isCallable()) throw std::runtime_error("Invalid callback");
-		_hooks[id].emplace_back(name, func);
+
+		rawrbox::HookID hook(id);
+		if (hook.index() >= _hooks.size()) _hooks.resize(hook.index() + 1);
+
+		_hooks[hook.index()].emplace_back(name, func);
 	}
 
 	void Hooks::remove(const std::string& id, const std::string& name) {
-		auto nameMap = _hooks.find(id);
-		if (nameMap == _hooks.end()) return;
+		if (rawrbox::Mod::onWorker()) throw std::runtime_error("Hooks are not available to threaded mods, use messages");
+		auto hook = rawrbox::HookID::find(id);
+		if (!hook.valid() || hook.index() >= _hooks.size()) return;
 
-		auto& arr = nameMap->second;
-		auto hook = std::find_if(arr.begin(), arr.end(), [&](auto& elem) {
+		auto& arr = _hooks[hook.index()];
+		auto fnd = std::find_if(arr.begin(), arr.end(), [&](auto& elem) {
 			return elem.name == name;
 		});
 
-		if (hook == arr.end()) return;
-		arr.erase(hook);
+		if (fnd == arr.end()) return;
+		arr.erase(fnd);
+	}
 
-		if (arr.empty()) _hooks.erase(id);
+	void Hooks::removeState(lua_State* L) {
+		auto* main = lua_mainthread(L); // Callbacks come from the sandbox thread
+		for (auto& arr : _hooks) {
+			arr.erase(std::remove_if(arr.begin(), arr.end(), [main](const rawrbox::Hook& hook) { return lua_mainthread(hook.func.state()) == main; }), arr.end());
+		}
 	}
 
 	// Utils ---
-	size_t Hooks::count() { return _hooks.size(); }
-	bool Hooks::empty() { return _hooks.empty(); }
+	size_t Hooks::count() {
+		return std::count_if(_hooks.begin(), _hooks.end(), [](const auto& arr) { return !arr.empty(); });
+	}
+
+	bool Hooks::empty() { return count() == 0; }
 	// ----
 
 	void Hooks::registerLua(lua_State* L) {
 		luabridge::getGlobalNamespace(L)
 		    .beginNamespace("hooks", {})
-		    .addFunction("call", &rawrbox::Hooks::call)
+		    .addFunction("call", static_cast<void (*)(const std::string&, const luabridge::LuaRef&)>(&rawrbox::Hooks::call))
 		    .addFunction("add", &rawrbox::Hooks::add)
 		    .addFunction("remove", &rawrbox::Hooks::remove)
 		    .endNamespace();
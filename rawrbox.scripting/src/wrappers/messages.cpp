@@ -0,0 +1,49 @@
+#include <rawrbox/scripting/manager.hpp>
+#include <rawrbox/scripting/wrappers/messages.hpp>
+
+namespace rawrbox {
+	void MessagesWrapper::send(const std::string& to, const std::string& topic, const luabridge::LuaRef& payload) {
+		auto* mod = rawrbox::Mod::fromState(payload.state());
+		if (mod == nullptr) throw std::runtime_error("Invalid mod state");
+
+		mod->send(to, topic, toPayload(payload));
+	}
+
+	void MessagesWrapper::broadcast(const std::string& topic, const luabridge::LuaRef& payload) {
+		send(rawrbox::SCRIPTING::BROADCAST_ID, topic, payload);
+	}
+
+	glz::generic MessagesWrapper::toPayload(const luabridge::LuaRef& ref) {
+		glz::generic payload = {};
+
+		switch (ref.type()) {
+			case LUA_TBOOLEAN:
+				payload = ref.unsafe_cast<bool>();
+				break;
+			case LUA_TNUMBER:
+				payload = ref.unsafe_cast<double>();
+				break;
+			case LUA_TSTRING:
+				payload = ref.unsafe_cast<std::string>();
+				break;
+			case LUA_TTABLE:
+				payload = rawrbox::LuaUtils::luaToJsonObject(ref);
+				break;
+			case LUA_TNONE:
+			case LUA_TNIL:
+				break;
+			default:
+				throw std::runtime_error("Message payloads can only be nil, booleans, numbers, strings or tables");
+		}
+
+		return payload;
+	}
+
+	void MessagesWrapper::registerLua(lua_State* L) {
+		luabridge::getGlobalNamespace(L)
+		    .beginNamespace("messages", {})
+		    .addFunction("send", &rawrbox::MessagesWrapper::send)
+		    .addFunction("broadcast", &rawrbox::MessagesWrapper::broadcast)
+		    .endNamespace();
+	}
+} // namespace rawrbox
@@ -7,6 +7,7 @@ namespace rawrbox {
 	// Can be a bit expensive to call this, since it will create a new table on the new env every time
 	void MODWrapper::call(const std::string& method, const luabridge::LuaRef& ref) const {
 		if (this->_mod == nullptr) throw std::runtime_error("Invalid mod reference");
+		if (rawrbox::Mod::onWorker()) throw std::runtime_error("Calling other mods is not available to threaded mods, use messages");
 
 		auto* modEnv = this->_mod->getEnvironment();
 		auto func = luabridge::getGlobal(modEnv, method.c_str());
@@ -1,45 +1,48 @@
+#include <rawrbox/scripting/mod.hpp>
 #include <rawrbox/scripting/wrappers/timer.hpp>
 #include <rawrbox/utils/timer.hpp>
 
 namespace rawrbox {
+	// PRIVATE ---
+	std::unordered_map<std::string, lua_State*> TimerWrapper::_owners = {};
+	// ------------
+
 	// CREATE ---
 	bool TimerWrapper::create(const std::string& id, int reps, float delay, const luabridge::LuaRef& callback, std::optional<luabridge::LuaRef> onComplete) {
+		if (rawrbox::Mod::onWorker()) throw std::runtime_error("Timers are not available to threaded mods");
 		if (!callback.isCallable()) throw std::runtime_error("Invalid callback");
 		if (onComplete.has_value() && !onComplete->isCallable()) throw std::runtime_error("Invalid onComplete callback");
 
+		// Same id TIMER would pick, _owners needs to know it
+		std::string timerId = id.empty() ? std::to_string(++rawrbox::TIMER::ID) : id;
+
 		auto* timer = rawrbox::TIMER::create(
-		    id, reps, delay, [callback]() {
+		    timerId, reps, delay, [callback]() {
 				auto result = luabridge::call(callback);
 				if (result.hasFailed()) fmt::print("Lua error\n  └── {}\n", result.errorMessage()); },
-		    [onComplete]() {
+		    [timerId, onComplete]() {
+			    _owners.erase(timerId);
 			    if (!onComplete.has_value()) return;
 			    auto result = luabridge::call(onComplete.value());
 			    if (result.hasFailed()) fmt::print("Lua error\n  └── {}\n", result.errorMessage());
 		    });
 
-		return timer != nullptr;
+		if (timer == nullptr) return false;
+
+		_owners[timerId] = lua_mainthread(callback.state());
+		return true;
 	}
 
 	bool TimerWrapper::simple(const std::string& id, float delay, const luabridge::LuaRef& callback, std::optional<luabridge::LuaRef> onComplete) {
-		if (!callback.isCallable()) throw std::runtime_error("Invalid callback");
-		if (onComplete.has_value() && !onComplete->isCallable()) throw std::runtime_error("Invalid onComplete callback");
-
-		auto* timer = rawrbox::TIMER::simple(
-		    id, delay, [callback]() {
-				auto result = luabridge::call(callback);
-			    if (result.hasFailed()) fmt::print("Lua error\n  └── {}\n", result.errorMessage()); },
-		    [onComplete]() {
-			    if (!onComplete.has_value()) return;
-			    auto result = luabridge::call(onComplete.value());
-			    if (result.hasFailed()) fmt::print("Lua error\n  └── {}\n", result.errorMessage());
-		    });
-
-		return timer != nullptr;
+		return create(id, 1, delay, callback, std::move(onComplete)); // Same as TIMER::simple
 	}
 	// ----
 
 	// UTILS ---
 	bool TimerWrapper::destroy(const std::string& id) {
+		if (rawrbox::Mod::onWorker()) throw std::runtime_error("Timers are not available to threaded mods");
+
+		_owners.erase(id);
 		return rawrbox::TIMER::destroy(id);
 	}
 
@@ -48,8 +51,22 @@ namespace rawrbox {
 	}
 
 	bool TimerWrapper::pause(const std::string& id, bool pause) {
+		if (rawrbox::Mod::onWorker()) throw std::runtime_error("Timers are not available to threaded mods");
 		return rawrbox::TIMER::pause(id, pause);
 	}
+
+	void TimerWrapper::removeState(lua_State* L) {
+		auto* main = lua_mainthread(L);
+		for (auto it = _owners.begin(); it != _owners.end();) {
+			if (it->second != main) {
+				++it;
+				continue;
+			}
+
+			rawrbox::TIMER::destroy(it->first); // Frees the callbacks right away
+			it = _owners.erase(it);
+		}
+	}
 	// ----
 
 	void TimerWrapper::registerLua(lua_State* L) {
@@ -0,0 +1,167 @@
+#include <rawrbox/scripting/mod.hpp>
+#include <rawrbox/scripting/utils/bytecode_cache.hpp>
+
+#include "helpers.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <fmt/format.h>
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+	constexpr size_t BOOT_MODS = 150;
+
+	// Stand-in for the shared libs (sha2, json, math, ...) every mod loads
+	std::vector<std::string> makeLibraries() {
+		std::vector<std::string> libs = {};
+
+		for (size_t lib = 0; lib < 6; lib++) {
+			std::string src = fmt::format("local LIB{} = {{}}\n", lib);
+			for (size_t i = 0; i < 120; i++) {
+				src += fmt::format("function LIB{0}.fn{1}(a, b)\n\tlocal t = {{}}\n\tfor i = 1, a do\n\t\tt[i] = (i * {1} + b) % 255\n\tend\n\treturn #t\nend\n", lib, i);
+			}
+
+			libs.push_back(std::move(src));
+		}
+
+		return libs;
+	}
+
+	void bootMod(size_t index, const std::vector<std::string>& libs, bool cached) {
+		auto loadLibs = [&](rawrbox::Mod& mod) {
+			if (!cached) rawrbox::LuaBytecodeCache::clear(); // Same as compiling every lib per mod
+			for (const auto& lib : libs) {
+				mod.script(lib);
+			}
+		};
+
+		rawrbox::tests::makeMod(fmt::format("mod_{}", index), fmt::format("function MOD:onInit() return {} end", index), loadLibs);
+	}
+
+	Luau::CompileOptions options() {
+		Luau::CompileOptions opt = {};
+		opt.optimizationLevel = 2;
+		opt.debugLevel = 0;
+
+		return opt;
+	}
+
+	// Plants another chunk under the source's key, same as a 64-bit hash collision
+	class CollidingCache : public rawrbox::LuaBytecodeCache {
+	public:
+		static void collide(const std::string& source, const Luau::CompileOptions& opt) {
+			std::unique_lock lock(_mutex);
+			_entries[hash(source, opt, {})] = {"return 'other'", std::make_shared<const std::string>("other")};
+		}
+
+		// Same, on disk. The entry is tagged with the other source's SHA-256
+		static void collideDisk(const std::filesystem::path& folder, const std::string& source, const Luau::CompileOptions& opt) {
+			saveDisk(folder, hash(source, opt, {}), rawrbox::SHA256::hash("return 'other'"), "other");
+		}
+
+		[[nodiscard]] static std::shared_ptr<const std::string> loadOther(const std::filesystem::path& folder, const std::string& source, const Luau::CompileOptions& opt) {
+			return loadDisk(folder, hash(source, opt, {}), rawrbox::SHA256::hash("return 'other'"));
+		}
+	};
+} // namespace
+
+TEST_CASE("LuaBytecodeCache should behave as expected", "[rawrbox::LuaBytecodeCache]") {
+	rawrbox::LuaBytecodeCache::clear();
+
+	SECTION("rawrbox::LuaBytecodeCache::get") {
+		auto a = rawrbox::LuaBytecodeCache::get("return 1", options(), {});
+		auto b = rawrbox::LuaBytecodeCache::get("return 1", options(), {});
+		REQUIRE(a == b); // Same chunk, not a copy
+
+		auto debug = options();
+		debug.debugLevel = 2;
+
+		auto c = rawrbox::LuaBytecodeCache::get("return 1", debug, {});
+		REQUIRE(c != a); // Options are part of the key
+
+		REQUIRE(rawrbox::LuaBytecodeCache::size() == 2);
+		REQUIRE(rawrbox::LuaBytecodeCache::getStats().compiles == 2);
+		REQUIRE(rawrbox::LuaBytecodeCache::getStats().memoryHits == 1);
+
+		REQUIRE_THROWS(rawrbox::LuaBytecodeCache::get("return = =", options(), {}));
+		REQUIRE(rawrbox::LuaBytecodeCache::size() == 2); // Errors are not cached
+
+		// Same key, different source, compiled instead of handing out the other chunk
+		CollidingCache::collide("return 3", options());
+		auto collided = rawrbox::LuaBytecodeCache::get("return 3", options(), {});
+
+		REQUIRE(*collided != "other");
+		REQUIRE(*collided == *rawrbox::LuaBytecodeCache::get("return 3", options(), {}));
+	}
+
+	SECTION("rawrbox::LuaBytecodeCache::hash") {
+		REQUIRE(rawrbox::LuaBytecodeCache::hash("return 1", options(), {}) == rawrbox::LuaBytecodeCache::hash("return 1", options(), {}));
+		REQUIRE(rawrbox::LuaBytecodeCache::hash("return 1", options(), {}) != rawrbox::LuaBytecodeCache::hash("return 2", options(), {}));
+	}
+
+	SECTION("rawrbox::LuaBytecodeCache::setFolder") {
+		auto folder = std::filesystem::temp_directory_path() / "rawrbox_luau_cache";
+		std::filesystem::remove_all(folder);
+
+		rawrbox::LuaBytecodeCache::setFolder(folder);
+		auto compiled = rawrbox::LuaBytecodeCache::get("return 5", options(), {});
+
+		rawrbox::LuaBytecodeCache::clear(); // Next process
+		auto loaded = rawrbox::LuaBytecodeCache::get("return 5", options(), {});
+
+		REQUIRE(*loaded == *compiled);
+		REQUIRE(rawrbox::LuaBytecodeCache::getStats().diskHits == 1);
+		REQUIRE(rawrbox::LuaBytecodeCache::getStats().compiles == 0);
+
+		// Another source under the same key is neither loaded nor replaced
+		CollidingCache::collideDisk(folder, "return 7", options());
+		auto collided = rawrbox::LuaBytecodeCache::get("return 7", options(), {});
+
+		REQUIRE(*collided != "other");
+		REQUIRE(rawrbox::LuaBytecodeCache::getStats().diskHits == 1);
+
+		auto kept = CollidingCache::loadOther(folder, "return 7", options());
+		REQUIRE(kept != nullptr);
+		REQUIRE(*kept == "other");
+
+		rawrbox::LuaBytecodeCache::setFolder("");
+		std::filesystem::remove_all(folder);
+	}
+
+	SECTION("rawrbox::LuaUtils::compileAndLoadScript") {
+		auto libs = makeLibraries();
+		for (size_t i = 0; i < 4; i++) {
+			REQUIRE_NOTHROW(bootMod(i, libs, true));
+		}
+
+		REQUIRE(rawrbox::LuaBytecodeCache::getStats().compiles == libs.size() + 4);
+		REQUIRE(rawrbox::LuaBytecodeCache::getStats().memoryHits == libs.size() * 3);
+	}
+
+	rawrbox::LuaBytecodeCache::clear();
+}
+
+TEST_CASE("LuaBytecodeCache benchmark", "[.benchmark][rawrbox::LuaBytecodeCache]") {
+	auto libs = makeLibraries();
+
+	BENCHMARK(fmt::format("Boot {} mods, compile per mod", BOOT_MODS)) {
+		for (size_t i = 0; i < BOOT_MODS; i++) {
+			bootMod(i, libs, false);
+		}
+	};
+
+	rawrbox::LuaBytecodeCache::clear();
+	BENCHMARK(fmt::format("Boot {} mods, shared bytecode", BOOT_MODS)) {
+		for (size_t i = 0; i < BOOT_MODS; i++) {
+			bootMod(i, libs, true);
+		}
+	};
+
+	rawrbox::LuaBytecodeCache::clear();
+}
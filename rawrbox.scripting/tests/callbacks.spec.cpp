@@ -0,0 +1,53 @@
+#include <rawrbox/scripting/mod.hpp>
+#include <rawrbox/scripting/utils/callbacks.hpp>
+
+#include "helpers.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+	luabridge::LuaRef getHook(rawrbox::Mod& mod, const std::string& name) {
+		return luabridge::getGlobal(mod.getEnvironment(), "MOD")[name];
+	}
+} // namespace
+
+TEST_CASE("LuaCallbacks should behave as expected", "[rawrbox::LuaCallbacks]") {
+	SECTION("rawrbox::LuaCallbacks::add") {
+		auto mod = rawrbox::tests::makeMod("my_mod", "MOD.calls = 0 function MOD.count(n) MOD.calls += n end");
+		rawrbox::LuaCallbacks callbacks = {}; // After the mod, refs go before the state closes
+
+		auto handle = callbacks.add(getHook(*mod, "count"));
+		REQUIRE(callbacks.size() == 1);
+
+		rawrbox::LuaCallbacks::call(handle, 2);
+		REQUIRE_NOTHROW(mod->script("assert(MOD.calls == 2)"));
+
+		REQUIRE_THROWS(callbacks.add(getHook(*mod, "calls"))); // Not a function
+
+		// Nothing else holds the first one, the next add drops it
+		handle.reset();
+		auto other = callbacks.add(getHook(*mod, "count"));
+		REQUIRE(other->has_value());
+		REQUIRE(callbacks.size() == 1);
+	}
+
+	SECTION("rawrbox::LuaCallbacks::removeState") {
+		auto first = rawrbox::tests::makeMod("first", "function MOD.fn() end");
+		auto second = rawrbox::tests::makeMod("second", "function MOD.fn() end");
+		rawrbox::LuaCallbacks callbacks = {};
+
+		auto firstHandle = callbacks.add(getHook(*first, "fn"));
+		auto secondHandle = callbacks.add(getHook(*second, "fn"));
+
+		callbacks.removeState(first->getEnvironment());
+		REQUIRE(callbacks.size() == 1);
+
+		REQUIRE_FALSE(firstHandle->has_value());
+		REQUIRE(secondHandle->has_value());
+
+		// The event still holds the handle after the state is gone, calling and releasing it is harmless
+		first.reset();
+		REQUIRE_NOTHROW(rawrbox::LuaCallbacks::call(firstHandle));
+		firstHandle.reset();
+	}
+}
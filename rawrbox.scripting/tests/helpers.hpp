@@ -0,0 +1,24 @@
+#pragma once
+
+#include <rawrbox/scripting/mod.hpp>
+
+#include <fmt/format.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace rawrbox::tests {
+	// Same setup as mod.spec.cpp, on the heap. prepare runs on the open state before init (wrappers, native, threaded, ...)
+	inline std::unique_ptr<rawrbox::Mod> makeMod(const std::string& id, const std::string& script = "", const std::function<void(rawrbox::Mod&)>& prepare = nullptr) {
+		auto mod = std::make_unique<rawrbox::Mod>(id, fmt::format("./{}", id), glz::generic{});
+		luaL_openlibs(mod->getEnvironment());
+
+		if (prepare) prepare(*mod);
+
+		mod->init();
+		if (!script.empty()) mod->script(script);
+
+		return mod;
+	}
+} // namespace rawrbox::tests
@@ -0,0 +1,165 @@
+#include <rawrbox/scripting/mod.hpp>
+#include <rawrbox/scripting/utils/hook_id.hpp>
+
+#include "helpers.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <fmt/format.h>
+
+#include <memory>
+#include <vector>
+
+namespace {
+	constexpr size_t DISPATCH_MODS = 100;
+
+	constexpr auto TICKS = "MOD.ticks = 0";
+	constexpr auto THINK = "MOD.ticks = 0 function MOD:think(dt) self.ticks += 1 end";
+} // namespace
+
+TEST_CASE("HookID should behave as expected", "[rawrbox::HookID]") {
+	SECTION("rawrbox::HookID::HookID") {
+		rawrbox::HookID a("test_hook_a");
+		rawrbox::HookID b("test_hook_a");
+		rawrbox::HookID c("test_hook_c");
+
+		REQUIRE(a.valid());
+		REQUIRE(a == b);
+		REQUIRE(a != c);
+		REQUIRE(a.name() == "test_hook_a");
+
+		REQUIRE_FALSE(rawrbox::HookID().valid());
+	}
+
+	SECTION("rawrbox::HookID::find") {
+		REQUIRE_FALSE(rawrbox::HookID::find("never_interned_hook").valid());
+
+		auto count = rawrbox::HookID::count();
+		rawrbox::HookID id("interned_hook");
+		REQUIRE(rawrbox::HookID::find("interned_hook") == id);
+		REQUIRE(rawrbox::HookID::count() == count + 1);
+	}
+}
+
+TEST_CASE("Mod hooks should behave as expected", "[rawrbox::Mod]") {
+	rawrbox::HookID think("think");
+
+	SECTION("rawrbox::Mod::implements") {
+		auto mod = rawrbox::tests::makeMod("mod_0", TICKS);
+		REQUIRE_FALSE(mod->implements(think));
+
+		mod->script("function MOD:think() return 1 end");
+		REQUIRE(mod->implements(think)); // script() re-resolves
+
+		mod->script("MOD.think = nil");
+		REQUIRE_FALSE(mod->implements(think));
+	}
+
+	SECTION("rawrbox::Mod::call") {
+		auto mod = rawrbox::tests::makeMod("mod_0", THINK);
+
+		auto version = rawrbox::Mod::getHooksVersion();
+		for (int i = 0; i < 10; i++) {
+			REQUIRE(mod->call(think, 0.016F).has_value());
+		}
+
+		REQUIRE(rawrbox::Mod::getHooksVersion() == version); // Calls keep the cache
+		REQUIRE_NOTHROW(mod->script("assert(MOD.ticks == 10)"));
+
+		mod->script("function MOD:think() return 5 end");
+		REQUIRE(mod->call(think).value()[0].unsafe_cast<int>() == 5); // Replaced function picked up
+
+		// Plain table, nothing in the way of the usual table functions
+		REQUIRE_NOTHROW(mod->script("local n = 0 for k, v in pairs(MOD) do n += 1 end assert(n == 2)"));
+		REQUIRE_NOTHROW(mod->script("assert(next(MOD) ~= nil) assert(rawget(MOD, 'ticks') == 10)"));
+		REQUIRE_NOTHROW(mod->script("MOD[1] = true assert(#MOD == 1) MOD[1] = nil"));
+		REQUIRE_NOTHROW(mod->script("setmetatable(MOD, { __index = function() return nil end })"));
+	}
+
+	SECTION("rawrbox::Mod::invalidateHooks") {
+		auto mod = rawrbox::tests::makeMod("mod_0", "function MOD:think() return 1 end function MOD:swap() MOD.think = function() return 2 end end function MOD:drop() MOD.think = nil end");
+		REQUIRE(mod->call(think).value()[0].unsafe_cast<int>() == 1);
+
+		// Changed from inside a hook, the cached function no longer matches MOD
+		REQUIRE(mod->call("swap").has_value());
+		REQUIRE(mod->call(think).value()[0].unsafe_cast<int>() == 2);
+
+		REQUIRE(mod->call("drop").has_value());
+		REQUIRE_FALSE(mod->call(think).has_value());
+		REQUIRE_FALSE(mod->implements(think));
+
+		// New key from inside a hook, dispatch lists rebuild
+		mod->script("function MOD:add() MOD.think = function() return 3 end end");
+
+		auto version = rawrbox::Mod::getHooksVersion();
+		REQUIRE(mod->call("add").has_value());
+
+		REQUIRE(rawrbox::Mod::getHooksVersion() != version);
+		REQUIRE(mod->implements(think));
+
+		// New data keys don't
+		mod->script("function MOD:count() MOD.counter = 1 end");
+
+		version = rawrbox::Mod::getHooksVersion();
+		REQUIRE(mod->call("count").has_value());
+		REQUIRE(rawrbox::Mod::getHooksVersion() == version);
+
+		// An existing data key turning into a function is the one case left to invalidateHooks
+		rawrbox::HookID later("later");
+		mod->script("MOD.later = 1 function MOD:promote() MOD.later = function() return 4 end end");
+
+		REQUIRE_FALSE(mod->implements(later));
+		REQUIRE(mod->call("promote").has_value());
+		REQUIRE_FALSE(mod->implements(later));
+
+		mod->invalidateHooks();
+		REQUIRE(mod->call(later).value()[0].unsafe_cast<int>() == 4);
+	}
+}
+
+TEST_CASE("Mod hooks benchmark", "[.benchmark][rawrbox::Mod]") {
+	std::vector<std::unique_ptr<rawrbox::Mod>> mods = {};
+	for (size_t i = 0; i < DISPATCH_MODS; i++) {
+		mods.push_back(rawrbox::tests::makeMod(fmt::format("mod_{}", i), i % 10 == 0 ? THINK : TICKS)); // 1 in 10 thinks
+	}
+
+	rawrbox::HookID think("think");
+
+	BENCHMARK("Lookup MOD.think per mod") {
+		size_t calls = 0;
+		for (auto& mod : mods) {
+			auto modTable = luabridge::getGlobal(mod->getEnvironment(), "MOD");
+
+			luabridge::LuaRef fnc = modTable["think"];
+			if (!fnc.isCallable()) continue;
+
+			luabridge::call(fnc, modTable, 0.016F);
+			calls++;
+		}
+
+		return calls;
+	};
+
+	BENCHMARK("HookID per mod") {
+		size_t calls = 0;
+		for (auto& mod : mods) {
+			if (mod->call(think, 0.016F).has_value()) calls++;
+		}
+
+		return calls;
+	};
+
+	std::vector<rawrbox::Mod*> subscribers = {};
+	for (auto& mod : mods) {
+		if (mod->implements(think)) subscribers.push_back(mod.get());
+	}
+
+	BENCHMARK("HookID dispatch list") {
+		for (auto* mod : subscribers) {
+			mod->call(think, 0.016F);
+		}
+
+		return subscribers.size();
+	};
+}
@@ -0,0 +1,305 @@
+#include <rawrbox/scripting/manager.hpp>
+#include <rawrbox/scripting/mod.hpp>
+#include <rawrbox/scripting/wrappers/console.hpp>
+#include <rawrbox/scripting/wrappers/hooks.hpp>
+#include <rawrbox/scripting/wrappers/messages.hpp>
+#include <rawrbox/utils/threading.hpp>
+
+#include "helpers.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <fmt/format.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+	const rawrbox::HookID HOOK_TICK("tick");
+
+	// Three messages to the collector per tick, threaded senders race each other on the pool
+	constexpr auto SENDER = R"(
+		local tick = 0
+
+		function MOD:tick()
+			tick += 1
+			for i = 1, 3 do
+				messages.send("collector", "ping", { tick = tick, n = i })
+			end
+		end
+	)";
+
+	constexpr auto COLLECTOR = R"(
+		local log = {}
+
+		function MOD:onMessage(from: string, topic: string, payload)
+			table.insert(log, string.format("%s:%s:%d:%d", from, topic, payload.tick, payload.n))
+		end
+
+		function MOD:getLog()
+			return table.concat(log, ",")
+		end
+	)";
+
+	// Server side simulation, no engine calls
+	constexpr auto SIMULATION = R"(
+		function MOD:tick()
+			local acc = 0
+			for x = 1, 150 do
+				for y = 1, 150 do
+					acc += math.sin(x * 0.1) * math.cos(y * 0.1)
+				end
+			end
+
+			messages.send("collector", "sim", { tick = 0, n = if acc > 0 then 1 else 0 })
+		end
+	)";
+
+	constexpr auto UNSAFE = R"(
+		local ok = nil
+		local consoleErr = nil
+
+		function MOD:tick()
+			ok = pcall(hooks.add, "unsafe", "test", function() end)
+			_, consoleErr = pcall(console.hasCommand, "unsafe")
+		end
+
+		function MOD:getOk()
+			return ok
+		end
+
+		function MOD:getConsoleErr()
+			return tostring(consoleErr)
+		end
+	)";
+
+	void initPool() {
+		static const bool ready = [] {
+			rawrbox::ASYNC::init(4);
+			return true;
+		}();
+
+		(void)ready;
+	}
+
+	constexpr auto UNLOADER = R"(
+		function MOD:tick()
+			unload("b_victim")
+		end
+	)";
+
+	constexpr auto VICTIM = R"(
+		function MOD:tick()
+			messages.send("engine", "ticked")
+		end
+	)";
+
+	// Lets tests put mods in SCRIPTING without mod folders on disk
+	class StepScripting : public rawrbox::SCRIPTING {
+	public:
+		static void adopt(std::unique_ptr<rawrbox::Mod> mod) {
+			auto* ptr = mod.get();
+			_mods.emplace(ptr->getID(), std::move(mod));
+
+			ptr->invalidateHooks();
+			sortMods();
+		}
+	};
+
+	auto messaging(bool threaded) {
+		return [threaded](rawrbox::Mod& mod) {
+			rawrbox::Hooks::registerLua(mod.getEnvironment());
+			rawrbox::MessagesWrapper::registerLua(mod.getEnvironment());
+
+			mod.setThreaded(threaded);
+		};
+	}
+
+	void unloading(rawrbox::Mod& mod) {
+		messaging(false)(mod);
+		luabridge::getGlobalNamespace(mod.getEnvironment()).addFunction("unload", [](const std::string& id) { return rawrbox::SCRIPTING::unloadMod(id); });
+	}
+
+	std::vector<rawrbox::Mod*> getPtrs(const std::vector<std::unique_ptr<rawrbox::Mod>>& mods) {
+		std::vector<rawrbox::Mod*> ptrs = {};
+		for (const auto& mod : mods) {
+			ptrs.push_back(mod.get());
+		}
+
+		return ptrs;
+	}
+
+	std::string getLog(rawrbox::Mod& collector) {
+		auto result = collector.call("getLog");
+		if (!result.has_value()) return "";
+
+		return result.value()[0].unsafe_cast<std::string>();
+	}
+
+	std::string runSenders(size_t senders, size_t ticks) {
+		std::vector<std::unique_ptr<rawrbox::Mod>> mods = {};
+		for (size_t i = senders; i > 0; i--) { // Reversed, step orders them by id
+			mods.push_back(rawrbox::tests::makeMod(fmt::format("sender_{:02}", i - 1), SENDER, messaging(true)));
+		}
+
+		mods.push_back(rawrbox::tests::makeMod("collector", COLLECTOR, messaging(false)));
+
+		auto ptrs = getPtrs(mods);
+		for (size_t i = 0; i < ticks; i++) {
+			rawrbox::SCRIPTING::step(ptrs, HOOK_TICK);
+		}
+
+		return getLog(*mods.back());
+	}
+} // namespace
+
+TEST_CASE("Mod messages should behave as expected", "[rawrbox::Mod]") {
+	initPool();
+
+	SECTION("rawrbox::Mod::send") {
+		rawrbox::Mod mod = {"sender", "./sender", {}};
+
+		REQUIRE_NOTHROW(mod.send("other", "a"));
+		REQUIRE_NOTHROW(mod.send("other", "b"));
+		REQUIRE_THROWS(mod.send("", "c"));
+		REQUIRE_THROWS(mod.send("other", ""));
+
+		auto outbox = mod.takeOutbox();
+		REQUIRE(outbox.size() == 2);
+		REQUIRE(outbox[0].from == "sender");
+		REQUIRE(outbox[0].topic == "a");
+		REQUIRE(outbox[0].sequence == 0);
+		REQUIRE(outbox[1].sequence == 1);
+
+		REQUIRE(mod.takeOutbox().empty());
+	}
+
+	SECTION("rawrbox::Mod::deliverMessages") {
+		auto collector = rawrbox::tests::makeMod("collector", COLLECTOR, messaging(false));
+
+		for (size_t i = 1; i <= 2; i++) {
+			glz::generic payload = {};
+			payload["tick"] = 1.0;
+			payload["n"] = static_cast<double>(i);
+
+			collector->receive({"other", "collector", "ping", payload, i});
+		}
+
+		REQUIRE(collector->pendingMessages() == 2);
+		REQUIRE(collector->deliverMessages() == 2);
+		REQUIRE(collector->pendingMessages() == 0);
+
+		REQUIRE(getLog(*collector) == "other:ping:1:1,other:ping:1:2");
+	}
+
+	SECTION("rawrbox::SCRIPTING::step") {
+		// Sent on step N, delivered on N + 1, by sender id then send order
+		std::string expected = {};
+		for (size_t tick = 1; tick < 5; tick++) {
+			for (size_t sender = 0; sender < 8; sender++) {
+				for (size_t n = 1; n <= 3; n++) {
+					if (!expected.empty()) expected += ",";
+					expected += fmt::format("sender_{:02}:ping:{}:{}", sender, tick, n);
+				}
+			}
+		}
+
+		for (size_t run = 0; run < 3; run++) {
+			REQUIRE(runSenders(8, 5) == expected);
+		}
+	}
+
+	SECTION("rawrbox::SCRIPTING::send") {
+		auto collector = rawrbox::tests::makeMod("collector", COLLECTOR, messaging(true));
+		std::vector<rawrbox::Mod*> mods = {collector.get()};
+
+		glz::generic payload = {};
+		payload["tick"] = 7.0;
+		payload["n"] = 1.0;
+
+		rawrbox::SCRIPTING::send("collector", "hello", payload);
+		rawrbox::SCRIPTING::step(mods, HOOK_TICK); // Routed
+		REQUIRE(getLog(*collector).empty());
+
+		rawrbox::SCRIPTING::step(mods, HOOK_TICK); // Delivered
+		REQUIRE(getLog(*collector) == "engine:hello:7:1");
+
+		std::vector<std::string> received = {};
+		rawrbox::SCRIPTING::onMessage += [&received](const rawrbox::ModMessage& msg) { received.push_back(fmt::format("{}:{}", msg.from, msg.topic)); };
+
+		REQUIRE_NOTHROW(collector->script(R"(messages.send("engine", "done", 5))"));
+		rawrbox::SCRIPTING::step(mods, HOOK_TICK);
+
+		REQUIRE(received.size() == 1);
+		REQUIRE(received[0] == "collector:done");
+
+		rawrbox::SCRIPTING::onMessage.clear();
+	}
+
+	SECTION("rawrbox::Mod::onWorker") {
+		auto unsafe = [](bool threaded) {
+			return [threaded](rawrbox::Mod& mod) {
+				messaging(threaded)(mod);
+				rawrbox::ConsoleWrapper::registerLua(mod.getEnvironment());
+			};
+		};
+
+		std::vector<std::unique_ptr<rawrbox::Mod>> mods = {};
+		mods.push_back(rawrbox::tests::makeMod("serial", UNSAFE, unsafe(false)));
+		mods.push_back(rawrbox::tests::makeMod("threaded", UNSAFE, unsafe(true)));
+
+		REQUIRE_FALSE(rawrbox::Mod::onWorker());
+		rawrbox::SCRIPTING::step(getPtrs(mods), HOOK_TICK);
+		REQUIRE_FALSE(rawrbox::Mod::onWorker());
+
+		REQUIRE(mods[0]->call("getOk").value()[0].unsafe_cast<bool>());
+		REQUIRE_FALSE(mods[1]->call("getOk").value()[0].unsafe_cast<bool>()); // Hooks are shared, not for workers
+
+		// No console instance in here, the serial mod gets past the worker check and the threaded one doesn't
+		REQUIRE(mods[0]->call("getConsoleErr").value()[0].unsafe_cast<std::string>().find("threaded mods") == std::string::npos);
+		REQUIRE(mods[1]->call("getConsoleErr").value()[0].unsafe_cast<std::string>().find("threaded mods") != std::string::npos);
+
+		rawrbox::Hooks::remove("unsafe", "test");
+	}
+
+	SECTION("rawrbox::SCRIPTING::unloadMod") {
+		StepScripting::adopt(rawrbox::tests::makeMod("a_unloader", UNLOADER, unloading));
+		StepScripting::adopt(rawrbox::tests::makeMod("b_victim", VICTIM, unloading));
+
+		size_t ticks = 0;
+		rawrbox::SCRIPTING::onMessage += [&ticks](const rawrbox::ModMessage& /*msg*/) { ticks++; };
+
+		// a_unloader steps first, b_victim is skipped and only freed once the step is done
+		rawrbox::SCRIPTING::step(HOOK_TICK);
+		REQUIRE(ticks == 0);
+		REQUIRE_FALSE(rawrbox::SCRIPTING::hasMod("b_victim"));
+
+		StepScripting::adopt(rawrbox::tests::makeMod("b_victim", VICTIM, unloading));
+		REQUIRE_NOTHROW(rawrbox::SCRIPTING::call(HOOK_TICK));
+		REQUIRE_FALSE(rawrbox::SCRIPTING::hasMod("b_victim"));
+		REQUIRE(rawrbox::SCRIPTING::hasMod("a_unloader"));
+
+		rawrbox::SCRIPTING::onMessage.clear();
+		rawrbox::SCRIPTING::shutdown();
+	}
+}
+
+TEST_CASE("Mod threaded step benchmark", "[.benchmark][rawrbox::SCRIPTING]") {
+	initPool();
+
+	for (bool threaded : {false, true}) {
+		std::vector<std::unique_ptr<rawrbox::Mod>> mods = {};
+		for (size_t i = 0; i < 16; i++) {
+			mods.push_back(rawrbox::tests::makeMod(fmt::format("sim_{:02}", i), SIMULATION, messaging(threaded)));
+		}
+
+		mods.push_back(rawrbox::tests::makeMod("collector", COLLECTOR, messaging(false)));
+		auto ptrs = getPtrs(mods);
+
+		BENCHMARK(fmt::format("16 simulation mods, {}", threaded ? "threaded" : "serial")) {
+			rawrbox::SCRIPTING::step(ptrs, HOOK_TICK);
+		};
+	}
+}
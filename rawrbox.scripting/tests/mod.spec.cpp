@@ -1,4 +1,7 @@
 #include <rawrbox/scripting/mod.hpp>
+#include <rawrbox/scripting/wrappers/hooks.hpp>
+#include <rawrbox/scripting/wrappers/timer.hpp>
+#include <rawrbox/utils/timer.hpp>
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -12,6 +15,29 @@ TEST_CASE("Mod should behave as expected", "[rawrbox::Mod]") {
 		REQUIRE(mod.getID() == "my_mod");
 	}
 
+	SECTION("rawrbox::Mod::~Mod") {
+		auto hooks = rawrbox::Hooks::count();
+
+		{
+			rawrbox::Mod mod = {"my_mod", "./my_mod", {}};
+			luaL_openlibs(mod.getEnvironment());
+			rawrbox::Hooks::registerLua(mod.getEnvironment());
+			rawrbox::TimerWrapper::registerLua(mod.getEnvironment());
+
+			REQUIRE_NOTHROW(mod.init());
+			REQUIRE_NOTHROW(mod.script("hooks.add('closing', 'test', function() end) timer.simple('closing', 1000, function() end)"));
+
+			REQUIRE(rawrbox::Hooks::count() == hooks + 1);
+			REQUIRE(rawrbox::TIMER::exists("closing"));
+		}
+
+		// Both held refs into the closed state
+		REQUIRE(rawrbox::Hooks::count() == hooks);
+
+		rawrbox::TIMER::update();
+		REQUIRE_FALSE(rawrbox::TIMER::exists("closing"));
+	}
+
 	SECTION("rawrbox::Mod::init") {
 		rawrbox::Mod mod = {"my_mod", "./my_mod", {}};
 		luaL_openlibs(mod.getEnvironment());
@@ -37,4 +63,75 @@ TEST_CASE("Mod should behave as expected", "[rawrbox::Mod]") {
 
 		REQUIRE_NOTHROW(mod.gc());
 	}
+
+	SECTION("rawrbox::Mod::getStats") {
+		rawrbox::Mod mod = {"my_mod", "./my_mod", {}};
+		luaL_openlibs(mod.getEnvironment());
+
+		REQUIRE(mod.getStats().memory.bytes > 0); // State itself goes through the allocator
+		REQUIRE_NOTHROW(mod.init());
+		REQUIRE_NOTHROW(mod.script("function MOD:test() local t = {} for i = 1, 100 do t[i] = i end return #t end"));
+
+		for (size_t i = 0; i < 3; i++) {
+			REQUIRE(mod.call("test").has_value());
+		}
+
+		auto hook = mod.getHookStats(rawrbox::HookID("test"));
+		REQUIRE(hook.calls == 3);
+		REQUIRE(hook.totalNs >= hook.maxNs);
+
+		REQUIRE(mod.getHooksStats().size() == 1);
+		REQUIRE(mod.getStats().memory.allocations > 0);
+
+		mod.resetStats();
+		REQUIRE(mod.getHookStats(rawrbox::HookID("test")).calls == 0);
+	}
+
+	SECTION("rawrbox::Mod::gcStep") {
+		rawrbox::Mod mod = {"my_mod", "./my_mod", {}};
+		luaL_openlibs(mod.getEnvironment());
+		mod.setGCTuning(150, 200, 1);
+
+		REQUIRE_NOTHROW(mod.init());
+		REQUIRE_NOTHROW(mod.script("for i = 1, 1000 do local t = {i} end"));
+
+		bool finished = false;
+		for (size_t i = 0; i < 1000 && !finished; i++) {
+			finished = mod.gcStep(0.F); // One step each
+		}
+
+		REQUIRE(finished);
+		REQUIRE(mod.getStats().gcSteps > 0);
+	}
+
+	SECTION("rawrbox::Mod::setBudget") {
+		rawrbox::Mod mod = {"my_mod", "./my_mod", {}};
+		luaL_openlibs(mod.getEnvironment());
+		mod.setBudget(5.F, rawrbox::ModBudgetAction::PAUSE);
+
+		REQUIRE_NOTHROW(mod.init());
+		REQUIRE_NOTHROW(mod.script("function MOD:spin() while true do end end function MOD:ok() return true end"));
+
+		auto result = mod.call("spin");
+		REQUIRE((!result.has_value() || result->hasFailed()));
+
+		REQUIRE(mod.getStats().budgetOverruns == 1);
+		REQUIRE(mod.isPaused());
+		REQUIRE_FALSE(mod.call("ok").has_value()); // Skipped while paused
+
+		mod.resume();
+		REQUIRE(mod.call("ok").has_value());
+	}
+
+	SECTION("rawrbox::Mod::setMemoryLimit") {
+		rawrbox::Mod mod = {"my_mod", "./my_mod", {}};
+		luaL_openlibs(mod.getEnvironment());
+
+		REQUIRE_NOTHROW(mod.init());
+		mod.setMemoryLimit(mod.getStats().memory.bytes + 64 * 1024);
+
+		REQUIRE_THROWS(mod.script("local t = {} for i = 1, 1e6 do t[i] = i end"));
+		REQUIRE(mod.getStats().memory.failed > 0);
+		REQUIRE(mod.getStats().memory.bytes <= mod.getStats().memory.limit);
+	}
 }
@@ -0,0 +1,139 @@
+#include <rawrbox/scripting/manager.hpp>
+#include <rawrbox/scripting/mod.hpp>
+
+#include "helpers.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <fmt/format.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace {
+	// Typical per-tick mod work: steering entities with vector math
+	constexpr auto VECTOR_WORKLOAD = R"(
+		local ents = {}
+
+		function MOD:setup()
+			for i = 1, 2000 do
+				ents[i] = { pos = vector.create(i, 0, i * 0.5), vel = vector.create(1, 0.5, -1) }
+			end
+		end
+
+		function MOD:tick(dt: number)
+			local target = vector.create(100, 0, 100)
+			for _, e in ents do
+				local dir = target - e.pos
+				local len = vector.magnitude(dir)
+				if len > 0.001 then
+					e.vel = e.vel * 0.98 + (dir / len) * (dt * 4)
+				end
+
+				e.pos = e.pos + e.vel * dt
+			end
+
+			return #ents
+		end
+	)";
+
+	// Numeric loops, the kind used for noise / procedural gen
+	constexpr auto NUMERIC_WORKLOAD = R"(
+		function MOD:setup() end
+
+		function MOD:tick(dt: number)
+			local acc = 0
+			for x = 1, 200 do
+				for y = 1, 200 do
+					local v = math.sin(x * 0.1 + dt) * math.cos(y * 0.1 - dt)
+					acc += v * v
+				end
+			end
+
+			return acc
+		end
+	)";
+
+	// Table churn and sorting, mostly runtime calls so native helps least
+	constexpr auto TABLE_WORKLOAD = R"(
+		local items = {}
+
+		function MOD:setup()
+			for i = 1, 1000 do
+				items[i] = { id = i, score = (i * 7919) % 1000 }
+			end
+		end
+
+		function MOD:tick(dt: number)
+			for _, it in items do
+				it.score = (it.score * 31 + 17) % 1000
+			end
+
+			table.sort(items, function(a, b) return a.score < b.score end)
+			return items[1].id
+		end
+	)";
+
+	std::unique_ptr<rawrbox::Mod> makeBench(const char* workload, rawrbox::LuaNativeMode mode) {
+		auto mod = rawrbox::tests::makeMod("bench", workload, [mode](rawrbox::Mod& bench) { rawrbox::LuaUtils::enableNative(bench.getEnvironment(), mode); });
+		mod->call("setup");
+
+		return mod;
+	}
+} // namespace
+
+TEST_CASE("Lua native mode should behave as expected", "[rawrbox::LuaUtils]") {
+	SECTION("rawrbox::LuaUtils::enableNative") {
+		auto mod = std::make_unique<rawrbox::Mod>("my_mod", "./my_mod", glz::generic{});
+		auto* L = mod->getEnvironment();
+		luaL_openlibs(L);
+
+		REQUIRE(rawrbox::LuaUtils::getNativeMode(L) == rawrbox::LuaNativeMode::OFF);
+		REQUIRE_FALSE(rawrbox::LuaUtils::enableNative(L, rawrbox::LuaNativeMode::OFF));
+
+		bool native = rawrbox::LuaUtils::enableNative(L, rawrbox::LuaNativeMode::ALL);
+#ifndef RAWRBOX_SCRIPTING_NATIVE
+		REQUIRE_FALSE(native); // Not built, falls back to the interpreter
+#endif
+		REQUIRE(rawrbox::LuaUtils::getNativeMode(L) == (native ? rawrbox::LuaNativeMode::ALL : rawrbox::LuaNativeMode::OFF));
+
+		// Same results either way
+		REQUIRE_NOTHROW(mod->init());
+		REQUIRE_NOTHROW(mod->script("--!native\nfunction MOD:sum(n: number) local s = 0 for i = 1, n do s += i end return s end"));
+
+		auto result = mod->call("sum", 100);
+		REQUIRE(result.has_value());
+		REQUIRE(result.value()[0].unsafe_cast<int>() == 5050);
+	}
+
+	SECTION("rawrbox::SCRIPTING::getNativeMode") {
+#ifdef RAWRBOX_SCRIPTING_NATIVE
+		REQUIRE(rawrbox::SCRIPTING::getNativeMode() == rawrbox::LuaNativeMode::ANNOTATED);
+#else
+		REQUIRE(rawrbox::SCRIPTING::getNativeMode() == rawrbox::LuaNativeMode::OFF); // Nothing to enable
+#endif
+	}
+}
+
+TEST_CASE("Lua native mode benchmark", "[.benchmark][rawrbox::LuaUtils]") {
+	const std::pair<const char*, const char*> workloads[] = {
+	    {"vector", VECTOR_WORKLOAD},
+	    {"numeric", NUMERIC_WORKLOAD},
+	    {"table", TABLE_WORKLOAD},
+	};
+
+	for (const auto& [name, workload] : workloads) {
+		auto interpreted = makeBench(workload, rawrbox::LuaNativeMode::OFF);
+		auto native = makeBench(workload, rawrbox::LuaNativeMode::ALL);
+
+		BENCHMARK(fmt::format("{} tick, interpreted", name)) {
+			return interpreted->call("tick", 0.016F).has_value();
+		};
+
+		BENCHMARK(fmt::format("{} tick, native", name)) {
+			return native->call("tick", 0.016F).has_value();
+		};
+	}
+}
@@ -52,5 +52,9 @@ namespace rawrbox {
 			if (L == nullptr) throw std::runtime_error("Tried to register plugin on invalid mod!");
 			rawrbox::LuaUtils::compileAndLoadFile(L, "RawrBox::Enums::UI", "./lua/enums/ui.lua");
 		}
+
+		void removeState(lua_State* L) override {
+			rawrbox::UIWrapper::callbacks.removeState(L);
+		}
 	};
 } // namespace rawrbox
@@ -1,10 +1,13 @@
 #pragma once
+#include <rawrbox/scripting/utils/callbacks.hpp>
 #include <rawrbox/scripting/utils/lua.hpp>
 
 namespace rawrbox {
 	class UIRoot;
 	class UIWrapper {
 	public:
+		static rawrbox::LuaCallbacks callbacks; // Element events (onClick, onClose, ...), UIPlugin drops them per mod
+
 		static void registerLua(lua_State* L, rawrbox::UIRoot* root);
 	};
 } // namespace rawrbox
@@ -1,6 +1,7 @@
 
 #include <rawrbox/ui/elements/button.hpp>
 #include <rawrbox/ui/scripting/wrappers/button.hpp>
+#include <rawrbox/ui/scripting/wrappers/ui.hpp>
 
 namespace rawrbox {
 	void UIButtonWrapper::registerLua(lua_State* L) {
@@ -46,12 +47,8 @@ namespace rawrbox {
 		    .addFunction("setBorder", &rawrbox::UIButton::setBorder)
 		    .addFunction("borderEnabled", &rawrbox::UIButton::borderEnabled)
 		    .addFunction("onClick", [](rawrbox::UIButton& self, const luabridge::LuaRef& callback) {
-			    if (!callback.isCallable()) throw std::runtime_error("Callback not a function");
-
-			    self.onClick += [callback]() -> void {
-				    auto result = luabridge::call(callback);
-				    if (result.hasFailed()) fmt::print("Lua error\n  └── {}\n", result.errorMessage());
-			    };
+			    auto handle = rawrbox::UIWrapper::callbacks.add(callback);
+			    self.onClick += [handle]() -> void { rawrbox::LuaCallbacks::call(handle); };
 		    })
 		    .endClass();
 	}
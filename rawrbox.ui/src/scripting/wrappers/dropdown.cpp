@@ -1,5 +1,6 @@
 #include <rawrbox/ui/elements/dropdown.hpp>
 #include <rawrbox/ui/scripting/wrappers/dropdown.hpp>
+#include <rawrbox/ui/scripting/wrappers/ui.hpp>
 
 namespace rawrbox {
 	void UIDropdownWrapper::registerLua(lua_State* L) {
@@ -16,12 +17,8 @@ namespace rawrbox {
 		    .addFunction("getSelectedValue", &rawrbox::UIDropdown::getSelectedValue)
 
 		    .addFunction("onSelectionChange", [](rawrbox::UIDropdown& self, const luabridge::LuaRef& callback) {
-			    if (!callback.isCallable()) throw std::runtime_error("Callback not a function");
-
-			    self.onSelectionChange += [callback](size_t index, const std::string& value) -> void {
-				    auto result = luabridge::call(callback, index, value);
-				    if (result.hasFailed()) fmt::print("Lua error\n  └── {}\n", result.errorMessage());
-			    };
+			    auto handle = rawrbox::UIWrapper::callbacks.add(callback);
+			    self.onSelectionChange += [handle](size_t index, const std::string& value) -> void { rawrbox::LuaCallbacks::call(handle, index, value); };
 		    })
 		    .endClass();
 	}
@@ -1,5 +1,6 @@
 #include <rawrbox/ui/elements/frame.hpp>
 #include <rawrbox/ui/scripting/wrappers/frame.hpp>
+#include <rawrbox/ui/scripting/wrappers/ui.hpp>
 
 namespace rawrbox {
 	void UIFrameWrapper::registerLua(lua_State* L) {
@@ -17,12 +18,8 @@ namespace rawrbox {
 		    .addFunction("setDraggable", &rawrbox::UIFrame::setDraggable)
 		    .addFunction("isDraggable", &rawrbox::UIFrame::isDraggable)
 		    .addFunction("onClose", [](rawrbox::UIFrame& self, const luabridge::LuaRef& callback) {
-			    if (!callback.isCallable()) throw std::runtime_error("Callback not a function");
-
-			    self.onClose += [callback]() -> void {
-				    auto result = luabridge::call(callback);
-				    if (result.hasFailed()) fmt::print("Lua error\n  └── {}\n", result.errorMessage());
-			    };
+			    auto handle = rawrbox::UIWrapper::callbacks.add(callback);
+			    self.onClose += [handle]() -> void { rawrbox::LuaCallbacks::call(handle); };
 		    })
 		    .endClass();
 	}
@@ -1,5 +1,6 @@
 #include <rawrbox/ui/elements/input.hpp>
 #include <rawrbox/ui/scripting/wrappers/input.hpp>
+#include <rawrbox/ui/scripting/wrappers/ui.hpp>
 
 namespace rawrbox {
 	void UIInputWrapper::registerLua(lua_State* L) {
@@ -56,28 +57,16 @@ namespace rawrbox {
 		    .addFunction("clear", &rawrbox::UIInput::clear)
 
 		    .addFunction("onKey", [](rawrbox::UIInput& self, const luabridge::LuaRef& callback) {
-			    if (!callback.isCallable()) throw std::runtime_error("Callback not a function");
-
-			    self.onKey += [callback](uint32_t key) -> void {
-				    auto result = luabridge::call(callback, key);
-				    if (result.hasFailed()) fmt::print("Lua error\n  └── {}\n", result.errorMessage());
-			    };
+			    auto handle = rawrbox::UIWrapper::callbacks.add(callback);
+			    self.onKey += [handle](uint32_t key) -> void { rawrbox::LuaCallbacks::call(handle, key); };
 		    })
 		    .addFunction("onTextUpdate", [](rawrbox::UIInput& self, const luabridge::LuaRef& callback) {
-			    if (!callback.isCallable()) throw std::runtime_error("Callback not a function");
-
-			    self.onTextUpdate += [callback]() -> void {
-				    auto result = luabridge::call(callback);
-				    if (result.hasFailed()) fmt::print("Lua error\n  └── {}\n", result.errorMessage());
-			    };
+			    auto handle = rawrbox::UIWrapper::callbacks.add(callback);
+			    self.onTextUpdate += [handle]() -> void { rawrbox::LuaCallbacks::call(handle); };
 		    })
 		    .addFunction("onEnter", [](rawrbox::UIInput& self, const luabridge::LuaRef& callback) {
-			    if (!callback.isCallable()) throw std::runtime_error("Callback not a function");
-
-			    self.onEnter += [callback]() -> void {
-				    auto result = luabridge::call(callback);
-				    if (result.hasFailed()) fmt::print("Lua error\n  └── {}\n", result.errorMessage());
-			    };
+			    auto handle = rawrbox::UIWrapper::callbacks.add(callback);
+			    self.onEnter += [handle]() -> void { rawrbox::LuaCallbacks::call(handle); };
 		    })
 		    .endClass();
 	}
@@ -1,5 +1,6 @@
 #include <rawrbox/ui/elements/tabs.hpp>
 #include <rawrbox/ui/scripting/wrappers/tabs.hpp>
+#include <rawrbox/ui/scripting/wrappers/ui.hpp>
 
 namespace rawrbox {
 	void UITabsWrapper::registerLua(lua_State* L) {
@@ -15,12 +16,8 @@ namespace rawrbox {
 		    .addStaticProperty("TAB_HEIGHT", &rawrbox::UITabs::TAB_HEIGHT)
 
 		    .addFunction("onTabChange", [](rawrbox::UITabs& self, const luabridge::LuaRef& callback) {
-			    if (!callback.isCallable()) throw std::runtime_error("Callback not a function");
-
-			    self.onTabChange += [callback](const std::string& tabId) -> void {
-				    auto result = luabridge::call(callback, tabId);
-				    if (result.hasFailed()) fmt::print("Lua error\n  └── {}\n", result.errorMessage());
-			    };
+			    auto handle = rawrbox::UIWrapper::callbacks.add(callback);
+			    self.onTabChange += [handle](const std::string& tabId) -> void { rawrbox::LuaCallbacks::call(handle, tabId); };
 		    })
 
 		    .endClass();
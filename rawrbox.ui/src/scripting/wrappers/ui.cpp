@@ -14,6 +14,8 @@
 #include <rawrbox/ui/scripting/wrappers/ui.hpp>
 
 namespace rawrbox {
+	rawrbox::LuaCallbacks UIWrapper::callbacks = {};
+
 	void UIWrapper::registerLua(lua_State* L, rawrbox::UIRoot* root) {
 		luabridge::getGlobalNamespace(L)
 		    .beginNamespace("ui", luabridge::allowOverridingMethods)
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace rawrbox {
+	using SHA256Digest = std::array<uint8_t, 32>;
+
+	// FIPS 180-4 SHA-256, for content checks where a 64 bit hash is not enough
+	class SHA256 {
+	public:
+		static rawrbox::SHA256Digest hash(const void* data, size_t size);
+		static rawrbox::SHA256Digest hash(const std::string& data);
+
+		static std::string toHex(const rawrbox::SHA256Digest& digest);
+	};
+} // namespace rawrbox
@@ -18,5 +18,8 @@ namespace rawrbox {
 		static void shutdown();
 
 		static void run(const std::function<void()>& job);
+
+		// Splits [0, count) into blocks and waits for all of them, runs inline if the pool is not ready, the work is too small or we are already on a pool thread
+		static void parallel(size_t count, const std::function<void(size_t, size_t)>& job, size_t minBlock = 256);
 	};
 } // namespace rawrbox
@@ -2,6 +2,8 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+
 namespace rawrbox {
 	// PRIVATE -------------
 	std::unique_ptr<BS::thread_pool<>> ASYNC::_pool = nullptr;
@@ -32,4 +34,21 @@ namespace rawrbox {
 			RAWRBOX_CRITICAL("Fatal error\n  └── {}", e.what());
 		}
 	}
+
+	void ASYNC::parallel(size_t count, const std::function<void(size_t, size_t)>& job, size_t minBlock) {
+		if (count == 0) return;
+
+		minBlock = std::max<size_t>(minBlock, 1);
+		if (_pool == nullptr || count <= minBlock || BS::this_thread::get_index().has_value()) {
+			job(0, count);
+			return;
+		}
+
+		size_t blocks = std::min<size_t>(_pool->get_thread_count(), (count + minBlock - 1) / minBlock);
+		try {
+			_pool->submit_blocks<size_t>(0, count, job, blocks).wait();
+		} catch (const std::exception& e) {
+			RAWRBOX_CRITICAL("Fatal error\n  └── {}", e.what());
+		}
+	}
 } // namespace rawrbox
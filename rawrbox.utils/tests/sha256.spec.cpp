@@ -0,0 +1,27 @@
+#include <rawrbox/utils/sha256.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+TEST_CASE("SHA256 should behave as expected", "[rawrbox::SHA256]") {
+	SECTION("rawrbox::SHA256::hash") {
+		REQUIRE(rawrbox::SHA256::toHex(rawrbox::SHA256::hash("")) == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+		REQUIRE(rawrbox::SHA256::toHex(rawrbox::SHA256::hash("abc")) == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+		REQUIRE(rawrbox::SHA256::toHex(rawrbox::SHA256::hash("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq")) == "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+		REQUIRE(rawrbox::SHA256::toHex(rawrbox::SHA256::hash(std::string(1000000, 'a'))) == "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+
+		// Padding spills into a second block from 56 bytes on
+		REQUIRE(rawrbox::SHA256::toHex(rawrbox::SHA256::hash(std::string(55, 'a'))) == "9f4390f8d30c2dd92ec9f095b65e2b9ae9b0a925a5258e241c9f1e910f734318");
+		REQUIRE(rawrbox::SHA256::toHex(rawrbox::SHA256::hash(std::string(56, 'a'))) == "b35439a4ac6f0948b6d6f9e3c6af0f5f590ce20f1bde7090ef7970686ec6738a");
+		REQUIRE(rawrbox::SHA256::toHex(rawrbox::SHA256::hash(std::string(64, 'a'))) == "ffe054fe7ae0cb6dc65c3af9b61d5209f439851db43d0ba5997337df154668eb");
+	}
+
+	SECTION("rawrbox::SHA256::toHex") {
+		rawrbox::SHA256Digest digest = {};
+		digest[0] = 0x0f;
+		digest[31] = 0xa0;
+
+		REQUIRE(rawrbox::SHA256::toHex(digest) == "0f000000000000000000000000000000000000000000000000000000000000a0");
+	}
+}
@@ -18,6 +18,7 @@ namespace rawrbox {
 
 	struct WEBMFrame {
 		long long pos = 0;
+		uint64_t time = 0; // Presentation time in ns
 
 		std::vector<uint8_t> buffer = {};
 		rawrbox::VIDEO_CODEC codec = rawrbox::VIDEO_CODEC::UNKNOWN;
@@ -29,23 +30,29 @@ namespace rawrbox {
 		std::vector<uint8_t> pixels = {};
 		rawrbox::Vector2u size = {};
 
+		uint64_t time = 0; // Presentation time in ns
+		bool end = false;  // Marks where the stream ended, has no pixels
+
 		[[nodiscard]] inline bool valid() const { return !pixels.empty(); }
 	};
 
+	// One per stream, vpx contexts keep reference frames so they can't be shared
 	class WEBMDecoder {
 	private:
-		static rawrbox::VIDEO_CODEC _codec;
-		static std::unique_ptr<vpx_codec_ctx> _ctx;
-		static const void* _iter;
-
-		// LOGGER ------
-		static std::unique_ptr<rawrbox::Logger> _logger;
-		// -------------
+		rawrbox::VIDEO_CODEC _codec = rawrbox::VIDEO_CODEC::UNKNOWN;
+		std::unique_ptr<vpx_codec_ctx> _ctx; // Incomplete here, no initializer
 
 	public:
-		static void init(rawrbox::VIDEO_CODEC codec, uint32_t threads = 6);
-		static void shutdown();
+		explicit WEBMDecoder(rawrbox::VIDEO_CODEC codec, uint32_t threads = 2);
+		WEBMDecoder(const WEBMDecoder&) = delete;
+		WEBMDecoder(WEBMDecoder&&) = delete;
+		WEBMDecoder& operator=(const WEBMDecoder&) = delete;
+		WEBMDecoder& operator=(WEBMDecoder&&) = delete;
+		~WEBMDecoder();
+
+		// convert = false still decodes (later frames reference this one) but skips the RGBA conversion, used to drop late frames
+		bool decode(const rawrbox::WEBMFrame& frame, rawrbox::WEBMImage& image, bool convert = true);
 
-		static bool decode(const rawrbox::WEBMFrame& frame, rawrbox::WEBMImage& image);
+		[[nodiscard]] rawrbox::VIDEO_CODEC getCodec() const;
 	};
 } // namespace rawrbox
@@ -7,8 +7,13 @@
 #include <mkvparser/mkvparser.h>
 #include <mkvparser/mkvreader.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <filesystem>
+#include <mutex>
 #include <string>
+#include <thread>
 
 namespace rawrbox {
 	// NOLINTBEGIN{unused-const-variable}
@@ -18,6 +23,12 @@ namespace rawrbox {
 	}; // namespace WEBMLoadFlags
 	// NOLINTEND{unused-const-variable}
 
+	struct WEBMStats {
+		uint64_t decoded = 0;   // Converted to RGBA
+		uint64_t presented = 0; // Handed to present()
+		uint64_t dropped = 0;   // Late, skipped or never shown
+	};
+
 	struct WEBMInfo {
 		rawrbox::Vector2u size = {};
 
@@ -30,6 +41,11 @@ namespace rawrbox {
 	};
 
 	class WEBM {
+	protected:
+		rawrbox::WEBMInfo _info = {};
+		rawrbox::WEBMFrame _frame = {}; // Written by demux()
+		uint32_t _flags = 0;
+
 	private:
 		std::filesystem::path _filePath = {};
 
@@ -38,14 +54,37 @@ namespace rawrbox {
 		int _videoTrack = 0;
 
 		bool _loop = false;
-		bool _paused = false;
-		bool _eos = false;
+		bool _loaded = false;
+		std::atomic<bool> _paused = false; // Set from anywhere, present() flips it on the end
 
-		uint32_t _flags = 0;
+		std::vector<rawrbox::WEBMImage> _preloadedFrames = {}; // By time
+		size_t _preloadedIndex = SIZE_MAX;
 
-		rawrbox::WEBMInfo _info = {};
-		rawrbox::WEBMFrame _frame = {};
-		std::unordered_map<long long, rawrbox::WEBMImage> _preloadedFrames = {};
+		std::unique_ptr<rawrbox::WEBMDecoder> _decoder = nullptr;
+
+		// DECODE AHEAD ------
+		std::jthread _thread;
+		std::mutex _demuxMutex; // Guards the demuxer and _frame, held while reading from disk
+		std::mutex _mutex;      // Guards the queue, pool and clock. Generation / time base change under both, taken demux first
+		std::condition_variable_any _wake;
+
+		std::deque<rawrbox::WEBMImage> _queue = {}; // Decoded, waiting for their time
+		std::vector<rawrbox::WEBMImage> _pool = {}; // Recycled pixel buffers
+		rawrbox::WEBMImage _presented = {};
+
+		uint64_t _generation = 0; // Bumped on seek / reset, frames decoded before it are thrown away
+		uint64_t _timeBase = 0;   // Added to frame times, grows every loop so time never goes back
+		uint32_t _lateSkips = 0;
+		bool _streamEnded = false;
+		// -------------------
+
+		// CLOCK ------
+		uint64_t _playTime = 0; // ns
+		uint64_t _lastPresent = 0;
+		bool _started = false;
+		// -------------------
+
+		rawrbox::WEBMStats _stats = {};
 
 		std::unique_ptr<mkvparser::MkvReader> _reader = nullptr;
 		std::unique_ptr<mkvparser::Segment> _segment = nullptr;
@@ -62,7 +101,31 @@ namespace rawrbox {
 		void preloadVideo();
 		void internalLoad();
 
+		void restart(uint64_t time);
+
+		[[nodiscard]] const rawrbox::WEBMFrame& getFrame() const; // Demuxer scratch, only safe before the decode thread starts
+
+		void decodeThread(const std::stop_token& stop);
+		void recycle(rawrbox::WEBMImage& img);
+		[[nodiscard]] uint64_t getFrameDuration() const;
+
+	protected:
+		// DEMUX / DECODE ------
+		// Called with the demuxer lock held, on the decode thread. Overridable so playback can run without a file or libvpx
+		virtual bool demux(); // Next video frame into _frame, false on the stream end
+		virtual void rewind();
+		virtual void seekDemuxer(uint64_t time); // ns, lands on the cluster holding it
+
+		virtual bool decode(const rawrbox::WEBMFrame& frame, rawrbox::WEBMImage& image, bool convert = true);
+		// -------------------
+
+		void play(); // _info is set, preload or start the decode thread
+		void stop(); // Joins the decode thread, subclasses call it on destruction since it uses their overrides
+
 	public:
+		static constexpr size_t MAX_DECODE_AHEAD = 4; // Frames queued per stream
+		static constexpr uint32_t MAX_LATE_SKIPS = 8; // Late frames skipped in a row before one is shown anyway
+
 		rawrbox::Event<> onEnd;
 
 		WEBM() = default;
@@ -70,20 +133,18 @@ namespace rawrbox {
 		WEBM(WEBM&&) = delete;
 		WEBM& operator=(const WEBM&) = delete;
 		WEBM& operator=(WEBM&&) = delete;
-		~WEBM();
+		virtual ~WEBM();
 
 		void load(const std::filesystem::path& filePath, uint32_t flags = 0);
-		bool advance();
-		[[nodiscard]] bool eos() const;
 
 		void reset();
 		void seek(uint64_t timeMS);
 
-		[[nodiscard]] bool getNextFrame(rawrbox::WEBMImage& img);
+		// Frame due at the current play time, nullptr if it didn't change. Valid until the next call
+		[[nodiscard]] const rawrbox::WEBMImage* present();
 
 		// UTILS ------
 		[[nodiscard]] const rawrbox::Vector2u& getSize() const;
-		[[nodiscard]] const rawrbox::WEBMFrame& getFrame() const;
 		[[nodiscard]] const rawrbox::WEBMInfo& getInfo() const;
 
 		[[nodiscard]] bool getLoop() const;
@@ -93,6 +154,7 @@ namespace rawrbox {
 		void setPaused(bool paused);
 
 		[[nodiscard]] bool isPreLoaded() const;
+		[[nodiscard]] rawrbox::WEBMStats getStats();
 		// --------
 	};
 } // namespace rawrbox
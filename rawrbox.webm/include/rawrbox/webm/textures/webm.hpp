@@ -13,7 +13,7 @@ namespace rawrbox {
 		std::unique_ptr<rawrbox::WEBM> _webm = nullptr;
 
 		void internalLoad(const std::vector<uint8_t>& data, bool useFallback = true) override;
-		void internalUpdate();
+		void internalUpdate(const rawrbox::WEBMImage& img);
 
 	public:
 		rawrbox::Event<> onEnd;
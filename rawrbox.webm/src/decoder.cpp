@@ -9,18 +9,7 @@
 #include <vpx/vpx_decoder.h>
 
 namespace rawrbox {
-	// PRIVATE -----
-	std::unique_ptr<vpx_codec_ctx> WEBMDecoder::_ctx = nullptr;
-	const void* WEBMDecoder::_iter = nullptr;
-
-	rawrbox::VIDEO_CODEC WEBMDecoder::_codec = rawrbox::VIDEO_CODEC::UNKNOWN;
-
-	// LOGGER ------
-	std::unique_ptr<rawrbox::Logger> WEBMDecoder::_logger = std::make_unique<rawrbox::Logger>("RawrBox-WEBMDecoder");
-	// -------------
-	// ------
-
-	void WEBMDecoder::init(rawrbox::VIDEO_CODEC codec, uint32_t threads) {
+	WEBMDecoder::WEBMDecoder(rawrbox::VIDEO_CODEC codec, uint32_t threads) : _codec(codec) {
 		const vpx_codec_dec_cfg_t codecCfg = {
 		    threads,
 		    0,
@@ -38,35 +27,38 @@ namespace rawrbox {
 				RAWRBOX_CRITICAL("Invalid vpx codec");
 		}
 
-		_codec = codec;
-		_ctx = std::make_unique<vpx_codec_ctx>();
-
-		if (vpx_codec_dec_init(_ctx.get(), codecIface, &codecCfg, VPX_CODEC_USE_FRAME_THREADING)) {
-			_ctx.reset();
+		this->_ctx = std::make_unique<vpx_codec_ctx>();
+		if (vpx_codec_dec_init(this->_ctx.get(), codecIface, &codecCfg, VPX_CODEC_USE_FRAME_THREADING)) {
+			this->_ctx.reset();
 			RAWRBOX_CRITICAL("Failed to initialize vpx codec");
 		}
 	}
 
-	void WEBMDecoder::shutdown() {
-		vpx_codec_destroy(_ctx.get());
-		_ctx.reset();
+	WEBMDecoder::~WEBMDecoder() {
+		if (this->_ctx == nullptr) return;
+
+		vpx_codec_destroy(this->_ctx.get());
+		this->_ctx.reset();
 	}
 
-	bool WEBMDecoder::decode(const rawrbox::WEBMFrame& frame, rawrbox::WEBMImage& image) {
-		if (_ctx == nullptr)
-			RAWRBOX_CRITICAL("Codec not initialized, did you call 'init' ?");
+	bool WEBMDecoder::decode(const rawrbox::WEBMFrame& frame, rawrbox::WEBMImage& image, bool convert) {
+		if (this->_ctx == nullptr) RAWRBOX_CRITICAL("Codec not initialized");
 
-		if (frame.codec != _codec) {
+		if (frame.codec != this->_codec) {
 			const auto* badname = magic_enum::enum_name(static_cast<rawrbox::VIDEO_CODEC>(frame.codec)).data();
-			const auto* name = magic_enum::enum_name(static_cast<rawrbox::VIDEO_CODEC>(_codec)).data();
+			const auto* name = magic_enum::enum_name(static_cast<rawrbox::VIDEO_CODEC>(this->_codec)).data();
 
 			RAWRBOX_CRITICAL("Codec '{}' not set as config! '{}' was loaded instead", badname, name);
 		}
 
-		_iter = nullptr;
-		if (vpx_codec_decode(_ctx.get(), frame.buffer.data(), static_cast<uint32_t>(frame.buffer.size()), nullptr, 0) != 0) return false;
+		const void* iter = nullptr;
+		if (vpx_codec_decode(this->_ctx.get(), frame.buffer.data(), static_cast<uint32_t>(frame.buffer.size()), nullptr, 0) != 0) return false;
+
+		image.time = frame.time;
+		image.end = false;
 
-		if (vpx_image_t* img = vpx_codec_get_frame(_ctx.get(), &_iter)) {
+		if (vpx_image_t* img = vpx_codec_get_frame(this->_ctx.get(), &iter)) {
+			if (!convert) return true;
 			if ((img->fmt & VPX_IMG_FMT_PLANAR) == 0) RAWRBOX_CRITICAL("Failed to get image! Image not in FMT_PLANAR!");
 
 			rawrbox::YUVLuminanceScale scale = rawrbox::YUVLuminanceScale::UNKNOWN;
@@ -97,8 +89,12 @@ namespace rawrbox {
 				default:
 					RAWRBOX_CRITICAL("Format not supported, video not in I420 format");
 			}
+
+			return true;
 		}
 
-		return true;
+		return false; // Decoded, but nothing to show yet
 	}
+
+	rawrbox::VIDEO_CODEC WEBMDecoder::getCodec() const { return this->_codec; }
 } // namespace rawrbox
@@ -1,29 +1,28 @@
 
 #include <rawrbox/webm/loader.hpp>
 
+#include <rawrbox/utils/time.hpp>
+
 #include <fmt/format.h>
 
-#include <mutex>
+#include <algorithm>
 
 namespace rawrbox {
-	static std::mutex RENDER_THREAD_LOCK;
-
 	void WEBM::preloadVideo() {
-		std::lock_guard<std::mutex> lock(RENDER_THREAD_LOCK);
 		this->_logger->debug("Pre-loading video '{}'", fmt::styled(this->_filePath.generic_string(), fmt::fg(fmt::color::light_coral)));
 
-		while (this->advance()) {
-			auto frame = this->getFrame();
+		while (this->demux()) {
+			const auto& frame = this->getFrame();
 			if (!frame.valid()) RAWRBOX_CRITICAL("Failed to find frame");
 
 			rawrbox::WEBMImage img;
-			if (!rawrbox::WEBMDecoder::decode(frame, img) || !img.valid()) RAWRBOX_CRITICAL("Failed to decode frame");
+			if (!this->decode(frame, img) || !img.valid()) RAWRBOX_CRITICAL("Failed to decode frame");
 
-			this->_preloadedFrames[frame.pos] = img;
+			this->_preloadedFrames.push_back(std::move(img));
 		}
 
 		this->_logger->debug("Done pre-loading '{}'", fmt::styled(this->_filePath.generic_string(), fmt::fg(fmt::color::light_coral)));
-		this->reset();
+		this->rewind();
 	}
 
 	void WEBM::internalLoad() {
@@ -96,54 +95,30 @@ namespace rawrbox {
 		this->_info.size = {static_cast<uint32_t>(this->_video->GetWidth()), static_cast<uint32_t>(this->_video->GetHeight())};
 		// -----
 
-		// Start pre-loading video if flag enabled ----
-		if ((this->_flags & rawrbox::WEBMLoadFlags::PRELOAD) > 0) {
-			this->preloadVideo();
-		}
-		// -----
+		this->_decoder = std::make_unique<rawrbox::WEBMDecoder>(this->_info.vCodec);
+		this->play();
 	}
 
-	WEBM::~WEBM() {
-		this->_reader->Close();
-		this->_reader.reset();
-
-		this->_segment.reset();
-
-		this->_preloadedFrames.clear();
+	void WEBM::play() {
+		this->_loaded = true;
 
-		this->_cluster = nullptr;
-		this->_blockEntry = nullptr;
-		this->_block = nullptr;
-		this->_video = nullptr;
+		// Pre-load everything, or keep a few frames decoded ahead ----
+		if (this->isPreLoaded()) {
+			this->preloadVideo();
+		} else {
+			this->_thread = std::jthread([this](const std::stop_token& stop) { this->decodeThread(stop); });
+		}
+		// -----
 	}
 
-	void WEBM::load(const std::filesystem::path& filePath, uint32_t flags) {
-		this->_flags = flags;
-		this->_filePath = filePath;
-		this->_reader = std::make_unique<mkvparser::MkvReader>();
-
-		if (this->_reader->Open(filePath.string().c_str()) != 0)
-			RAWRBOX_CRITICAL("Filename is invalid or error while opening");
+	void WEBM::stop() {
+		if (!this->_thread.joinable()) return;
 
-		this->internalLoad();
+		this->_thread.request_stop();
+		this->_thread.join();
 	}
 
-	bool WEBM::advance() {
-		if (this->_video == nullptr) RAWRBOX_CRITICAL("Video not loaded! Did you call load()?");
-		if (this->_paused) return false;
-
-		if (this->eos()) {
-			if (this->_loop) {
-				this->reset();
-				this->onEnd();
-			} else {
-				this->setPaused(true);
-				this->onEnd();
-
-				return false; // Reached the end
-			}
-		}
-
+	bool WEBM::demux() {
 		if (this->_cluster == nullptr) {
 			this->_cluster = this->_segment->GetFirst();
 		}
@@ -160,10 +135,7 @@ namespace rawrbox {
 			} else if (blockEntryEOS || this->_blockEntry->EOS()) {
 				this->_cluster = this->_segment->GetNext(this->_cluster);
 
-				if (this->_cluster == nullptr || this->_cluster->EOS()) {
-					this->_eos = true;
-					return false; // Reached end
-				}
+				if (this->_cluster == nullptr || this->_cluster->EOS()) return false; // Reached end
 
 				status = this->_cluster->GetFirst(this->_blockEntry);
 
@@ -199,6 +171,7 @@ namespace rawrbox {
 		this->_frame.buffer.resize(blockFrame.len);
 		this->_frame.codec = this->_info.vCodec;
 		this->_frame.pos = blockFrame.pos;
+		this->_frame.time = static_cast<uint64_t>(std::max<long long>(this->_block->GetTime(this->_cluster), 0));
 
 		blockFrame.Read(this->_reader.get(), this->_frame.buffer.data());
 		// ----------------------
@@ -206,52 +179,272 @@ namespace rawrbox {
 		return true;
 	}
 
-	bool WEBM::eos() const {
-		return this->_eos;
-	}
+	void WEBM::rewind() {
+		this->_cluster = this->_segment->GetFirst();
 
-	void WEBM::reset() {
-		if (this->_video == nullptr || this->_segment == nullptr) RAWRBOX_CRITICAL("Video not loaded! Did you call 'load' ?");
+		this->_blockEntry = nullptr;
+		this->_block = nullptr;
 
-		this->_cluster = this->_segment->GetFirst();
+		this->_blockFrameIndex = 0;
+	}
+
+	void WEBM::seekDemuxer(uint64_t time) {
+		this->_cluster = this->_segment->FindCluster(static_cast<long long>(time));
 
 		this->_blockEntry = nullptr;
 		this->_block = nullptr;
 
 		this->_blockFrameIndex = 0;
-		this->_eos = false;
-		this->_paused = false;
 	}
 
-	void WEBM::seek(uint64_t timeMS) {
-		if (this->_video == nullptr || this->_segment == nullptr) RAWRBOX_CRITICAL("Video not loaded! Did you call 'load' ?");
+	bool WEBM::decode(const rawrbox::WEBMFrame& frame, rawrbox::WEBMImage& image, bool convert) {
+		return this->_decoder->decode(frame, image, convert);
+	}
+
+	void WEBM::restart(uint64_t time) {
+		this->_generation++;
+
+		for (auto& img : this->_queue) {
+			this->recycle(img);
+		}
+
+		this->_queue.clear();
+		this->_streamEnded = false;
+		this->_timeBase = 0;
+		this->_lateSkips = 0;
+
+		this->_playTime = time;
+		this->_lastPresent = 0;
+		this->_started = false;
+		this->_preloadedIndex = SIZE_MAX;
+
+		this->_wake.notify_all();
+	}
+
+	void WEBM::decodeThread(const std::stop_token& stop) {
+		rawrbox::WEBMFrame frame = {};
+		std::unique_lock<std::mutex> lock(this->_mutex);
+
+		while (!stop.stop_requested()) {
+			if (!this->_wake.wait(lock, stop, [this]() { return !this->_streamEnded && this->_queue.size() < MAX_DECODE_AHEAD; })) break; // Stopped
+			lock.unlock();
+
+			// Demux ----
+			// Own lock, reading the block hits the disk and present() shouldn't wait on it
+			std::unique_lock<std::mutex> demuxLock(this->_demuxMutex);
+			auto generation = this->_generation; // Only changes with both locks held
+
+			if (!this->demux()) {
+				rawrbox::WEBMImage marker = {};
+				marker.end = true;
+				marker.time = this->_timeBase + this->_frame.time + this->getFrameDuration();
+
+				lock.lock();
+
+				// present() fires onEnd when it reaches this, on its own thread
+				this->_queue.push_back(std::move(marker));
+
+				if (this->_loop) {
+					this->_timeBase = this->_queue.back().time;
+					this->rewind();
+				} else {
+					this->_streamEnded = true;
+				}
+
+				continue;
+			}
+
+			frame.buffer.assign(this->_frame.buffer.begin(), this->_frame.buffer.end());
+			frame.codec = this->_frame.codec;
+			frame.pos = this->_frame.pos;
+			frame.time = this->_timeBase + this->_frame.time;
+
+			demuxLock.unlock();
+			// ---------
+
+			lock.lock();
+
+			// Behind the clock, decode for the reference frames but skip the conversion
+			bool late = this->_started && frame.time + this->getFrameDuration() < this->_playTime && this->_lateSkips < MAX_LATE_SKIPS;
+
+			rawrbox::WEBMImage img = {};
+			if (!this->_pool.empty()) {
+				img = std::move(this->_pool.back());
+				this->_pool.pop_back();
+			}
+
+			lock.unlock();
+			bool decoded = this->decode(frame, img, !late);
+			lock.lock();
+
+			if (late) {
+				this->_lateSkips++;
+				this->_stats.dropped++;
+			}
+
+			if (!decoded || late || generation != this->_generation || !img.valid()) {
+				this->recycle(img);
+				continue;
+			}
+
+			this->_lateSkips = 0;
+			this->_stats.decoded++;
+			this->_queue.push_back(std::move(img));
+		}
+	}
+
+	const rawrbox::WEBMFrame& WEBM::getFrame() const {
+		return this->_frame;
+	}
+
+	void WEBM::recycle(rawrbox::WEBMImage& img) {
+		img.end = false;
+		if (img.pixels.capacity() == 0 || this->_pool.size() >= MAX_DECODE_AHEAD + 2) return;
 
-		this->_cluster = this->_segment->FindCluster(timeMS * 1000000);
+		this->_pool.push_back(std::move(img));
+	}
+
+	uint64_t WEBM::getFrameDuration() const {
+		if (this->_info.frameRate <= 0) return 1000000000ULL / 30ULL; // Most files don't store it
+		return static_cast<uint64_t>(1000000000.0 / this->_info.frameRate);
+	}
 
+	WEBM::~WEBM() {
+		this->stop();
+
+		if (this->_reader != nullptr) {
+			this->_reader->Close();
+			this->_reader.reset();
+		}
+
+		this->_segment.reset();
+
+		this->_preloadedFrames.clear();
+		this->_queue.clear();
+		this->_pool.clear();
+		this->_decoder.reset();
+
+		this->_cluster = nullptr;
 		this->_blockEntry = nullptr;
 		this->_block = nullptr;
+		this->_video = nullptr;
+	}
 
-		this->_blockFrameIndex = 0;
-		this->_eos = false;
+	void WEBM::load(const std::filesystem::path& filePath, uint32_t flags) {
+		this->_flags = flags;
+		this->_filePath = filePath;
+		this->_reader = std::make_unique<mkvparser::MkvReader>();
+
+		if (this->_reader->Open(filePath.string().c_str()) != 0)
+			RAWRBOX_CRITICAL("Filename is invalid or error while opening");
+
+		this->internalLoad();
 	}
 
-	bool WEBM::getNextFrame(rawrbox::WEBMImage& img) {
-		if (this->_paused) return false;
+	void WEBM::reset() {
+		if (!this->_loaded) RAWRBOX_CRITICAL("Video not loaded! Did you call 'load' ?");
+		std::scoped_lock lock(this->_demuxMutex, this->_mutex);
 
-		bool success = this->advance();
-		if (!success) return false;
+		this->rewind();
+		this->restart(0);
 
-		auto frame = this->getFrame();
-		if (!frame.valid()) return false;
+		this->_paused = false;
+	}
 
-		if (this->isPreLoaded()) {
-			img = this->_preloadedFrames[frame.pos];
-		} else {
-			std::lock_guard<std::mutex> lock(RENDER_THREAD_LOCK);
-			rawrbox::WEBMDecoder::decode(frame, img);
+	void WEBM::seek(uint64_t timeMS) {
+		if (!this->_loaded) RAWRBOX_CRITICAL("Video not loaded! Did you call 'load' ?");
+		std::scoped_lock lock(this->_demuxMutex, this->_mutex);
+
+		this->seekDemuxer(timeMS * 1000000);
+		this->restart(timeMS * 1000000);
+	}
+
+	const rawrbox::WEBMImage* WEBM::present() {
+		if (!this->_loaded) RAWRBOX_CRITICAL("Video not loaded! Did you call load()?");
+
+		const rawrbox::WEBMImage* result = nullptr;
+		bool ended = false;
+
+		{
+			std::scoped_lock<std::mutex> lock(this->_mutex);
+			if (this->_paused) {
+				this->_lastPresent = 0; // Don't count the pause
+				return nullptr;
+			}
+
+			// Clock ----
+			auto now = rawrbox::TimeUtils::curtime();
+			if (this->_started && this->_lastPresent != 0) this->_playTime += (now - this->_lastPresent) * 1000000ULL;
+			this->_lastPresent = now;
+			// ---------
+
+			if (this->isPreLoaded()) {
+				if (this->_preloadedFrames.empty()) return nullptr;
+				this->_started = true;
+
+				auto end = this->_preloadedFrames.back().time + this->getFrameDuration();
+				if (this->_playTime >= end) {
+					ended = true;
+
+					if (this->_loop) {
+						this->_playTime %= end;
+					} else {
+						this->_playTime = end - 1;
+						this->_paused = true;
+					}
+				}
+
+				auto it = std::upper_bound(this->_preloadedFrames.begin(), this->_preloadedFrames.end(), this->_playTime, [](uint64_t time, const rawrbox::WEBMImage& img) { return time < img.time; });
+				auto index = static_cast<size_t>(std::max<std::ptrdiff_t>(std::distance(this->_preloadedFrames.begin(), it) - 1, 0));
+
+				if (index != this->_preloadedIndex) {
+					this->_preloadedIndex = index;
+					this->_stats.presented++;
+
+					result = &this->_preloadedFrames[index];
+				}
+			} else {
+				// Everything that is due goes, only the newest gets shown
+				bool shown = false;
+				while (!this->_queue.empty()) {
+					auto& front = this->_queue.front();
+					if (this->_started && front.time > this->_playTime) break;
+
+					if (front.end) {
+						ended = true;
+						this->_queue.pop_front();
+
+						if (this->_loop) continue;
+
+						this->_paused = true;
+						break;
+					}
+
+					// Clock starts on the first frame, so slow starts / seeks don't drop anything
+					if (!this->_started) {
+						this->_playTime = front.time;
+						this->_started = true;
+					}
+
+					if (shown) this->_stats.dropped++;
+					std::swap(this->_presented, front);
+
+					this->recycle(front);
+					this->_queue.pop_front();
+					shown = true;
+				}
+
+				if (shown) {
+					this->_stats.presented++;
+					result = &this->_presented;
+				}
+
+				this->_wake.notify_one();
+			}
 		}
 
-		return img.valid();
+		if (ended) this->onEnd();
+		return result;
 	}
 
 	// UTILS ------
@@ -259,10 +452,6 @@ namespace rawrbox {
 		return this->_info.size;
 	}
 
-	const rawrbox::WEBMFrame& WEBM::getFrame() const {
-		return this->_frame;
-	}
-
 	const rawrbox::WEBMInfo& WEBM::getInfo() const {
 		return this->_info;
 	}
@@ -270,16 +459,23 @@ namespace rawrbox {
 	bool WEBM::getLoop() const { return this->_loop; }
 	void WEBM::setLoop(bool loop) {
 		if (loop != this->_loop) this->reset();
+
+		std::scoped_lock<std::mutex> lock(this->_mutex);
 		this->_loop = loop;
 	}
 
-	bool WEBM::getPaused() const { return this->_paused; }
+	bool WEBM::getPaused() const { return this->_paused.load(); }
 	void WEBM::setPaused(bool paused) {
-		this->_paused = paused;
+		this->_paused.store(paused);
 	}
 
 	bool WEBM::isPreLoaded() const {
 		return (this->_flags & rawrbox::WEBMLoadFlags::PRELOAD) > 0;
 	}
+
+	rawrbox::WEBMStats WEBM::getStats() {
+		std::scoped_lock<std::mutex> lock(this->_mutex);
+		return this->_stats;
+	}
 	// -------
 } // namespace rawrbox
@@ -2,7 +2,6 @@
 
 #include <rawrbox/render/static.hpp>
 #include <rawrbox/utils/path.hpp>
-#include <rawrbox/utils/time.hpp>
 #include <rawrbox/webm/textures/webm.hpp>
 
 namespace rawrbox {
@@ -38,7 +37,7 @@ namespace rawrbox {
 		}
 	}
 
-	void TextureWEBM::internalUpdate() {
+	void TextureWEBM::internalUpdate(const rawrbox::WEBMImage& img) {
 		auto* context = rawrbox::RENDERER->context();
 
 		Diligent::Box UpdateBox;
@@ -49,7 +48,7 @@ namespace rawrbox {
 
 		Diligent::TextureSubResData SubresData;
 		SubresData.Stride = this->_data.size.x * this->_data.channels;
-		SubresData.pData = this->_data.pixels().data();
+		SubresData.pData = img.pixels.data(); // Straight from the decoder's buffer
 
 		rawrbox::BarrierUtils::barrier({{this->_tex, Diligent::RESOURCE_STATE_SHADER_RESOURCE, Diligent::RESOURCE_STATE_COPY_DEST, Diligent::STATE_TRANSITION_FLAG_UPDATE_STATE}});
 		context->UpdateTexture(this->_tex, 0, 0, UpdateBox, SubresData, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY, Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY);
@@ -60,16 +59,13 @@ namespace rawrbox {
 	// PUBLIC --------
 	void TextureWEBM::update() {
 		if (this->_failedToLoad || this->_handle == nullptr) return; // Not bound
-		if (this->_pause || this->_cooldown >= rawrbox::TimeUtils::curtime()) return;
 		if (this->_webm == nullptr) RAWRBOX_CRITICAL("WEBM loader not initialized!");
 
-		rawrbox::WEBMImage img;
-		if (!this->_webm->getNextFrame(img)) return; // Reached end
+		// Decoded ahead on the stream's thread, presented by timestamp
+		const auto* img = this->_webm->present();
+		if (img == nullptr || img->size != this->_data.size) return; // Nothing new due
 
-		std::memcpy(this->_data.pixels().data(), img.pixels.data(), img.pixels.size());
-		this->_cooldown = rawrbox::TimeUtils::curtime() + 20; // TODO: FIX TIME SCALE
-
-		this->internalUpdate();
+		this->internalUpdate(*img);
 	}
 
 	// UTILS ------
@@ -82,7 +78,6 @@ namespace rawrbox {
 		if (this->_webm == nullptr) return;
 
 		this->_webm->reset();
-		this->_cooldown = rawrbox::TimeUtils::curtime() + 20;
 	}
 
 	bool TextureWEBM::getLoop() const {
@@ -0,0 +1,218 @@
+#include <rawrbox/webm/loader.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+namespace {
+	// 20 frames, 10ms apart in clusters of 4. Pixels hold the frame index, no file or libvpx needed
+	class FakeWEBM : public rawrbox::WEBM {
+	protected:
+		size_t _next = 0;
+
+		bool demux() override {
+			if (this->_next >= FRAMES) return false;
+
+			this->_frame.time = this->_next * FRAME_TIME;
+			this->_frame.codec = this->_info.vCodec;
+			this->_frame.buffer.assign(1, static_cast<uint8_t>(this->_next));
+
+			this->_next++;
+			return true;
+		}
+
+		void rewind() override { this->_next = 0; }
+		void seekDemuxer(uint64_t time) override { this->_next = std::min<size_t>(time / FRAME_TIME / 4 * 4, FRAMES); }
+
+		bool decode(const rawrbox::WEBMFrame& frame, rawrbox::WEBMImage& image, bool convert) override {
+			image.time = frame.time;
+			image.end = false;
+
+			if (convert) {
+				image.size = {1, 1};
+				image.pixels.assign(4, frame.buffer.front());
+			}
+
+			return true;
+		}
+
+	public:
+		static constexpr size_t FRAMES = 20;
+		static constexpr uint64_t FRAME_TIME = 10000000; // ns
+
+		explicit FakeWEBM(uint32_t flags = rawrbox::WEBMLoadFlags::NONE) {
+			this->_flags = flags;
+
+			this->_info.vCodec = rawrbox::VIDEO_CODEC::VIDEO_VP9;
+			this->_info.size = {1, 1};
+			this->_info.frameRate = 100.0;
+
+			this->play();
+		}
+
+		FakeWEBM(const FakeWEBM&) = delete;
+		FakeWEBM(FakeWEBM&&) = delete;
+		FakeWEBM& operator=(const FakeWEBM&) = delete;
+		FakeWEBM& operator=(FakeWEBM&&) = delete;
+		~FakeWEBM() override { this->stop(); } // Decode thread calls our overrides
+	};
+
+	// Presents until the callback is happy with a frame, false on timeout
+	bool playUntil(FakeWEBM& webm, const std::function<bool(const rawrbox::WEBMImage&)>& callback) {
+		auto start = std::chrono::steady_clock::now();
+
+		while (std::chrono::steady_clock::now() - start < std::chrono::seconds(5)) {
+			const auto* img = webm.present();
+			if (img != nullptr && callback(*img)) return true;
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		return false;
+	}
+} // namespace
+
+TEST_CASE("WEBM should behave as expected", "[rawrbox::WEBM]") {
+	SECTION("rawrbox::WEBM::present") {
+		FakeWEBM webm;
+
+		int ends = 0;
+		webm.onEnd += [&ends]() { ends++; };
+
+		uint64_t lastTime = 0;
+		bool ordered = true;
+
+		REQUIRE(playUntil(webm, [&](const rawrbox::WEBMImage& img) {
+			if (img.time < lastTime) ordered = false;
+			lastTime = img.time;
+
+			return img.pixels.front() == FakeWEBM::FRAMES - 1;
+		}));
+
+		// End marker is due a frame later, it pauses on the last frame
+		auto start = std::chrono::steady_clock::now();
+		while (!webm.getPaused() && std::chrono::steady_clock::now() - start < std::chrono::seconds(5)) {
+			REQUIRE(webm.present() == nullptr);
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		REQUIRE(ordered);
+		REQUIRE(webm.getPaused());
+		REQUIRE(ends == 1);
+		REQUIRE(webm.present() == nullptr);
+
+		auto stats = webm.getStats();
+		REQUIRE(stats.presented > 0);
+		REQUIRE(stats.presented + stats.dropped >= FakeWEBM::FRAMES - 1);
+	}
+
+	SECTION("rawrbox::WEBM::setLoop") {
+		FakeWEBM webm;
+		webm.setLoop(true);
+
+		int ends = 0;
+		webm.onEnd += [&ends]() { ends++; };
+
+		// Time keeps growing across loops, while the frames start over
+		uint64_t lastTime = 0;
+		bool ordered = true;
+		bool wrapped = false;
+		uint8_t lastFrame = 0;
+
+		REQUIRE(playUntil(webm, [&](const rawrbox::WEBMImage& img) {
+			if (img.time < lastTime) ordered = false;
+			if (img.pixels.front() < lastFrame) wrapped = true;
+
+			lastTime = img.time;
+			lastFrame = img.pixels.front();
+
+			return ends >= 2;
+		}));
+
+		REQUIRE(ordered);
+		REQUIRE(wrapped);
+		REQUIRE(lastTime >= FakeWEBM::FRAMES * FakeWEBM::FRAME_TIME);
+		REQUIRE_FALSE(webm.getPaused());
+	}
+
+	SECTION("rawrbox::WEBM::seek") {
+		FakeWEBM webm;
+		REQUIRE(playUntil(webm, [](const rawrbox::WEBMImage& /*img*/) { return true; }));
+
+		// Frames decoded before the seek are thrown away, playback starts on the cluster
+		for (uint64_t time : {120ULL, 40ULL, 170ULL, 0ULL}) {
+			webm.seek(time);
+
+			uint8_t first = UINT8_MAX;
+			REQUIRE(playUntil(webm, [&first](const rawrbox::WEBMImage& img) {
+				first = img.pixels.front();
+				return true;
+			}));
+
+			REQUIRE(first == time / 10 / 4 * 4);
+		}
+	}
+
+	SECTION("rawrbox::WEBM::reset") {
+		FakeWEBM webm;
+		REQUIRE(playUntil(webm, [](const rawrbox::WEBMImage& img) { return img.pixels.front() >= 8; }));
+
+		webm.setPaused(true);
+		webm.reset();
+		REQUIRE_FALSE(webm.getPaused());
+
+		uint8_t first = UINT8_MAX;
+		REQUIRE(playUntil(webm, [&first](const rawrbox::WEBMImage& img) {
+			first = img.pixels.front();
+			return true;
+		}));
+
+		REQUIRE(first == 0);
+	}
+
+	SECTION("rawrbox::WEBM::setPaused") {
+		FakeWEBM webm;
+
+		uint8_t before = 0;
+		REQUIRE(playUntil(webm, [&before](const rawrbox::WEBMImage& img) {
+			before = img.pixels.front();
+			return before >= 2;
+		}));
+
+		webm.setPaused(true);
+		auto presented = webm.getStats().presented;
+
+		for (int i = 0; i < 50; i++) {
+			REQUIRE(webm.present() == nullptr);
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		REQUIRE(webm.getStats().presented == presented);
+
+		// The pause is not counted, playback picks up where it stopped
+		webm.setPaused(false);
+
+		uint8_t after = 0;
+		REQUIRE(playUntil(webm, [&after](const rawrbox::WEBMImage& img) {
+			after = img.pixels.front();
+			return true;
+		}));
+
+		REQUIRE(after > before);
+		REQUIRE(after <= before + 2);
+	}
+
+	SECTION("rawrbox::WEBM::isPreLoaded") {
+		FakeWEBM webm(rawrbox::WEBMLoadFlags::PRELOAD);
+		REQUIRE(webm.isPreLoaded());
+
+		const auto* img = webm.present();
+		REQUIRE(img != nullptr);
+		REQUIRE(img->pixels.front() == 0);
+
+		REQUIRE(playUntil(webm, [](const rawrbox::WEBMImage& img) { return img.pixels.front() == FakeWEBM::FRAMES - 1; }));
+	}
+}
@@ -3,6 +3,7 @@
 #include <rawrbox/engine/static.hpp>
 #include <rawrbox/render/cameras/orbital.hpp>
 #include <rawrbox/render/models/utils/mesh.hpp>
+#include <rawrbox/render/plugins/gpu_culling.hpp>
 #include <rawrbox/render/resources/texture.hpp>
 #include <rawrbox/render/static.hpp>
 #include <rawrbox/resources/manager.hpp>
@@ -45,6 +46,10 @@ namespace instance_test {
 		});
 		// ---------------
 
+		// Setup plugins ---
+		render->addPlugin<rawrbox::GPUCullingPlugin>();
+		// ---------------
+
 		// Setup camera
 		auto* cam = render->createCamera<rawrbox::CameraOrbital>(*window);
 		cam->setPos({0.F, 5.F, -5.F});
@@ -94,6 +99,7 @@ namespace instance_test {
 			}
 		}
 
+		this->_model->setIndirect(true); // Only draw the visible instances
 		this->_model->upload();
 		this->_ready = true;
 	}
@@ -28,6 +28,10 @@
 #include <scripting_test/wrapper_test.hpp>
 
 namespace scripting_test {
+	// Per-frame hooks, interned once
+	static const rawrbox::HookID HOOK_UPDATE("update");
+	static const rawrbox::HookID HOOK_FIXED_UPDATE("fixedUpdate");
+	static const rawrbox::HookID HOOK_DRAW("draw");
 	void Game::setupGLFW() {
 #if defined(_DEBUG) && defined(RAWRBOX_SUPPORT_DX12)
 		auto* window = rawrbox::Window::createWindow(Diligent::RENDER_DEVICE_TYPE_D3D12); // DX12 is faster on DEBUG than Vulkan, due to vulkan having extra check steps to prevent you from doing bad things
@@ -194,23 +198,23 @@ namespace scripting_test {
 
 	void Game::update() {
 		rawrbox::Window::update();
-		rawrbox::SCRIPTING::call("update");
+		rawrbox::SCRIPTING::call(HOOK_UPDATE);
 	}
 
 	void Game::fixedUpdate() {
-		rawrbox::SCRIPTING::call("fixedUpdate");
+		rawrbox::SCRIPTING::step(HOOK_FIXED_UPDATE); // Mods with "threaded": true run it on the job pool
 	}
 
 	void Game::drawWorld() {
 		if (!this->_ready) return;
 		if (this->_model != nullptr) this->_model->draw();
 		if (this->_instance != nullptr) this->_instance->draw();
-		rawrbox::SCRIPTING::call("draw", static_cast<int>(rawrbox::DrawPass::PASS_WORLD));
+		rawrbox::SCRIPTING::call(HOOK_DRAW, static_cast<int>(rawrbox::DrawPass::PASS_WORLD));
 	}
 
 	void Game::drawOverlay() {
 		if (!this->_ready) return;
-		rawrbox::SCRIPTING::call("draw", static_cast<int>(rawrbox::DrawPass::PASS_OVERLAY));
+		rawrbox::SCRIPTING::call(HOOK_DRAW, static_cast<int>(rawrbox::DrawPass::PASS_OVERLAY));
 
 #ifdef RAWRBOX_UI
 		this->_ROOT_UI->render();